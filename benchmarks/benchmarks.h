@@ -0,0 +1,33 @@
+// Benchmarks of the performance critical parts of the game logic. Each benchmark prints its results to stdout.
+// Run all of them with ./Gomoku-bench or a single one with ./Gomoku-bench <name>.
+
+#ifndef GOMOKU_BENCHMARKS_H
+#define GOMOKU_BENCHMARKS_H
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+// measures the wall-clock time of 'f' in nanoseconds
+template <class F>
+double measure_ns(F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+inline void print_result(const std::string& benchmark, const std::string& metric, double value, const std::string& unit) {
+    std::cout << benchmark << ": " << metric << " = " << value << " " << unit << std::endl;
+}
+
+void run_renju_rules_benchmark();
+void run_pattern_board_benchmark();
+void run_mcts_engine_benchmark();
+void run_nnue_evaluator_benchmark();
+void run_position_hash_benchmark();
+void run_position_database_benchmark();
+void run_move_generator_benchmark();
+void run_game_state_copy_benchmark();
+
+#endif //GOMOKU_BENCHMARKS_H
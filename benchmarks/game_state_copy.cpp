@@ -0,0 +1,84 @@
+// Measures how the client copies its confirmed game state into the predicted one on every click and redraw: through
+// a json round trip, and in place with game_state::copy_from. Both the time and the number of heap allocations per
+// copy are reported.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/game_state.h"
+
+namespace {
+
+std::atomic<unsigned long> nof_allocations = 0;
+
+}
+
+// counts every allocation of the benchmark binary, the benchmarks run one after another on one thread
+void* operator new(std::size_t size) {
+    nof_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void run_game_state_copy_benchmark() {
+    // a running game with a few stones
+    std::string err;
+    game_state source;
+    player* player1 = new player("player1", black);
+    player* player2 = new player("player2", white);
+    source.add_player(player1, err);
+    source.add_player(player2, err);
+    source.set_game_mode("freestyle", err);
+    source.start_game(err);
+    for (unsigned int i = 0; i < 20; ++i) {
+        source.place_stone(i % 15, i / 15 * 2 + i % 2, i % 2 == 0 ? field_type::black_stone : field_type::white_stone, err);
+        source.update_current_player(err);
+        source.iterate_turn();
+    }
+
+    rapidjson::Document* json = source.to_json();
+    game_state* target = game_state::from_json(*json);
+    delete json;
+
+    const unsigned int num_iterations = 2000;
+    unsigned long allocations_before = nof_allocations.load();
+    double ns = measure_ns([&]() {
+        for (unsigned int i = 0; i < num_iterations; ++i) {
+            rapidjson::Document* state_json = source.to_json();
+            target->update_from_json(*state_json);
+            delete state_json;
+        }
+    });
+    print_result("game_state_copy", "json round trip", ns / num_iterations, "ns/copy");
+    print_result("game_state_copy", "json round trip allocations",
+                 double(nof_allocations.load() - allocations_before) / num_iterations, "allocations/copy");
+
+    allocations_before = nof_allocations.load();
+    ns = measure_ns([&]() {
+        for (unsigned int i = 0; i < num_iterations; ++i) {
+            target->copy_from(source);
+        }
+    });
+    print_result("game_state_copy", "copy_from", ns / num_iterations, "ns/copy");
+    print_result("game_state_copy", "copy_from allocations",
+                 double(nof_allocations.load() - allocations_before) / num_iterations, "allocations/copy");
+
+    for (player* copied_player : target->get_players()) {
+        delete copied_player;
+    }
+    delete target;
+    delete player1;
+    delete player2;
+}
@@ -0,0 +1,24 @@
+#include <functional>
+#include <map>
+
+#include "benchmarks.h"
+
+int main(int argc, char* argv[]) {
+    const std::map<std::string, std::function<void()>> benchmarks = {
+            {"renju_rules", run_renju_rules_benchmark},
+            {"pattern_board", run_pattern_board_benchmark},
+            {"mcts_engine", run_mcts_engine_benchmark},
+            {"nnue_evaluator", run_nnue_evaluator_benchmark},
+            {"position_hash", run_position_hash_benchmark},
+            {"position_database", run_position_database_benchmark},
+            {"move_generator", run_move_generator_benchmark},
+            {"game_state_copy", run_game_state_copy_benchmark},
+    };
+
+    for (const auto& benchmark : benchmarks) {
+        if (argc < 2 || benchmark.first == argv[1]) {
+            benchmark.second();
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Measures the playouts per second of the mcts_engine with one thread and with all cores, and plays it against a
+// greedy bot that picks the move with the best pattern_board evaluation. There is no alpha-beta engine in the tree yet,
+// so the greedy bot is the reference for the playing strength.
+
+#include <algorithm>
+#include <climits>
+#include <random>
+#include <thread>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/mcts_engine/mcts_engine.h"
+
+namespace {
+
+    // a position after a few moves near the centre, in which the playouts are about as long as in a real game
+    search_position create_opening(game_state& state, player& first, player& second, std::mt19937& rng) {
+        std::string err;
+        state.add_player(&first, err);
+        state.add_player(&second, err);
+        state.set_game_mode("freestyle", err);
+        state.start_game(err);
+        search_position position(state);
+        std::uniform_int_distribution<unsigned int> coordinate(5, 9);
+        while (position.get_num_stones() < 4) {
+            position.apply_move(search_move::stone(coordinate(rng), coordinate(rng)));
+        }
+        return position;
+    }
+
+    pattern_board create_pattern_board(const search_position& position) {
+        pattern_board board(position.get_board_size());
+        for (unsigned int y = 0; y < position.get_board_size(); ++y) {
+            for (unsigned int x = 0; x < position.get_board_size(); ++x) {
+                if (position.get_field(x, y) != field_type::empty) {
+                    board.place_stone(x, y, position.get_field(x, y));
+                }
+            }
+        }
+        return board;
+    }
+
+    // the move after which the evaluation is best for the player to move, the first of equal moves
+    search_move choose_greedy_move(const search_position& position, pattern_board& board) {
+        const field_type colour = position.get_current_colour();
+        search_move best_move = search_move::stone(0, 0);
+        int best_score = INT_MIN;
+        for (unsigned int y = 0; y < position.get_board_size(); ++y) {
+            for (unsigned int x = 0; x < position.get_board_size(); ++x) {
+                if (!position.is_legal(search_move::stone(x, y))) {
+                    continue;
+                }
+                board.place_stone(x, y, colour);
+                int score = board.evaluate(colour);
+                board.undo_stone(x, y);
+                if (score > best_score) {
+                    best_score = score;
+                    best_move = search_move::stone(x, y);
+                }
+            }
+        }
+        return best_move;
+    }
+}
+
+void run_mcts_engine_benchmark() {
+    std::mt19937 rng(42);
+
+    // playouts without the tree
+    {
+        game_state state;
+        player first("first", black);
+        player second("second", white);
+        search_position position = create_opening(state, first, second, rng);
+        pattern_board board = create_pattern_board(position);
+        const unsigned int num_playouts = 2000;
+        long checksum = 0;
+        double ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_playouts; ++i) {
+                checksum += mcts_engine::playout(position, board, rng);
+            }
+        });
+        print_result("mcts_engine", "playout", ns / num_playouts / 1000, "us/playout (checksum " + std::to_string(checksum) + ")");
+    }
+
+    // tree search with one thread and with all cores
+    const unsigned int num_cores = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int num_threads : {1u, num_cores}) {
+        game_state state;
+        player first("first", black);
+        player second("second", white);
+        search_position position = create_opening(state, first, second, rng);
+        mcts_engine engine({std::chrono::milliseconds(1000), 0, num_threads, 1.5f, 3, 1u << 20, 42});
+        mcts_result result = engine.search(position);
+        double seconds = std::chrono::duration<double>(result.elapsed).count();
+        print_result("mcts_engine", "search with " + std::to_string(num_threads) + " threads",
+                     result.num_playouts / seconds, "playouts/s");
+        print_result("mcts_engine", "search with " + std::to_string(num_threads) + " threads",
+                     result.num_playouts / seconds / num_threads, "playouts/s per core");
+    }
+
+    // playing strength against the greedy bot, with alternating colours
+    const unsigned int num_games = 4;
+    double mcts_score = 0;
+    for (unsigned int game = 0; game < num_games; ++game) {
+        game_state state;
+        player first("first", black);
+        player second("second", white);
+        search_position position = create_opening(state, first, second, rng);
+        pattern_board board = create_pattern_board(position);
+        const unsigned int mcts_player_idx = game % 2;
+        mcts_engine engine({std::chrono::milliseconds(100), 0, 0, 1.5f, 3, 1u << 20, 42 + game});
+        while (!position.is_finished()) {
+            const field_type colour = position.get_current_colour();
+            search_move move = position.get_current_player_idx() == mcts_player_idx
+                               ? engine.search(position).best_move : choose_greedy_move(position, board);
+            position.apply_move(move);
+            board.place_stone(move.x, move.y, colour);
+        }
+        if (position.is_tied()) {
+            mcts_score += 0.5;
+        } else if (position.get_current_player_idx() == mcts_player_idx) {
+            mcts_score += 1;
+        }
+    }
+    print_result("mcts_engine", "score against the greedy bot at 100ms per move", mcts_score,
+                 "of " + std::to_string(num_games) + " games");
+}
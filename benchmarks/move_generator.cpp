@@ -0,0 +1,114 @@
+// Counts the positions reachable within a few moves (perft) from a middle game position, with the candidate moves of
+// the move_generator, and compares it to finding the same fields by scanning the whole board for every position.
+// The ordered variant also scores the moves by their patterns, like the search does.
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/move_generator/move_generator.h"
+
+namespace {
+
+    enum generation_mode {
+        bitmask_generation,
+        ordered_generation,
+        scan_generation,
+    };
+
+    // the empty fields within distance 2 of a stone, found by looking at the neighbourhood of every field
+    void scan_candidates(const search_position& position, move_generator::move_list& moves) {
+        const int board_size = int(position.get_board_size());
+        const field_type* fields = position.get_fields();
+        moves.size = 0;
+        for (int y = 0; y < board_size; ++y) {
+            for (int x = 0; x < board_size; ++x) {
+                if (fields[y * board_size + x] != field_type::empty) {
+                    continue;
+                }
+                bool is_near = false;
+                for (int neighbour_y = std::max(0, y - 2); neighbour_y <= std::min(board_size - 1, y + 2) && !is_near; ++neighbour_y) {
+                    for (int neighbour_x = std::max(0, x - 2); neighbour_x <= std::min(board_size - 1, x + 2); ++neighbour_x) {
+                        if (fields[neighbour_y * board_size + neighbour_x] != field_type::empty) {
+                            is_near = true;
+                            break;
+                        }
+                    }
+                }
+                if (is_near) {
+                    moves.moves[moves.size++] = {static_cast<std::uint16_t>(y * board_size + x), 0};
+                }
+            }
+        }
+    }
+
+    std::uint64_t perft(search_position& position, pattern_board& board, move_generator& generator, unsigned int depth,
+                        generation_mode mode) {
+        if (depth == 0 || position.is_finished()) {
+            return 1;
+        }
+        move_generator::move_list moves;
+        switch (mode) {
+            case bitmask_generation:
+                generator.generate(move_generator::max_distance, moves);
+                break;
+            case ordered_generation:
+                generator.generate(move_generator::max_distance, board, position.get_current_colour(), moves);
+                break;
+            case scan_generation:
+                scan_candidates(position, moves);
+                break;
+        }
+
+        const unsigned int board_size = position.get_board_size();
+        std::uint64_t num_nodes = 0;
+        for (unsigned int i = 0; i < moves.size; ++i) {
+            const unsigned int x = moves.moves[i].field % board_size;
+            const unsigned int y = moves.moves[i].field / board_size;
+            const field_type colour = position.get_current_colour();
+            if (!position.apply_move(search_move::stone(x, y))) {
+                continue;
+            }
+            board.place_stone(x, y, colour);
+            generator.place_stone(x, y);
+            num_nodes += perft(position, board, generator, depth - 1, mode);
+            generator.undo_stone(x, y);
+            board.undo_stone(x, y);
+            position.undo_move();
+        }
+        return num_nodes;
+    }
+}
+
+void run_move_generator_benchmark() {
+    // a few stones near the centre of a freestyle game
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<unsigned int> coordinate(5, 9);
+    search_position position(ruleset_type::freestyle, 15);
+    pattern_board board(15);
+    while (position.get_num_stones() < 6) {
+        const unsigned int x = coordinate(rng);
+        const unsigned int y = coordinate(rng);
+        const field_type colour = position.get_current_colour();
+        if (position.apply_move(search_move::stone(x, y))) {
+            board.place_stone(x, y, colour);
+        }
+    }
+    move_generator generator(position);
+
+    const std::array<std::pair<generation_mode, const char*>, 3> modes = {{
+            {bitmask_generation, "bitmask"}, {ordered_generation, "ordered"}, {scan_generation, "scan"}
+    }};
+    for (const auto& [mode, name] : modes) {
+        for (unsigned int depth = 1; depth <= 3; ++depth) {
+            std::uint64_t num_nodes = 0;
+            const double ns = measure_ns([&]() {
+                num_nodes = perft(position, board, generator, depth, mode);
+            });
+            print_result("move_generator", std::string("perft ") + name + " depth " + std::to_string(depth),
+                         num_nodes / (ns / 1e9), "nodes/s (" + std::to_string(num_nodes) + " nodes)");
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// Measures how many positions per second the nnue_evaluator evaluates while stones are placed and undone, compared
+// to recomputing its accumulators for every position and to the handcrafted pattern_board evaluation.
+
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/evaluation/nnue_evaluator.h"
+#include "../src/common/game_state/line_patterns/pattern_board.h"
+
+namespace {
+
+    // places the moves one after another and evaluates every position, then takes them back
+    template <class evaluator_type>
+    double measure_evaluations(evaluator_type& evaluator, const std::vector<std::pair<unsigned int, unsigned int>>& moves,
+                               unsigned int num_iterations, bool refresh, long& checksum) {
+        return measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                for (unsigned int m = 0; m < moves.size(); ++m) {
+                    evaluator.place_stone(moves[m].first, moves[m].second, m % 2 == 0 ? field_type::black_stone : field_type::white_stone);
+                    if constexpr (std::is_same_v<evaluator_type, nnue_evaluator>) {
+                        if (refresh) {
+                            evaluator.refresh();
+                        }
+                    }
+                    checksum += evaluator.evaluate(m % 2 == 0 ? field_type::white_stone : field_type::black_stone);
+                }
+                for (auto move = moves.rbegin(); move != moves.rend(); ++move) {
+                    evaluator.undo_stone(move->first, move->second);
+                }
+            }
+        });
+    }
+}
+
+void run_nnue_evaluator_benchmark() {
+    const unsigned int board_size = 15;
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<unsigned int> coordinate(0, board_size - 1);
+
+    // a game of distinct fields, which is played and undone repeatedly
+    std::vector<std::pair<unsigned int, unsigned int>> moves;
+    std::vector<bool> is_occupied(board_size * board_size, false);
+    while (moves.size() < board_size * board_size / 3) {
+        unsigned int x = coordinate(rng);
+        unsigned int y = coordinate(rng);
+        if (!is_occupied[y * board_size + x]) {
+            is_occupied[y * board_size + x] = true;
+            moves.emplace_back(x, y);
+        }
+    }
+
+    const unsigned int num_iterations = 200;
+    const double num_evaluations = double(num_iterations) * moves.size();
+    long checksum = 0;
+
+    nnue_evaluator evaluator(nnue_network::create_random(board_size, 42));
+    double ns = measure_evaluations(evaluator, moves, num_iterations, false, checksum);
+    print_result("nnue_evaluator", std::string("incremental, ") + nnue_evaluator::get_instruction_set(),
+                 num_evaluations / ns * 1e9, "evaluations/s (checksum " + std::to_string(checksum) + ")");
+
+    ns = measure_evaluations(evaluator, moves, num_iterations / 10, true, checksum);
+    print_result("nnue_evaluator", "accumulators recomputed for every position",
+                 num_evaluations / 10 / ns * 1e9, "evaluations/s (checksum " + std::to_string(checksum) + ")");
+
+    pattern_board board(board_size);
+    ns = measure_evaluations(board, moves, num_iterations, false, checksum);
+    print_result("nnue_evaluator", "pattern_board for comparison", num_evaluations / ns * 1e9,
+                 "evaluations/s (checksum " + std::to_string(checksum) + ")");
+}
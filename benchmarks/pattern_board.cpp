@@ -0,0 +1,68 @@
+// Times placing and undoing stones on a pattern_board, which includes the incremental pattern count updates, and
+// compares the O(1) evaluation to recounting all patterns of the board.
+
+#include <random>
+#include <vector>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/line_patterns/pattern_board.h"
+
+void run_pattern_board_benchmark() {
+    std::mt19937 rng(42);
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        pattern_board board(board_size);
+        std::uniform_int_distribution<unsigned int> coordinate(0, board_size - 1);
+
+        // a sequence of moves on distinct fields, which is played and undone repeatedly
+        std::vector<std::pair<unsigned int, unsigned int>> moves;
+        while (moves.size() < board_size * board_size / 3) {
+            unsigned int x = coordinate(rng);
+            unsigned int y = coordinate(rng);
+            if (board.place_stone(x, y, field_type::black_stone)) {
+                moves.emplace_back(x, y);
+            }
+        }
+        for (const std::pair<unsigned int, unsigned int>& move : moves) {
+            board.undo_stone(move.first, move.second);
+        }
+
+        const unsigned int num_iterations = 200;
+        long checksum = 0;
+        double ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                for (unsigned int m = 0; m < moves.size(); ++m) {
+                    board.place_stone(moves[m].first, moves[m].second, m % 2 == 0 ? field_type::black_stone : field_type::white_stone);
+                    checksum += board.evaluate(field_type::black_stone);
+                }
+                for (auto move = moves.rbegin(); move != moves.rend(); ++move) {
+                    board.undo_stone(move->first, move->second);
+                }
+            }
+        });
+        const std::string size_string = std::to_string(board_size) + "x" + std::to_string(board_size);
+        print_result("pattern_board", "place + evaluate + undo " + size_string, ns / (num_iterations * moves.size()),
+                     "ns/move (checksum " + std::to_string(checksum) + ")");
+
+        // the same evaluation without incremental updates has to look at every field and direction
+        for (unsigned int m = 0; m < moves.size(); ++m) {
+            board.place_stone(moves[m].first, moves[m].second, m % 2 == 0 ? field_type::black_stone : field_type::white_stone);
+        }
+        const unsigned int num_rescans = 2000;
+        ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_rescans; ++i) {
+                int score = 0;
+                for (unsigned int y = 0; y < board_size; ++y) {
+                    for (unsigned int x = 0; x < board_size; ++x) {
+                        for (unsigned int direction = 0; direction < pattern_board::NUM_DIRECTIONS; ++direction) {
+                            score += pattern_board::_pattern_scores[board.get_pattern(x, y, direction, field_type::black_stone)];
+                            score -= pattern_board::_pattern_scores[board.get_pattern(x, y, direction, field_type::white_stone)];
+                        }
+                    }
+                }
+                checksum += score;
+            }
+        });
+        print_result("pattern_board", "full board rescan " + size_string, ns / num_rescans,
+                     "ns/evaluation (checksum " + std::to_string(checksum) + ")");
+    }
+}
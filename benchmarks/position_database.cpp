@@ -0,0 +1,55 @@
+// Measures lookups in a position database with a million positions: hits, which decode part of a block, and misses,
+// which are mostly answered by the bloom filter. Also reports the size of the file per position.
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/position_database/position_database_builder.h"
+
+void run_position_database_benchmark() {
+    const std::string path = (std::filesystem::temp_directory_path() / "gomoku-positions-bench.bin").string();
+    const unsigned int num_positions = 1000000;
+    std::mt19937_64 rng(42);
+    std::vector<std::uint64_t> hashes;
+    hashes.reserve(num_positions);
+    {
+        position_database_builder builder(0);
+        for (unsigned int i = 0; i < num_positions; ++i) {
+            position_record record = {rng(), field_type::black_stone, position_result::position_won,
+                                      search_move::stone(rng() % 15, rng() % 15), unsigned(rng() % 200), 1};
+            builder.add_position(record);
+            hashes.push_back(record.hash);
+        }
+        double ns = measure_ns([&]() {
+            builder.write(path);
+        });
+        print_result("position_database", "write", ns / num_positions, "ns/position");
+    }
+    print_result("position_database", "file size", double(std::filesystem::file_size(path)) / num_positions,
+                 "bytes/position");
+
+    position_database database(path);
+    std::shuffle(hashes.begin(), hashes.end(), rng);
+    const unsigned int num_queries = 200000;
+    unsigned int num_found = 0;
+    double ns = measure_ns([&]() {
+        position_record record;
+        for (unsigned int i = 0; i < num_queries; ++i) {
+            num_found += database.find(hashes[i], record) ? 1 : 0;
+        }
+    });
+    print_result("position_database", "hit", ns / num_queries, "ns/query (" + std::to_string(num_found) + " found)");
+
+    num_found = 0;
+    ns = measure_ns([&]() {
+        position_record record;
+        for (unsigned int i = 0; i < num_queries; ++i) {
+            num_found += database.find(rng(), record) ? 1 : 0;
+        }
+    });
+    print_result("position_database", "miss", ns / num_queries, "ns/query (" + std::to_string(num_found) + " found)");
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,89 @@
+// Measures the cost of the canonical hash of a position: recomputing it from the board by transforming the coordinates
+// of every stone, recomputing it with the precomputed symmetry tables, and reading it from the hashes that a
+// search_position keeps up to date with every move.
+
+#include <random>
+#include <vector>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/position_hash/position_hash.h"
+#include "../src/common/game_state/search_position/search_position.h"
+
+void run_position_hash_benchmark() {
+    std::mt19937 rng(42);
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        // a mid-game position
+        search_position position(ruleset_type::freestyle, board_size);
+        std::uniform_int_distribution<unsigned int> coordinate(0, board_size - 1);
+        std::vector<search_move> moves;
+        while (moves.size() < 40) {
+            search_move move = search_move::stone(coordinate(rng), coordinate(rng));
+            if (position.apply_move(move)) {
+                moves.push_back(move);
+            }
+        }
+        const field_type* fields = position.get_fields();
+        const std::string size_string = std::to_string(board_size) + "x" + std::to_string(board_size);
+        const unsigned int num_iterations = 20000;
+        std::uint64_t checksum = 0;
+
+        double ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                position_hash::symmetric_hashes hashes = {};
+                for (unsigned int y = 0; y < board_size; ++y) {
+                    for (unsigned int x = 0; x < board_size; ++x) {
+                        const field_type colour = fields[y * board_size + x];
+                        if (colour == field_type::empty) {
+                            continue;
+                        }
+                        for (unsigned int symmetry = 0; symmetry < position_hash::num_symmetries; ++symmetry) {
+                            // the coordinates are transformed like before the tables existed
+                            unsigned int symmetric_x = symmetry >= 4 ? board_size - 1 - x : x;
+                            unsigned int symmetric_y = y;
+                            for (unsigned int r = 0; r < symmetry % 4; ++r) {
+                                unsigned int rotated_x = board_size - 1 - symmetric_y;
+                                symmetric_y = symmetric_x;
+                                symmetric_x = rotated_x;
+                            }
+                            hashes[symmetry] ^= position_hash::get_stone_key(symmetric_x, symmetric_y, colour);
+                        }
+                    }
+                }
+                checksum += position_hash::get_canonical_hash(hashes, position_hash::get_turn_key(position)).hash;
+            }
+        });
+        print_result("position_hash", "canonical hash, coordinate transforms " + size_string, ns / num_iterations,
+                     "ns/position");
+
+        ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                position_hash::symmetric_hashes hashes = position_hash::compute_stone_hashes(fields, board_size);
+                checksum += position_hash::get_canonical_hash(hashes, position_hash::get_turn_key(position)).hash;
+            }
+        });
+        print_result("position_hash", "canonical hash, symmetry tables " + size_string, ns / num_iterations,
+                     "ns/position");
+
+        ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                checksum += position_hash::get_canonical_hash(position).hash;
+            }
+        });
+        print_result("position_hash", "canonical hash, incremental " + size_string, ns / num_iterations,
+                     "ns/position");
+
+        // the update cost that the incremental hashes add to every move
+        ns = measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations / 10; ++i) {
+                for (unsigned int m = 0; m < moves.size(); ++m) {
+                    position.undo_move();
+                }
+                for (const search_move& move : moves) {
+                    position.apply_move(move);
+                }
+            }
+        });
+        print_result("position_hash", "apply + undo with hash updates " + size_string,
+                     ns / (num_iterations / 10 * moves.size()), "ns/move (checksum " + std::to_string(checksum % 1000) + ")");
+    }
+}
@@ -0,0 +1,110 @@
+// Times the Renju forbidden move detection on a corpus of tricky positions (nested false threes, double-fours on
+// one line, overlines next to fives) and on randomly filled boards.
+
+#include <random>
+#include <vector>
+
+#include "benchmarks.h"
+#include "../src/common/game_state/renju_rules/renju_rules.h"
+
+namespace {
+
+    struct renju_position {
+        std::string name;
+        std::vector<std::pair<unsigned int, unsigned int>> black_stones;
+        std::vector<std::pair<unsigned int, unsigned int>> white_stones;
+        std::pair<unsigned int, unsigned int> move;
+        forbidden_move_type expected;
+    };
+
+    const std::vector<renju_position> tricky_positions = {
+            {"double-three", {{7, 5}, {7, 6}, {5, 7}, {6, 7}}, {}, {7, 7}, forbidden_double_three},
+            {"closed three", {{7, 5}, {7, 6}, {5, 7}, {6, 7}}, {{7, 8}}, {7, 7}, allowed_move},
+            {"split double-three", {{7, 4}, {7, 6}, {4, 7}, {6, 7}}, {}, {7, 7}, forbidden_double_three},
+            {"double-four", {{7, 4}, {7, 5}, {7, 6}, {4, 7}, {5, 7}, {6, 7}}, {}, {7, 7}, forbidden_double_four},
+            {"double-four on one line", {{3, 7}, {5, 7}, {6, 7}, {9, 7}}, {}, {7, 7}, forbidden_double_four},
+            {"four-three", {{7, 4}, {7, 5}, {7, 6}, {5, 7}, {6, 7}}, {}, {7, 7}, allowed_move},
+            {"overline", {{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, {}, {5, 7}, forbidden_overline},
+            {"five before double-three", {{3, 7}, {4, 7}, {5, 7}, {6, 7}, {7, 5}, {7, 6}, {5, 5}, {6, 6}}, {}, {7, 7}, allowed_move},
+            {"three limited by overline", {{3, 7}, {6, 7}, {8, 7}, {11, 7}, {7, 5}, {7, 6}}, {}, {7, 7}, allowed_move},
+            {"false three",
+             {{7, 6}, {7, 8}, {6, 7}, {8, 7}, {4, 5}, {5, 5}, {6, 5}, {8, 5}, {9, 5}, {4, 9}, {5, 9}, {6, 9}, {8, 9}, {9, 9}},
+             {}, {7, 7}, allowed_move},
+            {"double-three at the edge", {{0, 1}, {0, 2}, {1, 0}, {2, 0}}, {}, {0, 0}, allowed_move},
+            {"diagonal double-three", {{5, 5}, {6, 6}, {9, 5}, {8, 6}}, {}, {7, 7}, forbidden_double_three},
+    };
+
+    playing_board build_board(const renju_position& position) {
+        playing_board board;
+        std::string err;
+        for (const std::pair<unsigned int, unsigned int>& stone : position.black_stones) {
+            board.place_stone(stone.first, stone.second, field_type::black_stone, err);
+        }
+        for (const std::pair<unsigned int, unsigned int>& stone : position.white_stones) {
+            board.place_stone(stone.first, stone.second, field_type::white_stone, err);
+        }
+        return board;
+    }
+
+    // fills a board of the given size with 'num_stones' stones of alternating colour on random empty fields
+    playing_board build_random_board(unsigned int board_size, unsigned int num_stones, std::mt19937& rng) {
+        playing_board board(board_size);
+        std::uniform_int_distribution<unsigned int> coordinate(0, board_size - 1);
+        std::string err;
+        unsigned int placed = 0;
+        while (placed < num_stones) {
+            field_type colour = placed % 2 == 0 ? field_type::black_stone : field_type::white_stone;
+            if (board.place_stone(coordinate(rng), coordinate(rng), colour, err)) {
+                ++placed;
+            }
+        }
+        return board;
+    }
+}
+
+void run_renju_rules_benchmark() {
+    const unsigned int num_iterations = 20000;
+
+    // warm up the line table, so that its construction is not part of the first measurement
+    renju_rules::check_black_move(playing_board(), 7, 7);
+
+    unsigned int num_mismatches = 0;
+    unsigned long num_checks = 0;
+    double total_ns = 0;
+    for (const renju_position& position : tricky_positions) {
+        playing_board board = build_board(position);
+        forbidden_move_type result = renju_rules::check_black_move(board, position.move.first, position.move.second);
+        if (result != position.expected) {
+            std::cout << "renju_rules: unexpected result for '" << position.name << "': "
+                      << renju_rules::_forbidden_move_type_to_string.at(result) << std::endl;
+            ++num_mismatches;
+        }
+
+        total_ns += measure_ns([&]() {
+            for (unsigned int i = 0; i < num_iterations; ++i) {
+                result = renju_rules::check_black_move(board, position.move.first, position.move.second);
+            }
+        });
+        num_checks += num_iterations;
+    }
+    print_result("renju_rules", "tricky positions check_black_move", total_ns / num_checks, "ns/move");
+    print_result("renju_rules", "tricky positions mismatches", num_mismatches, "");
+
+    std::mt19937 rng(42);
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        const unsigned int num_boards = 50;
+        std::vector<playing_board> boards;
+        for (unsigned int i = 0; i < num_boards; ++i) {
+            boards.push_back(build_random_board(board_size, board_size * board_size / 4, rng));
+        }
+
+        unsigned long num_forbidden = 0;
+        double ns = measure_ns([&]() {
+            for (const playing_board& board : boards) {
+                num_forbidden += renju_rules::get_forbidden_fields(board).size();
+            }
+        });
+        print_result("renju_rules", "get_forbidden_fields " + std::to_string(board_size) + "x" + std::to_string(board_size),
+                     ns / num_boards / 1000.0, "us/board (" + std::to_string(num_forbidden) + " forbidden fields)");
+    }
+}
@@ -1,13 +1,23 @@
 #include "Gomoku.h"
+#include "../uiElements/image_cache.h"
+#include "../../common/logging/logger.h"
 
 
 // Application entry point
 bool Gomoku::OnInit()
 {
+    logger::configure_from_environment();
+
     // Allow loading of JPEG  and PNG image files
     wxImage::AddHandler(new wxJPEGHandler());
     wxImage::AddHandler(new wxPNGHandler());
 
+    // Decode the images of the lobby and the board in the background, while the connection panel is shown.
+    // All other images are decoded when they are first shown.
+    image_cache::preload({"assets/background_gameselection.jpg", "assets/background_game.png",
+                          "assets/playing_board.png", "assets/stone_black.png", "assets/stone_white.png",
+                          "assets/stone_shadow.png", "assets/stone_transparent.png"});
+
     // Open main game window
     game_window* gameWindow = new game_window(
             "Gomoku", // title of window,
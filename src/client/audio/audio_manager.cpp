@@ -0,0 +1,89 @@
+#include "audio_manager.h"
+
+
+// for sound playing
+const std::unordered_map<sound_type, std::string> audio_manager::_sound_type_to_path = {
+        {click_button_sound, "assets/music/click-button.wav"},
+        {place_stone_sound, "assets/music/place-stone-sound.wav"},
+        {rematch_sound, "assets/music/rematch.wav"},
+        {forfeit_sound, "assets/music/forfeit.wav"},
+};
+
+// initialize static members
+std::unordered_map<sound_type, std::unique_ptr<wxSound>> audio_manager::_sounds;
+wxMediaCtrl* audio_manager::_music_player = nullptr;
+bool audio_manager::_music_is_loaded = false;
+bool audio_manager::_music_is_started = false;
+bool audio_manager::_is_muted = false;
+
+
+void audio_manager::init(wxWindow* parent) {
+
+    // sound effects are short, so they are kept in memory
+    for (const auto& sound : audio_manager::_sound_type_to_path) {
+        audio_manager::_sounds[sound.first] = std::make_unique<wxSound>(sound.second);
+    }
+
+    // the background music is streamed from the file
+    audio_manager::_music_player = new wxMediaCtrl();
+    audio_manager::_music_player->Create(parent, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize,
+                                         (long) wxMEDIABACKEND_WMP10);
+    audio_manager::_music_player->Hide();
+    audio_manager::_music_player->SetVolume(1.0);
+    audio_manager::_music_player->Bind(wxEVT_MEDIA_LOADED, &audio_manager::on_music_loaded);
+    audio_manager::_music_player->Bind(wxEVT_MEDIA_FINISHED, &audio_manager::on_music_finished);
+    // some backends load synchronously, others report it with wxEVT_MEDIA_LOADED
+    audio_manager::_music_is_loaded = audio_manager::_music_player->Load("assets/music/chinese-journey.wav");
+}
+
+
+void audio_manager::play_sound(sound_type sound) {
+    auto it = audio_manager::_sounds.find(sound);
+    if (!audio_manager::_is_muted && it != audio_manager::_sounds.end() && it->second->IsOk()) {
+        it->second->Play(wxSOUND_ASYNC);
+    }
+}
+
+
+void audio_manager::start_music() {
+    if (audio_manager::_music_is_started) {
+        return;
+    }
+    audio_manager::_music_is_started = true;
+    // otherwise, the music starts as soon as it is loaded
+    if (audio_manager::_music_is_loaded && !audio_manager::_is_muted) {
+        audio_manager::_music_player->Play();
+    }
+}
+
+
+void audio_manager::set_muted(bool muted) {
+    audio_manager::_is_muted = muted;
+    if (audio_manager::_music_player == nullptr || !audio_manager::_music_is_loaded || !audio_manager::_music_is_started) {
+        return;
+    }
+    if (muted) {
+        audio_manager::_music_player->Pause();
+    } else {
+        audio_manager::_music_player->Play();
+    }
+}
+
+
+bool audio_manager::is_muted() {
+    return audio_manager::_is_muted;
+}
+
+
+void audio_manager::on_music_loaded(wxMediaEvent& event) {
+    audio_manager::_music_is_loaded = true;
+    if (audio_manager::_music_is_started && !audio_manager::_is_muted) {
+        audio_manager::_music_player->Play();
+    }
+}
+
+
+void audio_manager::on_music_finished(wxMediaEvent& event) {
+    // play the background music in a loop
+    audio_manager::_music_player->Play();
+}
@@ -0,0 +1,50 @@
+#ifndef GOMOKU_AUDIO_MANAGER_H
+#define GOMOKU_AUDIO_MANAGER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <wx/wx.h>
+#include <wx/mediactrl.h> // background music
+#include <wx/sound.h>
+
+enum sound_type{
+    click_button_sound,
+    place_stone_sound,
+    rematch_sound,
+    forfeit_sound
+};
+
+// Plays the sound effects and the background music of the client. The sound effects are loaded into memory once,
+// the background music is streamed by a single media control that lives as long as the game window, independent of
+// how often the panels are rebuilt.
+class audio_manager {
+
+public:
+    // loads all sound effects and the background music. 'parent' must live until the end of the application.
+    static void init(wxWindow* parent);
+
+    static void play_sound(sound_type sound);
+
+    // starts the background music in a loop, unless it is already playing
+    static void start_music();
+
+    // muting pauses the background music and silences all sound effects
+    static void set_muted(bool muted);
+    static bool is_muted();
+
+private:
+    static void on_music_loaded(wxMediaEvent& event);
+    static void on_music_finished(wxMediaEvent& event);
+
+    static const std::unordered_map<sound_type, std::string> _sound_type_to_path;
+
+    static std::unordered_map<sound_type, std::unique_ptr<wxSound>> _sounds;
+    static wxMediaCtrl* _music_player;
+    static bool _music_is_loaded;
+    static bool _music_is_started;
+    static bool _is_muted;
+};
+
+
+#endif //GOMOKU_AUDIO_MANAGER_H
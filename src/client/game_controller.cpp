@@ -1,4 +1,6 @@
 #include "game_controller.h"
+#include <algorithm>
+#include <thread>
 #include "../common/network/requests/join_game_request.h"
 #include "../common/network/requests/start_game_request.h"
 #include "../common/network/requests/place_stone_request.h"
@@ -7,6 +9,7 @@
 #include "../common/network/requests/restart_game_request.h"
 #include "../common/network/requests/forfeit_request.h"
 #include "network/client_network_manager.h"
+#include "audio/audio_manager.h"
 
 
 // initialize static members
@@ -15,6 +18,12 @@ connection_panel* game_controller::_connection_panel = nullptr;
 main_game_panel* game_controller::_main_game_panel = nullptr;
 player* game_controller::_me = nullptr;
 game_state* game_controller::_current_game_state = nullptr;
+game_state* game_controller::_confirmed_game_state = nullptr;
+game_state* game_controller::_predicted_game_state = nullptr;
+game_state* game_controller::_test_game_state = nullptr;
+std::vector<game_controller::pending_move> game_controller::_pending_moves;
+bool game_controller::_is_server_restarting = false;
+unsigned int game_controller::_nof_reconnect_attempts = 0;
 
 void game_controller::init(game_window* game_window) {
 
@@ -24,6 +33,9 @@ void game_controller::init(game_window* game_window) {
     game_controller::_connection_panel = new connection_panel(game_window);
     game_controller::_main_game_panel = new main_game_panel(game_window);
 
+    // Load sounds and background music, which are kept across panel rebuilds
+    audio_manager::init(game_window);
+
     // Hide all panels
     game_controller::_connection_panel->Show(false);
     game_controller::_main_game_panel->Show(false);
@@ -82,25 +94,84 @@ void game_controller::connect_to_server() {
 }
 
 
-void game_controller::update_game_state(game_state* new_game_state) {
+void game_controller::update_game_state(const rapidjson::Value& state_json, const std::string& answered_req_id) {
+
+    // the answered move is part of the new game state, if the server accepted it
+    if (!answered_req_id.empty()) {
+        std::erase_if(game_controller::_pending_moves, [&answered_req_id](const pending_move& move) {
+            return move.req_id == answered_req_id;
+        });
+    }
 
-    // the existing game state is now old
-    game_state* oldGameState = game_controller::_current_game_state;
+    // the confirmed game state is created once and then updated in place
+    if (game_controller::_confirmed_game_state == nullptr) {
+        game_controller::_confirmed_game_state = game_state::from_json(state_json);
+    } else {
+        game_controller::_confirmed_game_state->update_from_json(state_json);
+    }
 
-    // save the new game state as our current game state
-    game_controller::_current_game_state = new_game_state;
+    game_controller::show_predicted_game_state();
+}
+
+
+void game_controller::reject_move(const std::string& req_id) {
+    auto rejected_move = std::find_if(game_controller::_pending_moves.begin(), game_controller::_pending_moves.end(),
+                                      [&req_id](const pending_move& move) { return move.req_id == req_id; });
+    if (rejected_move == game_controller::_pending_moves.end()) {
+        return;
+    }
+    game_controller::_pending_moves.erase(rejected_move);
+    game_controller::show_predicted_game_state();
+}
+
+
+bool game_controller::apply_move(game_state* state, const pending_move& move, std::string& err) {
+    if (!state->place_stone(move.x, move.y, move.colour, err)) {
+        return false;
+    }
+    // a stone that ends the round is only shown, the round is wrapped up by the server
+    if (state->check_win_condition(move.x, move.y, move.colour) || state->check_for_tie()) {
+        return true;
+    }
+    if (!state->update_current_player(err)) {
+        return false;
+    }
+    state->iterate_turn();
+    return true;
+}
 
-    // make sure we are showing the main game panel in the window (if we are already showing it, nothing will happen)
-    game_controller::_game_window->show_panel(game_controller::_main_game_panel);
 
-    // save current music state for continuation
-    if(game_controller::_main_game_panel->music_is_started) {
-        game_controller::_main_game_panel->save_music_state();
+void game_controller::copy_game_state(const game_state* source, game_state*& target) {
+    if (target == nullptr) {
+        // only the first copy goes through json, later ones reuse the target's board and players
+        rapidjson::Document* json = source->to_json();
+        target = game_state::from_json(*json);
+        delete json;
+    } else {
+        target->copy_from(*source);
     }
+}
+
+
+void game_controller::show_predicted_game_state() {
+
+    // save the predicted game state, or the confirmed one if there are no pending moves, as our current game state
+    if (game_controller::_pending_moves.empty()) {
+        game_controller::_current_game_state = game_controller::_confirmed_game_state;
+    } else {
+        game_controller::copy_game_state(game_controller::_confirmed_game_state, game_controller::_predicted_game_state);
+        std::string err;
+        std::erase_if(game_controller::_pending_moves, [&err](const pending_move& move) {
+            return !game_controller::apply_move(game_controller::_predicted_game_state, move, err);
+        });
+        game_controller::_current_game_state = game_controller::_predicted_game_state;
+    }
+
+    // make sure we are showing the main game panel in the window (if we are already showing it, nothing will happen)
+    game_controller::_game_window->show_panel(game_controller::_main_game_panel);
 
     // command the main game panel to rebuild itself, based on the new game state
     game_controller::_main_game_panel->build_game_state(game_controller::_current_game_state, game_controller::_me);
-
 }
 
 
@@ -110,16 +181,33 @@ void game_controller::start_game() {
 }
 
 void game_controller::place_stone(unsigned int x, unsigned int y, field_type colour, std::string &err) {
-    if (x < 15 && y < 15 && (colour == field_type::black_stone || colour == field_type::white_stone)) {
-        place_stone_request request = place_stone_request(game_controller::_me->get_id(), game_controller::_current_game_state->get_id(), x, y, colour);
-        client_network_manager::send_request(request);
-    } else {
+    unsigned int board_size = game_controller::_current_game_state->get_board_size();
+    if (x >= board_size || y >= board_size || (colour != field_type::black_stone && colour != field_type::white_stone)) {
         err = "invalid position or colour";
+        return;
+    }
+    place_stone_request request = place_stone_request(game_controller::_me->get_id(), game_controller::_current_game_state->get_id(), x, y, colour);
+    pending_move move = {request.get_req_id(), x, y, colour};
+
+    // try the move on a copy first, so that moves the server would reject are not sent at all
+    game_controller::copy_game_state(game_controller::_current_game_state, game_controller::_test_game_state);
+    if (!game_controller::apply_move(game_controller::_test_game_state, move, err)) {
+        game_controller::show_error("Warning!", err);
+        return;
     }
+
+    game_controller::_pending_moves.push_back(move);
+    client_network_manager::send_request(request);
+
+    // show the stone without waiting for the server. The panel is rebuilt after the click on the stone button
+    // has been handled, because rebuilding destroys the button.
+    game_controller::get_main_thread_event_handler()->CallAfter([] {
+        game_controller::show_predicted_game_state();
+    });
 }
 
-void game_controller::set_game_rules(std::string ruleset_string, std::string &err) {
-    select_game_mode_request request = select_game_mode_request(game_controller::_me->get_id(), game_controller::_current_game_state->get_id(), ruleset_string);
+void game_controller::set_game_rules(std::string ruleset_string, unsigned int board_size, std::string &err) {
+    select_game_mode_request request = select_game_mode_request(game_controller::_me->get_id(), game_controller::_current_game_state->get_id(), ruleset_string, board_size);
     client_network_manager::send_request(request);
 }
 
@@ -155,4 +243,59 @@ void game_controller::close_game() {
 void game_controller::forfeit(){
     forfeit_request request = forfeit_request(game_controller::_me->get_id(), game_controller::_current_game_state->get_id());
     client_network_manager::send_request(request);
-}
\ No newline at end of file
+}
+
+
+void game_controller::on_server_shutdown(const std::string& message, std::chrono::milliseconds reconnect_delay) {
+    game_controller::_is_server_restarting = true;
+    game_controller::_nof_reconnect_attempts = 0;
+    game_controller::show_status(message + " Reconnecting...");
+    game_controller::schedule_reconnect(reconnect_delay);
+}
+
+void game_controller::on_connection_lost(const std::string& message) {
+    if (game_controller::_is_server_restarting) {
+        // the connection was closed on purpose, the reconnect is already scheduled
+        game_controller::show_status("Waiting for the server to restart...");
+    } else {
+        game_controller::show_error("Network error", message);
+    }
+}
+
+void game_controller::schedule_reconnect(std::chrono::milliseconds delay) {
+    std::thread timer([delay]() {
+        std::this_thread::sleep_for(delay);
+        game_controller::get_main_thread_event_handler()->CallAfter([] {
+            game_controller::reconnect_to_server();
+        });
+    });
+    timer.detach();
+}
+
+void game_controller::reconnect_to_server() {
+    if (game_controller::_me == nullptr) {
+        return;
+    }
+    game_controller::_nof_reconnect_attempts++;
+    if (!client_network_manager::reconnect()) {
+        if (game_controller::_nof_reconnect_attempts < game_controller::max_reconnect_attempts) {
+            game_controller::schedule_reconnect(game_controller::reconnect_retry_delay);
+        } else {
+            game_controller::_is_server_restarting = false;
+            game_controller::show_error("Connection error", "The server did not come back after the restart");
+        }
+        return;
+    }
+    game_controller::_is_server_restarting = false;
+
+    // the server restored the game from its snapshot, so we rejoin it with the same player id
+    if (game_controller::_confirmed_game_state != nullptr) {
+        join_game_request request = join_game_request(game_controller::_confirmed_game_state->get_id(),
+                                                      game_controller::_me->get_id(),
+                                                      game_controller::_me->get_player_name());
+        client_network_manager::send_request(request);
+    } else {
+        join_game_request request = join_game_request(game_controller::_me->get_id(), game_controller::_me->get_player_name());
+        client_network_manager::send_request(request);
+    }
+}
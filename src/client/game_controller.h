@@ -1,6 +1,7 @@
 #ifndef GOMOKUUI_GAMECONTROLLER_H
 #define GOMOKUUI_GAMECONTROLLER_H
 
+#include <chrono>
 #include <wx/sound.h>
 #include "windows/game_window.h"
 #include "panels/connection_panel.h"
@@ -15,15 +16,24 @@ public:
     static void init(game_window* game_window);
 
     static void connect_to_server();
-    static void update_game_state(game_state* new_game_state);
+    // Shows a game state received from the server. 'answered_req_id' is the req_id of the request that the state
+    // answers, if any. Own moves that the server has not answered yet are applied on top of the new state.
+    static void update_game_state(const rapidjson::Value& state_json, const std::string& answered_req_id = "");
+    // Takes back the own move sent with 'req_id', if it is still waiting for an answer. Called when the server
+    // rejected the request or did not answer in time.
+    static void reject_move(const std::string& req_id);
     static void start_game();
     static void place_stone(unsigned int x, unsigned int y, field_type colour, std::string &err);
-    static void set_game_rules(std::string ruleset_string,  std::string &err);
+    static void set_game_rules(std::string ruleset_string, unsigned int board_size, std::string &err);
     static void send_swap_decision(swap_decision_type decision);
     static void send_restart_decision(bool change_ruleset);
     static void close_game();
     static void forfeit();
 
+    // The server is about to restart. Keeps the game open and rejoins it once the server is back after 'reconnect_delay'.
+    static void on_server_shutdown(const std::string& message, std::chrono::milliseconds reconnect_delay);
+    static void on_connection_lost(const std::string& message);
+
     static wxEvtHandler* get_main_thread_event_handler();
     static void show_error(const std::string& title, const std::string& message);
     static void show_status(const std::string& message);
@@ -33,8 +43,42 @@ private:
     static connection_panel* _connection_panel;
     static main_game_panel* _main_game_panel;
 
+    // a stone that is already shown, but not yet confirmed by the server
+    struct pending_move {
+        std::string req_id;
+        unsigned int x;
+        unsigned int y;
+        field_type colour;
+    };
+
+    // applies 'move' to 'state' in the same way as the server does
+    static bool apply_move(game_state* state, const pending_move& move, std::string& err);
+    // shows the confirmed state with all pending moves applied. Moves that cannot be applied anymore are dropped.
+    static void show_predicted_game_state();
+    // makes 'target' a copy of 'source', reusing 'target' if it already exists
+    static void copy_game_state(const game_state* source, game_state*& target);
+    // calls reconnect_to_server() on the main thread after 'delay'
+    static void schedule_reconnect(std::chrono::milliseconds delay);
+    // connects again and rejoins the current game, retries a few times while the server is still starting
+    static void reconnect_to_server();
+
+    static constexpr unsigned int max_reconnect_attempts = 30;
+    static constexpr std::chrono::milliseconds reconnect_retry_delay = std::chrono::milliseconds(1000);
+
     static player* _me;
+    // The following game states are created once and then updated in place.
+    // the state that is shown, which is either the confirmed or the predicted state
     static game_state* _current_game_state;
+    // the last state received from the server
+    static game_state* _confirmed_game_state;
+    // a copy of the confirmed state with the pending moves applied, only shown if there are pending moves
+    static game_state* _predicted_game_state;
+    // for checking own moves before they are sent
+    static game_state* _test_game_state;
+    static std::vector<pending_move> _pending_moves;
+
+    static bool _is_server_restarting;
+    static unsigned int _nof_reconnect_attempts;
 };
 
 
@@ -3,16 +3,34 @@
 
 #include "../game_controller.h"
 #include "../../common/network/responses/server_response.h"
+#include "../../common/network/responses/request_response.h"
+#include "../../common/logging/logger.h"
 #include <sockpp/exception.h>
 
 
 // initialize static members
 sockpp::tcp_connector* client_network_manager::_connection = nullptr;
+request_writer_thread* client_network_manager::_writer_thread = nullptr;
+response_listener_thread* client_network_manager::_listener_thread = nullptr;
+std::string client_network_manager::_host;
+uint16_t client_network_manager::_port = 0;
 
 bool client_network_manager::_connection_success = false;
 bool client_network_manager::_failed_to_connect = false;
 
 void::client_network_manager::init(const std::string& host, const uint16_t port) {
+    client_network_manager::_host = host;
+    client_network_manager::_port = port;
+    client_network_manager::open_connection(true);
+}
+
+
+bool client_network_manager::reconnect() {
+    return client_network_manager::open_connection(false);
+}
+
+
+bool client_network_manager::open_connection(bool show_errors) {
 
     // initialize sockpp framework
     sockpp::socket_initializer sockInit;
@@ -21,45 +39,85 @@ void::client_network_manager::init(const std::string& host, const uint16_t port)
     client_network_manager::_connection_success = false;
     client_network_manager::_failed_to_connect = false;
 
-    // delete exiting connection and create new one
+    // Stop the writer and the listener of the previous connection. Shutting the socket down makes a write or read
+    // that is still running return, and both threads must have exited before their connection is deleted.
+    if (client_network_manager::_writer_thread != nullptr) {
+        client_network_manager::_writer_thread->stop();
+    }
+    if (client_network_manager::_listener_thread != nullptr) {
+        client_network_manager::_listener_thread->stop();
+    }
     if (client_network_manager::_connection != nullptr) {
         client_network_manager::_connection->shutdown();
+    }
+    if (client_network_manager::_writer_thread != nullptr) {
+        client_network_manager::_writer_thread->Wait();
+        delete client_network_manager::_writer_thread;
+        client_network_manager::_writer_thread = nullptr;
+    }
+    if (client_network_manager::_listener_thread != nullptr) {
+        client_network_manager::_listener_thread->Wait();
+        delete client_network_manager::_listener_thread;
+        client_network_manager::_listener_thread = nullptr;
+    }
+
+    // delete exiting connection and create new one
+    if (client_network_manager::_connection != nullptr) {
         delete client_network_manager::_connection;
     }
     client_network_manager::_connection = new sockpp::tcp_connector();
 
     // try to connect to server
-    if (client_network_manager::connect(host, port)) {
+    const std::string& host = client_network_manager::_host;
+    const uint16_t port = client_network_manager::_port;
+    if (client_network_manager::connect(host, port, show_errors)) {
         game_controller::show_status("Connected to " + host + ":" + std::to_string(port));
         client_network_manager::_connection_success = true;
 
         // start network thread
-        response_listener_thread* responseListenerThread = new response_listener_thread(client_network_manager::_connection);
-        if (responseListenerThread->Run() != wxTHREAD_NO_ERROR) {
+        client_network_manager::_listener_thread = new response_listener_thread(client_network_manager::_connection);
+        if (client_network_manager::_listener_thread->Run() != wxTHREAD_NO_ERROR) {
+            // a thread that never ran cannot be waited for
+            delete client_network_manager::_listener_thread;
+            client_network_manager::_listener_thread = nullptr;
             game_controller::show_error("Connection error", "Could not create client network thread");
         }
 
+        client_network_manager::_writer_thread = new request_writer_thread(client_network_manager::_connection);
+        if (client_network_manager::_writer_thread->Run() != wxTHREAD_NO_ERROR) {
+            // a thread that never ran cannot be waited for
+            delete client_network_manager::_writer_thread;
+            client_network_manager::_writer_thread = nullptr;
+            game_controller::show_error("Connection error", "Could not create client writer thread");
+        }
+        return true;
+
     } else {
         client_network_manager::_failed_to_connect = true;
         game_controller::show_status("Not connected");
+        return false;
     }
 }
 
 
-bool client_network_manager::connect(const std::string& host, const uint16_t port) {
+bool client_network_manager::connect(const std::string& host, const uint16_t port, bool show_errors) {
 
     // create sockpp address and catch any errors
     sockpp::inet_address address;
     try {
         address = sockpp::inet_address(host, port);
     } catch (const sockpp::getaddrinfo_error& e) {
-        game_controller::show_error("Connection error", "Failed to resolve address " + e.hostname());
+        if (show_errors) {
+            game_controller::show_error("Connection error", "Failed to resolve address " + e.hostname());
+        }
         return false;
     }
 
     // establish connection to given address
     if (!client_network_manager::_connection->connect(address)) {
-        game_controller::show_error("Connection error", "Failed to connect to server " + address.to_string());
+        if (show_errors) {
+            game_controller::show_error("Connection error", "Failed to connect to server " + address.to_string());
+        }
         return false;
     }
 
@@ -67,22 +125,14 @@ bool client_network_manager::connect(const std::string& host, const uint16_t por
 }
 
 
-void client_network_manager::send_request(const client_request &request) {
-    // wait until network is connected (max. 5 seconds)
-    int connectionCheckCounter = 0;
-    while (!client_network_manager::_connection_success
-          && !client_network_manager::_failed_to_connect
-          && connectionCheckCounter < 200) {
-        wxMilliSleep(25);
-        connectionCheckCounter++;
-    }
-
+void client_network_manager::send_request(const client_request &request, std::chrono::milliseconds timeout) {
     // do not continue if failed to connect to server
     if (client_network_manager::_failed_to_connect) {
         return;
     }
 
-    if (client_network_manager::_connection_success && client_network_manager::_connection->is_connected()) {
+    if (client_network_manager::_connection_success && client_network_manager::_writer_thread != nullptr
+        && client_network_manager::_connection->is_connected()) {
         // serialize request into JSON string
         rapidjson::Document* jsonDocument = request.to_json();
         std::string message = json_utils::to_string(jsonDocument);
@@ -91,21 +141,10 @@ void client_network_manager::send_request(const client_request &request) {
         // turn message into stream and prepend message length
         std::stringstream messageStream;
         messageStream << std::to_string(message.size()) << ':' << message;
-        message = messageStream.str();
-
-        // output message for debugging purposes
-#ifdef PRINT_NETWORK_MESSAGES
-        std::cout << "\nSending request : " << message << std::endl;
-#endif
-
-        // send message to server
-        ssize_t bytesSent = client_network_manager::_connection->write(message);
 
-        // if the number of bytes sent does not match the length of the message, probably something went wrong
-        if (bytesSent != ssize_t(message.length())) {
-            game_controller::show_error("Network error", "Error writing to the TCP stream: " +
-                                                         client_network_manager::_connection->last_error_str());
-        }
+        // the writer thread sends the message and watches the deadline
+        client_network_manager::_writer_thread->enqueue(request.get_req_id(), messageStream.str(),
+                                                        std::chrono::steady_clock::now() + timeout);
 
     } else {
         game_controller::show_error("Network error", "Lost connection to server");
@@ -116,16 +155,24 @@ void client_network_manager::send_request(const client_request &request) {
 void client_network_manager::parse_response(const std::string& message) {
 
     // output message for debugging purposes
-#ifdef PRINT_NETWORK_MESSAGES
-    std::cout << "\nReceived response : " << message << std::endl;
-#endif
+    GOMOKU_LOG(log_level::trace_level, "response_received", {"message", message});
 
     rapidjson::Document json = rapidjson::Document(rapidjson::kObjectType);
     json.Parse(message.c_str());
 
     try {
         server_response* res = server_response::from_json(json);
+
+        // match responses to the requests in flight. A late response is still processed, because it carries
+        // the newest state of the game, but its request has already been reported as timed out.
+        if (res->get_type() == ResponseType::req_response && client_network_manager::_writer_thread != nullptr) {
+            const std::string req_id = static_cast<request_response*>(res)->get_req_id();
+            if (!client_network_manager::_writer_thread->complete(req_id)) {
+                GOMOKU_LOG(log_level::debug_level, "unexpected_response", {"req_id", req_id});
+            }
+        }
         res->Process();
+        delete res;
 
     } catch (std::exception e) {
         game_controller::show_error("JSON parsing error",
@@ -2,25 +2,40 @@
 #define GOMOKU_CLIENT_NETWORK_MANAGER_H
 
 
+#include <chrono>
 #include <string>
 #include "response_listener_thread.h"
+#include "request_writer_thread.h"
 #include "../../common/network/requests/client_request.h"
 
 
 class client_network_manager {
 
 public:
+    static constexpr std::chrono::milliseconds DEFAULT_REQUEST_TIMEOUT = std::chrono::milliseconds(5000);
+
     static void init(const std::string& host, const uint16_t port);
+    // connects again to the server of the last init(), e.g. after the server was restarted. Does not show errors.
+    static bool reconnect();
 
-    static void send_request(const client_request& request);
+    // Queues the request for the writer thread and returns immediately, so several requests can be in flight at once.
+    // Shows an error if the server does not respond to the request within 'timeout'.
+    static void send_request(const client_request& request,
+                             std::chrono::milliseconds timeout = DEFAULT_REQUEST_TIMEOUT);
 
     static void parse_response(const std::string& message);
 
 private:
-    static bool connect(const std::string& host, const uint16_t port);
+    static bool open_connection(bool show_errors);
+    static bool connect(const std::string& host, const uint16_t port, bool show_errors);
 
 
     static sockpp::tcp_connector* _connection;
+    static request_writer_thread* _writer_thread;
+    static response_listener_thread* _listener_thread;
+
+    static std::string _host;
+    static uint16_t _port;
 
     static bool _connection_success;
     static bool _failed_to_connect;
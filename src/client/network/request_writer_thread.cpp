@@ -0,0 +1,111 @@
+#include "request_writer_thread.h"
+
+#include <algorithm>
+#include <vector>
+#include "../game_controller.h"
+#include "../../common/logging/logger.h"
+
+
+request_writer_thread::request_writer_thread(sockpp::tcp_connector* connection) :
+        wxThread(wxTHREAD_JOINABLE)
+{
+    this->_connection = connection;
+    this->_stopped = false;
+}
+
+
+void request_writer_thread::enqueue(const std::string& req_id, std::string message,
+                                    std::chrono::steady_clock::time_point deadline) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _outgoing_messages.push_back(std::move(message));
+        _in_flight[req_id] = deadline;
+    }
+    _wake_up.notify_one();
+}
+
+
+bool request_writer_thread::complete(const std::string& req_id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _in_flight.erase(req_id) > 0;
+}
+
+
+void request_writer_thread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopped = true;
+    }
+    _wake_up.notify_one();
+}
+
+
+wxThread::ExitCode request_writer_thread::Entry() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        // write all queued messages without holding the lock, so that new requests can be queued meanwhile
+        while (!_outgoing_messages.empty() && !_stopped) {
+            std::string message = std::move(_outgoing_messages.front());
+            _outgoing_messages.pop_front();
+            lock.unlock();
+
+            GOMOKU_LOG(log_level::trace_level, "request_sent", {"message", message});
+            ssize_t bytes_sent = _connection->write(message);
+            // if the number of bytes sent does not match the length of the message, probably something went wrong
+            if (bytes_sent != ssize_t(message.length())) {
+                this->output_error("Network error", "Error writing to the TCP stream: " + _connection->last_error_str());
+            }
+            lock.lock();
+        }
+
+        if (_stopped) {
+            break;
+        }
+
+        expire_requests(std::chrono::steady_clock::now());
+
+        // sleep until a new message is queued, or until the next request times out
+        if (_in_flight.empty()) {
+            _wake_up.wait(lock);
+        } else {
+            std::chrono::steady_clock::time_point next_deadline = std::chrono::steady_clock::time_point::max();
+            for (const auto& request : _in_flight) {
+                next_deadline = std::min(next_deadline, request.second);
+            }
+            _wake_up.wait_until(lock, next_deadline);
+        }
+    }
+    return (wxThread::ExitCode) 0; // everything okay
+}
+
+
+// must be called with _mutex locked
+void request_writer_thread::expire_requests(std::chrono::steady_clock::time_point now) {
+    std::vector<std::string> expired;
+    for (const auto& request : _in_flight) {
+        if (request.second <= now) {
+            expired.push_back(request.first);
+        }
+    }
+    for (const std::string& req_id : expired) {
+        _in_flight.erase(req_id);
+    }
+    if (!expired.empty()) {
+        std::string message = "The server did not respond in time to " + std::to_string(expired.size())
+                              + (expired.size() == 1 ? " request." : " requests.");
+        game_controller::get_main_thread_event_handler()->CallAfter([expired, message]{
+            // moves that were shown before the server answered are taken back
+            for (const std::string& req_id : expired) {
+                game_controller::reject_move(req_id);
+            }
+            game_controller::show_error("Network error", message);
+        });
+    }
+}
+
+
+void request_writer_thread::output_error(std::string title, std::string message) {
+    game_controller::get_main_thread_event_handler()->CallAfter([title, message]{
+        game_controller::show_error(title, message);
+    });
+}
@@ -0,0 +1,50 @@
+// The request_writer_thread sends queued requests to the server, so that the UI thread never blocks on the socket.
+// It also keeps track of the requests that are in flight, identified by their req_id, and reports requests whose
+// response did not arrive before their deadline.
+
+#ifndef GOMOKU_REQUEST_WRITER_THREAD_H
+#define GOMOKU_REQUEST_WRITER_THREAD_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <wx/wx.h>
+#include "sockpp/tcp_connector.h"
+
+
+class request_writer_thread : public wxThread {
+
+public:
+    explicit request_writer_thread(sockpp::tcp_connector* connection);
+
+    // Queues a serialized request. The request is in flight until complete() is called with its req_id,
+    // or until 'deadline' has passed. Can be called from any thread.
+    void enqueue(const std::string& req_id, std::string message, std::chrono::steady_clock::time_point deadline);
+
+    // Marks the request as answered. Returns false if the req_id is not in flight, e.g. because it timed out.
+    bool complete(const std::string& req_id);
+
+    // Lets the thread exit. Messages that have not been written yet are dropped, as the connection is closed.
+    // The thread is joinable: Wait() for it before the connection is deleted, as it may still be writing to it.
+    void stop();
+
+protected:
+    virtual ExitCode Entry();
+
+private:
+    void expire_requests(std::chrono::steady_clock::time_point now);
+    void output_error(std::string title, std::string message);
+
+    sockpp::tcp_connector* _connection;
+
+    std::mutex _mutex;
+    std::condition_variable _wake_up;
+    std::deque<std::string> _outgoing_messages;
+    std::unordered_map<std::string, std::chrono::steady_clock::time_point> _in_flight;
+    bool _stopped;
+};
+
+#endif //GOMOKU_REQUEST_WRITER_THREAD_H
@@ -1,27 +1,32 @@
-#ifndef GOMOKU_CLIENT_NETWORK_THREAD_H
-#define GOMOKU_CLIENT_NETWORK_THREAD_H
-
-#include <functional>
-#include <wx/wx.h>
-#include "sockpp/tcp_socket.h"
-#include "sockpp/tcp_connector.h"
-
-
-class response_listener_thread : public wxThread {
-
-public:
-    response_listener_thread(sockpp::tcp_connector* connection);
-    ~response_listener_thread();
-
-protected:
-    virtual ExitCode Entry();
-
-private:
-    void output_error(std::string title, std::string message);
-
-
-    sockpp::tcp_connector* _connection;
-
-};
-
-#endif //GOMOKU_CLIENT_NETWORK_THREAD_H
+#ifndef GOMOKU_CLIENT_NETWORK_THREAD_H
+#define GOMOKU_CLIENT_NETWORK_THREAD_H
+
+#include <atomic>
+#include <functional>
+#include <wx/wx.h>
+#include "sockpp/tcp_socket.h"
+#include "sockpp/tcp_connector.h"
+
+
+class response_listener_thread : public wxThread {
+
+public:
+    response_listener_thread(sockpp::tcp_connector* connection);
+
+    // Marks the connection as closed on purpose, so that its end is not reported as a lost connection. The caller
+    // shuts the socket down to end the read. The thread is joinable: Wait() for it before the connection is deleted.
+    void stop();
+
+protected:
+    virtual ExitCode Entry();
+
+private:
+    void output_error(std::string title, std::string message);
+
+
+    sockpp::tcp_connector* _connection;
+    std::atomic<bool> _stopped;
+
+};
+
+#endif //GOMOKU_CLIENT_NETWORK_THREAD_H
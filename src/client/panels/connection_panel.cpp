@@ -4,6 +4,7 @@
 #include "../uiElements/image_panel.h"
 #include "../../common/network/default.conf"
 #include "../game_controller.h"
+#include "../audio/audio_manager.h"
 
 
 connection_panel::connection_panel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPosition) {
@@ -44,8 +45,7 @@ connection_panel::connection_panel(wxWindow* parent) : wxPanel(parent, wxID_ANY,
                                                         button_size);
     connect_button->SetCursor(wxCursor(wxCURSOR_HAND));
     connect_button->Bind(wxEVT_LEFT_UP, [](wxMouseEvent &event) {
-        wxSound button_click_sound("assets/music/click-button.wav");
-        button_click_sound.Play(wxSOUND_ASYNC);
+        audio_manager::play_sound(click_button_sound);
         game_controller::connect_to_server();
     });
 
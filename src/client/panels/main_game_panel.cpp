@@ -1,6 +1,7 @@
 #include "main_game_panel.h"
 #include "../uiElements/image_panel.h"
 #include "../game_controller.h"
+#include "../audio/audio_manager.h"
 #include "../../common/exceptions/gomoku_exception.h"
 
 // for game mode choice
@@ -8,6 +9,7 @@ const std::unordered_map<std::string, std::string> main_game_panel::_pretty_stri
         {"Freestyle", "freestyle"},
         {"Swap2", "swap2"},
         {"Swap after first move","swap_after_first_move"},
+        {"Renju", "renju"},
 };
 
 // for game mode choice
@@ -15,6 +17,14 @@ const std::unordered_map<std::string, std::string> main_game_panel::_ruleset_str
         {"freestyle", "Freestyle"},
         {"swap2", "Swap2"},
         {"swap_after_first_move", "Swap after first move"},
+        {"renju", "Renju"},
+};
+
+// for board size choice
+const std::unordered_map<std::string, unsigned int> main_game_panel::_pretty_string_to_board_size = {
+        {"15 x 15", 15},
+        {"19 x 19", 19},
+        {"31 x 31", 31},
 };
 
 // for rule explanation rendering
@@ -24,20 +34,20 @@ const std::unordered_map<ruleset_type, std::string> main_game_panel::_ruleset_ty
         {swap2, "assets/information/rules_swap2.png"},
 };
 
-// for sound playing
-const std::unordered_map<sound_type, std::string> main_game_panel::_sound_type_to_path = {
-        {click_button_sound, "assets/music/click-button.wav"},
-        {place_stone_sound, "assets/music/place-stone-sound.wav"},
-        {rematch_sound, "assets/music/rematch.wav"},
-        {forfeit_sound, "assets/music/forfeit.wav"},
-};
-
 main_game_panel::main_game_panel(wxWindow* parent) : wxPanel(parent, wxID_ANY, wxDefaultPosition, wxSize(960, 760)) {}
 
 void main_game_panel::build_game_state(game_state* game_state, player* me) {
 
-    // remove any existing UI
-    this->DestroyChildren();
+    // remove any existing UI, except for the board canvas, which only repaints the fields that changed
+    std::vector<wxWindow*> children;
+    for (wxWindow* child : this->GetChildren()) {
+        children.push_back(child);
+    }
+    for (wxWindow* child : children) {
+        if (child != this->board_canvas_panel) {
+            child->Destroy();
+        }
+    }
 
     std::vector<player*> players = game_state->get_players();
 
@@ -54,29 +64,14 @@ void main_game_panel::build_game_state(game_state* game_state, player* me) {
         return;
     }
 
-    // setup media control for background music
-    this->background_music_player = new wxMediaCtrl();
-    wxString filePath = "assets/music/chinese-journey.wav";
-    this->background_music_player->Create(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize,
-                                          (long) wxMEDIABACKEND_WMP10);
-    this->background_music_player->Load(filePath);
-    this->background_music_player->SetVolume(1.0);
-    this->background_music_player->Connect(wxEVT_MEDIA_FINISHED,
-                       wxMediaEventHandler(main_game_panel::on_music_stop), NULL, this);
-    // start background music once
-    if(!this->music_is_started){
-        this->background_music_player->Play();
-        this->music_is_started = true;
-    } else {
-        // continue music from saved position
-        this->background_music_player->Seek(current_music_time);
-        if(!this->is_muted){
-            this->background_music_player->Play();
-        }
-    }
+    // start background music once, it keeps playing across rebuilds
+    audio_manager::start_music();
 
     // show game mode choice and start screen if the game is not yet started
     if(!game_state->is_started() && !game_state->is_finished()){
+        if (this->board_canvas_panel != nullptr) {
+            this->board_canvas_panel->Hide();
+        }
         this->build_before_start(game_state, me);
     } else {
 
@@ -104,9 +99,9 @@ void main_game_panel::build_game_state(game_state* game_state, player* me) {
     // build icon buttons for about, settings and help
     this->build_icons(icon_type::About, "assets/buttons/button_about.png", wxPoint(30, 30));
     // volume button indicates the current state (off if muted, on if unmuted)
-    if(!this->is_muted){
+    if(!audio_manager::is_muted()){
         this->build_icons(icon_type::Settings, "assets/buttons/button_volume_on.png", wxPoint(30, 100));
-    } else if(this->is_muted){
+    } else if(audio_manager::is_muted()){
         this->build_icons(icon_type::Settings, "assets/buttons/button_volume_off.png", wxPoint(30, 100));
     }
     this->build_icons(icon_type::Help, "assets/buttons/button_help.png", wxPoint(30, 170));
@@ -152,11 +147,22 @@ void main_game_panel::build_before_start(game_state* game_state, player* me){
         game_rule_choices.Add("Freestyle");
         game_rule_choices.Add("Swap after first move");
         game_rule_choices.Add("Swap2");
+        game_rule_choices.Add("Renju");
 
         wxComboBox* game_rule_dropdown = new wxComboBox(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, game_rule_choices, wxCB_DROPDOWN | wxCB_READONLY);
         inner_layout->Add(game_rule_dropdown, 0, wxALIGN_CENTER, 10);
         game_rule_dropdown->SetSelection(0);
 
+        // add a dropdown for the board size
+        wxArrayString board_size_choices;
+        board_size_choices.Add("15 x 15");
+        board_size_choices.Add("19 x 19");
+        board_size_choices.Add("31 x 31");
+
+        wxComboBox* board_size_dropdown = new wxComboBox(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, board_size_choices, wxCB_DROPDOWN | wxCB_READONLY);
+        inner_layout->Add(board_size_dropdown, 0, wxALIGN_CENTER, 10);
+        board_size_dropdown->SetSelection(0);
+
         // add a spacer for the gap
         inner_layout->AddSpacer(5);
 
@@ -167,9 +173,11 @@ void main_game_panel::build_before_start(game_state* game_state, player* me){
                                                          main_game_panel::button_size);
 
         choose_rules_button->SetCursor(wxCursor(wxCURSOR_HAND));
-        choose_rules_button->Bind(wxEVT_LEFT_UP, [game_rule_dropdown, this, &err](wxMouseEvent &event) {
-            this->play_sound(click_button_sound);
-            game_controller::set_game_rules(_pretty_string_to_ruleset_string.at(std::string(game_rule_dropdown->GetValue())), err);
+        choose_rules_button->Bind(wxEVT_LEFT_UP, [game_rule_dropdown, board_size_dropdown, this, &err](wxMouseEvent &event) {
+            audio_manager::play_sound(click_button_sound);
+            game_controller::set_game_rules(_pretty_string_to_ruleset_string.at(std::string(game_rule_dropdown->GetValue())),
+                                            _pretty_string_to_board_size.at(std::string(board_size_dropdown->GetValue())),
+                                            err);
         });
         inner_layout->Add(choose_rules_button, 0, wxALIGN_CENTER, 10);
     }
@@ -178,6 +186,7 @@ void main_game_panel::build_before_start(game_state* game_state, player* me){
     if (game_state->get_opening_rules() != ruleset_type::uninitialized) {
         inner_layout->AddSpacer(40);
         std::string ruleset_string = _ruleset_string_to_pretty_string.at(game_state::_ruleset_type_to_string.at(game_state->get_opening_rules()));
+        ruleset_string += " (" + std::to_string(game_state->get_board_size()) + " x " + std::to_string(game_state->get_board_size()) + ")";
         wxStaticText* game_rule_chosen_text = build_static_text(
                 std::string("Chosen game style: "),
                 wxDefaultPosition,
@@ -228,7 +237,7 @@ void main_game_panel::build_before_start(game_state* game_state, player* me){
 
     start_game_button->SetCursor(wxCursor(wxCURSOR_HAND));
     start_game_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         game_controller::start_game();
     });
     inner_layout->Add(start_game_button, 0, wxALIGN_CENTER, 8);
@@ -237,85 +246,23 @@ void main_game_panel::build_before_start(game_state* game_state, player* me){
 
 void main_game_panel::build_playing_board(game_state* game_state, player *me) {
 
-        // show background
-        wxSize panel_size = this->GetSize();
-        image_panel *background_panel = new image_panel(this, "assets/background_game.png", wxBITMAP_TYPE_ANY, wxDefaultPosition, panel_size);
-        background_panel->Lower(); // This ensures the background is behind all other elements
-
-        // show board image
-        wxPoint playing_board_position = main_game_panel::table_center - main_game_panel::board_size / 2;
-        image_panel *playing_board_panel = new image_panel(this, "assets/playing_board.png", wxBITMAP_TYPE_ANY, playing_board_position, main_game_panel::board_size);
-
-        // show stones on the playing board
-        std::vector<std::vector<field_type>> playing_board = game_state->get_playing_board();
-        unsigned int board_spot_num = playing_board.size();
-
-        for (unsigned int i = 0; i < board_spot_num; i++) {
-            for (unsigned int j = 0; j < board_spot_num; j++) {
-                // if a stone is placed at that spot, render it
-                if (playing_board.at(i).at(j) != field_type::empty) {
-                    int current_stone = playing_board.at(i).at(j);
-                    std::string current_stone_image;
-                    if (current_stone == field_type::white_stone) {
-                        current_stone_image = "assets/stone_white.png";
-                    } else if (current_stone == field_type::black_stone) {
-                        current_stone_image = "assets/stone_black.png";
-                    } else {
-                        throw gomoku_exception("Invalid stone colour for current_stone in rendering.");
-                    }
-                    wxPoint current_stone_position = table_center - board_size / 2 + grid_corner_offset +
-                                                     i * wxPoint(0, grid_spacing / scale_factor) +
-                                                     j * wxPoint(grid_spacing / scale_factor, 0) - stone_size / 2;
-                    image_panel *current_stone_panel = new image_panel(this, current_stone_image, wxBITMAP_TYPE_ANY,
-                                                                       current_stone_position,
-                                                                       main_game_panel::stone_size);
-
-                    // add drop shadow to stone
-                    std::string stone_shadow_image = "assets/stone_shadow.png";
-                    wxPoint current_stone_shadow_position = current_stone_position + stone_size / 17;
-                    image_panel *current_stone_shadow_panel = new image_panel(this, stone_shadow_image,
-                                                                              wxBITMAP_TYPE_ANY,
-                                                                              current_stone_shadow_position,
-                                                                              main_game_panel::stone_size);
-
-                } else {
-                    // if no stone is present, show a transparent button on each spot, if it is currently our turn
-                    if (game_state->get_current_player() == me && !game_state->get_swap_next_turn() &&
-                        !game_state->is_finished()) {
-                        player_colour_type current_player_colour = game_state->get_current_player()->get_colour();
-                        std::string transparent_stone_image = "assets/stone_transparent.png";
-                        wxPoint current_stone_position = table_center - board_size / 2 + grid_corner_offset +
-                                                         i * wxPoint(0, grid_spacing / scale_factor) +
-                                                         j * wxPoint(grid_spacing / scale_factor, 0) - stone_size / 2;
-                        image_panel *new_stone_button = new image_panel(this, transparent_stone_image,
-                                                                        wxBITMAP_TYPE_ANY,
-                                                                        current_stone_position,
-                                                                        main_game_panel::stone_size);
-
-                        new_stone_button->SetCursor(wxCursor(wxCURSOR_HAND));
-                        std::string err;
-
-                        field_type new_stone_colour = field_type::empty;
-
-                        if (current_player_colour == player_colour_type::black) {
-                            new_stone_colour = field_type::black_stone;
-                        } else if (current_player_colour == player_colour_type::white) {
-                            new_stone_colour = field_type::white_stone;
-                        } else {
-                            throw gomoku_exception("Invalid current player colour in new stone button rendering.");
-                        }
-                        unsigned int x = j;
-                        unsigned int y = i;
-
-                        new_stone_button->Bind(wxEVT_LEFT_UP, [x, y, new_stone_colour, this, &err](wxMouseEvent &event) {
-                            this->play_sound(place_stone_sound);
-
-                            game_controller::place_stone(x, y, new_stone_colour, err);
-                        });
-                    }
-                }
-            }
-        }
+    // the board canvas is created once and draws the background, the board and the stones
+    if (this->board_canvas_panel == nullptr) {
+        wxRect board_rect = wxRect(main_game_panel::table_center - main_game_panel::board_size / 2, main_game_panel::board_size);
+        wxPoint grid_origin = board_rect.GetTopLeft() + main_game_panel::grid_corner_offset;
+        int grid_length = (grid_spacing / scale_factor) * (playing_board::_playing_board_size - 1);
+        this->board_canvas_panel = new board_canvas(this, board_rect, grid_origin, grid_length, main_game_panel::stone_size);
+        this->board_canvas_panel->set_place_stone_handler([this](unsigned int x, unsigned int y, field_type colour) {
+            audio_manager::play_sound(place_stone_sound);
+
+            std::string err;
+            game_controller::place_stone(x, y, colour, err);
+        });
+    }
+
+    this->board_canvas_panel->Show();
+    this->board_canvas_panel->Lower(); // This ensures the background is behind all other elements
+    this->board_canvas_panel->show_game_state(game_state, me);
 }
 
 void main_game_panel::build_scoreboard(game_state *game_state, player *me) {
@@ -376,7 +323,7 @@ void main_game_panel::build_forfeit_button(game_state* game_state, player* me){
                                                   main_game_panel::button_size);
     forfeit_button->SetCursor(wxCursor(wxCURSOR_HAND));
     forfeit_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(forfeit_sound);
+        audio_manager::play_sound(forfeit_sound);
         game_controller::forfeit();
     });
 }
@@ -418,7 +365,7 @@ void main_game_panel::build_swap_field(game_state* game_state, player *me){
                                                main_game_panel::button_size);
     swap_button->SetCursor(wxCursor(wxCURSOR_HAND));
     swap_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         game_controller::send_swap_decision(swap_decision_type::do_swap);
     });
 
@@ -428,7 +375,7 @@ void main_game_panel::build_swap_field(game_state* game_state, player *me){
                                                   main_game_panel::button_size);
     no_swap_button->SetCursor(wxCursor(wxCURSOR_HAND));
     no_swap_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         game_controller::send_swap_decision(swap_decision_type::do_not_swap);
         });
 
@@ -440,7 +387,7 @@ void main_game_panel::build_swap_field(game_state* game_state, player *me){
                                                       main_game_panel::button_size);
         defer_swap_button->SetCursor(wxCursor(wxCURSOR_HAND));
         defer_swap_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-            this->play_sound(click_button_sound);
+            audio_manager::play_sound(click_button_sound);
             game_controller::send_swap_decision(swap_decision_type::defer_swap);
         });
 
@@ -489,7 +436,7 @@ void main_game_panel::build_game_over_field(game_state* game_state, player* me){
                                                main_game_panel::button_size);
     rematch_button->SetCursor(wxCursor(wxCURSOR_HAND));
     rematch_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(rematch_sound);
+        audio_manager::play_sound(rematch_sound);
         game_controller::send_restart_decision(false);
     });
 
@@ -499,7 +446,7 @@ void main_game_panel::build_game_over_field(game_state* game_state, player* me){
                                                   main_game_panel::button_size);
     change_ruleset_button->SetCursor(wxCursor(wxCURSOR_HAND));
     change_ruleset_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(rematch_sound);
+        audio_manager::play_sound(rematch_sound);
         game_controller::send_restart_decision(true);
     });
 
@@ -509,7 +456,7 @@ void main_game_panel::build_game_over_field(game_state* game_state, player* me){
                                                          main_game_panel::button_size);
     close_game_button->SetCursor(wxCursor(wxCURSOR_HAND));
     close_game_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         game_controller::close_game();
     });
 }
@@ -527,7 +474,7 @@ void main_game_panel::build_icons(/*game_state* gameState, player *me, */icon_ty
                 icon_button->SetToolTip("About");
                 icon_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent &event) {
                     if(!this->about_or_help_already_built) {
-                        this->play_sound(click_button_sound);
+                        audio_manager::play_sound(click_button_sound);
                         this->build_about_image(event);
                     }
                 });
@@ -535,21 +482,19 @@ void main_game_panel::build_icons(/*game_state* gameState, player *me, */icon_ty
 
         case icon_type::Settings:
             // volume button indicates the current state (off if muted, on if unmuted)
-            if(is_muted) {
+            if(audio_manager::is_muted()) {
                 icon_button->SetToolTip("Sounds muted");
                 icon_button->Bind(wxEVT_LEFT_UP, [this, icon_button](wxMouseEvent& event) {
-                    this->is_muted = false;
-                    this->background_music_player->Play();
-                    this->play_sound(click_button_sound);
+                    audio_manager::set_muted(false);
+                    audio_manager::play_sound(click_button_sound);
                     // set icon to opposite thing
                     this->build_icons(icon_type::Settings, "assets/buttons/button_volume_on.png", wxPoint(30, 100));
                     delete icon_button;
                 });
-            } else if (!is_muted) {
+            } else if (!audio_manager::is_muted()) {
                 icon_button->SetToolTip("Sounds unmuted");
                 icon_button->Bind(wxEVT_LEFT_UP, [this, icon_button](wxMouseEvent& event) {
-                    this->is_muted = true;
-                    this->background_music_player->Pause();
+                    audio_manager::set_muted(true);
                     // set icon to opposite thing
                     this->build_icons(icon_type::Settings, "assets/buttons/button_volume_off.png", wxPoint(30, 100));
                     delete icon_button;
@@ -560,7 +505,7 @@ void main_game_panel::build_icons(/*game_state* gameState, player *me, */icon_ty
         case icon_type::Help:
             icon_button->SetToolTip("Help");
             icon_button->Bind(wxEVT_LEFT_UP, [this](wxMouseEvent& event) {
-                this->play_sound(click_button_sound);
+                audio_manager::play_sound(click_button_sound);
                 this->build_help_image(event, freestyle);
             });
             break;
@@ -584,7 +529,7 @@ void main_game_panel::build_about_image(wxMouseEvent& event) {
                                                 wxSize(40, 40));
     close_button->SetCursor(wxCursor(wxCURSOR_HAND));
     close_button->Bind(wxEVT_LEFT_UP, [this, about_image, close_button](wxMouseEvent& event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         this->about_or_help_already_built = false;
         delete about_image;
         delete close_button;
@@ -628,7 +573,7 @@ void main_game_panel::build_help_image(wxMouseEvent& event, ruleset_type rule) {
 
     freestyle_button->SetCursor(wxCursor(wxCURSOR_HAND));
     freestyle_button->Bind(wxEVT_LEFT_UP, [this, about_image, close_button, freestyle_button, swap_first_button, swap2_button](wxMouseEvent& event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         main_game_panel::build_help_image(event, freestyle);
         delete freestyle_button;
         delete swap_first_button;
@@ -638,7 +583,7 @@ void main_game_panel::build_help_image(wxMouseEvent& event, ruleset_type rule) {
     });
     swap_first_button->SetCursor(wxCursor(wxCURSOR_HAND));
     swap_first_button->Bind(wxEVT_LEFT_UP, [this, about_image, close_button, freestyle_button, swap_first_button, swap2_button](wxMouseEvent& event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         main_game_panel::build_help_image(event, swap_after_first_move);
         delete freestyle_button;
         delete swap_first_button;
@@ -648,7 +593,7 @@ void main_game_panel::build_help_image(wxMouseEvent& event, ruleset_type rule) {
     });
     swap2_button->SetCursor(wxCursor(wxCURSOR_HAND));
     swap2_button->Bind(wxEVT_LEFT_UP, [this, about_image, close_button, freestyle_button, swap_first_button, swap2_button](wxMouseEvent& event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         main_game_panel::build_help_image(event, swap2);
         delete freestyle_button;
         delete swap_first_button;
@@ -659,7 +604,7 @@ void main_game_panel::build_help_image(wxMouseEvent& event, ruleset_type rule) {
 
     close_button->SetCursor(wxCursor(wxCURSOR_HAND));
     close_button->Bind(wxEVT_LEFT_UP, [this, about_image, close_button, freestyle_button, swap_first_button, swap2_button](wxMouseEvent& event) {
-        this->play_sound(click_button_sound);
+        audio_manager::play_sound(click_button_sound);
         this->about_or_help_already_built = false;
         delete about_image;
         delete freestyle_button;
@@ -678,19 +623,3 @@ wxStaticText* main_game_panel::build_static_text(std::string content, wxPoint po
     }
     return static_text;
 }
-
-void main_game_panel::play_sound(sound_type sound) {
-    if(!is_muted){
-        wxSound sound_to_play(_sound_type_to_path.at(sound));
-        sound_to_play.Play(wxSOUND_ASYNC);
-    }
-}
-
-void main_game_panel::save_music_state() {
-    this->current_music_time = this->background_music_player->Tell();
-    this->background_music_player->Pause();
-}
-
-void main_game_panel::on_music_stop(wxMediaEvent &) {
-    this->background_music_player->Play();
-}
\ No newline at end of file
@@ -2,10 +2,10 @@
 #define GOMOKU_CLIENT_MAINGAMEPANEL_H
 
 #include <wx/wx.h>
-#include <wx/mediactrl.h> // background music
 #include <wx/notebook.h>
 #include "../../common/game_state/game_state.h"
 #include "../windows/game_window.h"
+#include "../uiElements/board_canvas.h"
 
 
 enum class icon_type {
@@ -14,13 +14,6 @@ enum class icon_type {
     Help
 };
 
-enum sound_type{
-    click_button_sound,
-    place_stone_sound,
-    rematch_sound,
-    forfeit_sound
-};
-
 class main_game_panel : public wxPanel {
 
 public:
@@ -33,11 +26,7 @@ public:
 
     static const std::unordered_map<std::string, std::string> _pretty_string_to_ruleset_string;
     static const std::unordered_map<std::string, std::string> _ruleset_string_to_pretty_string;
-
-    // public sound functions
-    void save_music_state();
-    bool music_is_started = false;
-
+    static const std::unordered_map<std::string, unsigned int> _pretty_string_to_board_size;
 private:
     // UI build functions
     void build_before_start(game_state* game_state, player* me);
@@ -48,14 +37,8 @@ private:
     void build_game_over_field(game_state* game_state, player* me);
     void build_icons(icon_type iconType, std::string path, wxPoint position);
 
-    // sound functions
-    wxMediaCtrl* background_music_player; // wxMediaCtrl for background music
-    void on_music_stop(wxMediaEvent& WXUNUSED(event));
-
-    bool is_muted = false;
-    void play_sound(sound_type sound);
-    static const std::unordered_map<sound_type, std::string> _sound_type_to_path;
-    wxFileOffset current_music_time;
+    // kept across rebuilds, see build_playing_board
+    board_canvas* board_canvas_panel = nullptr;
 
     void build_help_text(wxMouseEvent& event);
     wxStaticText* build_static_text(std::string content, wxPoint position, wxSize size, long textAlignment, bool bold = false);
@@ -0,0 +1,263 @@
+#include "board_canvas.h"
+
+#include <cmath>
+#include <wx/dcbuffer.h>
+#include "image_cache.h"
+#include "../../common/exceptions/gomoku_exception.h"
+
+board_canvas::board_canvas(wxWindow* parent, wxRect board_rect, wxPoint grid_origin, int grid_length, wxSize stone_size) :
+        wxPanel(parent, wxID_ANY, wxDefaultPosition, parent->GetSize())
+{
+    this->_board_rect = board_rect;
+    this->_grid_origin = grid_origin;
+    this->_grid_length = grid_length;
+    this->_standard_stone_size = stone_size;
+
+    this->_sprites_are_scaled = false;
+    this->_board_spot_num = 0;
+    this->_spot_spacing = 0.0;
+    this->_new_stone_colour = field_type::empty;
+    this->_hovered_cell = -1;
+
+    // everything is drawn in paint_event, so the background must not be erased before
+    this->SetBackgroundStyle(wxBG_STYLE_PAINT);
+
+    this->Bind(wxEVT_PAINT, &board_canvas::paint_event, this);
+    this->Bind(wxEVT_SIZE, &board_canvas::on_size, this);
+    this->Bind(wxEVT_LEFT_UP, &board_canvas::on_left_up, this);
+    this->Bind(wxEVT_MOTION, &board_canvas::on_motion, this);
+}
+
+
+void board_canvas::show_game_state(game_state* game_state, player* me) {
+    std::vector<std::vector<field_type>> playing_board = game_state->get_playing_board();
+    unsigned int board_spot_num = playing_board.size();
+
+    std::vector<board_cell_type> cells(board_spot_num * board_spot_num, board_cell_type::empty_cell);
+
+    // mark the fields on which the current player is not allowed to play (renju restrictions for black)
+    if (!game_state->is_finished()) {
+        for (const std::pair<unsigned int, unsigned int>& forbidden_field : game_state->get_forbidden_fields()) {
+            cells.at(forbidden_field.second * board_spot_num + forbidden_field.first) = board_cell_type::forbidden_cell;
+        }
+    }
+
+    // empty fields can be clicked if it is currently our turn
+    bool is_my_turn = game_state->get_current_player() == me && !game_state->get_swap_next_turn() && !game_state->is_finished();
+    if (is_my_turn) {
+        player_colour_type current_player_colour = game_state->get_current_player()->get_colour();
+        if (current_player_colour == player_colour_type::black) {
+            this->_new_stone_colour = field_type::black_stone;
+        } else if (current_player_colour == player_colour_type::white) {
+            this->_new_stone_colour = field_type::white_stone;
+        } else {
+            throw gomoku_exception("Invalid current player colour in new stone button rendering.");
+        }
+    }
+
+    for (unsigned int y = 0; y < board_spot_num; ++y) {
+        for (unsigned int x = 0; x < board_spot_num; ++x) {
+            board_cell_type& cell = cells.at(y * board_spot_num + x);
+            if (playing_board.at(y).at(x) == field_type::black_stone) {
+                cell = board_cell_type::black_stone_cell;
+            } else if (playing_board.at(y).at(x) == field_type::white_stone) {
+                cell = board_cell_type::white_stone_cell;
+            } else if (cell != board_cell_type::forbidden_cell && is_my_turn) {
+                cell = board_cell_type::playable_cell;
+            }
+        }
+    }
+
+    if (board_spot_num != this->_board_spot_num) {
+        // the grid of the standard board spans 14 spots, larger boards squeeze their spots and stones into the same area
+        this->_board_spot_num = board_spot_num;
+        this->_spot_spacing = double(this->_grid_length) / (board_spot_num - 1);
+        this->_stone_size = this->_standard_stone_size * (playing_board::_playing_board_size - 1) / (board_spot_num - 1);
+        this->_cells = std::move(cells);
+        this->_sprites_are_scaled = false;
+        this->Refresh();
+    } else {
+        // only repaint the fields that changed
+        for (unsigned int i = 0; i < cells.size(); ++i) {
+            if (cells[i] != this->_cells[i]) {
+                this->RefreshRect(this->get_cell_rect(i % board_spot_num, i / board_spot_num));
+            }
+        }
+        this->_cells = std::move(cells);
+    }
+
+    this->_hovered_cell = -1;
+    this->update_cursor(this->ScreenToClient(wxGetMousePosition()));
+}
+
+
+void board_canvas::set_place_stone_handler(std::function<void(unsigned int x, unsigned int y, field_type colour)> handler) {
+    this->_place_stone_handler = std::move(handler);
+}
+
+
+void board_canvas::scale_sprites() {
+    this->_scaled_canvas_size = this->GetClientSize();
+    this->_background_bitmap = image_cache::get_bitmap("assets/background_game.png", this->_scaled_canvas_size);
+
+    if (this->_board_spot_num == playing_board::_playing_board_size) {
+        this->_board_bitmap = image_cache::get_bitmap("assets/playing_board.png", this->_board_rect.GetSize());
+    } else {
+        // draw a plain board with grid lines, for board sizes without a board image
+        std::shared_ptr<wxBitmap> grid_bitmap = std::make_shared<wxBitmap>(this->_board_rect.GetWidth(), this->_board_rect.GetHeight());
+        wxMemoryDC device_context(*grid_bitmap);
+        device_context.SetBackground(wxBrush(wxColor(222, 184, 135)));
+        device_context.Clear();
+        device_context.SetPen(wxPen(*wxBLACK, 1));
+        wxPoint grid_origin = this->_grid_origin - this->_board_rect.GetTopLeft();
+        for (unsigned int i = 0; i < this->_board_spot_num; ++i) {
+            int offset = int(i * this->_spot_spacing);
+            device_context.DrawLine(grid_origin.x, grid_origin.y + offset, grid_origin.x + this->_grid_length, grid_origin.y + offset);
+            device_context.DrawLine(grid_origin.x + offset, grid_origin.y, grid_origin.x + offset, grid_origin.y + this->_grid_length);
+        }
+        device_context.SelectObject(wxNullBitmap);
+        this->_board_bitmap = grid_bitmap;
+    }
+
+    this->_black_stone_bitmap = image_cache::get_bitmap("assets/stone_black.png", this->_stone_size);
+    this->_white_stone_bitmap = image_cache::get_bitmap("assets/stone_white.png", this->_stone_size);
+    this->_stone_shadow_bitmap = image_cache::get_bitmap("assets/stone_shadow.png", this->_stone_size);
+    this->_transparent_stone_bitmap = image_cache::get_bitmap("assets/stone_transparent.png", this->_stone_size);
+
+    this->_sprites_are_scaled = true;
+}
+
+
+void board_canvas::paint_event(wxPaintEvent& event) {
+    wxAutoBufferedPaintDC device_context(this);
+
+    if (!this->_sprites_are_scaled || this->GetClientSize() != this->_scaled_canvas_size) {
+        this->scale_sprites();
+    }
+
+    // the device context is clipped to the invalidated area, so only the dirty fields are drawn
+    if (this->_background_bitmap != nullptr) {
+        device_context.DrawBitmap(*this->_background_bitmap, 0, 0, false);
+    }
+    if (this->_board_spot_num == 0) {
+        return;
+    }
+    if (this->_board_bitmap != nullptr) {
+        device_context.DrawBitmap(*this->_board_bitmap, this->_board_rect.GetTopLeft(), true);
+    }
+
+    wxRect update_rect = this->GetUpdateRegion().GetBox();
+    for (unsigned int y = 0; y < this->_board_spot_num; ++y) {
+        for (unsigned int x = 0; x < this->_board_spot_num; ++x) {
+            if (this->get_cell_rect(x, y).Intersects(update_rect)) {
+                this->draw_cell(device_context, x, y);
+            }
+        }
+    }
+}
+
+
+void board_canvas::draw_cell(wxDC& device_context, unsigned int x, unsigned int y) const {
+    wxPoint stone_position = this->get_stone_position(x, y);
+
+    switch (this->_cells.at(y * this->_board_spot_num + x)) {
+        case board_cell_type::black_stone_cell:
+        case board_cell_type::white_stone_cell: {
+            // stones have a drop shadow
+            if (this->_stone_shadow_bitmap != nullptr) {
+                device_context.DrawBitmap(*this->_stone_shadow_bitmap, stone_position + this->_stone_size / 17, true);
+            }
+            const std::shared_ptr<const wxBitmap>& stone_bitmap = this->_cells.at(y * this->_board_spot_num + x) == board_cell_type::black_stone_cell
+                                                                 ? this->_black_stone_bitmap : this->_white_stone_bitmap;
+            if (stone_bitmap != nullptr) {
+                device_context.DrawBitmap(*stone_bitmap, stone_position, true);
+            }
+            break;
+        }
+        case board_cell_type::forbidden_cell: {
+            // forbidden spots are marked with a red cross
+            wxFont font = this->GetFont();
+            font.MakeBold();
+            device_context.SetFont(font);
+            device_context.SetTextForeground(*wxRED);
+            device_context.DrawLabel("x", wxRect(stone_position, this->_stone_size), wxALIGN_CENTER);
+            break;
+        }
+        case board_cell_type::playable_cell:
+            if (this->_transparent_stone_bitmap != nullptr) {
+                device_context.DrawBitmap(*this->_transparent_stone_bitmap, stone_position, true);
+            }
+            break;
+        case board_cell_type::empty_cell:
+            break;
+    }
+}
+
+
+void board_canvas::on_size(wxSizeEvent& event) {
+
+    // when the canvas is resized, the sprites are scaled again and everything is redrawn
+    Refresh();
+
+    // skip any other effects of this event.
+    event.Skip();
+}
+
+
+void board_canvas::on_left_up(wxMouseEvent& event) {
+    int cell = this->hit_test(event.GetPosition());
+    if (cell == -1 || this->_cells.at(cell) != board_cell_type::playable_cell || !this->_place_stone_handler) {
+        return;
+    }
+    this->_place_stone_handler(cell % this->_board_spot_num, cell / this->_board_spot_num, this->_new_stone_colour);
+}
+
+
+void board_canvas::on_motion(wxMouseEvent& event) {
+    this->update_cursor(event.GetPosition());
+    event.Skip();
+}
+
+
+void board_canvas::update_cursor(wxPoint position) {
+    int cell = this->hit_test(position);
+    if (cell == this->_hovered_cell) {
+        return;
+    }
+    this->_hovered_cell = cell;
+
+    board_cell_type cell_type = cell == -1 ? board_cell_type::empty_cell : this->_cells.at(cell);
+    this->SetCursor(wxCursor(cell_type == board_cell_type::playable_cell ? wxCURSOR_HAND : wxCURSOR_ARROW));
+    if (cell_type == board_cell_type::forbidden_cell) {
+        this->SetToolTip("Black is not allowed to play here (renju)");
+    } else {
+        this->UnsetToolTip();
+    }
+}
+
+
+wxPoint board_canvas::get_stone_position(unsigned int x, unsigned int y) const {
+    return this->_grid_origin + wxPoint(int(x * this->_spot_spacing), int(y * this->_spot_spacing)) - this->_stone_size / 2;
+}
+
+
+wxRect board_canvas::get_cell_rect(unsigned int x, unsigned int y) const {
+    return wxRect(this->get_stone_position(x, y), this->_stone_size + this->_stone_size / 17);
+}
+
+
+int board_canvas::hit_test(wxPoint position) const {
+    if (this->_board_spot_num == 0) {
+        return -1;
+    }
+    // the nearest crossing of the grid lines
+    long x = std::lround((position.x - this->_grid_origin.x) / this->_spot_spacing);
+    long y = std::lround((position.y - this->_grid_origin.y) / this->_spot_spacing);
+    if (x < 0 || y < 0 || x >= long(this->_board_spot_num) || y >= long(this->_board_spot_num)) {
+        return -1;
+    }
+    if (!wxRect(this->get_stone_position(x, y), this->_stone_size).Contains(position)) {
+        return -1;
+    }
+    return int(y * this->_board_spot_num + x);
+}
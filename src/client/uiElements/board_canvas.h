@@ -0,0 +1,78 @@
+#ifndef GOMOKU_BOARD_CANVAS_H
+#define GOMOKU_BOARD_CANVAS_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include <wx/wx.h>
+#include "../../common/game_state/game_state.h"
+
+// content of a field, as drawn by the board_canvas
+enum board_cell_type {
+    empty_cell,
+    black_stone_cell,
+    white_stone_cell,
+    forbidden_cell,
+    playable_cell
+};
+
+// This class draws the game background, the playing board and all stones into a single window. The stone sprites are
+// scaled once for each board size and canvas size, and clicks are mapped to fields by their coordinates.
+// When a new game state is shown, only the fields whose content changed are repainted.
+class board_canvas : public wxPanel {
+
+public:
+    // 'board_rect' is the area of the board, 'grid_origin' the top left crossing of the grid lines and 'grid_length'
+    // the length of the grid lines. 'stone_size' is the size of a stone on a standard board.
+    board_canvas(wxWindow* parent, wxRect board_rect, wxPoint grid_origin, int grid_length, wxSize stone_size);
+
+    // shows the fields of 'game_state' from the perspective of 'me', who must be one of its players
+    void show_game_state(game_state* game_state, player* me);
+
+    // 'handler' is called when the player clicks on a field on which they can place a stone
+    void set_place_stone_handler(std::function<void(unsigned int x, unsigned int y, field_type colour)> handler);
+
+private:
+    void paint_event(wxPaintEvent& event);
+    void on_size(wxSizeEvent& event);
+    void on_left_up(wxMouseEvent& event);
+    void on_motion(wxMouseEvent& event);
+
+    void scale_sprites();
+    void draw_cell(wxDC& device_context, unsigned int x, unsigned int y) const;
+    void update_cursor(wxPoint position);
+
+    wxPoint get_stone_position(unsigned int x, unsigned int y) const;
+    // returns the area covered by a stone at (x, y) including its shadow
+    wxRect get_cell_rect(unsigned int x, unsigned int y) const;
+    // returns the index of the field whose stone area contains 'position', or -1 if there is none
+    int hit_test(wxPoint position) const;
+
+    // layout
+    wxRect _board_rect;
+    wxPoint _grid_origin;
+    int _grid_length;
+    wxSize _standard_stone_size;
+
+    // sprites scaled for the current board size and canvas size, shared through the image_cache
+    bool _sprites_are_scaled;
+    wxSize _scaled_canvas_size;
+    std::shared_ptr<const wxBitmap> _background_bitmap;
+    std::shared_ptr<const wxBitmap> _board_bitmap;
+    std::shared_ptr<const wxBitmap> _black_stone_bitmap;
+    std::shared_ptr<const wxBitmap> _white_stone_bitmap;
+    std::shared_ptr<const wxBitmap> _stone_shadow_bitmap;
+    std::shared_ptr<const wxBitmap> _transparent_stone_bitmap;
+
+    // fields of the shown game state in row-major order
+    unsigned int _board_spot_num;
+    double _spot_spacing;
+    wxSize _stone_size;
+    std::vector<board_cell_type> _cells;
+    field_type _new_stone_colour;
+    int _hovered_cell;
+
+    std::function<void(unsigned int x, unsigned int y, field_type colour)> _place_stone_handler;
+};
+
+#endif //GOMOKU_BOARD_CANVAS_H
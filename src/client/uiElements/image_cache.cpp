@@ -0,0 +1,116 @@
+#include "image_cache.h"
+
+#include <algorithm>
+#include <thread>
+
+// initialize static members
+std::mutex image_cache::_mutex;
+std::unordered_map<std::string, std::shared_ptr<const wxImage>> image_cache::_images;
+std::map<image_cache::bitmap_key, image_cache::cached_bitmap> image_cache::_bitmaps;
+std::uint64_t image_cache::_bitmap_clock = 0;
+
+
+void image_cache::preload(const std::vector<wxString>& files) {
+    std::vector<std::string> paths;
+    for (const wxString& file : files) {
+        paths.push_back(file.ToStdString());
+    }
+
+    // decoding does not touch any GUI objects, so it can run next to the main thread. Bitmaps are only created
+    // by get_bitmap() on the main thread.
+    std::thread([paths] {
+        wxLogNull no_log; // missing files are reported when they are requested
+        for (const std::string& path : paths) {
+            {
+                std::lock_guard<std::mutex> lock(image_cache::_mutex);
+                if (image_cache::_images.count(path) != 0) {
+                    continue;
+                }
+            }
+            std::shared_ptr<const wxImage> image = image_cache::decode(path);
+            if (image != nullptr) {
+                std::lock_guard<std::mutex> lock(image_cache::_mutex);
+                image_cache::_images.emplace(path, image);
+            }
+        }
+    }).detach();
+}
+
+
+std::shared_ptr<const wxImage> image_cache::decode(const wxString& file) {
+    if (!wxFileExists(file)) {
+        return nullptr;
+    }
+    std::shared_ptr<wxImage> image = std::make_shared<wxImage>();
+    if (!image->LoadFile(file, wxBITMAP_TYPE_ANY)) {
+        return nullptr;
+    }
+    return image;
+}
+
+
+std::shared_ptr<const wxImage> image_cache::get_image(const wxString& file) {
+    std::string path = file.ToStdString();
+    {
+        std::lock_guard<std::mutex> lock(image_cache::_mutex);
+        auto it = image_cache::_images.find(path);
+        if (it != image_cache::_images.end()) {
+            return it->second;
+        }
+    }
+
+    // not preloaded (yet), decode it now
+    if (!wxFileExists(file)) {
+        wxMessageBox("Could not find file: " + file, "File error", wxICON_ERROR);
+        return nullptr;
+    }
+    std::shared_ptr<const wxImage> image = image_cache::decode(file);
+    if (image == nullptr) {
+        wxMessageBox("Could not load file: " + file, "File error", wxICON_ERROR);
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(image_cache::_mutex);
+    // if the preloading thread was faster, its image is kept
+    return image_cache::_images.emplace(path, image).first->second;
+}
+
+
+std::shared_ptr<const wxBitmap> image_cache::get_bitmap(const wxString& file, wxSize size, double rotation) {
+    bitmap_key key = {file.ToStdString(), size.GetWidth(), size.GetHeight(), rotation};
+    {
+        std::lock_guard<std::mutex> lock(image_cache::_mutex);
+        auto it = image_cache::_bitmaps.find(key);
+        if (it != image_cache::_bitmaps.end()) {
+            it->second.last_used = ++image_cache::_bitmap_clock;
+            return it->second.bitmap;
+        }
+    }
+
+    std::shared_ptr<const wxImage> image = image_cache::get_image(file);
+    if (image == nullptr || size.GetWidth() <= 0 || size.GetHeight() <= 0) {
+        return nullptr;
+    }
+
+    wxImage transformed;
+    if (rotation == 0.0) {
+        transformed = image->Scale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_BILINEAR);
+    } else {
+        wxPoint center_of_rotation = wxPoint(image->GetWidth() / 2, image->GetHeight() / 2);
+        transformed = image->Rotate(rotation, center_of_rotation, true);
+        transformed = transformed.Scale(size.GetWidth(), size.GetHeight(), wxIMAGE_QUALITY_BILINEAR);
+    }
+    std::shared_ptr<const wxBitmap> bitmap = std::make_shared<const wxBitmap>(transformed);
+
+    std::lock_guard<std::mutex> lock(image_cache::_mutex);
+    image_cache::_bitmaps[key] = {bitmap, ++image_cache::_bitmap_clock};
+    if (image_cache::_bitmaps.size() > image_cache::max_bitmaps) {
+        // panels that still show the evicted bitmap keep their handle
+        auto least_recently_used = std::min_element(image_cache::_bitmaps.begin(), image_cache::_bitmaps.end(),
+                                                    [](const auto& a, const auto& b) {
+            return a.second.last_used < b.second.last_used;
+        });
+        image_cache::_bitmaps.erase(least_recently_used);
+    }
+    return bitmap;
+}
@@ -0,0 +1,52 @@
+#ifndef GOMOKU_IMAGE_CACHE_H
+#define GOMOKU_IMAGE_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <wx/wx.h>
+
+// Process-wide cache of decoded images. Each image file is decoded once, when it is first needed or preloaded, and
+// each scaled and rotated variant of it is converted to a bitmap once. The returned handles are shared between all
+// users of the same variant. Only the most recently used variants are kept, as every window size creates new ones.
+class image_cache {
+
+public:
+    // the number of bitmap variants that are kept
+    static constexpr std::size_t max_bitmaps = 64;
+
+    // decodes 'files' on a background thread, e.g. the images of the panel that is shown next
+    static void preload(const std::vector<wxString>& files);
+
+    // returns the decoded image of 'file', or nullptr if it cannot be loaded. Must be called from the main thread,
+    // as errors are shown in a message box.
+    static std::shared_ptr<const wxImage> get_image(const wxString& file);
+
+    // returns the image of 'file' rotated by 'rotation' (in radian) and scaled to 'size', or nullptr if it cannot
+    // be loaded. Must be called from the main thread.
+    static std::shared_ptr<const wxBitmap> get_bitmap(const wxString& file, wxSize size, double rotation = 0.0);
+
+private:
+    // decodes 'file' without showing any errors, returns nullptr if it cannot be loaded
+    static std::shared_ptr<const wxImage> decode(const wxString& file);
+
+    // file, width, height and rotation of a bitmap
+    using bitmap_key = std::tuple<std::string, int, int, double>;
+
+    struct cached_bitmap {
+        std::shared_ptr<const wxBitmap> bitmap;
+        std::uint64_t last_used;
+    };
+
+    static std::mutex _mutex;
+    static std::unordered_map<std::string, std::shared_ptr<const wxImage>> _images;
+    static std::map<bitmap_key, cached_bitmap> _bitmaps;
+    static std::uint64_t _bitmap_clock;     // counts the uses of bitmaps, for the least recently used one
+};
+
+#endif //GOMOKU_IMAGE_CACHE_H
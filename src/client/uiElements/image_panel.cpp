@@ -1,19 +1,16 @@
 #include "image_panel.h"
+#include "image_cache.h"
 
 
 image_panel::image_panel(wxWindow* parent, wxString file, wxBitmapType format, wxPoint position, wxSize size, double rotation) :
         wxPanel(parent, wxID_ANY, position, size)
 {
-    if (!wxFileExists(file)) {
-        wxMessageBox("Could not find file: " + file, "File error", wxICON_ERROR);
-        return;
-    }
-
-    if (!this->_image.LoadFile(file, format)) {
-        wxMessageBox("Could not load file: " + file, "File error", wxICON_ERROR);
+    // errors are shown by the image cache
+    if (image_cache::get_image(file) == nullptr) {
         return;
     }
 
+    this->_file = file;
     this->_rotation = rotation;
 
     this->_width = -1;
@@ -27,35 +24,21 @@ image_panel::image_panel(wxWindow* parent, wxString file, wxBitmapType format, w
 void image_panel::paint_event(wxPaintEvent& event) {
     // this code is called when the system requests this panel to be redrawn.
 
-    if (!this->_image.IsOk()) {
-        return;
-    }
-
     wxPaintDC device_context = wxPaintDC(this);
 
     int new_width;
     int new_height;
     device_context.GetSize(&new_width, &new_height);
 
+    // the bitmap for this size is only created once for all panels showing the same file
     if (new_width != this->_width || new_height != this->_height) {
+        this->_bitmap = image_cache::get_bitmap(this->_file, wxSize(new_width, new_height), this->_rotation);
+        this->_width = new_width;
+        this->_height = new_height;
+    }
 
-        wxImage transformed;
-
-        if (this->_rotation == 0.0) {
-            transformed = this->_image.Scale(new_width, new_height, wxIMAGE_QUALITY_BILINEAR);
-
-        } else {
-            wxPoint center_of_rotation = wxPoint(this->_image.GetWidth() / 2, this->_image.GetHeight() / 2);
-            transformed = this->_image.Rotate(this->_rotation, center_of_rotation, true);
-            transformed = transformed.Scale(new_width, new_height, wxIMAGE_QUALITY_BILINEAR);
-        }
-        this->_bitmap = wxBitmap(transformed);
-        this->_width = transformed.GetWidth();
-        this->_height = transformed.GetHeight();
-
-        device_context.DrawBitmap(this->_bitmap, 0, 0, false);
-    } else {
-        device_context.DrawBitmap(this->_bitmap, 0, 0, false);
+    if (this->_bitmap != nullptr) {
+        device_context.DrawBitmap(*this->_bitmap, 0, 0, false);
     }
 }
 
@@ -1,14 +1,16 @@
 #ifndef IMAGEPANEL_H
 #define IMAGEPANEL_H
 
+#include <memory>
 #include <wx/wx.h>
 #include <wx/sizer.h>
 
 // This class can be used to display an image. It can be scaled with parameter <size> and rotated with <rotation> (in radian)
+// The decoded image and its scaled bitmap are shared with all other panels showing the same file, see image_cache.
 class image_panel : public wxPanel
 {
-    wxImage _image;
-    wxBitmap _bitmap;
+    wxString _file;
+    std::shared_ptr<const wxBitmap> _bitmap;
 
     double _rotation;
 
@@ -0,0 +1,205 @@
+#include "nnue_evaluator.h"
+
+#include <algorithm>
+
+#include "../../exceptions/gomoku_exception.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define GOMOKU_NNUE_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+    // index of black and white in the per-colour arrays
+    unsigned int colour_index(field_type colour) {
+        return colour == field_type::black_stone ? 0 : 1;
+    }
+
+    // sum of a[i] * b[i] over 'size' values, 'size' must be a multiple of 32
+    using dot_product_function = std::int32_t (*)(const std::uint8_t* a, const std::int8_t* b, unsigned int size);
+
+    std::int32_t dot_product_scalar(const std::uint8_t* a, const std::int8_t* b, unsigned int size) {
+        std::int32_t sum = 0;
+        for (unsigned int i = 0; i < size; ++i) {
+            sum += std::int32_t(a[i]) * std::int32_t(b[i]);
+        }
+        return sum;
+    }
+
+#ifdef GOMOKU_NNUE_X86
+    // the activations are at most 127, so the pairwise sums of maddubs cannot saturate
+    __attribute__((target("avx2")))
+    std::int32_t dot_product_avx2(const std::uint8_t* a, const std::int8_t* b, unsigned int size) {
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i sum = _mm256_setzero_si256();
+        for (unsigned int i = 0; i < size; i += 32) {
+            __m256i products = _mm256_maddubs_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+                                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+            sum = _mm256_add_epi32(sum, _mm256_madd_epi16(products, ones));
+        }
+        __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum128);
+    }
+
+    // SSE2 has no maddubs, so both inputs are widened to int16 first
+    __attribute__((target("sse2")))
+    std::int32_t dot_product_sse2(const std::uint8_t* a, const std::int8_t* b, unsigned int size) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i sum = _mm_setzero_si128();
+        for (unsigned int i = 0; i < size; i += 16) {
+            __m128i a_values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i b_values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i a_low = _mm_unpacklo_epi8(a_values, zero);
+            __m128i a_high = _mm_unpackhi_epi8(a_values, zero);
+            __m128i b_low = _mm_srai_epi16(_mm_unpacklo_epi8(b_values, b_values), 8);
+            __m128i b_high = _mm_srai_epi16(_mm_unpackhi_epi8(b_values, b_values), 8);
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(a_low, b_low));
+            sum = _mm_add_epi32(sum, _mm_madd_epi16(a_high, b_high));
+        }
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(sum);
+    }
+#endif
+
+    struct dot_product_implementation {
+        dot_product_function function;
+        const char* instruction_set;
+    };
+
+    // chosen once for the CPU the program runs on
+    dot_product_implementation select_dot_product() {
+#ifdef GOMOKU_NNUE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {dot_product_avx2, "avx2"};
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return {dot_product_sse2, "sse2"};
+        }
+#endif
+        return {dot_product_scalar, "scalar"};
+    }
+
+    const dot_product_implementation dot_product = select_dot_product();
+
+    std::uint8_t clip_activation(std::int32_t value) {
+        return std::uint8_t(std::clamp(value, 0, nnue_network::activation_max));
+    }
+}
+
+
+nnue_evaluator::nnue_evaluator(std::shared_ptr<const nnue_network> network) : _network(std::move(network)) {
+    if (_network == nullptr) {
+        throw gomoku_exception("The nnue_evaluator needs a network.");
+    }
+    _board_size = _network->board_size;
+    _num_stones = 0;
+    _fields = std::vector<field_type>(_board_size * _board_size, field_type::empty);
+    refresh();
+}
+
+
+void nnue_evaluator::update_accumulators(unsigned int field, field_type colour, int sign) {
+    const unsigned int own = colour_index(colour);
+    for (unsigned int perspective = 0; perspective < 2; ++perspective) {
+        const std::int16_t* weights = &_network->feature_weights[
+                _network->get_feature(field, perspective == own) * nnue_network::accumulator_size];
+        accumulator& values = _accumulators[perspective];
+        // simple enough for the compiler to vectorize
+        if (sign > 0) {
+            for (unsigned int i = 0; i < nnue_network::accumulator_size; ++i) {
+                values[i] += weights[i];
+            }
+        } else {
+            for (unsigned int i = 0; i < nnue_network::accumulator_size; ++i) {
+                values[i] -= weights[i];
+            }
+        }
+    }
+}
+
+void nnue_evaluator::refresh() {
+    _accumulators = {_network->feature_biases, _network->feature_biases};
+    for (unsigned int field = 0; field < _board_size * _board_size; ++field) {
+        if (_fields[field] != field_type::empty) {
+            update_accumulators(field, _fields[field], 1);
+        }
+    }
+}
+
+
+bool nnue_evaluator::place_stone(unsigned int x, unsigned int y, field_type colour) {
+    if (x >= _board_size || y >= _board_size || colour == field_type::empty || _fields[y * _board_size + x] != field_type::empty) {
+        return false;
+    }
+    _fields[y * _board_size + x] = colour;
+    update_accumulators(y * _board_size + x, colour, 1);
+    ++_num_stones;
+    return true;
+}
+
+bool nnue_evaluator::undo_stone(unsigned int x, unsigned int y) {
+    if (x >= _board_size || y >= _board_size || _fields[y * _board_size + x] == field_type::empty) {
+        return false;
+    }
+    update_accumulators(y * _board_size + x, _fields[y * _board_size + x], -1);
+    _fields[y * _board_size + x] = field_type::empty;
+    --_num_stones;
+    return true;
+}
+
+
+int nnue_evaluator::evaluate(field_type colour) const {
+    if (colour == field_type::empty) {
+        throw gomoku_exception("A position can only be evaluated for black or white.");
+    }
+    // the player to move comes first
+    alignas(32) std::array<std::uint8_t, 2 * nnue_network::accumulator_size> input;
+    const accumulator& own = _accumulators[colour_index(colour)];
+    const accumulator& opponent = _accumulators[1 - colour_index(colour)];
+    for (unsigned int i = 0; i < nnue_network::accumulator_size; ++i) {
+        input[i] = clip_activation(own[i]);
+        input[nnue_network::accumulator_size + i] = clip_activation(opponent[i]);
+    }
+
+    alignas(32) std::array<std::uint8_t, nnue_network::hidden_size> hidden;
+    for (unsigned int neuron = 0; neuron < nnue_network::hidden_size; ++neuron) {
+        const std::int32_t sum = _network->hidden_biases[neuron] + dot_product.function(
+                input.data(), &_network->hidden_weights[neuron * input.size()], input.size());
+        hidden[neuron] = clip_activation(sum >> nnue_network::hidden_weight_shift);
+    }
+
+    const std::int32_t output = _network->output_bias
+                                + dot_product.function(hidden.data(), _network->output_weights.data(), hidden.size());
+    return output / nnue_network::output_divisor;
+}
+
+
+const char* nnue_evaluator::get_instruction_set() {
+    return dot_product.instruction_set;
+}
+
+const nnue_evaluator::accumulator& nnue_evaluator::get_accumulator(field_type colour) const {
+    if (colour == field_type::empty) {
+        throw gomoku_exception("There are only accumulators for black and white.");
+    }
+    return _accumulators[colour_index(colour)];
+}
+
+field_type nnue_evaluator::get_field(unsigned int x, unsigned int y) const {
+    if (x >= _board_size || y >= _board_size) {
+        throw gomoku_exception("Field coordinates are outside of board dimensions.");
+    }
+    return _fields[y * _board_size + x];
+}
+
+unsigned int nnue_evaluator::get_board_size() const {
+    return _board_size;
+}
+
+unsigned int nnue_evaluator::get_num_stones() const {
+    return _num_stones;
+}
@@ -0,0 +1,55 @@
+// The nnue_evaluator evaluates positions with an nnue_network. Placing or undoing a stone only adds or subtracts one
+// row of feature weights to the accumulators of both players, so the first and by far largest layer is never
+// computed from scratch. The small dense layers are computed with AVX2 or SSE2 where the CPU supports it.
+
+#ifndef GOMOKU_NNUE_EVALUATOR_H
+#define GOMOKU_NNUE_EVALUATOR_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "position_evaluator.h"
+#include "nnue_network.h"
+
+class nnue_evaluator final : public position_evaluator {
+
+public:
+    using accumulator = std::array<std::int16_t, nnue_network::accumulator_size>;
+
+private:
+    std::shared_ptr<const nnue_network> _network;
+    unsigned int _board_size;
+    unsigned int _num_stones;
+    // fields in row-major order, like in playing_board
+    std::vector<field_type> _fields;
+    // the accumulators of black and of white
+    alignas(32) std::array<accumulator, 2> _accumulators;
+
+    // adds (sign = 1) or subtracts (sign = -1) the features of a stone of 'colour' on 'field'
+    void update_accumulators(unsigned int field, field_type colour, int sign);
+
+public:
+    // starts with an empty board of the size of the network
+    explicit nnue_evaluator(std::shared_ptr<const nnue_network> network);
+
+    bool place_stone(unsigned int x, unsigned int y, field_type colour) override;
+    bool undo_stone(unsigned int x, unsigned int y) override;
+    int evaluate(field_type colour) const override;
+
+    // computes the accumulators from the stones on the board, which gives the same result as the incremental updates
+    void refresh();
+
+    // the instruction set used for the dense layers: "avx2", "sse2" or "scalar"
+    static const char* get_instruction_set();
+
+// accessors
+    const accumulator& get_accumulator(field_type colour) const;
+    field_type get_field(unsigned int x, unsigned int y) const;
+    unsigned int get_board_size() const override;
+    unsigned int get_num_stones() const;
+};
+
+
+#endif //GOMOKU_NNUE_EVALUATOR_H
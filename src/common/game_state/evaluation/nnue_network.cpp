@@ -0,0 +1,122 @@
+#include "nnue_network.h"
+
+#include <fstream>
+#include <random>
+
+#include "../playing_board/playing_board.h"
+#include "../../exceptions/gomoku_exception.h"
+
+namespace {
+    template <class T>
+    void read_values(std::ifstream& file, T* values, size_t count, const std::string& path) {
+        file.read(reinterpret_cast<char*>(values), std::streamsize(count * sizeof(T)));
+        if (!file) {
+            throw gomoku_exception("The network file " + path + " ended early.");
+        }
+    }
+
+    template <class T>
+    void write_values(std::ofstream& file, const T* values, size_t count) {
+        file.write(reinterpret_cast<const char*>(values), std::streamsize(count * sizeof(T)));
+    }
+}
+
+
+unsigned int nnue_network::get_num_features() const {
+    return 2 * board_size * board_size;
+}
+
+unsigned int nnue_network::get_feature(unsigned int field, bool is_own_stone) const {
+    return is_own_stone ? field : board_size * board_size + field;
+}
+
+
+std::shared_ptr<const nnue_network> nnue_network::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw gomoku_exception("Could not open the network file " + path);
+    }
+
+    std::array<char, 4> magic;
+    std::array<std::uint32_t, 4> header;   // version, board size, accumulator size, hidden size
+    read_values(file, magic.data(), magic.size(), path);
+    if (magic != file_magic) {
+        throw gomoku_exception(path + " is not a network file.");
+    }
+    read_values(file, header.data(), header.size(), path);
+    if (header[0] != file_version) {
+        throw gomoku_exception("The network file " + path + " has version " + std::to_string(header[0])
+                               + ", but version " + std::to_string(file_version) + " is required.");
+    }
+    if (!playing_board::is_supported_board_size(header[1])) {
+        throw gomoku_exception("The network file " + path + " is for the unsupported board size " + std::to_string(header[1]));
+    }
+    if (header[2] != accumulator_size || header[3] != hidden_size) {
+        throw gomoku_exception("The network file " + path + " has layers of size " + std::to_string(header[2]) + " and "
+                               + std::to_string(header[3]) + ", but " + std::to_string(accumulator_size) + " and "
+                               + std::to_string(hidden_size) + " are required.");
+    }
+
+    std::shared_ptr<nnue_network> network = std::make_shared<nnue_network>();
+    network->board_size = header[1];
+    network->feature_weights.resize(network->get_num_features() * accumulator_size);
+    read_values(file, network->feature_weights.data(), network->feature_weights.size(), path);
+    read_values(file, network->feature_biases.data(), network->feature_biases.size(), path);
+    read_values(file, network->hidden_weights.data(), network->hidden_weights.size(), path);
+    read_values(file, network->hidden_biases.data(), network->hidden_biases.size(), path);
+    read_values(file, network->output_weights.data(), network->output_weights.size(), path);
+    read_values(file, &network->output_bias, 1, path);
+    if (file.peek() != std::ifstream::traits_type::eof()) {
+        throw gomoku_exception("The network file " + path + " is longer than expected.");
+    }
+    return network;
+}
+
+void nnue_network::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    const std::array<std::uint32_t, 4> header = {file_version, board_size, accumulator_size, hidden_size};
+    write_values(file, file_magic.data(), file_magic.size());
+    write_values(file, header.data(), header.size());
+    write_values(file, feature_weights.data(), feature_weights.size());
+    write_values(file, feature_biases.data(), feature_biases.size());
+    write_values(file, hidden_weights.data(), hidden_weights.size());
+    write_values(file, hidden_biases.data(), hidden_biases.size());
+    write_values(file, output_weights.data(), output_weights.size());
+    write_values(file, &output_bias, 1);
+    if (!file) {
+        throw gomoku_exception("Could not write the network file " + path);
+    }
+}
+
+
+std::shared_ptr<nnue_network> nnue_network::create_random(unsigned int board_size, unsigned int seed) {
+    if (!playing_board::is_supported_board_size(board_size)) {
+        throw gomoku_exception("Unsupported board size " + std::to_string(board_size));
+    }
+    std::mt19937 rng(seed);
+    // small enough that the accumulators stay within int16 on a full board
+    std::uniform_int_distribution<int> feature_weight(-64, 64);
+    std::uniform_int_distribution<int> weight(-127, 127);
+    std::uniform_int_distribution<int> bias(-2000, 2000);
+
+    std::shared_ptr<nnue_network> network = std::make_shared<nnue_network>();
+    network->board_size = board_size;
+    network->feature_weights.resize(network->get_num_features() * accumulator_size);
+    for (std::int16_t& value : network->feature_weights) {
+        value = std::int16_t(feature_weight(rng));
+    }
+    for (std::int16_t& value : network->feature_biases) {
+        value = std::int16_t(feature_weight(rng));
+    }
+    for (std::int8_t& value : network->hidden_weights) {
+        value = std::int8_t(weight(rng));
+    }
+    for (std::int32_t& value : network->hidden_biases) {
+        value = bias(rng);
+    }
+    for (std::int8_t& value : network->output_weights) {
+        value = std::int8_t(weight(rng));
+    }
+    network->output_bias = bias(rng);
+    return network;
+}
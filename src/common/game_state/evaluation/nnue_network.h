@@ -0,0 +1,60 @@
+// The nnue_network holds the quantized weights of the network of the nnue_evaluator. Its input is one feature per
+// stone, seen from one player: an own stone or an opponent's stone on a field. The first layer sums up the weights of
+// the features into an accumulator of int16 values for each player. The accumulators of the player to move and of the
+// opponent are clipped to [0, 127] and passed through a hidden layer with int8 weights to a single output.
+//
+// Weights are stored in a binary file (all values little endian):
+//   char[4] "GNUE", uint32 version, uint32 board size, uint32 accumulator size, uint32 hidden size,
+//   int16 feature weights [2 * board size^2][accumulator size], int16 feature biases [accumulator size],
+//   int8 hidden weights [hidden size][2 * accumulator size], int32 hidden biases [hidden size],
+//   int8 output weights [hidden size], int32 output bias
+
+#ifndef GOMOKU_NNUE_NETWORK_H
+#define GOMOKU_NNUE_NETWORK_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class nnue_network {
+
+public:
+    static constexpr std::array<char, 4> file_magic = {'G', 'N', 'U', 'E'};
+    static constexpr std::uint32_t file_version = 1;
+    static constexpr unsigned int accumulator_size = 128;
+    static constexpr unsigned int hidden_size = 32;
+    // the activations are clipped to [0, activation_max], which stands for [0, 1]
+    static constexpr int activation_max = 127;
+    // the hidden weights are scaled by 2^hidden_weight_shift
+    static constexpr int hidden_weight_shift = 6;
+    // the output is divided by this to get the evaluation
+    static constexpr int output_divisor = 16;
+
+    unsigned int board_size = 0;
+    // one row of accumulator_size weights per feature, see get_feature()
+    std::vector<std::int16_t> feature_weights;
+    std::array<std::int16_t, accumulator_size> feature_biases = {};
+    // one row of 2 * accumulator_size weights per hidden neuron: first for the player to move, then for the opponent
+    std::array<std::int8_t, hidden_size * 2 * accumulator_size> hidden_weights = {};
+    std::array<std::int32_t, hidden_size> hidden_biases = {};
+    std::array<std::int8_t, hidden_size> output_weights = {};
+    std::int32_t output_bias = 0;
+
+    unsigned int get_num_features() const;
+    // index of the feature for a stone on 'field' (y * board_size + x), as seen by the player it belongs to or not
+    unsigned int get_feature(unsigned int field, bool is_own_stone) const;
+
+    // Reads a network from 'path'. Throws a gomoku_exception if the file cannot be read, has another version or
+    // another architecture, or the board size is not supported.
+    static std::shared_ptr<const nnue_network> load(const std::string& path);
+    // throws a gomoku_exception if the file cannot be written
+    void save(const std::string& path) const;
+
+    // small random weights for tests and benchmarks
+    static std::shared_ptr<nnue_network> create_random(unsigned int board_size, unsigned int seed);
+};
+
+
+#endif //GOMOKU_NNUE_NETWORK_H
@@ -0,0 +1,28 @@
+// The position_evaluator is the interface of the static evaluations: the handcrafted pattern_board and the
+// nnue_evaluator. Both follow the stones of a game through place_stone() and undo_stone() and update their evaluation
+// incrementally. The mcts_engine only uses the pattern_board so far, the nnue_evaluator is not used by bots until
+// trained weights exist.
+
+#ifndef GOMOKU_POSITION_EVALUATOR_H
+#define GOMOKU_POSITION_EVALUATOR_H
+
+#include "../playing_board/playing_board.h"
+
+class position_evaluator {
+
+public:
+    virtual ~position_evaluator() = default;
+
+    // Both return false without changing the evaluator if the move is not possible. undo_stone() must be called in
+    // reverse order of place_stone() to restore the previous position.
+    virtual bool place_stone(unsigned int x, unsigned int y, field_type colour) = 0;
+    virtual bool undo_stone(unsigned int x, unsigned int y) = 0;
+
+    // evaluation from the point of view of 'colour', positive if 'colour' is better
+    virtual int evaluate(field_type colour) const = 0;
+
+    virtual unsigned int get_board_size() const = 0;
+};
+
+
+#endif //GOMOKU_POSITION_EVALUATOR_H
@@ -0,0 +1,329 @@
+#include "game_annotator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#include "../../exceptions/gomoku_exception.h"
+#include "../../../../rapidjson/include/rapidjson/stringbuffer.h"
+#include "../../../../rapidjson/include/rapidjson/writer.h"
+
+// initialize static members
+const std::unordered_map<annotation_type, std::string> game_annotator::_annotation_type_to_string = {
+        {annotation_type::normal_move, "normal"},
+        {annotation_type::blunder, "blunder"},
+        {annotation_type::missed_win, "missed_win"}
+};
+
+namespace {
+
+void write_move(rapidjson::Writer<rapidjson::StringBuffer>& writer, const search_move& move) {
+    if (move.type == search_move_type::stone_move) {
+        writer.StartArray();
+        writer.Uint(move.x);
+        writer.Uint(move.y);
+        writer.EndArray();
+    } else {
+        writer.String(game_state::_swap_decision_type_to_string.at(move.swap_decision).c_str());
+    }
+}
+
+}
+
+
+evaluation_table::evaluation_table(std::size_t max_entries) :
+        _max_entries(max_entries)
+{ }
+
+bool evaluation_table::find(std::uint64_t hash, position_evaluation& evaluation) const {
+    const shard& table_shard = _shards[hash % nof_shards];
+    std::lock_guard<std::mutex> shard_guard(table_shard.lock);
+    auto it = table_shard.entries.find(hash);
+    if (it == table_shard.entries.end() || !it->second.is_searched) {
+        return false;
+    }
+    evaluation = it->second.evaluation;
+    return true;
+}
+
+bool evaluation_table::try_claim(std::uint64_t hash) {
+    shard& table_shard = _shards[hash % nof_shards];
+    std::lock_guard<std::mutex> shard_guard(table_shard.lock);
+    if (table_shard.entries.count(hash) != 0) {
+        return false;
+    }
+    if (_size.load(std::memory_order_relaxed) < _max_entries) {
+        table_shard.entries.emplace(hash, entry{{}, false});
+        _size.fetch_add(1, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void evaluation_table::insert(std::uint64_t hash, const position_evaluation& evaluation) {
+    shard& table_shard = _shards[hash % nof_shards];
+    std::lock_guard<std::mutex> shard_guard(table_shard.lock);
+    auto it = table_shard.entries.find(hash);
+    if (it != table_shard.entries.end()) {
+        it->second = {evaluation, true};
+    } else if (_size.load(std::memory_order_relaxed) < _max_entries) {
+        table_shard.entries.emplace(hash, entry{evaluation, true});
+        _size.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void evaluation_table::release(std::uint64_t hash) {
+    shard& table_shard = _shards[hash % nof_shards];
+    std::lock_guard<std::mutex> shard_guard(table_shard.lock);
+    auto it = table_shard.entries.find(hash);
+    if (it != table_shard.entries.end() && !it->second.is_searched) {
+        table_shard.entries.erase(it);
+        _size.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+std::size_t evaluation_table::size() const {
+    return _size.load();
+}
+
+
+std::string annotated_game::to_json_line() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.SetMaxDecimalPlaces(3);
+    writer.StartObject();
+    writer.Key("ruleset");
+    writer.String(game_state::_ruleset_type_to_string.at(record.ruleset).c_str());
+    writer.Key("board_size");
+    writer.Uint(record.board_size);
+    writer.Key("moves");
+    writer.StartArray();
+    for (const search_move& move : record.moves) {
+        write_move(writer, move);
+    }
+    writer.EndArray();
+    writer.Key("annotations");
+    writer.StartArray();
+    for (const move_annotation& annotation : annotations) {
+        writer.StartObject();
+        writer.Key("win_rate");
+        writer.Double(annotation.win_rate);
+        writer.Key("best_move");
+        write_move(writer, annotation.best_move);
+        writer.Key("loss");
+        writer.Double(annotation.loss);
+        writer.Key("type");
+        writer.String(game_annotator::_annotation_type_to_string.at(annotation.type).c_str());
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+void annotated_game::write(std::ostream& out) const {
+    out << to_json_line() << '\n';
+}
+
+
+game_annotator::game_annotator(const annotator_settings& settings) :
+        _settings(settings),
+        _table(settings.max_table_entries)
+{
+    const unsigned int num_workers = settings.num_workers != 0
+            ? settings.num_workers : std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int worker_idx = 0; worker_idx < num_workers; ++worker_idx) {
+        _engines.push_back(std::make_unique<mcts_engine>(settings.search));
+        _engines.back()->set_num_threads(1);
+    }
+}
+
+const game_annotator::statistics& game_annotator::get_statistics() const {
+    return _statistics;
+}
+
+unsigned int game_annotator::get_num_workers() const {
+    return _engines.size();
+}
+
+
+std::vector<game_annotator::ply> game_annotator::replay(const game_record& record) {
+    search_position position(record.ruleset, record.board_size);
+    std::vector<ply> plies;
+    plies.reserve(record.moves.size() + 1);
+    for (std::size_t i = 0; i < record.moves.size(); ++i) {
+        plies.push_back({position_hash::get_canonical_hash(position), position.get_current_player_idx(), false, false,
+                         false, {}});
+        if (!position.apply_move(record.moves[i])) {
+            throw gomoku_exception("Move " + std::to_string(i + 1) + " of the game record is illegal.");
+        }
+    }
+    // the player to move of a finished game is its winner
+    plies.push_back({position_hash::get_canonical_hash(position), position.get_current_player_idx(),
+                     position.is_finished(), position.is_tied(), false, {}});
+    return plies;
+}
+
+float game_annotator::get_value(const ply& after, const position_evaluation& evaluation, unsigned int player_idx) {
+    if (after.is_finished) {
+        return after.is_tied ? 0.5f : (after.player_idx == player_idx ? 1.0f : 0.0f);
+    }
+    // in the swap openings, a player may move several times in a row
+    return after.player_idx == player_idx ? evaluation.win_rate : 1.0f - evaluation.win_rate;
+}
+
+
+void game_annotator::search_positions(const std::vector<game_record>& records,
+                                      std::vector<std::vector<ply>>& game_plies) {
+    std::atomic<std::size_t> next_record{0};
+    std::atomic<std::uint64_t> nof_searched{0};
+    std::atomic<std::uint64_t> nof_reused{0};
+    std::mutex error_lock;
+    std::string error;
+
+    auto run_worker = [&](unsigned int worker_idx) {
+        mcts_engine& engine = *_engines[worker_idx];
+        for (std::size_t record_idx = next_record.fetch_add(1); record_idx < records.size();
+             record_idx = next_record.fetch_add(1)) {
+            // the plies are in the order of the game, so each search can continue with the tree of the last one
+            const game_record& record = records[record_idx];
+            std::vector<ply>& plies = game_plies[record_idx];
+            search_position position(record.ruleset, record.board_size);
+            for (std::size_t ply_idx = 0; ply_idx < plies.size(); ++ply_idx) {
+                ply& current = plies[ply_idx];
+                if (current.is_finished) {
+                    continue;
+                } else if (!_table.try_claim(current.key.hash)) {
+                    // known, or another worker searches it right now
+                    nof_reused++;
+                } else {
+                    // an exception must not leave the thread, it would terminate the program
+                    try {
+                        const mcts_result result = engine.search(position);
+                        const search_move best_move = position_hash::transform(current.key.symmetry,
+                                                                               record.board_size, result.best_move);
+                        current.evaluation = {best_move, result.win_rate, result.num_playouts};
+                        current.is_evaluated = true;
+                        _table.insert(current.key.hash, current.evaluation);
+                        nof_searched++;
+                    } catch (const std::exception& e) {
+                        _table.release(current.key.hash);
+                        std::lock_guard<std::mutex> error_guard(error_lock);
+                        if (error.empty()) {
+                            error = "Could not search the position before move " + std::to_string(ply_idx + 1)
+                                    + " of game " + std::to_string(_statistics.nof_games + record_idx + 1) + ": "
+                                    + e.what();
+                        }
+                    }
+                }
+                if (ply_idx < record.moves.size()) {
+                    position.apply_move(record.moves[ply_idx]);
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned int worker_idx = 1; worker_idx < _engines.size(); ++worker_idx) {
+        workers.emplace_back(run_worker, worker_idx);
+    }
+    run_worker(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    _statistics.nof_searched += nof_searched.load();
+    _statistics.nof_reused += nof_reused.load();
+    if (!error.empty()) {
+        throw gomoku_exception(error);
+    }
+
+    // the positions that other workers or earlier batches searched
+    for (std::vector<ply>& plies : game_plies) {
+        for (ply& current : plies) {
+            if (!current.is_finished && !current.is_evaluated) {
+                if (!_table.find(current.key.hash, current.evaluation)) {
+                    throw gomoku_exception("The evaluation of a position was lost.");
+                }
+                current.is_evaluated = true;
+            }
+        }
+    }
+}
+
+std::vector<annotated_game> game_annotator::annotate(const std::vector<game_record>& records) {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    // replay all games first, so that illegal moves are found before the workers start
+    std::vector<std::vector<ply>> game_plies;
+    game_plies.reserve(records.size());
+    for (const game_record& record : records) {
+        game_plies.push_back(replay(record));
+        _statistics.nof_positions += game_plies.back().size();
+    }
+    search_positions(records, game_plies);
+
+    std::vector<annotated_game> games;
+    games.reserve(records.size());
+    for (std::size_t record_idx = 0; record_idx < records.size(); ++record_idx) {
+        const game_record& record = records[record_idx];
+        const std::vector<ply>& plies = game_plies[record_idx];
+        annotated_game game = {record, {}};
+        game.annotations.reserve(record.moves.size());
+        for (std::size_t i = 0; i < record.moves.size(); ++i) {
+            const ply& before = plies[i];
+            const ply& after = plies[i + 1];
+            const position_evaluation& evaluation = before.evaluation;
+            move_annotation annotation = {};
+            annotation.win_rate = evaluation.win_rate;
+            annotation.best_move = position_hash::inverse_transform(before.key.symmetry, record.board_size,
+                                                                    evaluation.best_move);
+            if (!(annotation.best_move == record.moves[i])) {
+                const float value = after.is_finished ? get_value(after, {}, before.player_idx)
+                                                      : get_value(after, after.evaluation, before.player_idx);
+                annotation.loss = std::max(0.0f, annotation.win_rate - value);
+            }
+            annotation.type = annotation_type::normal_move;
+            if (annotation.loss >= _settings.blunder_loss) {
+                if (annotation.win_rate >= _settings.won_win_rate) {
+                    annotation.type = annotation_type::missed_win;
+                    _statistics.nof_missed_wins++;
+                } else {
+                    annotation.type = annotation_type::blunder;
+                    _statistics.nof_blunders++;
+                }
+            }
+            game.annotations.push_back(annotation);
+        }
+        games.push_back(std::move(game));
+    }
+
+    _statistics.nof_games += records.size();
+    _statistics.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return games;
+}
+
+void game_annotator::annotate_records(std::istream& in, std::ostream& out, unsigned int batch_size,
+                                      const std::function<void(const statistics&)>& on_batch) {
+    std::vector<game_record> batch;
+    game_record record;
+    bool is_at_end = false;
+    while (!is_at_end) {
+        batch.clear();
+        while (batch.size() < std::max(1u, batch_size)) {
+            if (!game_record::read(in, record)) {
+                is_at_end = true;
+                break;
+            }
+            batch.push_back(record);
+        }
+        if (batch.empty()) {
+            break;
+        }
+        for (const annotated_game& game : annotate(batch)) {
+            game.write(out);
+        }
+        out.flush();
+        if (on_batch) {
+            on_batch(_statistics);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+// The game_annotator evaluates every position of finished games with the mcts_engine and marks the moves that lost
+// much of the mover's winning chances (blunders), in particular moves that gave away a won position (missed wins).
+// Records are read and written in streaming fashion, batch by batch. Positions are deduplicated across all games by
+// their canonical hash: the workers annotate the games of a batch in parallel, one engine per worker, and claim every
+// position in an evaluation_table that they all share before they search it, so that every distinct position is
+// searched once. Each worker searches the positions of a game in order, so that it can reuse the tree of the previous
+// position.
+//
+// Annotated records are game records with an additional member, one entry per move:
+//   {"ruleset":"freestyle","board_size":15,"moves":[[7,7],[8,8]],
+//    "annotations":[{"win_rate":0.55,"best_move":[7,7],"loss":0,"type":"normal"},...]}
+// 'win_rate' is the evaluation of the position before the move for the player to move, 'loss' how much the move
+// played lowered it. Annotated records can still be read as game_records.
+
+#ifndef GOMOKU_GAME_ANNOTATOR_H
+#define GOMOKU_GAME_ANNOTATOR_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../game_record/game_record.h"
+#include "../mcts_engine/mcts_engine.h"
+#include "../position_hash/position_hash.h"
+
+enum annotation_type {
+    normal_move,
+    blunder,
+    missed_win,
+};
+
+// the result of searching a position
+struct position_evaluation {
+    search_move best_move;      // in the canonical orientation of the position
+    float win_rate;             // for the player to move
+    std::uint32_t num_playouts;
+};
+
+// Evaluations by canonical hash, shared by the threads of the game_annotator. The table is split into shards with a
+// lock each, so that threads rarely wait for each other. Once 'max_entries' positions are stored, new ones are
+// dropped: the positions seen first are the openings, which most games share.
+class evaluation_table {
+
+public:
+    static constexpr unsigned int nof_shards = 64;
+
+    explicit evaluation_table(std::size_t max_entries);
+
+    // false if the position is unknown or still being searched
+    bool find(std::uint64_t hash, position_evaluation& evaluation) const;
+    // Returns false if the position is known or claimed by another thread already, otherwise the caller should search
+    // it. If the table is full, the position cannot be claimed and several threads may search it.
+    bool try_claim(std::uint64_t hash);
+    // stores the evaluation of a claimed position, or of a new one if the table is not full
+    void insert(std::uint64_t hash, const position_evaluation& evaluation);
+    // gives up the claim of a position whose search failed
+    void release(std::uint64_t hash);
+    std::size_t size() const;
+
+private:
+    struct entry {
+        position_evaluation evaluation;
+        bool is_searched;
+    };
+
+    struct shard {
+        mutable std::mutex lock;
+        std::unordered_map<std::uint64_t, entry> entries;
+    };
+
+    std::size_t _max_entries;
+    std::atomic<std::size_t> _size{0};
+    std::array<shard, nof_shards> _shards;
+};
+
+struct move_annotation {
+    float win_rate;         // before the move, for the player who made it
+    search_move best_move;  // the best move according to the search
+    float loss;             // how much the move lowered 'win_rate', 0 for the best move
+    annotation_type type;
+};
+
+struct annotated_game {
+    game_record record;
+    std::vector<move_annotation> annotations;   // one per move of 'record'
+
+    std::string to_json_line() const;
+    void write(std::ostream& out) const;
+};
+
+struct annotator_settings {
+    mcts_settings search;           // the number of threads is ignored, every worker searches with one thread
+    unsigned int num_workers;       // 0 uses all cores
+    float blunder_loss;             // moves that lose at least this much are blunders
+    float won_win_rate;             // positions evaluated at least this high count as won
+    std::size_t max_table_entries;
+};
+
+class game_annotator {
+
+public:
+    // the totals of all batches annotated so far
+    struct statistics {
+        std::uint64_t nof_games;
+        std::uint64_t nof_positions;    // positions before every move and at the end of every game
+        std::uint64_t nof_searched;     // distinct positions that were searched
+        std::uint64_t nof_reused;       // positions whose evaluation was known from an earlier position
+        std::uint64_t nof_blunders;
+        std::uint64_t nof_missed_wins;
+        double seconds;
+    };
+
+    static const std::unordered_map<annotation_type, std::string> _annotation_type_to_string;
+
+    explicit game_annotator(const annotator_settings& settings);
+
+    // Annotates a batch of games. Throws a gomoku_exception if a record contains an illegal move.
+    std::vector<annotated_game> annotate(const std::vector<game_record>& records);
+    // Annotates all game records of 'in' in batches of 'batch_size' games and writes them to 'out' in the same order.
+    // 'on_batch' is called after every batch, e.g. to report progress. Throws a gomoku_exception for invalid records.
+    void annotate_records(std::istream& in, std::ostream& out, unsigned int batch_size,
+                          const std::function<void(const statistics&)>& on_batch = nullptr);
+
+    const statistics& get_statistics() const;
+    unsigned int get_num_workers() const;
+
+private:
+    // a position of a game, before the move with the same index or at the end of the game
+    struct ply {
+        canonical_hash key;
+        unsigned int player_idx;    // the player to move, or the winner at the end of a finished game
+        bool is_finished;
+        bool is_tied;
+        bool is_evaluated;          // 'evaluation' is only set then
+        position_evaluation evaluation;
+    };
+
+    annotator_settings _settings;
+    std::vector<std::unique_ptr<mcts_engine>> _engines;    // one per worker
+    evaluation_table _table;
+    statistics _statistics = {};
+
+    static std::vector<ply> replay(const game_record& record);
+    // Searches the positions of all records in parallel that are neither known nor claimed by another worker. Throws
+    // a gomoku_exception if a search failed, after all workers are done.
+    void search_positions(const std::vector<game_record>& records, std::vector<std::vector<ply>>& game_plies);
+    // the value of the position of 'after' for 'player_idx'
+    static float get_value(const ply& after, const position_evaluation& evaluation, unsigned int player_idx);
+};
+
+
+#endif //GOMOKU_GAME_ANNOTATOR_H
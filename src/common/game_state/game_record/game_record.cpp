@@ -0,0 +1,108 @@
+#include "game_record.h"
+
+#include "../../exceptions/gomoku_exception.h"
+#include "../../../../rapidjson/include/rapidjson/document.h"
+#include "../../../../rapidjson/include/rapidjson/stringbuffer.h"
+#include "../../../../rapidjson/include/rapidjson/writer.h"
+
+
+game_record game_record::from_position(const search_position& position) {
+    game_record record;
+    record.ruleset = position.get_ruleset();
+    record.board_size = position.get_board_size();
+    record.moves = position.get_moves();
+    return record;
+}
+
+search_position game_record::replay() const {
+    search_position position(ruleset, board_size);
+    for (size_t i = 0; i < moves.size(); ++i) {
+        if (!position.apply_move(moves[i])) {
+            throw gomoku_exception("Move " + std::to_string(i + 1) + " of the game record is illegal.");
+        }
+    }
+    return position;
+}
+
+
+game_record game_record::from_json_line(const std::string& line) {
+    rapidjson::Document json;
+    json.Parse(line.c_str(), line.size());
+    if (json.HasParseError() || !json.IsObject()
+        || !json.HasMember("ruleset") || !json["ruleset"].IsString()
+        || !json.HasMember("board_size") || !json["board_size"].IsUint()
+        || !json.HasMember("moves") || !json["moves"].IsArray()) {
+        throw gomoku_exception("Could not parse game record: " + line);
+    }
+
+    game_record record;
+    auto ruleset_it = game_state::_string_to_ruleset_type.find(json["ruleset"].GetString());
+    if (ruleset_it == game_state::_string_to_ruleset_type.end() || ruleset_it->second == ruleset_type::uninitialized) {
+        throw gomoku_exception("Unknown ruleset in game record: " + std::string(json["ruleset"].GetString()));
+    }
+    record.ruleset = ruleset_it->second;
+    record.board_size = json["board_size"].GetUint();
+    if (!playing_board::is_supported_board_size(record.board_size)) {
+        throw gomoku_exception("Unsupported board size in game record: " + std::to_string(record.board_size));
+    }
+
+    const rapidjson::Value& moves = json["moves"];
+    record.moves.reserve(moves.Size());
+    for (const rapidjson::Value& move : moves.GetArray()) {
+        if (move.IsArray() && move.Size() == 2 && move[0].IsUint() && move[1].IsUint()
+            && move[0].GetUint() < record.board_size && move[1].GetUint() < record.board_size) {
+            record.moves.push_back(search_move::stone(move[0].GetUint(), move[1].GetUint()));
+            continue;
+        }
+        if (move.IsString()) {
+            auto decision_it = game_state::_string_to_swap_decision_type.find(move.GetString());
+            if (decision_it != game_state::_string_to_swap_decision_type.end()) {
+                record.moves.push_back(search_move::swap(decision_it->second));
+                continue;
+            }
+        }
+        throw gomoku_exception("Invalid move in game record: " + line);
+    }
+    return record;
+}
+
+std::string game_record::to_json_line() const {
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("ruleset");
+    writer.String(game_state::_ruleset_type_to_string.at(ruleset).c_str());
+    writer.Key("board_size");
+    writer.Uint(board_size);
+    writer.Key("moves");
+    writer.StartArray();
+    for (const search_move& move : moves) {
+        if (move.type == search_move_type::stone_move) {
+            writer.StartArray();
+            writer.Uint(move.x);
+            writer.Uint(move.y);
+            writer.EndArray();
+        } else {
+            writer.String(game_state::_swap_decision_type_to_string.at(move.swap_decision).c_str());
+        }
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+
+bool game_record::read(std::istream& in, game_record& record) {
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") != std::string::npos) {
+            record = from_json_line(line);
+            return true;
+        }
+    }
+    return false;
+}
+
+void game_record::write(std::ostream& out) const {
+    out << to_json_line() << '\n';
+}
@@ -0,0 +1,40 @@
+// A game_record is the replay format of a game: the ruleset, the board size and all moves in the order they were
+// played. Records are stored as JSON lines, one game per line, so that large archives can be streamed:
+//   {"ruleset":"swap2","board_size":15,"moves":[[7,7],[8,7],[8,8],"do_swap",[6,6]]}
+// Stones are written as [x, y] and swap decisions by their name.
+
+#ifndef GOMOKU_GAME_RECORD_H
+#define GOMOKU_GAME_RECORD_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../search_position/search_position.h"
+
+class game_record {
+
+public:
+    ruleset_type ruleset = ruleset_type::freestyle;
+    unsigned int board_size = playing_board::_playing_board_size;
+    std::vector<search_move> moves;
+
+    // the moves that led to 'position', which must have been created at the start of a game
+    static game_record from_position(const search_position& position);
+
+    // Plays all moves from the start of the game. Throws a gomoku_exception if a move is illegal.
+    search_position replay() const;
+
+    // Parses a single record. Throws a gomoku_exception if 'line' is not a valid record.
+    static game_record from_json_line(const std::string& line);
+    std::string to_json_line() const;
+
+    // Reads the next record from 'in', skipping empty lines. Returns false at the end of the stream and throws a
+    // gomoku_exception if the line is not a valid record.
+    static bool read(std::istream& in, game_record& record);
+    void write(std::ostream& out) const;
+};
+
+
+#endif //GOMOKU_GAME_RECORD_H
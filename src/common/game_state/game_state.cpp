@@ -6,7 +6,10 @@
 
 #include "../exceptions/gomoku_exception.h"
 #include "../serialization/vector_utils.h"
+#include "../serialization/json_utils.h"
 #include "playing_board/playing_board.h"
+#include "playing_board/board_geometry.h"
+#include "renju_rules/renju_rules.h"
 
 // for deserialization
 const std::unordered_map<std::string, swap_decision_type> game_state::_string_to_swap_decision_type = {
@@ -33,6 +36,7 @@ const std::unordered_map<std::string, ruleset_type> game_state::_string_to_rules
         {"freestyle", ruleset_type::freestyle },
         {"swap2", ruleset_type::swap2 },
         {"swap_after_first_move", ruleset_type::swap_after_first_move },
+        {"renju", ruleset_type::renju },
         {"uninitialized", ruleset_type::uninitialized },
 };
 
@@ -41,6 +45,7 @@ const std::unordered_map<ruleset_type, std::string> game_state::_ruleset_type_to
         { ruleset_type::freestyle, "freestyle" },
         { ruleset_type::swap2, "swap2"},
         { ruleset_type::swap_after_first_move, "swap_after_first_move"},
+        { ruleset_type::renju, "renju"},
         { ruleset_type::uninitialized, "uninitialized"},
 };
 
@@ -147,10 +152,18 @@ int game_state::get_starting_player_idx() const {
     return _starting_player_idx->get_value();
 }
 
+int game_state::get_current_player_idx() const {
+    return _current_player_idx->get_value();
+}
+
 std::vector<std::vector<field_type>> game_state::get_playing_board() const{
     return _playing_board->get_playing_board();
 }
 
+unsigned int game_state::get_board_size() const {
+    return _playing_board->get_board_size();
+}
+
 ruleset_type game_state::get_opening_rules() const {
     return _opening_ruleset;
 }
@@ -180,6 +193,19 @@ std::vector<player*>& game_state::get_players() {
     return _players;
 }
 
+const std::vector<player*>& game_state::get_players() const {
+    return _players;
+}
+
+std::vector<std::pair<unsigned int, unsigned int>> game_state::get_forbidden_fields() const {
+    player* current_player = get_current_player();
+    if (_opening_ruleset != ruleset_type::renju || current_player == nullptr
+        || current_player->get_colour() != player_colour_type::black) {
+        return {};
+    }
+    return renju_rules::get_forbidden_fields(*_playing_board);
+}
+
 
 #ifdef GOMOKU_SERVER
 
@@ -208,12 +234,17 @@ void game_state::wrap_up_round(std::string& err) {
     this->_is_finished->set_value(true);
 }
 
+#endif
+
+
+// in-round functions, which are also used by the client to predict the outcome of its own moves
 bool game_state::update_current_player(std::string& err) {
     bool result;
     int current_turn_val = this->get_turn_number();
 
     switch(_opening_ruleset) {
         case freestyle:
+        case renju:
             result = alternate_current_player(err);
             break;
         case swap_after_first_move:
@@ -367,6 +398,8 @@ bool game_state::determine_swap_decision(swap_decision_type swap_decision, std::
     return false;
 }
 
+#ifdef GOMOKU_SERVER
+
 bool game_state::switch_starting_player(std::string& err) {
     if (_starting_player_idx->get_value() == 0){
         _starting_player_idx->set_value(1);
@@ -442,11 +475,34 @@ bool game_state::add_player(player* player_ptr, std::string& err) {
 }
 
 bool game_state::set_game_mode(const std::string& rule_name, std::string& err) {
-    this->_opening_ruleset = _string_to_ruleset_type.at(rule_name);
+    auto ruleset = _string_to_ruleset_type.find(rule_name);
+    if (ruleset == _string_to_ruleset_type.end()) {
+        err = "Unknown ruleset " + rule_name + ".";
+        return false;
+    }
+    this->_opening_ruleset = ruleset->second;
     return true;
 }
 
+// Selects the board dimensions of the next round. The board can only be resized while no round is being played.
+bool game_state::set_board_size(unsigned int board_size, std::string& err) {
+    if (_is_started->get_value()) {
+        err = "Could not change the board size, because the game is already started.";
+        return false;
+    }
+    return _playing_board->set_board_size(board_size, err);
+}
+
+#endif
+
 bool game_state::place_stone(unsigned int x, unsigned int y, field_type colour, std::string& err) {
+    if (_opening_ruleset == ruleset_type::renju && colour == field_type::black_stone) {
+        forbidden_move_type forbidden_move = renju_rules::check_black_move(*_playing_board, x, y);
+        if (forbidden_move != forbidden_move_type::allowed_move) {
+            err = "GameState: Black is not allowed to play a " + renju_rules::_forbidden_move_type_to_string.at(forbidden_move) + ".";
+            return false;
+        }
+    }
     if (this->_playing_board->place_stone(x, y, colour, err)) {
         return true;
     }
@@ -454,67 +510,41 @@ bool game_state::place_stone(unsigned int x, unsigned int y, field_type colour,
     return false;
 }
 
+// returns true if the stone at (x, y) completes a line of five or more stones of 'colour'.
+// Under the renju ruleset, black only wins with exactly five stones.
 bool game_state::check_win_condition(unsigned int x, unsigned int y, int colour) {
-    /*
-     * order of directions in vector
-     *   0  1  2
-     *   3     4
-     *   5  6  7
-     */
-    std::vector<unsigned int> stones_in_directions;
-    for (int i = -1; i<2; ++i) {
-        for (int j = -1; j<2; ++j) {
-            if (i != 0 || j != 0) {
-                stones_in_directions.push_back(count_stones_one_direction(x, y, i, j, colour));
-            }
+    const field_type* fields = _playing_board->get_fields();
+    const bool exact_five_only = _opening_ruleset == ruleset_type::renju && colour == field_type::black_stone;
+    return with_board_geometry(_playing_board->get_board_size(), [&](auto geometry) {
+        if (exact_five_only) {
+            return decltype(geometry)::has_exact_five(fields, x, y, static_cast<field_type>(colour));
         }
-    }
-    if (stones_in_directions.at(0)+stones_in_directions.at(7)+1 >= 5 ||
-        stones_in_directions.at(1)+stones_in_directions.at(6)+1 >= 5 ||
-        stones_in_directions.at(2)+stones_in_directions.at(5)+1 >= 5 ||
-        stones_in_directions.at(3)+stones_in_directions.at(4)+1 >= 5) {
-        return true;
-    } else {
-        return false;
-    }
+        return decltype(geometry)::longest_line(fields, x, y, static_cast<field_type>(colour)) >= 5;
+    });
 }
 
-// recursive function to find the number of same-colour stones in a direction from a given location
+// returns the number of same-colour stones in a direction from a given location, not counting the location itself
 unsigned int game_state::count_stones_one_direction(unsigned int x, unsigned int y, int direction_x, int direction_y, int colour) {
-    // edge checking
-    if (x == 0 && direction_x == -1 ||
-        y == 0 && direction_y == -1 ||
-        x == 14 && direction_x == 1 ||
-        y == 14 && direction_y == 1){
-        return 0;
-    } else {
-        int next_stone_colour = _playing_board->get_playing_board().at(y + direction_y).at(x + direction_x);
-        //return zero if we have reached the end of the line
-        if (next_stone_colour != colour) {
-            return 0;
-        } else {
-            return 1 +
-                   game_state::count_stones_one_direction(x + direction_x, y + direction_y, direction_x, direction_y,
-                                                          colour);
-        }
+    // map the direction onto the direction index used by board_geometry
+    int direction = (direction_y + 1) * 3 + (direction_x + 1);
+    if (direction > 4) {
+        --direction;
     }
+    const field_type* fields = _playing_board->get_fields();
+    return with_board_geometry(_playing_board->get_board_size(), [&](auto geometry) {
+        return decltype(geometry)::count_stones_one_direction(fields, x, y, direction, static_cast<field_type>(colour));
+    });
 }
 
+// the game is tied once every field of the board is taken, which the board tracks with its stone counter
 bool game_state::check_for_tie(){
-    int playing_board_size = playing_board::_playing_board_size;
-    for(int i = 0; i<playing_board_size; ++i){
-        for(int j = 0; j<playing_board_size; ++j){
-            if(this->get_playing_board().at(i).at(j) == field_type::empty){
-                return false;
-            }
-        }
+    if (!_playing_board->is_full()) {
+        return false;
     }
     this->_is_tied->set_value(true);
     return true;
 }
 
-#endif
-
 
 // Serializable interface
 void game_state::write_into_json(rapidjson::Value &json,
@@ -604,3 +634,96 @@ game_state* game_state::from_json(const rapidjson::Value &json) {
     }
 }
 
+void game_state::update_from_json(const rapidjson::Value &json) {
+    if (!json.HasMember("id")
+        || !json.HasMember("is_started")
+        || !json.HasMember("is_finished")
+        || !json.HasMember("is_tied")
+        || !json.HasMember("current_player_idx")
+        || !json.HasMember("starting_player_idx")
+        || !json.HasMember("turn_number")
+        || !json.HasMember("players")
+        || !json.HasMember("playing_board")
+        || !json.HasMember("opening_ruleset")
+        || !json.HasMember("swap_next_turn")
+        || !json.HasMember("swap_decision"))
+    {
+        throw gomoku_exception("Failed to deserialize game_state. Required entries were missing.");
+    }
+
+    // validate everything before the first value changes, so that an invalid message leaves the state as it was
+    if (!json["id"].IsString()
+        || !json_utils::has_serialized_value(json, "is_started", &rapidjson::Value::IsBool)
+        || !json_utils::has_serialized_value(json, "is_finished", &rapidjson::Value::IsBool)
+        || !json_utils::has_serialized_value(json, "is_tied", &rapidjson::Value::IsBool)
+        || !json_utils::has_serialized_value(json, "current_player_idx", &rapidjson::Value::IsInt)
+        || !json_utils::has_serialized_value(json, "starting_player_idx", &rapidjson::Value::IsInt)
+        || !json_utils::has_serialized_value(json, "turn_number", &rapidjson::Value::IsInt)
+        || !json_utils::has_serialized_value(json, "swap_next_turn", &rapidjson::Value::IsBool)
+        || !json["players"].IsArray())
+    {
+        throw gomoku_exception("Failed to deserialize game_state. Entries have the wrong type.");
+    }
+    playing_board::validate_json(json["playing_board"]);
+    const ruleset_type opening_ruleset = json_utils::parse_enum_value(json["opening_ruleset"], _string_to_ruleset_type);
+    const swap_decision_type swap_decision = json_utils::parse_enum_value(json["swap_decision"], _string_to_swap_decision_type);
+    for (const rapidjson::Value& serialized_player : json["players"].GetArray()) {
+        player::validate_json(serialized_player);
+    }
+
+    this->_id = json["id"].GetString();
+    this->_playing_board->update_from_json(json["playing_board"]);
+    this->_opening_ruleset = opening_ruleset;
+    this->_is_started->set_value(json["is_started"]["value"].GetBool());
+    this->_is_finished->set_value(json["is_finished"]["value"].GetBool());
+    this->_is_tied->set_value(json["is_tied"]["value"].GetBool());
+    this->_current_player_idx->set_value(json["current_player_idx"]["value"].GetInt());
+    this->_starting_player_idx->set_value(json["starting_player_idx"]["value"].GetInt());
+    this->_turn_number->set_value(json["turn_number"]["value"].GetInt());
+    this->_swap_next_turn->set_value(json["swap_next_turn"]["value"].GetBool());
+    this->_swap_decision = swap_decision;
+
+    // player objects are reused by position, each one takes over the serialized player at its index
+    const rapidjson::Value& serialized_players = json["players"];
+    while (this->_players.size() > serialized_players.Size()) {
+        delete this->_players.back();
+        this->_players.pop_back();
+    }
+    for (unsigned int i = 0; i < serialized_players.Size(); ++i) {
+        if (i < this->_players.size()) {
+            this->_players[i]->update_from_json(serialized_players[i]);
+        } else {
+            this->_players.push_back(player::from_json(serialized_players[i]));
+        }
+    }
+}
+
+void game_state::copy_from(const game_state& other) {
+    if (this == &other) {
+        return;
+    }
+    this->_id = other._id;
+    this->_playing_board->copy_from(*other._playing_board);
+    this->_opening_ruleset = other._opening_ruleset;
+    this->_is_started->set_value(other._is_started->get_value());
+    this->_is_finished->set_value(other._is_finished->get_value());
+    this->_is_tied->set_value(other._is_tied->get_value());
+    this->_current_player_idx->set_value(other._current_player_idx->get_value());
+    this->_starting_player_idx->set_value(other._starting_player_idx->get_value());
+    this->_turn_number->set_value(other._turn_number->get_value());
+    this->_swap_next_turn->set_value(other._swap_next_turn->get_value());
+    this->_swap_decision = other._swap_decision;
+
+    // player objects are reused by position, like in update_from_json
+    while (this->_players.size() > other._players.size()) {
+        delete this->_players.back();
+        this->_players.pop_back();
+    }
+    for (unsigned int i = 0; i < other._players.size(); ++i) {
+        if (i < this->_players.size()) {
+            this->_players[i]->copy_from(*other._players[i]);
+        } else {
+            this->_players.push_back(other._players[i]->clone());
+        }
+    }
+}
@@ -23,6 +23,7 @@ enum ruleset_type {
     freestyle,
     swap2,
     swap_after_first_move,
+    renju,
     uninitialized
 };
 
@@ -72,15 +73,21 @@ public:
     bool is_tied() const;
     bool is_allowed_to_play_now(player* player) const;
     int get_starting_player_idx() const;
+    int get_current_player_idx() const;
     std::vector<player*>& get_players();
+    const std::vector<player*>& get_players() const;
     int get_turn_number() const;
     std::vector<std::vector<field_type>> get_playing_board() const;
+    unsigned int get_board_size() const;
     ruleset_type get_opening_rules() const;
     bool get_swap_next_turn() const;
     swap_decision_type get_swap_decision() const;
 
     player* get_current_player() const;
 
+    // returns the fields on which the current player must not place a stone (only black under the renju ruleset)
+    std::vector<std::pair<unsigned int, unsigned int>> get_forbidden_fields() const;
+
     // for deserialization of swap_decision
     static const std::unordered_map<std::string, swap_decision_type> _string_to_swap_decision_type;
     // for serialization of swap_decision
@@ -98,11 +105,19 @@ public:
     bool prepare_game(player* player, std::string& err);
     bool start_game(std::string& err);
     bool set_game_mode(const std::string& rule_name, std::string& err);
+    bool set_board_size(unsigned int board_size, std::string& err);
 
     //// start of round functions
     void setup_round(std::string& err);
 
-    //// in-round functionalities
+    //// end of round functions
+    bool switch_starting_player(std::string& err);
+    void wrap_up_round(std::string& err);
+
+#endif
+
+    // in-round state update functions, used by the server and by the client to apply its own moves before
+    // the server confirms them
     bool place_stone(unsigned int x, unsigned int y, field_type colour, std::string& err);
     bool check_win_condition(unsigned int x, unsigned int y, int colour);
     bool check_for_tie();
@@ -113,14 +128,16 @@ public:
     bool execute_swap(std::string& err);
     void iterate_turn();
 
-    //// end of round functions
-    bool switch_starting_player(std::string& err);
-    void wrap_up_round(std::string& err);
-
-#endif
-
 // serializable interface
     static game_state* from_json(const rapidjson::Value& json);
+    // Updates this state in place to the state serialized in 'json', reusing the board, the players and all values.
+    // The whole json is validated first, so the state is left unchanged if it throws a gomoku_exception. Players that
+    // are no longer part of the state are deleted, so this is only meant for states created by from_json, which own
+    // their players.
+    void update_from_json(const rapidjson::Value& json);
+    // Updates this state in place to a copy of 'other', reusing the board, the players and all values like
+    // update_from_json, but without going through json.
+    void copy_from(const game_state& other);
     virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
 
 };
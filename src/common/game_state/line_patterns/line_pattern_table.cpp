@@ -0,0 +1,129 @@
+#include "line_pattern_table.h"
+
+namespace {
+
+    constexpr std::uint8_t cell_empty = line_pattern_table::CELL_EMPTY;
+    constexpr std::uint8_t cell_own = line_pattern_table::CELL_OWN;
+
+    constexpr int window_size = 2 * line_pattern_table::WINDOW_RADIUS + 1;
+    constexpr int centre = line_pattern_table::WINDOW_RADIUS;
+    constexpr unsigned int num_windows = line_pattern_table::NUM_WINDOWS;
+
+    using window_type = std::array<std::uint8_t, window_size>;
+
+    // value of the base-3 digit of each window field, the centre is not part of the index
+    constexpr std::array<unsigned int, window_size> digit = {
+            line_pattern_table::digit(-4), line_pattern_table::digit(-3), line_pattern_table::digit(-2),
+            line_pattern_table::digit(-1), 0, line_pattern_table::digit(1), line_pattern_table::digit(2),
+            line_pattern_table::digit(3), line_pattern_table::digit(4)};
+
+    constexpr window_type decode_window(unsigned int idx) {
+        window_type window{};
+        for (int i = 0; i < window_size; ++i) {
+            if (i == centre) {
+                window[i] = cell_own;
+            } else {
+                window[i] = static_cast<std::uint8_t>(idx % 3);
+                idx /= 3;
+            }
+        }
+        return window;
+    }
+
+    constexpr unsigned int run_through_centre(const window_type& window) {
+        unsigned int length = 1;
+        for (int i = centre - 1; i >= 0 && window[i] == cell_own; --i) {
+            ++length;
+        }
+        for (int i = centre + 1; i < window_size && window[i] == cell_own; ++i) {
+            ++length;
+        }
+        return length;
+    }
+
+    // Classifies all windows in three passes. Each pass only looks up windows with one more own stone, whose
+    // classification is already final for the patterns that pass is interested in.
+    constexpr std::array<line_pattern, num_windows> build_window_table() {
+        std::array<line_pattern, num_windows> table{};
+
+        // fives and fours
+        for (unsigned int idx = 0; idx < num_windows; ++idx) {
+            window_type window = decode_window(idx);
+            if (run_through_centre(window) >= 5) {
+                table[idx] = pattern_five;
+                continue;
+            }
+            unsigned int num_completions = 0;
+            for (int i = 0; i < window_size; ++i) {
+                if (window[i] == cell_empty) {
+                    window[i] = cell_own;
+                    if (run_through_centre(window) >= 5) {
+                        ++num_completions;
+                    }
+                    window[i] = cell_empty;
+                }
+            }
+            table[idx] = num_completions >= 2 ? pattern_open_four : (num_completions == 1 ? pattern_four : no_pattern);
+        }
+
+        // threes become a four with one more stone, twos become a three
+        constexpr std::array<std::array<line_pattern, 4>, 2> passes = {{
+                {pattern_open_four, pattern_four, pattern_open_three, pattern_three},
+                {pattern_open_three, pattern_three, pattern_open_two, pattern_two},
+        }};
+        for (const std::array<line_pattern, 4>& pass : passes) {
+            for (unsigned int idx = 0; idx < num_windows; ++idx) {
+                if (table[idx] != no_pattern) {
+                    continue;
+                }
+                window_type window = decode_window(idx);
+                for (int i = 0; i < window_size; ++i) {
+                    if (window[i] != cell_empty) {
+                        continue;
+                    }
+                    line_pattern next = table[idx + digit[i]];
+                    if (next == pass[0]) {
+                        table[idx] = pass[2];
+                        break;
+                    }
+                    if (next == pass[1]) {
+                        table[idx] = pass[3];
+                    }
+                }
+            }
+        }
+        return table;
+    }
+
+    constexpr std::array<line_pattern, num_windows> window_table = build_window_table();
+
+    // window index of the given fields (offsets -4..4 without the centre)
+    constexpr std::uint16_t make_index(std::array<std::uint16_t, 8> fields) {
+        std::uint16_t idx = 0;
+        for (int offset = -line_pattern_table::WINDOW_RADIUS; offset <= line_pattern_table::WINDOW_RADIUS; ++offset) {
+            if (offset != 0) {
+                idx += fields[offset < 0 ? offset + 4 : offset + 3] * line_pattern_table::digit(offset);
+            }
+        }
+        return idx;
+    }
+
+    constexpr std::uint16_t e = line_pattern_table::CELL_EMPTY;
+    constexpr std::uint16_t x = line_pattern_table::CELL_OWN;
+    constexpr std::uint16_t o = line_pattern_table::CELL_BLOCKED;
+
+    static_assert(window_table[make_index({e, x, x, x, x, e, e, e})] == pattern_five);
+    static_assert(window_table[make_index({x, x, x, x, x, x, x, x})] == pattern_five);
+    static_assert(window_table[make_index({e, e, e, x, x, x, e, e})] == pattern_open_four);
+    static_assert(window_table[make_index({e, x, e, x, x, e, x, e})] == pattern_open_four);
+    static_assert(window_table[make_index({e, e, o, x, x, x, e, e})] == pattern_four);
+    static_assert(window_table[make_index({e, e, e, x, x, e, e, e})] == pattern_open_three);
+    static_assert(window_table[make_index({e, e, x, e, x, e, e, e})] == pattern_open_three);
+    static_assert(window_table[make_index({o, o, o, x, x, e, e, e})] == pattern_three);
+    static_assert(window_table[make_index({e, e, e, x, e, e, e, e})] == pattern_open_two);
+    static_assert(window_table[make_index({e, e, o, x, e, e, e, e})] == pattern_two);
+    static_assert(window_table[make_index({e, e, e, o, o, e, e, e})] == no_pattern);
+    static_assert(window_table[make_index({e, e, o, x, o, e, e, e})] == no_pattern);
+}
+
+const std::array<line_pattern, line_pattern_table::NUM_WINDOWS> line_pattern_table::_table = window_table;
@@ -0,0 +1,54 @@
+// The line_pattern_table classifies the line through a field in one direction, as seen by one colour. The 8 fields
+// within a distance of 4 on that line are packed into a window index with one base-3 digit per field: empty, own
+// stone, or blocked (by a stone of the opponent or the edge of the board). For every window the table stores the
+// pattern that a stone of that colour forms on the line. The table is computed at compile time.
+
+#ifndef GOMOKU_LINE_PATTERN_TABLE_H
+#define GOMOKU_LINE_PATTERN_TABLE_H
+
+#include <array>
+#include <cstdint>
+
+// ordered by strength
+enum line_pattern : std::uint8_t {
+    no_pattern,
+    pattern_two,        // one more stone makes a three
+    pattern_open_two,   // one more stone makes an open three
+    pattern_three,      // one more stone makes a four
+    pattern_open_three, // one more stone makes an open four
+    pattern_four,       // one more stone makes a five
+    pattern_open_four,  // two different stones make a five
+    pattern_five,       // five or more stones in a row
+};
+
+class line_pattern_table {
+
+public:
+    static constexpr unsigned int NUM_LINE_PATTERNS = 8;
+    static constexpr int WINDOW_RADIUS = 4;
+    static constexpr unsigned int NUM_WINDOWS = 6561; // 3^8
+
+    static constexpr std::uint16_t CELL_EMPTY = 0;
+    static constexpr std::uint16_t CELL_OWN = 1;
+    static constexpr std::uint16_t CELL_BLOCKED = 2;
+
+    // value of the base-3 digit of the field at 'offset' (-4..-1 and 1..4) from the centre
+    static constexpr std::uint16_t digit(int offset) {
+        int position = offset < 0 ? offset + WINDOW_RADIUS : offset + WINDOW_RADIUS - 1;
+        std::uint16_t value = 1;
+        for (int i = 0; i < position; ++i) {
+            value *= 3;
+        }
+        return value;
+    }
+
+    static line_pattern get_pattern(std::uint16_t window_index) {
+        return _table[window_index];
+    }
+
+private:
+    static const std::array<line_pattern, NUM_WINDOWS> _table;
+};
+
+
+#endif //GOMOKU_LINE_PATTERN_TABLE_H
@@ -0,0 +1,171 @@
+#include "pattern_board.h"
+
+#include <algorithm>
+
+#include "../../exceptions/gomoku_exception.h"
+
+const std::array<int, line_pattern_table::NUM_LINE_PATTERNS> pattern_board::_pattern_scores = {
+        0,      // no_pattern
+        1,      // pattern_two
+        4,      // pattern_open_two
+        6,      // pattern_three
+        30,     // pattern_open_three
+        40,     // pattern_four
+        300,    // pattern_open_four
+        5000,   // pattern_five
+};
+
+namespace {
+    // index of black and white in the per-colour arrays
+    unsigned int colour_index(field_type colour) {
+        return colour == field_type::black_stone ? 0 : 1;
+    }
+}
+
+pattern_board::pattern_board(unsigned int board_size) {
+    if (!playing_board::is_supported_board_size(board_size)) {
+        throw gomoku_exception("Unsupported board size " + std::to_string(board_size));
+    }
+    _board_size = board_size;
+    _num_stones = 0;
+    _fields = std::vector<field_type>(board_size * board_size, field_type::empty);
+    _windows = std::vector<std::array<std::uint16_t, 2>>(board_size * board_size * NUM_DIRECTIONS, {0, 0});
+    _pattern_counts = {};
+
+    // fields outside of the board block the line for both colours
+    const int size = int(board_size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            for (unsigned int direction = 0; direction < NUM_DIRECTIONS; ++direction) {
+                std::array<std::uint16_t, 2>& window = _windows[(y * size + x) * NUM_DIRECTIONS + direction];
+                for (int offset = -line_pattern_table::WINDOW_RADIUS; offset <= line_pattern_table::WINDOW_RADIUS; ++offset) {
+                    int neighbour_x = x + offset * direction_x[direction];
+                    int neighbour_y = y + offset * direction_y[direction];
+                    if (offset != 0 && (neighbour_x < 0 || neighbour_x >= size || neighbour_y < 0 || neighbour_y >= size)) {
+                        window[0] += line_pattern_table::CELL_BLOCKED * line_pattern_table::digit(offset);
+                        window[1] += line_pattern_table::CELL_BLOCKED * line_pattern_table::digit(offset);
+                    }
+                }
+                count_patterns((y * size + x) * NUM_DIRECTIONS + direction, 1);
+            }
+        }
+    }
+}
+
+pattern_board::pattern_board(const playing_board& board) : pattern_board(board.get_board_size()) {
+    for (unsigned int y = 0; y < _board_size; ++y) {
+        for (unsigned int x = 0; x < _board_size; ++x) {
+            field_type field = board.get_field(x, y);
+            if (field != field_type::empty) {
+                place_stone(x, y, field);
+            }
+        }
+    }
+}
+
+// adds (sign = 1) or removes (sign = -1) the patterns of one window to the pattern counts
+void pattern_board::count_patterns(unsigned int window, int sign) {
+    _pattern_counts[0][line_pattern_table::get_pattern(_windows[window][0])] += sign;
+    _pattern_counts[1][line_pattern_table::get_pattern(_windows[window][1])] += sign;
+}
+
+// Adds (sign = 1) or removes (sign = -1) a stone on (x, y) in the windows of all fields whose lines contain it.
+// The patterns of empty fields are recounted, occupied fields do not contribute to the pattern counts.
+void pattern_board::update_windows(unsigned int x, unsigned int y, field_type colour, int sign) {
+    const int size = int(_board_size);
+    const std::uint16_t black_cell = colour == field_type::black_stone ? line_pattern_table::CELL_OWN : line_pattern_table::CELL_BLOCKED;
+    const std::uint16_t white_cell = colour == field_type::white_stone ? line_pattern_table::CELL_OWN : line_pattern_table::CELL_BLOCKED;
+    for (unsigned int direction = 0; direction < NUM_DIRECTIONS; ++direction) {
+        for (int distance = -line_pattern_table::WINDOW_RADIUS; distance <= line_pattern_table::WINDOW_RADIUS; ++distance) {
+            int field_x = int(x) + distance * direction_x[direction];
+            int field_y = int(y) + distance * direction_y[direction];
+            if (distance == 0 || field_x < 0 || field_x >= size || field_y < 0 || field_y >= size) {
+                continue;
+            }
+            // the stone is at offset -distance as seen from that field
+            const unsigned int window = (field_y * size + field_x) * NUM_DIRECTIONS + direction;
+            const bool counted = _fields[field_y * size + field_x] == field_type::empty;
+            if (counted) {
+                count_patterns(window, -1);
+            }
+            _windows[window][0] += sign * black_cell * line_pattern_table::digit(-distance);
+            _windows[window][1] += sign * white_cell * line_pattern_table::digit(-distance);
+            if (counted) {
+                count_patterns(window, 1);
+            }
+        }
+    }
+}
+
+bool pattern_board::place_stone(unsigned int x, unsigned int y, field_type colour) {
+    if (x >= _board_size || y >= _board_size || colour == field_type::empty || _fields[y * _board_size + x] != field_type::empty) {
+        return false;
+    }
+    for (unsigned int direction = 0; direction < NUM_DIRECTIONS; ++direction) {
+        count_patterns((y * _board_size + x) * NUM_DIRECTIONS + direction, -1);
+    }
+    _fields[y * _board_size + x] = colour;
+    update_windows(x, y, colour, 1);
+    ++_num_stones;
+    return true;
+}
+
+bool pattern_board::undo_stone(unsigned int x, unsigned int y) {
+    if (x >= _board_size || y >= _board_size || _fields[y * _board_size + x] == field_type::empty) {
+        return false;
+    }
+    field_type colour = _fields[y * _board_size + x];
+    _fields[y * _board_size + x] = field_type::empty;
+    update_windows(x, y, colour, -1);
+    for (unsigned int direction = 0; direction < NUM_DIRECTIONS; ++direction) {
+        count_patterns((y * _board_size + x) * NUM_DIRECTIONS + direction, 1);
+    }
+    --_num_stones;
+    return true;
+}
+
+line_pattern pattern_board::get_pattern(unsigned int x, unsigned int y, unsigned int direction, field_type colour) const {
+    if (x >= _board_size || y >= _board_size || direction >= NUM_DIRECTIONS || colour == field_type::empty) {
+        throw gomoku_exception("Field coordinates are outside of board dimensions, or invalid direction or colour.");
+    }
+    if (_fields[y * _board_size + x] != field_type::empty) {
+        return no_pattern;
+    }
+    return line_pattern_table::get_pattern(_windows[(y * _board_size + x) * NUM_DIRECTIONS + direction][colour_index(colour)]);
+}
+
+line_pattern pattern_board::get_best_pattern(unsigned int x, unsigned int y, field_type colour) const {
+    line_pattern best = no_pattern;
+    for (unsigned int direction = 0; direction < NUM_DIRECTIONS; ++direction) {
+        best = std::max(best, get_pattern(x, y, direction, colour));
+    }
+    return best;
+}
+
+unsigned int pattern_board::get_pattern_count(field_type colour, line_pattern pattern) const {
+    return _pattern_counts[colour_index(colour)][pattern];
+}
+
+int pattern_board::evaluate(field_type colour) const {
+    int score = 0;
+    for (unsigned int pattern = 1; pattern < line_pattern_table::NUM_LINE_PATTERNS; ++pattern) {
+        score += int(_pattern_counts[0][pattern]) * _pattern_scores[pattern];
+        score -= int(_pattern_counts[1][pattern]) * _pattern_scores[pattern];
+    }
+    return colour == field_type::black_stone ? score : -score;
+}
+
+field_type pattern_board::get_field(unsigned int x, unsigned int y) const {
+    if (x >= _board_size || y >= _board_size) {
+        throw gomoku_exception("Field coordinates are outside of board dimensions.");
+    }
+    return _fields[y * _board_size + x];
+}
+
+unsigned int pattern_board::get_board_size() const {
+    return _board_size;
+}
+
+unsigned int pattern_board::get_num_stones() const {
+    return _num_stones;
+}
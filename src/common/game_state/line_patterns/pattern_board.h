@@ -0,0 +1,68 @@
+// The pattern_board is a board for search and evaluation. For every empty field and line direction it keeps the
+// window index of the surrounding line for both colours, and counts how many (field, direction) pairs would form
+// each line_pattern if black or white played there. Placing or undoing a stone only updates the 32 windows that
+// contain it, so threats and the evaluation of a position are available in O(1) after every move.
+// It is final, so that the mcts_engine, which uses it directly, calls it without going through the vtable.
+
+#ifndef GOMOKU_PATTERN_BOARD_H
+#define GOMOKU_PATTERN_BOARD_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "line_pattern_table.h"
+#include "../evaluation/position_evaluator.h"
+#include "../playing_board/playing_board.h"
+
+class pattern_board final : public position_evaluator {
+
+public:
+    static constexpr unsigned int NUM_DIRECTIONS = 4;
+
+private:
+    unsigned int _board_size;
+    unsigned int _num_stones;
+    // fields in row-major order, like in playing_board
+    std::vector<field_type> _fields;
+    // window index for black and white of every field and direction, at (y * _board_size + x) * 4 + direction
+    std::vector<std::array<std::uint16_t, 2>> _windows;
+    // number of (empty field, direction) pairs on which black/white would form each pattern
+    std::array<std::array<unsigned int, line_pattern_table::NUM_LINE_PATTERNS>, 2> _pattern_counts;
+
+    void count_patterns(unsigned int window, int sign);
+    void update_windows(unsigned int x, unsigned int y, field_type colour, int sign);
+
+public:
+    explicit pattern_board(unsigned int board_size = playing_board::_playing_board_size);
+    explicit pattern_board(const playing_board& board);
+
+    // the four line directions: horizontal, vertical and both diagonals
+    static constexpr std::array<int, NUM_DIRECTIONS> direction_x = {1, 0, 1, 1};
+    static constexpr std::array<int, NUM_DIRECTIONS> direction_y = {0, 1, 1, -1};
+
+    // pattern values used by evaluate()
+    static const std::array<int, line_pattern_table::NUM_LINE_PATTERNS> _pattern_scores;
+
+    // Both return false without changing the board if the move is not possible. undo_stone() must be called in
+    // reverse order of place_stone() to restore the previous position.
+    bool place_stone(unsigned int x, unsigned int y, field_type colour) override;
+    bool undo_stone(unsigned int x, unsigned int y) override;
+
+    // pattern that 'colour' would form on the line through the empty field (x, y), no_pattern for occupied fields
+    line_pattern get_pattern(unsigned int x, unsigned int y, unsigned int direction, field_type colour) const;
+    // strongest pattern over all four directions
+    line_pattern get_best_pattern(unsigned int x, unsigned int y, field_type colour) const;
+    unsigned int get_pattern_count(field_type colour, line_pattern pattern) const;
+
+    // Static evaluation from the point of view of 'colour', computed from the pattern counts of both colours.
+    int evaluate(field_type colour) const override;
+
+// accessors
+    field_type get_field(unsigned int x, unsigned int y) const;
+    unsigned int get_board_size() const override;
+    unsigned int get_num_stones() const;
+};
+
+
+#endif //GOMOKU_PATTERN_BOARD_H
@@ -0,0 +1,726 @@
+#include "mcts_engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+#include "../position_hash/position_hash.h"
+#include "../../exceptions/gomoku_exception.h"
+
+namespace {
+    const std::array<swap_decision_type, 3> swap_decisions = {do_swap, do_not_swap, defer_swap};
+
+    // number of fields among which a playout chooses its move, and how often it draws again after a forbidden move
+    constexpr unsigned int playout_sample_size = 6;
+    constexpr unsigned int max_playout_attempts = 8;
+
+    // The empty fields next to a stone, from which the playouts draw their moves. Fields that get occupied are only
+    // removed when they are drawn.
+    struct neighbour_fields {
+        std::vector<std::uint16_t> fields;
+        std::vector<bool> contains;
+
+        void reset(const search_position& position) {
+            const unsigned int board_size = position.get_board_size();
+            fields.clear();
+            contains.assign(board_size * board_size, false);
+            if (position.get_num_stones() == 0) {
+                const unsigned int centre = (board_size / 2) * board_size + board_size / 2;
+                fields.push_back(centre);
+                contains[centre] = true;
+                return;
+            }
+            for (unsigned int field = 0; field < board_size * board_size; ++field) {
+                if (position.get_fields()[field] != field_type::empty) {
+                    add(position, field);
+                }
+            }
+        }
+
+        // adds the empty fields around the stone on 'field'
+        void add(const search_position& position, unsigned int field) {
+            const int board_size = int(position.get_board_size());
+            const int x = int(field) % board_size;
+            const int y = int(field) / board_size;
+            for (int neighbour_y = std::max(0, y - 1); neighbour_y <= std::min(board_size - 1, y + 1); ++neighbour_y) {
+                for (int neighbour_x = std::max(0, x - 1); neighbour_x <= std::min(board_size - 1, x + 1); ++neighbour_x) {
+                    const unsigned int neighbour = neighbour_y * board_size + neighbour_x;
+                    if (!contains[neighbour] && position.get_fields()[neighbour] == field_type::empty) {
+                        contains[neighbour] = true;
+                        fields.push_back(neighbour);
+                    }
+                }
+            }
+        }
+
+        // draws a random empty field, returns false if there is none left
+        bool draw(const field_type* board, std::mt19937& rng, std::uint16_t& field) {
+            while (!fields.empty()) {
+                const size_t index = rng() % fields.size();
+                field = fields[index];
+                if (board[field] == field_type::empty) {
+                    return true;
+                }
+                contains[field] = false;
+                fields[index] = fields.back();
+                fields.pop_back();
+            }
+            return false;
+        }
+    };
+
+    field_type get_opponent_colour(field_type colour) {
+        return colour == field_type::black_stone ? field_type::white_stone : field_type::black_stone;
+    }
+
+    pattern_board create_pattern_board(const search_position& position) {
+        pattern_board board(position.get_board_size());
+        for (unsigned int y = 0; y < position.get_board_size(); ++y) {
+            for (unsigned int x = 0; x < position.get_board_size(); ++x) {
+                if (position.get_field(x, y) != field_type::empty) {
+                    board.place_stone(x, y, position.get_field(x, y));
+                }
+            }
+        }
+        return board;
+    }
+}
+
+
+mcts_settings mcts_engine::get_settings(bot_difficulty difficulty) {
+    std::random_device seed;
+    switch (difficulty) {
+        case easy_bot:
+            // few playouts and more exploration make the bot miss longer threats
+            return {std::chrono::milliseconds(150), 2000, 1, 3.0f, 3, 1u << 16, seed()};
+        case medium_bot:
+            return {std::chrono::milliseconds(750), 0, 2, 1.5f, 3, 1u << 18, seed()};
+        case hard_bot:
+        default:
+            return {std::chrono::milliseconds(3000), 0, 0, 1.2f, 3, 1u << 20, seed()};
+    }
+}
+
+
+mcts_engine::mcts_engine(const mcts_settings& settings) :
+        _settings(settings),
+        _num_nodes(0),
+        _num_playouts(0),
+        _is_stopped(false),
+        _num_reused_playouts(0),
+        _is_cancelled(nullptr)
+{ }
+
+void mcts_engine::set_opening_book(std::shared_ptr<const opening_book> book) {
+    _opening_book = std::move(book);
+}
+
+void mcts_engine::set_position_database(std::shared_ptr<const position_database> database) {
+    _position_database = std::move(database);
+}
+
+void mcts_engine::set_num_threads(unsigned int num_threads) {
+    _settings.num_threads = num_threads;
+}
+
+
+bool mcts_engine::apply_move(search_position& position, pattern_board& board, const search_move& move) {
+    const field_type colour = position.get_current_colour();
+    if (!position.apply_move(move)) {
+        return false;
+    }
+    if (move.type == search_move_type::stone_move) {
+        board.place_stone(move.x, move.y, colour);
+    }
+    return true;
+}
+
+void mcts_engine::undo_move(search_position& position, pattern_board& board) {
+    const search_move move = position.get_last_move();
+    position.undo_move();
+    if (move.type == search_move_type::stone_move) {
+        board.undo_stone(move.x, move.y);
+    }
+}
+
+int mcts_engine::get_winner(const search_position& position) {
+    if (!position.is_finished() || position.is_tied()) {
+        return no_winner;
+    }
+    // the current player does not change after the winning stone
+    return int(position.get_current_player_idx());
+}
+
+
+void mcts_engine::generate_candidates(const search_position& position, const pattern_board& board,
+                                      const move_generator& generator, std::vector<candidate>& candidates) {
+    candidates.clear();
+    if (position.get_swap_next_turn()) {
+        for (swap_decision_type decision : swap_decisions) {
+            if (position.is_legal(search_move::swap(decision))) {
+                candidates.push_back({search_move::swap(decision), 1.0f});
+            }
+        }
+        return;
+    }
+
+    const unsigned int board_size = position.get_board_size();
+    if (position.get_num_stones() == 0) {
+        candidates.push_back({search_move::stone(board_size / 2, board_size / 2), 1.0f});
+        return;
+    }
+
+    const field_type colour = position.get_current_colour();
+    const field_type opponent = get_opponent_colour(colour);
+    const bool can_win = board.get_pattern_count(colour, line_pattern::pattern_five) > 0;
+    const bool must_block = board.get_pattern_count(opponent, line_pattern::pattern_five) > 0;
+    // fives are completed and blocked next to a stone, all other patterns worth playing are close to the stones
+    move_generator::move_list moves;
+    generator.generate(move_generator::max_distance, moves);
+    for (unsigned int i = 0; i < moves.size; ++i) {
+        const unsigned int x = moves.moves[i].field % board_size;
+        const unsigned int y = moves.moves[i].field / board_size;
+        const line_pattern own = board.get_best_pattern(x, y, colour);
+        if (can_win && own == line_pattern::pattern_five && position.is_legal(search_move::stone(x, y))) {
+            candidates.clear();
+            candidates.push_back({search_move::stone(x, y), 1.0f});
+            return;
+        }
+        const line_pattern blocked = board.get_best_pattern(x, y, opponent);
+        if (must_block) {
+            if (blocked == line_pattern::pattern_five) {
+                candidates.push_back({search_move::stone(x, y), 1.0f});
+            }
+        } else if (own != line_pattern::no_pattern || blocked != line_pattern::no_pattern) {
+            candidates.push_back({search_move::stone(x, y), move_generator::own_pattern_weights[own]
+                                                            + move_generator::opponent_pattern_weights[blocked]});
+        }
+    }
+
+    if (candidates.empty()) {
+        const field_type* fields = position.get_fields();
+        // no field near the stones, e.g. because they are all blocked: every empty field is equally good
+        for (unsigned int field = 0; field < board_size * board_size; ++field) {
+            if (fields[field] == field_type::empty) {
+                candidates.push_back({search_move::stone(field % board_size, field / board_size), 1.0f});
+            }
+        }
+    }
+}
+
+
+int mcts_engine::playout(search_position& position, pattern_board& board, std::mt19937& rng) {
+    thread_local neighbour_fields neighbours;
+    neighbours.reset(position);
+    const field_type* fields = position.get_fields();
+    unsigned int num_applied_moves = 0;
+
+    while (!position.is_finished()) {
+        if (position.get_swap_next_turn()) {
+            search_move swap = search_move::swap(swap_decisions[rng() % swap_decisions.size()]);
+            if (!apply_move(position, board, swap)) {
+                break;
+            }
+            ++num_applied_moves;
+            continue;
+        }
+
+        const field_type colour = position.get_current_colour();
+        const field_type opponent = get_opponent_colour(colour);
+        bool is_applied = false;
+        unsigned int field = 0;
+
+        // a five is completed and a five of the opponent is blocked. Both fields are next to a stone.
+        if (board.get_pattern_count(colour, line_pattern::pattern_five) > 0
+            || board.get_pattern_count(opponent, line_pattern::pattern_five) > 0) {
+            int forced_field = -1;
+            for (std::uint16_t neighbour : neighbours.fields) {
+                if (fields[neighbour] != field_type::empty) {
+                    continue;
+                }
+                const unsigned int x = neighbour % position.get_board_size();
+                const unsigned int y = neighbour / position.get_board_size();
+                if (board.get_best_pattern(x, y, colour) == line_pattern::pattern_five) {
+                    forced_field = neighbour;
+                    break;
+                }
+                if (board.get_best_pattern(x, y, opponent) == line_pattern::pattern_five) {
+                    forced_field = neighbour;
+                }
+            }
+            if (forced_field >= 0) {
+                field = forced_field;
+                is_applied = apply_move(position, board, search_move::stone(field % position.get_board_size(),
+                                                                            field / position.get_board_size()));
+            }
+        }
+
+        // otherwise a few fields next to the stones are drawn and one of them is chosen by the patterns it forms
+        for (unsigned int attempt = 0; attempt < max_playout_attempts && !is_applied; ++attempt) {
+            std::array<std::uint16_t, playout_sample_size> sample;
+            std::array<float, playout_sample_size> weights;
+            unsigned int sample_size = 0;
+            float total_weight = 0;
+            for (; sample_size < playout_sample_size; ++sample_size) {
+                if (!neighbours.draw(fields, rng, sample[sample_size])) {
+                    break;
+                }
+                const unsigned int x = sample[sample_size] % position.get_board_size();
+                const unsigned int y = sample[sample_size] / position.get_board_size();
+                weights[sample_size] = 1 + move_generator::own_pattern_weights[board.get_best_pattern(x, y, colour)]
+                                         + move_generator::opponent_pattern_weights[board.get_best_pattern(x, y, opponent)];
+                total_weight += weights[sample_size];
+            }
+            if (sample_size == 0) {
+                break;
+            }
+            float target = std::uniform_real_distribution<float>(0, total_weight)(rng);
+            unsigned int chosen = 0;
+            while (chosen + 1 < sample_size && target >= weights[chosen]) {
+                target -= weights[chosen];
+                ++chosen;
+            }
+            // forbidden moves are only detected here, checking every field in advance would be too slow
+            field = sample[chosen];
+            is_applied = apply_move(position, board, search_move::stone(field % position.get_board_size(),
+                                                                        field / position.get_board_size()));
+        }
+        if (!is_applied) {
+            break;  // no allowed field was found, which counts as a tie
+        }
+        neighbours.add(position, field);
+        ++num_applied_moves;
+    }
+
+    const int winner = get_winner(position);
+    for (; num_applied_moves > 0; --num_applied_moves) {
+        undo_move(position, board);
+    }
+    return winner;
+}
+
+
+void mcts_engine::remove_symmetric_moves(const search_position& position, std::vector<candidate>& candidates) {
+    const unsigned int board_size = position.get_board_size();
+    const position_hash::symmetry_table& table = position_hash::get_symmetry_table(board_size);
+    const position_hash::symmetric_hashes& stone_hashes = position.get_stone_hashes();
+    const field_type* fields = position.get_fields();
+
+    // the symmetries that leave the stones where they are, the hashes rule out all others quickly
+    std::vector<unsigned int> symmetries;
+    for (unsigned int symmetry = 1; symmetry < position_hash::num_symmetries; ++symmetry) {
+        if (stone_hashes[symmetry] != stone_hashes[0]) {
+            continue;
+        }
+        bool is_symmetric = true;
+        for (unsigned int field = 0; field < board_size * board_size && is_symmetric; ++field) {
+            is_symmetric = fields[table.transform(symmetry, field)] == fields[field];
+        }
+        if (is_symmetric) {
+            symmetries.push_back(symmetry);
+        }
+    }
+    if (symmetries.empty()) {
+        return;
+    }
+
+    std::vector<bool> is_kept(board_size * board_size, false);
+    std::erase_if(candidates, [&](const candidate& c) {
+        if (c.move.type != search_move_type::stone_move) {
+            return false;
+        }
+        const unsigned int field = c.move.y * board_size + c.move.x;
+        for (unsigned int symmetry : symmetries) {
+            if (is_kept[table.transform(symmetry, field)]) {
+                return true;
+            }
+        }
+        is_kept[field] = true;
+        return false;
+    });
+}
+
+bool mcts_engine::try_expand(node& parent, const search_position& position, const pattern_board& board,
+                             const move_generator& generator,
+                             std::vector<candidate>& candidates) {
+    std::uint8_t state = expansion_state::unexpanded;
+    if (!parent.expansion.compare_exchange_strong(state, expansion_state::expanding, std::memory_order_acquire)) {
+        return false;   // another thread is faster
+    }
+
+    generate_candidates(position, board, generator, candidates);
+    // the tree only contains legal moves, so that the threads never have to check them again
+    std::erase_if(candidates, [&position](const candidate& c) { return !position.is_legal(c.move); });
+    // symmetric positions mostly occur in the opening, close to the root
+    if (&parent == &_nodes[0]) {
+        remove_symmetric_moves(position, candidates);
+    }
+
+    // reserve the children in the pool
+    const std::uint32_t num_children = candidates.size();
+    std::uint32_t first_child = _num_nodes.load(std::memory_order_relaxed);
+    do {
+        if (num_children == 0 || first_child + num_children > _settings.max_nodes) {
+            parent.expansion.store(expansion_state::leaf_only, std::memory_order_release);
+            return false;
+        }
+    } while (!_num_nodes.compare_exchange_weak(first_child, first_child + num_children, std::memory_order_relaxed));
+
+    float total_weight = 0;
+    for (const candidate& c : candidates) {
+        total_weight += c.weight;
+    }
+    const std::uint8_t mover_idx = position.get_current_player_idx();
+    for (std::uint32_t i = 0; i < num_children; ++i) {
+        node& child = _nodes[first_child + i];
+        child.move = candidates[i].move;
+        child.prior = candidates[i].weight / total_weight;
+        child.mover_idx = mover_idx;
+    }
+    parent.first_child.store(first_child, std::memory_order_relaxed);
+    parent.num_children.store(num_children, std::memory_order_relaxed);
+    // publishes the children to the other threads
+    parent.expansion.store(expansion_state::expanded, std::memory_order_release);
+    return true;
+}
+
+mcts_engine::node& mcts_engine::select_child(const node& parent) const {
+    const std::uint32_t first_child = parent.first_child.load(std::memory_order_relaxed);
+    const std::uint16_t num_children = parent.num_children.load(std::memory_order_relaxed);
+    const float exploration = _settings.exploration * std::sqrt(float(parent.visits.load(std::memory_order_relaxed)
+                                                                      + parent.virtual_losses.load(std::memory_order_relaxed) + 1));
+    node* best_child = &_nodes[first_child];
+    float best_score = -1;
+    for (std::uint32_t i = first_child; i < first_child + num_children; ++i) {
+        node& child = _nodes[i];
+        // virtual losses count as visits without points
+        const std::uint32_t visits = child.visits.load(std::memory_order_relaxed)
+                                     + child.virtual_losses.load(std::memory_order_relaxed);
+        const float value = visits == 0 ? 0.5f : float(child.points.load(std::memory_order_relaxed)) / float(2 * visits);
+        const float score = value + exploration * child.prior / float(1 + visits);
+        if (score > best_score) {
+            best_score = score;
+            best_child = &child;
+        }
+    }
+    return *best_child;
+}
+
+
+void mcts_engine::run_worker(search_position position, unsigned int thread_idx, std::chrono::steady_clock::time_point slice_end) {
+    pattern_board board = create_pattern_board(position);
+    // only follows the tree, the playouts take back all their moves
+    move_generator generator(position);
+    // later slices of the same thread continue with different playouts
+    std::mt19937 rng(_settings.seed + thread_idx + 7919 * _num_playouts.load(std::memory_order_relaxed));
+    std::vector<candidate> candidates;
+    std::vector<node*> path;
+    path.reserve(position.get_board_size() * position.get_board_size() + 3);
+
+    while (!_is_stopped.load(std::memory_order_relaxed)
+           && (_is_cancelled == nullptr || !_is_cancelled->load(std::memory_order_relaxed))) {
+        // walk down the tree to a leaf
+        path.clear();
+        node* current = &_nodes[0];
+        path.push_back(current);
+        while (!position.is_finished()) {
+            std::uint8_t state = current->expansion.load(std::memory_order_acquire);
+            if (state == expansion_state::unexpanded) {
+                try_expand(*current, position, board, generator, candidates);
+                break;  // the new leaf is evaluated with a playout
+            }
+            if (state != expansion_state::expanded) {
+                break;
+            }
+            node& child = select_child(*current);
+            child.virtual_losses.fetch_add(_settings.virtual_loss, std::memory_order_relaxed);
+            apply_move(position, board, child.move);
+            if (child.move.type == search_move_type::stone_move) {
+                generator.place_stone(child.move.x, child.move.y);
+            }
+            path.push_back(&child);
+            current = &child;
+        }
+
+        const int winner = position.is_finished() ? get_winner(position) : playout(position, board, rng);
+
+        for (size_t i = 0; i < path.size(); ++i) {
+            node* visited = path[i];
+            if (i > 0) {
+                visited->virtual_losses.fetch_sub(_settings.virtual_loss, std::memory_order_relaxed);
+                undo_move(position, board);
+                if (visited->move.type == search_move_type::stone_move) {
+                    generator.undo_stone(visited->move.x, visited->move.y);
+                }
+            }
+            visited->points.fetch_add(winner == no_winner ? 1 : (winner == visited->mover_idx ? 2 : 0),
+                                      std::memory_order_relaxed);
+            visited->visits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        const std::uint32_t num_playouts = _num_playouts.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (_settings.max_playouts != 0 && num_playouts >= _settings.max_playouts) {
+            _is_stopped.store(true, std::memory_order_relaxed);
+        }
+        if (_settings.time_budget.count() != 0 || slice_end != std::chrono::steady_clock::time_point::max()) {
+            const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            if (now >= _search_deadline) {
+                _is_stopped.store(true, std::memory_order_relaxed);
+            }
+            if (now >= slice_end) {
+                break;
+            }
+        }
+    }
+}
+
+
+mcts_result mcts_engine::search(const search_position& position) {
+    if (position.is_finished()) {
+        throw gomoku_exception("Cannot search for a move in a finished game.");
+    }
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    mcts_result result;
+    if (find_known_move(position, result)) {
+        return result;
+    }
+
+    begin_search(position, false);
+    unsigned int num_threads = _settings.num_threads != 0 ? _settings.num_threads : std::thread::hardware_concurrency();
+    std::vector<std::thread> workers;
+    for (unsigned int thread_idx = 1; thread_idx < num_threads; ++thread_idx) {
+        workers.emplace_back(&mcts_engine::run_worker, this, position, thread_idx, std::chrono::steady_clock::time_point::max());
+    }
+    run_worker(position, 0, std::chrono::steady_clock::time_point::max());
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    result = end_search();
+    result.elapsed = std::chrono::steady_clock::now() - start;
+    return result;
+}
+
+bool mcts_engine::find_known_move(const search_position& position, mcts_result& result) const {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    search_move book_move;
+    if (_opening_book != nullptr) {
+        if (const opening_book::entry* book_entry = _opening_book->lookup(position, book_move)) {
+            result = {book_move, 0, 0, book_entry->get_score(), std::chrono::steady_clock::now() - start, 0};
+            return true;
+        }
+    }
+    position_record known_position;
+    if (_position_database != nullptr && _position_database->find(position, known_position)
+        && known_position.result == position_result::position_won && known_position.plies_to_end <= max_database_plies
+        && position.is_legal(known_position.best_move)) {
+        result = {known_position.best_move, 0, 0, 1.0f, std::chrono::steady_clock::now() - start, 0};
+        return true;
+    }
+    return false;
+}
+
+void mcts_engine::ponder(const search_position& position, const std::atomic<bool>& is_cancelled) {
+    if (position.is_finished()) {
+        return;
+    }
+    begin_search(position, true);
+    _is_cancelled = &is_cancelled;
+    run_worker(position, 0, std::chrono::steady_clock::time_point::max());
+    _is_cancelled = nullptr;
+}
+
+void mcts_engine::begin_search(const search_position& position, bool is_pondering) {
+    if (position.is_finished()) {
+        throw gomoku_exception("Cannot search for a move in a finished game.");
+    }
+    _search_start = std::chrono::steady_clock::now();
+    _search_deadline = is_pondering || _settings.time_budget.count() == 0
+            ? std::chrono::steady_clock::time_point::max() : _search_start + _settings.time_budget;
+    if (!reuse_tree(position)) {
+        reset_tree(position);
+    }
+    _num_reused_playouts = _nodes[0].visits.load();
+    _num_playouts.store(0);
+    _is_stopped.store(false);
+    // the root is expanded up front, so that there is a move even if the time is up before the first playout
+    if (!prepare_root(position)) {
+        throw gomoku_exception("There is no legal move in this position.");
+    }
+}
+
+bool mcts_engine::run_search_slice(const search_position& position, unsigned int thread_idx,
+                                   std::chrono::steady_clock::time_point slice_end) {
+    if (!_is_stopped.load()) {
+        run_worker(position, thread_idx, slice_end);
+    }
+    return _is_stopped.load();
+}
+
+mcts_result mcts_engine::end_search() {
+    // the most visited move is the most reliable one
+    const node& root = _nodes[0];
+    const node* best_child = &_nodes[root.first_child.load()];
+    for (std::uint32_t i = root.first_child.load(); i < root.first_child.load() + root.num_children.load(); ++i) {
+        if (_nodes[i].visits.load() > best_child->visits.load()
+            || (_nodes[i].visits.load() == best_child->visits.load() && _nodes[i].prior > best_child->prior)) {
+            best_child = &_nodes[i];
+        }
+    }
+    const std::uint32_t best_visits = best_child->visits.load();
+    return {best_child->move,
+            _num_playouts.load(),
+            _num_nodes.load(),
+            best_visits == 0 ? 0.5f : float(best_child->points.load()) / float(2 * best_visits),
+            std::chrono::steady_clock::now() - _search_start,
+            _num_reused_playouts};
+}
+
+std::vector<mcts_line> mcts_engine::get_lines(unsigned int nof_lines, unsigned int max_length) const {
+    std::vector<mcts_line> lines;
+    if (_nodes == nullptr || _nodes[0].expansion.load() != expansion_state::expanded) {
+        return lines;
+    }
+    auto get_most_visited_child = [this](const node& parent) -> const node* {
+        if (parent.expansion.load() != expansion_state::expanded || parent.num_children.load() == 0) {
+            return nullptr;
+        }
+        const std::uint32_t first_child = parent.first_child.load();
+        const node* best_child = &_nodes[first_child];
+        for (std::uint32_t i = first_child + 1; i < first_child + parent.num_children.load(); ++i) {
+            if (_nodes[i].visits.load() > best_child->visits.load()) {
+                best_child = &_nodes[i];
+            }
+        }
+        return best_child->visits.load() > 0 ? best_child : nullptr;
+    };
+
+    const node& root = _nodes[0];
+    std::vector<const node*> children;
+    for (std::uint32_t i = root.first_child.load(); i < root.first_child.load() + root.num_children.load(); ++i) {
+        children.push_back(&_nodes[i]);
+    }
+    std::stable_sort(children.begin(), children.end(), [](const node* a, const node* b) {
+        return a->visits.load() > b->visits.load();
+    });
+    children.resize(std::min<std::size_t>(children.size(), nof_lines));
+
+    for (const node* child : children) {
+        const std::uint32_t visits = child->visits.load();
+        mcts_line line = {child->move, visits == 0 ? 0.5f : float(child->points.load()) / float(2 * visits), visits, {}};
+        for (const node* current = child; current != nullptr && line.principal_variation.size() < max_length;
+             current = get_most_visited_child(*current)) {
+            line.principal_variation.push_back(current->move);
+        }
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+void mcts_engine::clear_tree() {
+    _nodes.reset();
+    _tree_position.reset();
+}
+
+
+bool mcts_engine::prepare_root(const search_position& position) {
+    node& root = _nodes[0];
+    if (root.expansion.load() == expansion_state::unexpanded) {
+        std::vector<candidate> candidates;
+        pattern_board board = create_pattern_board(position);
+        try_expand(root, position, board, move_generator(position), candidates);
+    }
+    return root.expansion.load() == expansion_state::expanded && root.num_children.load() > 0;
+}
+
+void mcts_engine::reset_tree(const search_position& position) {
+    _nodes = std::make_unique<node[]>(_settings.max_nodes);
+    _nodes[0].mover_idx = position.get_current_player_idx() == 0 ? 1 : 0;
+    _num_nodes.store(1);
+    _tree_position = position;
+}
+
+bool mcts_engine::reuse_tree(const search_position& position) {
+    if (!_tree_position.has_value() || _nodes == nullptr) {
+        return false;
+    }
+    const std::uint64_t hash = position_hash::get_hash(position);
+    search_position& tree_position = *_tree_position;
+    if (position_hash::get_hash(tree_position) == hash) {
+        return true;
+    }
+
+    // the children of an expanded node are legal moves, so they can be applied without checking them
+    auto find_child = [this, &tree_position, hash](const node& parent, std::uint32_t& found) {
+        if (parent.expansion.load() != expansion_state::expanded) {
+            return false;
+        }
+        const std::uint32_t first_child = parent.first_child.load();
+        for (std::uint32_t i = first_child; i < first_child + parent.num_children.load(); ++i) {
+            tree_position.apply_move(_nodes[i].move);
+            const bool is_found = position_hash::get_hash(tree_position) == hash;
+            tree_position.undo_move();
+            if (is_found) {
+                found = i;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::uint32_t new_root;
+    bool is_found = find_child(_nodes[0], new_root);
+    const node& root = _nodes[0];
+    if (!is_found && root.expansion.load() == expansion_state::expanded) {
+        for (std::uint32_t i = root.first_child.load(); i < root.first_child.load() + root.num_children.load() && !is_found; ++i) {
+            tree_position.apply_move(_nodes[i].move);
+            is_found = find_child(_nodes[i], new_root);
+            tree_position.undo_move();
+        }
+    }
+    if (!is_found) {
+        return false;
+    }
+    compact_tree(new_root);
+    _tree_position = position;
+    return true;
+}
+
+void mcts_engine::compact_tree(std::uint32_t new_root) {
+    std::unique_ptr<node[]> nodes = std::make_unique<node[]>(_settings.max_nodes);
+    auto copy_node = [](const node& from, node& to) {
+        to.move = from.move;
+        to.prior = from.prior;
+        to.mover_idx = from.mover_idx;
+        // nodes that could not be expanded for lack of space can be expanded in the new pool
+        const std::uint8_t state = from.expansion.load(std::memory_order_relaxed);
+        to.expansion.store(state == expansion_state::expanded ? state : std::uint8_t(expansion_state::unexpanded),
+                           std::memory_order_relaxed);
+        to.num_children.store(state == expansion_state::expanded ? from.num_children.load(std::memory_order_relaxed) : 0,
+                              std::memory_order_relaxed);
+        to.visits.store(from.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.points.store(from.points.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    };
+
+    // breadth first, so that the children of a node stay next to each other
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> queue = {{new_root, 0}};   // old and new index
+    copy_node(_nodes[new_root], nodes[0]);
+    std::uint32_t num_nodes = 1;
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        const node& from = _nodes[queue[i].first];
+        node& to = nodes[queue[i].second];
+        if (to.expansion.load(std::memory_order_relaxed) != expansion_state::expanded) {
+            continue;
+        }
+        const std::uint32_t first_child = from.first_child.load(std::memory_order_relaxed);
+        const std::uint32_t num_children = from.num_children.load(std::memory_order_relaxed);
+        to.first_child.store(num_nodes, std::memory_order_relaxed);
+        for (std::uint32_t child = 0; child < num_children; ++child) {
+            copy_node(_nodes[first_child + child], nodes[num_nodes + child]);
+            queue.emplace_back(first_child + child, num_nodes + child);
+        }
+        num_nodes += num_children;
+    }
+    _nodes = std::move(nodes);
+    _num_nodes.store(num_nodes);
+}
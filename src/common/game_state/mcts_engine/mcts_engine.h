@@ -0,0 +1,185 @@
+// The mcts_engine chooses the move of a bot with a Monte Carlo tree search (PUCT) on search_positions.
+// All threads search the same tree: a thread that walks down a node adds a virtual loss to it, so that the other
+// threads prefer different branches, and nodes are expanded without locks by reserving their children in a shared
+// node pool. Leaves are evaluated with playouts that prefer moves forming strong patterns on a pattern_board. The
+// same pattern weights are used as the priors of the children.
+// The tree is kept between searches. When the next search is for a position one or two moves below the root, e.g.
+// after the opponent replied, the subtree of that position is moved to the front of a fresh node pool and the search
+// continues with it. ponder() grows the tree while the opponent thinks, so that the subtree of its reply is ready.
+
+#ifndef GOMOKU_MCTS_ENGINE_H
+#define GOMOKU_MCTS_ENGINE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "../search_position/search_position.h"
+#include "../line_patterns/pattern_board.h"
+#include "../move_generator/move_generator.h"
+#include "../opening_book/opening_book.h"
+#include "../position_database/position_database.h"
+
+enum bot_difficulty {
+    easy_bot,
+    medium_bot,
+    hard_bot,
+};
+
+struct mcts_settings {
+    // the search stops at whichever limit is reached first, 0 disables a limit. At least one of them must be set.
+    std::chrono::milliseconds time_budget;
+    unsigned int max_playouts;
+    unsigned int num_threads;       // 0 uses all cores
+    float exploration;              // weight of the priors compared to the playout results
+    unsigned int virtual_loss;      // number of lost playouts added to a node while a thread searches below it
+    unsigned int max_nodes;         // size of the node pool, leaves are not expanded anymore once it is used up
+    unsigned int seed;
+};
+
+struct mcts_result {
+    search_move best_move;
+    unsigned int num_playouts;
+    unsigned int num_nodes;
+    // share of the playouts through 'best_move' that the current player won, ties count half
+    float win_rate;
+    std::chrono::steady_clock::duration elapsed;
+    // playouts through the root that were done by earlier searches or while pondering
+    unsigned int num_reused_playouts;
+};
+
+// a move of the root with the moves that the search expects to follow
+struct mcts_line {
+    search_move move;
+    // share of the playouts through 'move' that the player to move won, ties count half
+    float win_rate;
+    unsigned int visits;
+    // starts with 'move' and follows the most visited replies
+    std::vector<search_move> principal_variation;
+};
+
+class mcts_engine {
+
+public:
+    static constexpr int no_winner = -1;
+    // positions of the database are only trusted if the side to move won them within this many plies
+    static constexpr unsigned int max_database_plies = 3;
+
+    static mcts_settings get_settings(bot_difficulty difficulty);
+
+    explicit mcts_engine(const mcts_settings& settings);
+
+    // Moves of 'book' are played without searching, as long as the position is in it. nullptr disables the book.
+    void set_opening_book(std::shared_ptr<const opening_book> book);
+    // Known quick wins from 'database' are played without searching. nullptr disables the database.
+    void set_position_database(std::shared_ptr<const position_database> database);
+    // overrides the number of threads of the settings, e.g. to stay within a CPU budget
+    void set_num_threads(unsigned int num_threads);
+
+    // Searches the best move for the current player of 'position'. Throws a gomoku_exception if the game is finished.
+    mcts_result search(const search_position& position);
+    // looks 'position' up in the opening book and the position database, which search() does first
+    bool find_known_move(const search_position& position, mcts_result& result) const;
+
+    // Searches on the opponent's time: grows the tree of 'position', in which the opponent is to move, with a single
+    // thread until 'is_cancelled' is set or the playout limit is reached.
+    void ponder(const search_position& position, const std::atomic<bool>& is_cancelled);
+    // drops the tree, e.g. when a new round starts
+    void clear_tree();
+
+    // search() and ponder() in slices, e.g. for the tasks of a scheduler: begin_search() prepares the tree for
+    // 'position', then run_search_slice() grows it until 'slice_end' and returns true once a limit of the search is
+    // reached. Several threads may run slices at the same time with different 'thread_idx'. end_search() returns the
+    // best move. A search for pondering has no time limit. Throws a gomoku_exception if the game is finished.
+    void begin_search(const search_position& position, bool is_pondering);
+    bool run_search_slice(const search_position& position, unsigned int thread_idx,
+                          std::chrono::steady_clock::time_point slice_end);
+    mcts_result end_search();
+    // The 'nof_lines' most visited moves of the root, best first, with principal variations of at most 'max_length'
+    // moves. Can be called while slices are running.
+    std::vector<mcts_line> get_lines(unsigned int nof_lines, unsigned int max_length) const;
+
+    // Plays the game from 'position' to the end with the playout policy and takes all moves back afterwards.
+    // 'board' must hold the same stones as 'position'. Returns the index of the winning player or no_winner for a tie.
+    static int playout(search_position& position, pattern_board& board, std::mt19937& rng);
+
+private:
+    enum expansion_state : std::uint8_t {
+        unexpanded,
+        expanding,
+        expanded,
+        leaf_only,  // the node pool was used up
+    };
+
+    struct node {
+        search_move move;               // the move that leads to this node
+        float prior;
+        std::uint8_t mover_idx;         // the player who made 'move'
+        std::atomic<std::uint8_t> expansion{unexpanded};
+        std::atomic<std::uint16_t> num_children{0};
+        std::atomic<std::uint32_t> first_child{0};
+        std::atomic<std::uint32_t> visits{0};
+        std::atomic<std::uint32_t> virtual_losses{0};
+        std::atomic<std::uint64_t> points{0};     // 2 per won playout and 1 per tie, for 'mover_idx'
+    };
+
+    // candidate moves with their prior, reused to avoid allocations
+    struct candidate {
+        search_move move;
+        float weight;
+    };
+
+    mcts_settings _settings;
+    std::shared_ptr<const opening_book> _opening_book;
+    std::shared_ptr<const position_database> _position_database;
+    std::unique_ptr<node[]> _nodes;
+    std::atomic<std::uint32_t> _num_nodes;
+    std::atomic<std::uint32_t> _num_playouts;
+    std::atomic<bool> _is_stopped;
+    // of the current search
+    std::chrono::steady_clock::time_point _search_start;
+    std::chrono::steady_clock::time_point _search_deadline;
+    std::uint32_t _num_reused_playouts;
+    // set while pondering
+    const std::atomic<bool>* _is_cancelled;
+    // the position at the root of the tree, if there is a tree
+    std::optional<search_position> _tree_position;
+
+    // applies 'move' to both the position and the board, returns false for illegal moves
+    static bool apply_move(search_position& position, pattern_board& board, const search_move& move);
+    static void undo_move(search_position& position, pattern_board& board);
+    // winner of a finished position, or no_winner for a tie
+    static int get_winner(const search_position& position);
+    // Collects the moves worth considering in 'position' among the fields near its stones, which 'generator' lists,
+    // and weights them by the patterns they form. If the player can win on the spot, only the winning move is
+    // returned. If the opponent threatens a five, only the blocks are.
+    static void generate_candidates(const search_position& position, const pattern_board& board,
+                                    const move_generator& generator, std::vector<candidate>& candidates);
+
+    // Removes moves that lead to the same position as an earlier candidate, up to a symmetry of the board. Only
+    // positions that are symmetric themselves (e.g. the empty board) have such moves.
+    static void remove_symmetric_moves(const search_position& position, std::vector<candidate>& candidates);
+
+    // Makes the node of 'position' the root of the tree if it is the root or one or two moves below it.
+    // Returns false if there is no such node.
+    bool reuse_tree(const search_position& position);
+    // replaces the tree by a single root for 'position'
+    void reset_tree(const search_position& position);
+    // moves the subtree of 'new_root' into a fresh node pool, with 'new_root' at index 0
+    void compact_tree(std::uint32_t new_root);
+    // expands the root if needed, returns false if there is no legal move
+    bool prepare_root(const search_position& position);
+
+    bool try_expand(node& parent, const search_position& position, const pattern_board& board,
+                    const move_generator& generator, std::vector<candidate>& candidates);
+    node& select_child(const node& parent) const;
+    // runs playouts until the search is stopped or 'slice_end' is reached
+    void run_worker(search_position position, unsigned int thread_idx, std::chrono::steady_clock::time_point slice_end);
+};
+
+
+#endif //GOMOKU_MCTS_ENGINE_H
@@ -0,0 +1,122 @@
+#include "move_generator.h"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+
+#include "../../exceptions/gomoku_exception.h"
+
+
+move_generator::move_generator(unsigned int board_size) :
+        _board_size(board_size),
+        _num_stones(0),
+        _row_mask(board_size >= 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << board_size) - 1),
+        _stones{},
+        _near{}
+{
+    if (board_size == 0 || board_size > max_board_size) {
+        throw gomoku_exception("The move generator does not support boards of size " + std::to_string(board_size));
+    }
+}
+
+move_generator::move_generator(const search_position& position) :
+        move_generator(position.get_board_size())
+{
+    const field_type* fields = position.get_fields();
+    for (unsigned int field = 0; field < _board_size * _board_size; ++field) {
+        if (fields[field] != field_type::empty) {
+            place_stone(field % _board_size, field / _board_size);
+        }
+    }
+}
+
+
+std::uint32_t move_generator::dilate_row(std::uint32_t row, unsigned int distance) const {
+    std::uint32_t dilated = row;
+    for (unsigned int step = 1; step <= distance; ++step) {
+        dilated |= (row << step) | (row >> step);
+    }
+    return dilated & _row_mask;
+}
+
+void move_generator::place_stone(unsigned int x, unsigned int y) {
+    _stones[y] |= std::uint32_t(1) << x;
+    ++_num_stones;
+    for (unsigned int distance = 1; distance <= max_distance; ++distance) {
+        const std::uint32_t block = dilate_row(std::uint32_t(1) << x, distance);
+        const unsigned int last_row = std::min(_board_size - 1, y + distance);
+        for (unsigned int row = y >= distance ? y - distance : 0; row <= last_row; ++row) {
+            _near[distance - 1][row] |= block;
+        }
+    }
+}
+
+void move_generator::undo_stone(unsigned int x, unsigned int y) {
+    _stones[y] &= ~(std::uint32_t(1) << x);
+    --_num_stones;
+    // other stones may cover the same fields, so the rows around the stone are dilated again
+    for (unsigned int distance = 1; distance <= max_distance; ++distance) {
+        const unsigned int last_row = std::min(_board_size - 1, y + distance);
+        for (unsigned int row = y >= distance ? y - distance : 0; row <= last_row; ++row) {
+            std::uint32_t near = 0;
+            const unsigned int last_source = std::min(_board_size - 1, row + distance);
+            for (unsigned int source = row >= distance ? row - distance : 0; source <= last_source; ++source) {
+                near |= _stones[source];
+            }
+            _near[distance - 1][row] = dilate_row(near, distance);
+        }
+    }
+}
+
+
+void move_generator::generate(unsigned int distance, move_list& moves) const {
+    moves.size = 0;
+    if (_num_stones == 0) {
+        moves.moves[moves.size++] = {static_cast<std::uint16_t>((_board_size / 2) * _board_size + _board_size / 2), 0};
+        return;
+    }
+    const std::array<std::uint32_t, max_board_size>& near = _near[std::clamp(distance, 1u, max_distance) - 1];
+    for (unsigned int y = 0; y < _board_size; ++y) {
+        std::uint32_t fields = near[y] & ~_stones[y];
+        while (fields != 0) {
+            const unsigned int x = std::countr_zero(fields);
+            fields &= fields - 1;
+            moves.moves[moves.size++] = {static_cast<std::uint16_t>(y * _board_size + x), 0};
+        }
+    }
+}
+
+void move_generator::generate(unsigned int distance, const pattern_board& board, field_type colour,
+                              move_list& moves) const {
+    generate(distance, moves);
+    const field_type opponent = colour == field_type::black_stone ? field_type::white_stone : field_type::black_stone;
+    for (unsigned int i = 0; i < moves.size; ++i) {
+        scored_move& move = moves.moves[i];
+        const line_pattern own = board.get_best_pattern(move.field % _board_size, move.field / _board_size, colour);
+        const line_pattern blocked = board.get_best_pattern(move.field % _board_size, move.field / _board_size, opponent);
+        move.score = own_pattern_weights[own] + opponent_pattern_weights[blocked]
+                     + (own == line_pattern::pattern_five ? win_weight : 0)
+                     + (blocked == line_pattern::pattern_five ? block_weight : 0);
+    }
+    // ties keep the row-major order, so that the order does not depend on the sort implementation
+    std::sort(moves.moves.begin(), moves.moves.begin() + moves.size, [](const scored_move& a, const scored_move& b) {
+        return a.score != b.score ? a.score > b.score : a.field < b.field;
+    });
+}
+
+
+bool move_generator::is_occupied(unsigned int x, unsigned int y) const {
+    return (_stones[y] >> x) & 1;
+}
+
+bool move_generator::is_near_stone(unsigned int x, unsigned int y, unsigned int distance) const {
+    return (_near[std::clamp(distance, 1u, max_distance) - 1][y] >> x) & 1;
+}
+
+unsigned int move_generator::get_board_size() const {
+    return _board_size;
+}
+
+unsigned int move_generator::get_num_stones() const {
+    return _num_stones;
+}
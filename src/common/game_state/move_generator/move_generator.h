@@ -0,0 +1,81 @@
+// The move_generator lists the fields worth considering in a search: the empty fields within a distance of 1 or 2 of a
+// stone. Every row of the board is kept as a bitmask of its stones, together with the bitmasks of the fields within
+// each distance (the occupancy dilated by that distance). Placing a stone ORs a precomputed block into the rows
+// around it, undoing it recomputes those rows from the stones, so both only touch 2 * max_distance + 1 rows.
+// Generated moves are written into fixed-size arrays, which can live on the stack of a search, and can be ordered by
+// the threats they make and block on a pattern_board.
+
+#ifndef GOMOKU_MOVE_GENERATOR_H
+#define GOMOKU_MOVE_GENERATOR_H
+
+#include <array>
+#include <cstdint>
+
+#include "../line_patterns/pattern_board.h"
+#include "../search_position/search_position.h"
+
+class move_generator {
+
+public:
+    static constexpr unsigned int max_board_size = 31;     // a row fits into 32 bits
+    static constexpr unsigned int max_fields = max_board_size * max_board_size;
+    static constexpr unsigned int max_distance = 2;
+
+    // weights of the patterns that a move forms for the player to move and that it takes away from the opponent
+    static constexpr std::array<float, line_pattern_table::NUM_LINE_PATTERNS> own_pattern_weights = {
+            0, 1, 3, 4, 20, 30, 200, 0
+    };
+    static constexpr std::array<float, line_pattern_table::NUM_LINE_PATTERNS> opponent_pattern_weights = {
+            0, 0.5f, 1.5f, 2, 15, 25, 150, 0
+    };
+    // completing a five comes before everything else, blocking one before all other threats
+    static constexpr float win_weight = 1e6f;
+    static constexpr float block_weight = 1e5f;
+
+    struct scored_move {
+        std::uint16_t field;    // y * board_size + x
+        float score;
+    };
+
+    struct move_list {
+        std::array<scored_move, max_fields> moves;
+        unsigned int size = 0;
+    };
+
+    // an empty board. Throws a gomoku_exception for board sizes above max_board_size.
+    explicit move_generator(unsigned int board_size);
+    // the stones of 'position'
+    explicit move_generator(const search_position& position);
+
+    // the field must be empty for place_stone() and occupied for undo_stone()
+    void place_stone(unsigned int x, unsigned int y);
+    void undo_stone(unsigned int x, unsigned int y);
+
+    // The empty fields within 'distance' (1 to max_distance) of a stone in row-major order, with a score of 0.
+    // On an empty board, only the centre is generated.
+    void generate(unsigned int distance, move_list& moves) const;
+    // the same fields, ordered by the patterns a stone of 'colour' forms and blocks on them, strongest first
+    void generate(unsigned int distance, const pattern_board& board, field_type colour, move_list& moves) const;
+
+    bool is_occupied(unsigned int x, unsigned int y) const;
+    // true if a stone is within 'distance' of (x, y), the field itself included
+    bool is_near_stone(unsigned int x, unsigned int y, unsigned int distance) const;
+
+// accessors
+    unsigned int get_board_size() const;
+    unsigned int get_num_stones() const;
+
+private:
+    unsigned int _board_size;
+    unsigned int _num_stones;
+    std::uint32_t _row_mask;    // the bits of the fields of a row
+    std::array<std::uint32_t, max_board_size> _stones;
+    // the fields within distance d + 1 of a stone, the stones included
+    std::array<std::array<std::uint32_t, max_board_size>, max_distance> _near;
+
+    // 'row' with every bit spread 'distance' fields to both sides
+    std::uint32_t dilate_row(std::uint32_t row, unsigned int distance) const;
+};
+
+
+#endif //GOMOKU_MOVE_GENERATOR_H
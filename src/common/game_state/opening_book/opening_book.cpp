@@ -0,0 +1,82 @@
+#include "opening_book.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../position_hash/position_hash.h"
+#include "../../exceptions/gomoku_exception.h"
+
+
+search_move opening_book::entry::get_move() const {
+    if (move_type == search_move_type::swap_move) {
+        return search_move::swap(static_cast<swap_decision_type>(swap_decision));
+    }
+    return search_move::stone(x, y);
+}
+
+float opening_book::entry::get_score() const {
+    return float(points + 1) / float(2 * games + 2);
+}
+
+
+opening_book::opening_book(const std::string& path) : _file(path), _entries(nullptr), _num_entries(0) {
+    file_header header;
+    if (_file.get_size() < sizeof(header)) {
+        throw gomoku_exception(path + " is not an opening book.");
+    }
+    std::memcpy(&header, _file.get_data(), sizeof(header));
+    if (header.magic != file_magic) {
+        throw gomoku_exception(path + " is not an opening book.");
+    }
+    if (header.version != file_version) {
+        throw gomoku_exception("The opening book " + path + " has version " + std::to_string(header.version)
+                               + ", but version " + std::to_string(file_version) + " is required.");
+    }
+    if (_file.get_size() != sizeof(file_header) + std::size_t(header.num_entries) * sizeof(entry)) {
+        throw gomoku_exception("The size of the opening book " + path + " does not match its number of entries.");
+    }
+    // the mapping starts at a page boundary, so the entries after the 16 byte header are aligned
+    _entries = reinterpret_cast<const entry*>(_file.get_data() + sizeof(file_header));
+    _num_entries = header.num_entries;
+}
+
+
+void opening_book::find_entries(std::uint64_t canonical_hash, const entry*& first, const entry*& last) const {
+    const entry* end = _entries + _num_entries;
+    first = std::lower_bound(_entries, end, canonical_hash, [](const entry& e, std::uint64_t hash) {
+        return e.hash < hash;
+    });
+    last = first;
+    while (last != end && last->hash == canonical_hash) {
+        ++last;
+    }
+}
+
+const opening_book::entry* opening_book::lookup(const search_position& position, search_move& move, unsigned int min_games) const {
+    if (_num_entries == 0 || position.is_finished()) {
+        return nullptr;
+    }
+    const canonical_hash key = position_hash::get_canonical_hash(position);
+    const entry* first;
+    const entry* last;
+    find_entries(key.hash, first, last);
+
+    const entry* best = nullptr;
+    for (const entry* e = first; e != last; ++e) {
+        if (e->games < min_games || (best != nullptr && e->get_score() <= best->get_score())) {
+            continue;
+        }
+        // guards against hash collisions with positions that are not in the book
+        if (position.is_legal(position_hash::inverse_transform(key.symmetry, position.get_board_size(), e->get_move()))) {
+            best = e;
+        }
+    }
+    if (best != nullptr) {
+        move = position_hash::inverse_transform(key.symmetry, position.get_board_size(), best->get_move());
+    }
+    return best;
+}
+
+std::size_t opening_book::get_num_entries() const {
+    return _num_entries;
+}
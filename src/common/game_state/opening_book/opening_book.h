@@ -0,0 +1,72 @@
+// The opening_book holds moves for the first turns of a game, where the opening rules (swap2, swap_after_first_move)
+// make bots think long and play badly. Positions are identified by their canonical hash (see position_hash), so that
+// a book move covers all 8 symmetric positions. Moves are stored in the canonical orientation of their position.
+//
+// The book is a file of entries sorted by hash (all values little endian):
+//   char[4] "GBOK", uint32 version, uint32 number of entries, uint32 reserved,
+//   entries [number of entries]: uint64 hash, uint32 games, uint32 points, uint8 move type, uint8 x, uint8 y,
+//                                uint8 swap decision, uint32 reserved
+// The file is memory-mapped when the book is opened and searched in place, so looking up a move never allocates.
+
+#ifndef GOMOKU_OPENING_BOOK_H
+#define GOMOKU_OPENING_BOOK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "../search_position/search_position.h"
+#include "../../storage/mapped_file.h"
+
+class opening_book {
+
+public:
+    static constexpr std::array<char, 4> file_magic = {'G', 'B', 'O', 'K'};
+    static constexpr std::uint32_t file_version = 1;
+
+    struct file_header {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::uint32_t num_entries;
+        std::uint32_t reserved;
+    };
+
+    struct entry {
+        std::uint64_t hash;
+        std::uint32_t games;        // number of games in which the move was played
+        std::uint32_t points;       // 2 per won game and 1 per tie, for the player who made the move
+        std::uint8_t move_type;
+        std::uint8_t x;
+        std::uint8_t y;
+        std::uint8_t swap_decision;
+        std::uint32_t reserved;
+
+        search_move get_move() const;
+        // share of the points the move got, with one tie added so that rarely played moves are not overrated
+        float get_score() const;
+    };
+
+    // Maps the book at 'path'. Throws a gomoku_exception if the file cannot be opened or is not a valid book.
+    explicit opening_book(const std::string& path);
+
+    // Looks up the best move for 'position' with at least 'min_games' games and returns its entry. Returns nullptr if
+    // the position is not in the book or none of its moves is legal.
+    const entry* lookup(const search_position& position, search_move& move, unsigned int min_games = 1) const;
+
+    // the entries of 'position' as [first, last), with their moves in the canonical orientation of the position
+    void find_entries(std::uint64_t canonical_hash, const entry*& first, const entry*& last) const;
+
+    std::size_t get_num_entries() const;
+
+private:
+    mapped_file _file;
+    const entry* _entries;
+    std::size_t _num_entries;
+};
+
+static_assert(sizeof(opening_book::file_header) == 16 && sizeof(opening_book::entry) == 24,
+              "The layout of the book file must not depend on the compiler.");
+
+
+#endif //GOMOKU_OPENING_BOOK_H
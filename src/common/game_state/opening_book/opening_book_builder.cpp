@@ -0,0 +1,107 @@
+#include "opening_book_builder.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "../position_hash/position_hash.h"
+#include "../../exceptions/gomoku_exception.h"
+
+
+opening_book_builder::opening_book_builder(unsigned int max_depth) : _max_depth(max_depth), _num_games(0) { }
+
+
+bool opening_book_builder::add_game(const game_record& record) {
+    // the canonical key, the canonical move and the player who made it for each move of the opening
+    struct book_move {
+        std::uint64_t hash;
+        search_move move;
+        unsigned int player_idx;
+    };
+    std::vector<book_move> opening;
+    opening.reserve(std::min<std::size_t>(_max_depth, record.moves.size()));
+
+    search_position position(record.ruleset, record.board_size);
+    for (std::size_t i = 0; i < record.moves.size(); ++i) {
+        if (i < _max_depth) {
+            canonical_hash key = position_hash::get_canonical_hash(position);
+            opening.push_back({key.hash, position_hash::transform(key.symmetry, record.board_size, record.moves[i]),
+                               position.get_current_player_idx()});
+        }
+        if (!position.apply_move(record.moves[i])) {
+            throw gomoku_exception("Move " + std::to_string(i + 1) + " of the game record is illegal.");
+        }
+    }
+    if (!position.is_finished()) {
+        return false;
+    }
+
+    for (const book_move& played : opening) {
+        std::uint32_t points = 1;
+        if (!position.is_tied()) {
+            points = position.get_current_player_idx() == played.player_idx ? 2 : 0;
+        }
+        std::vector<opening_book::entry>& entries = _positions[played.hash];
+        auto it = std::find_if(entries.begin(), entries.end(), [&played](const opening_book::entry& e) {
+            return e.get_move() == played.move;
+        });
+        if (it == entries.end()) {
+            opening_book::entry e = {};
+            e.hash = played.hash;
+            e.move_type = static_cast<std::uint8_t>(played.move.type);
+            e.x = played.move.x;
+            e.y = played.move.y;
+            e.swap_decision = static_cast<std::uint8_t>(played.move.swap_decision);
+            entries.push_back(e);
+            it = entries.end() - 1;
+        }
+        it->games++;
+        it->points += points;
+    }
+    _num_games++;
+    return true;
+}
+
+game_record opening_book_builder::play_self_play_game(ruleset_type ruleset, unsigned int board_size,
+                                                      const mcts_settings& settings) {
+    search_position position(ruleset, board_size);
+    mcts_settings move_settings = settings;
+    while (!position.is_finished()) {
+        // vary the seed, so that the games do not all repeat the same opening
+        move_settings.seed = settings.seed + position.get_num_moves();
+        mcts_engine engine(move_settings);
+        position.apply_move(engine.search(position).best_move);
+    }
+    return game_record::from_position(position);
+}
+
+
+unsigned int opening_book_builder::get_num_games() const {
+    return _num_games;
+}
+
+unsigned int opening_book_builder::get_num_positions() const {
+    return _positions.size();
+}
+
+void opening_book_builder::write(const std::string& path, unsigned int min_games) const {
+    std::vector<opening_book::entry> entries;
+    for (const auto& [hash, position_entries] : _positions) {
+        for (const opening_book::entry& e : position_entries) {
+            if (e.games >= min_games) {
+                entries.push_back(e);
+            }
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const opening_book::entry& a, const opening_book::entry& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.games > b.games;
+    });
+
+    const opening_book::file_header header = {opening_book::file_magic, opening_book::file_version,
+                                              static_cast<std::uint32_t>(entries.size()), 0};
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(entries.data()), std::streamsize(entries.size() * sizeof(opening_book::entry)));
+    if (!file) {
+        throw gomoku_exception("Could not write the opening book " + path);
+    }
+}
@@ -0,0 +1,44 @@
+// The opening_book_builder collects the moves of the first turns of many games, from game records or from games that
+// bots play against each other, and writes them as a sorted opening_book file. Every move is counted for the
+// canonical form of the position it was played in, with the result of the game for the player who made it.
+
+#ifndef GOMOKU_OPENING_BOOK_BUILDER_H
+#define GOMOKU_OPENING_BOOK_BUILDER_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "opening_book.h"
+#include "../game_record/game_record.h"
+#include "../mcts_engine/mcts_engine.h"
+
+class opening_book_builder {
+
+public:
+    // only the first 'max_depth' moves of a game are added to the book
+    explicit opening_book_builder(unsigned int max_depth);
+
+    // Adds the opening of a finished game. Returns false for games that are not finished, as they have no result.
+    // Throws a gomoku_exception if the record contains an illegal move.
+    bool add_game(const game_record& record);
+
+    // plays a game in which both players are bots with 'settings'
+    static game_record play_self_play_game(ruleset_type ruleset, unsigned int board_size, const mcts_settings& settings);
+
+    unsigned int get_num_games() const;
+    unsigned int get_num_positions() const;
+
+    // Writes all moves played in at least 'min_games' games. Throws a gomoku_exception if the file cannot be written.
+    void write(const std::string& path, unsigned int min_games) const;
+
+private:
+    unsigned int _max_depth;
+    unsigned int _num_games;
+    // the moves played in each position, by canonical hash
+    std::unordered_map<std::uint64_t, std::vector<opening_book::entry>> _positions;
+};
+
+
+#endif //GOMOKU_OPENING_BOOK_BUILDER_H
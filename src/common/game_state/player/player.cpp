@@ -5,6 +5,7 @@
 #include "player.h"
 
 #include "../../exceptions/gomoku_exception.h"
+#include "../../serialization/json_utils.h"
 
 player::player(std::string name, player_colour_type colour) : unique_serializable() {
     this->_player_name = new serializable_value<std::string>(name);
@@ -73,6 +74,17 @@ const std::unordered_map<player_colour_type, std::string> player::_player_colour
         {player_colour_type::white, "white"},
 };
 
+void player::change_colour(std::string& err) {
+    if (this->_colour == player_colour_type::black) {
+        this->_colour = player_colour_type::white;
+    } else if (this->_colour == player_colour_type::white) {
+        this->_colour = player_colour_type::black;
+    } else {
+        throw gomoku_exception("Failed to swap player colour. Unknown player colour was given.");
+    }
+}
+
+
 #ifdef GOMOKU_SERVER
 
 void player::increment_score(std::string& err){
@@ -85,16 +97,6 @@ bool player::reset_score(std::string& err){
     return true;
 }
 
-void player::change_colour(std::string& err) {
-    if (this->_colour == player_colour_type::black) {
-        this->_colour = player_colour_type::white;
-    } else if (this->_colour == player_colour_type::white) {
-        this->_colour = player_colour_type::black;
-    } else {
-        throw gomoku_exception("Failed to swap player colour. Unknown player colour was given.");
-    }
-}
-
 
 
 #endif
@@ -137,3 +139,37 @@ player *player::from_json(const rapidjson::Value &json) {
         throw gomoku_exception("Failed to deserialize player from json. Required json entries were missing.");
     }
 }
+
+void player::validate_json(const rapidjson::Value &json) {
+    if (!json.IsObject()
+        || !json.HasMember("id") || !json["id"].IsString()
+        || !json_utils::has_serialized_value(json, "player_name", &rapidjson::Value::IsString)
+        || !json_utils::has_serialized_value(json, "score", &rapidjson::Value::IsInt)
+        || !json.HasMember("colour"))
+    {
+        throw gomoku_exception("Failed to deserialize player from json. Required json entries were missing.");
+    }
+    json_utils::parse_enum_value(json["colour"], _string_to_player_colour_type);
+}
+
+void player::update_from_json(const rapidjson::Value &json) {
+    validate_json(json);
+    this->_id = json["id"].GetString();
+    this->_player_name->set_value(json["player_name"]["value"].GetString());
+    this->_score->set_value(json["score"]["value"].GetInt());
+    this->_colour = json_utils::parse_enum_value(json["colour"], _string_to_player_colour_type);
+}
+
+void player::copy_from(const player& other) {
+    this->_id = other._id;
+    this->_player_name->set_value(other._player_name->get_value());
+    this->_score->set_value(other._score->get_value());
+    this->_colour = other._colour;
+}
+
+player* player::clone() const {
+    return new player(this->_id,
+                      new serializable_value<std::string>(this->_player_name->get_value()),
+                      new serializable_value<int>(this->_score->get_value()),
+                      this->_colour);
+}
@@ -52,11 +52,13 @@ public:
     player_colour_type get_colour() const noexcept;
     std::string get_player_name() const noexcept;
 
-#ifdef GOMOKU_SERVER
     // state update functions
+    // also used by the client to predict the outcome of its own moves
+    void change_colour(std::string& err);
+
+#ifdef GOMOKU_SERVER
     void increment_score(std::string& err);
     bool reset_score(std::string& err);
-    void change_colour(std::string& err);
 
 #endif
 
@@ -64,6 +66,14 @@ public:
     // serialization
     virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
     static player* from_json(const rapidjson::Value& json);
+    // checks the player serialized in 'json' without creating one, throws a gomoku_exception if it is invalid
+    static void validate_json(const rapidjson::Value& json);
+    // updates this player in place to the player serialized in 'json', which is left unchanged if the json is invalid
+    void update_from_json(const rapidjson::Value& json);
+    // updates this player in place to a copy of 'other'
+    void copy_from(const player& other);
+    // a new player with the same id, name, score and colour
+    player* clone() const;
 
 };
 
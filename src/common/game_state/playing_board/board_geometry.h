@@ -0,0 +1,123 @@
+// The board_geometry template contains the line scanning routines of the playing board, specialized at compile time
+// for every supported board size. All loop bounds and the distances from each field to the board edges are
+// compile-time constants, so the compiler can unroll the scans for each size.
+// with_board_geometry() is the runtime dispatcher that selects the instantiation for a given board size.
+
+#ifndef GOMOKU_BOARD_GEOMETRY_H
+#define GOMOKU_BOARD_GEOMETRY_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "playing_board.h"
+#include "../../exceptions/gomoku_exception.h"
+
+template <unsigned int N>
+class board_geometry {
+
+public:
+    static constexpr unsigned int size = N;
+    static constexpr unsigned int num_fields = N * N;
+
+    /*
+     * order of directions
+     *   0  1  2
+     *   3     4
+     *   5  6  7
+     * direction i and direction 7-i are opposite to each other
+     */
+    static constexpr std::array<int, 8> direction_x = {-1, 0, 1, -1, 1, -1, 0, 1};
+    static constexpr std::array<int, 8> direction_y = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+    static constexpr unsigned int index(unsigned int x, unsigned int y) {
+        return y * N + x;
+    }
+
+    // returns the number of fields between the field at 'idx' and the board edge in 'direction'
+    static constexpr unsigned int steps_to_edge(unsigned int idx, unsigned int direction) {
+        return _steps_to_edge[idx][direction];
+    }
+
+    // returns the number of consecutive 'colour' stones next to (x, y) in 'direction', not counting (x, y) itself
+    static unsigned int count_stones_one_direction(const field_type* fields, unsigned int x, unsigned int y,
+                                                   unsigned int direction, field_type colour) {
+        const unsigned int start = index(x, y);
+        const int step = direction_y[direction] * int(N) + direction_x[direction];
+        const unsigned int max_steps = steps_to_edge(start, direction);
+        unsigned int count = 0;
+        int idx = int(start);
+        while (count < max_steps) {
+            idx += step;
+            if (fields[idx] != colour) {
+                break;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    // returns the length of the line of 'colour' stones running through (x, y) along 'direction' and its opposite
+    static unsigned int line_length(const field_type* fields, unsigned int x, unsigned int y, unsigned int direction,
+                                    field_type colour) {
+        return 1 + count_stones_one_direction(fields, x, y, direction, colour)
+                 + count_stones_one_direction(fields, x, y, 7 - direction, colour);
+    }
+
+    // returns the length of the longest line of 'colour' stones running through (x, y)
+    static unsigned int longest_line(const field_type* fields, unsigned int x, unsigned int y, field_type colour) {
+        unsigned int longest = 0;
+        for (unsigned int direction = 0; direction < 4; ++direction) {
+            unsigned int length = line_length(fields, x, y, direction, colour);
+            if (length > longest) {
+                longest = length;
+            }
+        }
+        return longest;
+    }
+
+    // returns true if a line of exactly five 'colour' stones runs through (x, y)
+    static bool has_exact_five(const field_type* fields, unsigned int x, unsigned int y, field_type colour) {
+        for (unsigned int direction = 0; direction < 4; ++direction) {
+            if (line_length(fields, x, y, direction, colour) == 5) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    static constexpr std::array<std::array<std::uint8_t, 8>, N * N> compute_steps_to_edge() {
+        std::array<std::array<std::uint8_t, 8>, N * N> steps{};
+        for (unsigned int y = 0; y < N; ++y) {
+            for (unsigned int x = 0; x < N; ++x) {
+                for (unsigned int direction = 0; direction < 8; ++direction) {
+                    unsigned int steps_x = direction_x[direction] < 0 ? x : (direction_x[direction] > 0 ? N - 1 - x : N);
+                    unsigned int steps_y = direction_y[direction] < 0 ? y : (direction_y[direction] > 0 ? N - 1 - y : N);
+                    steps[index(x, y)][direction] = static_cast<std::uint8_t>(steps_x < steps_y ? steps_x : steps_y);
+                }
+            }
+        }
+        return steps;
+    }
+
+    static constexpr std::array<std::array<std::uint8_t, 8>, N * N> _steps_to_edge = compute_steps_to_edge();
+};
+
+// Calls 'f' with the board_geometry instantiation for 'board_size' and returns its result.
+// Throws a gomoku_exception if the board size is not supported.
+template <class F>
+decltype(auto) with_board_geometry(unsigned int board_size, F&& f) {
+    switch (board_size) {
+        case 15:
+            return f(board_geometry<15>());
+        case 19:
+            return f(board_geometry<19>());
+        case 31:
+            return f(board_geometry<31>());
+        default:
+            throw gomoku_exception("Unsupported board size " + std::to_string(board_size));
+    }
+}
+
+#endif //GOMOKU_BOARD_GEOMETRY_H
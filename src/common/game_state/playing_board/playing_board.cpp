@@ -4,36 +4,51 @@
 
 #include "playing_board.h"
 
+#include <algorithm>
+
 #include "../../exceptions/gomoku_exception.h"
 #include "../../serialization/vector_utils.h"
+#include "../../serialization/json_utils.h"
+
+const std::vector<unsigned int> playing_board::_supported_board_sizes = {15, 19, 31};
+
+playing_board::playing_board() : playing_board(_playing_board_size) { }
 
-playing_board::playing_board() : unique_serializable() {
-    std::vector<field_type> row(_playing_board_size, field_type::empty);
-    std::vector<std::vector<field_type>> playing_board (_playing_board_size, row);
-    this->_playing_board = playing_board;
+playing_board::playing_board(unsigned int board_size) : unique_serializable() {
+    if (!is_supported_board_size(board_size)) {
+        throw gomoku_exception("Unsupported board size " + std::to_string(board_size));
+    }
+    this->_board_size = board_size;
+    this->_fields = std::vector<field_type>(board_size * board_size, field_type::empty);
+    this->_num_empty_fields = board_size * board_size;
 }
 
 playing_board::playing_board(std::string id) : unique_serializable(id) {
-    std::vector<field_type> row(_playing_board_size, field_type::empty);
-    std::vector<std::vector<field_type>> playing_board (_playing_board_size, row);
-    this->_playing_board = playing_board;
+    this->_board_size = _playing_board_size;
+    this->_fields = std::vector<field_type>(MAX_NUM_STONES, field_type::empty);
+    this->_num_empty_fields = MAX_NUM_STONES;
 }
 
 // deserialization constructor
-playing_board::playing_board(std::string id, std::vector<std::vector<field_type>> playing_board) : unique_serializable(id) {
-    this->_playing_board = playing_board;
+playing_board::playing_board(std::string id, unsigned int board_size, std::vector<field_type> fields,
+                             unsigned int num_empty_fields)
+        : unique_serializable(id) {
+    this->_board_size = board_size;
+    this->_fields = fields;
+    this->_num_empty_fields = num_empty_fields;
 }
 
 playing_board::~playing_board() {
-    _playing_board.clear();
+    _fields.clear();
+}
+
+bool playing_board::is_supported_board_size(unsigned int board_size) {
+    return std::find(_supported_board_sizes.begin(), _supported_board_sizes.end(), board_size) != _supported_board_sizes.end();
 }
 
 void playing_board::reset() {
-    for (int i = 0; i < _playing_board.size(); i++) {
-        for (int j = 0; j < _playing_board.size(); j++) {
-            _playing_board.at((i)).at((j)) = field_type::empty;
-        }
-    }
+    std::fill(_fields.begin(), _fields.end(), field_type::empty);
+    _num_empty_fields = get_max_num_stones();
 }
 
 /*
@@ -43,9 +58,10 @@ void playing_board::reset() {
  *   - the spot is not occupied (== field_type::empty)
  */
 bool playing_board::place_stone(const unsigned int x, const unsigned int y, field_type colour, std::string &err) {
-    if (x < _playing_board_size && y < _playing_board_size && colour != field_type::empty) {
-        if (this->_playing_board.at(y).at(x) == field_type::empty) {
-            this->_playing_board.at(y).at(x) = colour;
+    if (x < _board_size && y < _board_size && colour != field_type::empty) {
+        if (this->_fields[y * _board_size + x] == field_type::empty) {
+            this->_fields[y * _board_size + x] = colour;
+            --_num_empty_fields;
             return true;
         } else {
             err = "Stone coordinates on board are already taken.";
@@ -73,11 +89,45 @@ const std::unordered_map<field_type, std::string> playing_board::_field_type_to_
 
 
 std::vector<std::vector<field_type>> playing_board::get_playing_board() const {
-    return _playing_board;
+    std::vector<std::vector<field_type>> playing_board;
+    playing_board.reserve(_board_size);
+    for (unsigned int i = 0; i < _board_size; ++i) {
+        playing_board.emplace_back(_fields.begin() + i * _board_size, _fields.begin() + (i + 1) * _board_size);
+    }
+    return playing_board;
 }
 
-std::vector<std::vector<field_type>>::iterator playing_board::get_playing_board_iterator() {
-    return _playing_board.begin();
+// returns the field at column x and row y without copying the board
+field_type playing_board::get_field(unsigned int x, unsigned int y) const {
+    if (x >= _board_size || y >= _board_size) {
+        throw gomoku_exception("Field coordinates are outside of board dimensions.");
+    }
+    return _fields[y * _board_size + x];
+}
+
+// returns the fields in row-major order, as expected by board_geometry
+const field_type* playing_board::get_fields() const {
+    return _fields.data();
+}
+
+unsigned int playing_board::get_board_size() const {
+    return _board_size;
+}
+
+unsigned int playing_board::get_max_num_stones() const {
+    return _board_size * _board_size;
+}
+
+unsigned int playing_board::get_num_empty_fields() const {
+    return _num_empty_fields;
+}
+
+unsigned int playing_board::get_num_stones() const {
+    return get_max_num_stones() - _num_empty_fields;
+}
+
+bool playing_board::is_full() const {
+    return _num_empty_fields == 0;
 }
 
 
@@ -86,41 +136,115 @@ void playing_board::setup_round(std::string& err) {
     this->reset();
 }
 
+// Changes the dimensions of the board. All stones are removed.
+bool playing_board::set_board_size(unsigned int board_size, std::string& err) {
+    if (!is_supported_board_size(board_size)) {
+        err = "Unsupported board size " + std::to_string(board_size) + ".";
+        return false;
+    }
+    this->_board_size = board_size;
+    this->_fields.assign(board_size * board_size, field_type::empty);
+    this->_num_empty_fields = board_size * board_size;
+    return true;
+}
+
 #endif
 
 void playing_board::write_into_json(rapidjson::Value &json, rapidjson::Document::AllocatorType& allocator) const {
     unique_serializable::write_into_json(json, allocator);
     std::vector<serializable_value<std::string>> flattened_playing_board;
-    for (int i=0; i<_playing_board.size(); ++i) {
-        for (int j=0; j<_playing_board.size(); ++j) {
-            serializable_value<std::string> current_value = serializable_value<std::string>(_field_type_to_string.at(
-                    static_cast<const field_type>(_playing_board.at(i).at(j))));
-            flattened_playing_board.push_back(current_value);
-        }
+    for (field_type field : _fields) {
+        flattened_playing_board.push_back(serializable_value<std::string>(_field_type_to_string.at(field)));
     }
     json.AddMember("playing_board", vector_utils::serialize_vector(flattened_playing_board, allocator), allocator);
+    json.AddMember("board_size", _board_size, allocator);
+    json.AddMember("num_stones", get_num_stones(), allocator);
 }
 
 playing_board *playing_board::from_json(const rapidjson::Value &json) {
     if (json.HasMember("id") && json.HasMember("playing_board")) {
-        std::vector<int> deserialized_flattened_playing_board;
-        for (auto &serialized_field : json["playing_board"].GetArray()) {
-            int current_field = _string_to_field_type.at(serializable_value<std::string>::from_json(serialized_field.GetObject())->get_value());
-            deserialized_flattened_playing_board.push_back(current_field);
+        unsigned int board_size = _playing_board_size;
+        if (json.HasMember("board_size")) {
+            board_size = json["board_size"].GetUint();
+        }
+        if (!is_supported_board_size(board_size)) {
+            throw gomoku_exception("Could not parse playing board from json. Unsupported board size " + std::to_string(board_size) + ".");
         }
-        std::vector<field_type> row(_playing_board_size, field_type::empty);
-        std::vector<std::vector<field_type>> deserialized_playing_board (_playing_board_size, row);
-        for (int i=0; i<_playing_board_size; i++) {
-            for (int j=0; j<_playing_board_size; j++) {
-                deserialized_playing_board.at(i).at(j) = static_cast<field_type>(deserialized_flattened_playing_board.at(
-                        i * _playing_board_size + j));
+        std::vector<field_type> deserialized_fields;
+        deserialized_fields.reserve(board_size * board_size);
+        unsigned int num_empty_fields = 0;
+        for (auto &serialized_field : json["playing_board"].GetArray()) {
+            serializable_value<std::string>* field_value = serializable_value<std::string>::from_json(serialized_field.GetObject());
+            field_type current_field = _string_to_field_type.at(field_value->get_value());
+            delete field_value;
+            if (current_field == field_type::empty) {
+                ++num_empty_fields;
             }
+            deserialized_fields.push_back(current_field);
+        }
+        if (deserialized_fields.size() != board_size * board_size) {
+            throw gomoku_exception("Could not parse playing board from json. Wrong number of fields.");
+        }
+        // the sender's stone counter must agree with the stones that were actually transmitted
+        if (json.HasMember("num_stones") && json["num_stones"].GetUint() != board_size * board_size - num_empty_fields) {
+            throw gomoku_exception("Could not parse playing board from json. Number of stones does not match 'num_stones'.");
         }
-        return new playing_board(json["id"].GetString(), deserialized_playing_board);
+        return new playing_board(json["id"].GetString(), board_size, deserialized_fields, num_empty_fields);
     } else {
         throw gomoku_exception("Could not parse playing board from json. 'playing_board' was missing.");
     }
 }
 
+void playing_board::validate_json(const rapidjson::Value &json) {
+    if (!json.IsObject() || !json.HasMember("id") || !json["id"].IsString()
+        || !json.HasMember("playing_board") || !json["playing_board"].IsArray()) {
+        throw gomoku_exception("Could not parse playing board from json. 'playing_board' was missing.");
+    }
+    unsigned int board_size = _playing_board_size;
+    if (json.HasMember("board_size")) {
+        if (!json["board_size"].IsUint()) {
+            throw gomoku_exception("Could not parse playing board from json. 'board_size' is not a number.");
+        }
+        board_size = json["board_size"].GetUint();
+    }
+    if (!is_supported_board_size(board_size)) {
+        throw gomoku_exception("Could not parse playing board from json. Unsupported board size " + std::to_string(board_size) + ".");
+    }
+    const rapidjson::Value& serialized_fields = json["playing_board"];
+    if (serialized_fields.Size() != board_size * board_size) {
+        throw gomoku_exception("Could not parse playing board from json. Wrong number of fields.");
+    }
+    unsigned int num_stones = 0;
+    for (const rapidjson::Value& serialized_field : serialized_fields.GetArray()) {
+        if (json_utils::parse_enum_value(serialized_field, _string_to_field_type) != field_type::empty) {
+            ++num_stones;
+        }
+    }
+    if (json.HasMember("num_stones") && (!json["num_stones"].IsUint() || json["num_stones"].GetUint() != num_stones)) {
+        throw gomoku_exception("Could not parse playing board from json. Number of stones does not match 'num_stones'.");
+    }
+}
 
+void playing_board::update_from_json(const rapidjson::Value &json) {
+    validate_json(json);
+
+    // nothing below throws anymore
+    const rapidjson::Value& serialized_fields = json["playing_board"];
+    this->_id = json["id"].GetString();
+    this->_board_size = json.HasMember("board_size") ? json["board_size"].GetUint() : _playing_board_size;
+    this->_fields.resize(serialized_fields.Size());
+    this->_num_empty_fields = 0;
+    for (unsigned int i = 0; i < serialized_fields.Size(); ++i) {
+        this->_fields[i] = json_utils::parse_enum_value(serialized_fields[i], _string_to_field_type);
+        if (this->_fields[i] == field_type::empty) {
+            ++this->_num_empty_fields;
+        }
+    }
+}
 
+void playing_board::copy_from(const playing_board& other) {
+    this->_id = other._id;
+    this->_board_size = other._board_size;
+    this->_fields = other._fields;
+    this->_num_empty_fields = other._num_empty_fields;
+}
@@ -17,23 +17,41 @@ enum field_type {
 class playing_board : public unique_serializable {
 
 private:
-    std::vector<std::vector<field_type>> _playing_board;
+    unsigned int _board_size;
+    // fields of the board in row-major order, i.e. the field at column x and row y is at index y * _board_size + x
+    std::vector<field_type> _fields;
+    // number of empty fields, kept up to date by place_stone() and reset() so that a full board is detected in O(1)
+    unsigned int _num_empty_fields;
 
     playing_board(std::string id);
-    playing_board(std::string id, std::vector<std::vector<field_type>> playing_board);
+    playing_board(std::string id, unsigned int board_size, std::vector<field_type> fields, unsigned int num_empty_fields);
     void reset();
 
 public:
     playing_board();
+    explicit playing_board(unsigned int board_size);
     ~playing_board();
 
-    static const int _playing_board_size = 15;
-    static const int MAX_NUM_STONES = _playing_board_size*_playing_board_size;
+    // size of a standard board, which is used unless another size is requested
+    static constexpr int _playing_board_size = 15;
+    static constexpr int MAX_NUM_STONES = _playing_board_size*_playing_board_size;
+
+    // board sizes for which board_geometry is instantiated
+    static const std::vector<unsigned int> _supported_board_sizes;
+    static bool is_supported_board_size(unsigned int board_size);
 
     bool place_stone(unsigned int x, unsigned int y, field_type colour, std::string &err);
 
 // serializable interface
     static playing_board* from_json(const rapidjson::Value& json);
+    // Checks the board serialized in 'json' without changing anything: the board size, every field and 'num_stones'.
+    // Throws a gomoku_exception if the board is invalid.
+    static void validate_json(const rapidjson::Value& json);
+    // Updates this board in place to the board serialized in 'json', reusing the storage of the fields. The board is
+    // validated first, so it is left unchanged if the json is invalid.
+    void update_from_json(const rapidjson::Value& json);
+    // updates this board in place to a copy of 'other', reusing the storage of the fields
+    void copy_from(const playing_board& other);
     virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
 
     // for deserialization
@@ -43,13 +61,19 @@ public:
 
 // accessors
     std::vector<std::vector<field_type>> get_playing_board() const;
+    field_type get_field(unsigned int x, unsigned int y) const;
+    const field_type* get_fields() const;
+    unsigned int get_board_size() const;
+    unsigned int get_max_num_stones() const;
+    unsigned int get_num_empty_fields() const;
+    unsigned int get_num_stones() const;
+    bool is_full() const;
 
 #ifdef GOMOKU_SERVER
 // state update functions
     void setup_round(std::string& err);
+    bool set_board_size(unsigned int board_size, std::string& err);
 #endif
-
-    std::vector<std::vector<field_type>>::iterator get_playing_board_iterator();
 };
 
 
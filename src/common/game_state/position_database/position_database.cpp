@@ -0,0 +1,175 @@
+#include "position_database.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../position_hash/position_hash.h"
+#include "../../exceptions/gomoku_exception.h"
+
+namespace {
+    void append_varint(std::string& out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    // returns false if the varint does not end before 'end'
+    bool read_varint(const unsigned char*& data, const unsigned char* end, std::uint64_t& value) {
+        value = 0;
+        for (unsigned int shift = 0; data != end && shift < 64; shift += 7) {
+            const unsigned char byte = *data++;
+            value |= std::uint64_t(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // decodes the record after 'data' except for its hash, returns false if the block is corrupt
+    bool read_record(const unsigned char*& data, const unsigned char* end, position_record& record) {
+        if (data == end) {
+            return false;
+        }
+        const unsigned char flags = *data++;
+        record.side_to_move = (flags & 1) != 0 ? field_type::white_stone : field_type::black_stone;
+        record.result = static_cast<position_result>((flags >> 1) & 3);
+        if ((flags & 8) != 0) {
+            record.best_move = search_move::swap(static_cast<swap_decision_type>((flags >> 4) & 7));
+        } else {
+            if (end - data < 2) {
+                return false;
+            }
+            record.best_move = search_move::stone(data[0], data[1]);
+            data += 2;
+        }
+        std::uint64_t plies_to_end;
+        std::uint64_t num_games;
+        if (!read_varint(data, end, plies_to_end) || !read_varint(data, end, num_games)) {
+            return false;
+        }
+        record.plies_to_end = static_cast<std::uint32_t>(plies_to_end);
+        record.num_games = static_cast<std::uint32_t>(num_games);
+        return true;
+    }
+}
+
+
+position_database::position_database(const std::string& path) : _file(path), _header(), _bloom_words(nullptr),
+                                                                 _block_index(nullptr) {
+    if (_file.get_size() < sizeof(_header)) {
+        throw gomoku_exception(path + " is not a position database.");
+    }
+    std::memcpy(&_header, _file.get_data(), sizeof(_header));
+    if (_header.magic != file_magic) {
+        throw gomoku_exception(path + " is not a position database.");
+    }
+    if (_header.version != file_version) {
+        throw gomoku_exception("The position database " + path + " has version " + std::to_string(_header.version)
+                               + ", but version " + std::to_string(file_version) + " is required.");
+    }
+    const std::uint64_t bloom_size = _header.bloom_num_bits / 64 * sizeof(std::uint64_t);
+    const std::uint64_t index_size = std::uint64_t(_header.num_blocks) * sizeof(block_index_entry);
+    if (_header.bloom_num_bits == 0 || _header.bloom_num_bits % 64 != 0
+        || sizeof(_header) + bloom_size + index_size > _file.get_size()) {
+        throw gomoku_exception("The position database " + path + " is truncated.");
+    }
+    // the mapping starts at a page boundary and all sections before the blocks are multiples of 8 bytes
+    _bloom_words = reinterpret_cast<const std::uint64_t*>(_file.get_data() + sizeof(_header));
+    _block_index = reinterpret_cast<const block_index_entry*>(_file.get_data() + sizeof(_header) + bloom_size);
+    for (std::uint32_t block = 0; block < _header.num_blocks; ++block) {
+        if (_block_index[block].offset + _block_index[block].size > _file.get_size()) {
+            throw gomoku_exception("The position database " + path + " is truncated.");
+        }
+    }
+}
+
+
+std::uint64_t position_database::get_bloom_bit(std::uint64_t hash, unsigned int i, std::uint64_t num_bits) {
+    // the second hash has to be odd, so that the probes do not repeat early
+    const std::uint64_t second_hash = ((hash >> 32) | (hash << 32)) * 0x9e3779b97f4a7c15ULL | 1;
+    return (hash + i * second_hash) % num_bits;
+}
+
+bool position_database::may_contain(std::uint64_t canonical_hash) const {
+    for (unsigned int i = 0; i < _header.bloom_num_hashes; ++i) {
+        const std::uint64_t bit = get_bloom_bit(canonical_hash, i, _header.bloom_num_bits);
+        if ((_bloom_words[bit / 64] & (std::uint64_t(1) << (bit % 64))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool position_database::find(std::uint64_t canonical_hash, position_record& record) const {
+    if (_header.num_blocks == 0 || !may_contain(canonical_hash)) {
+        return false;
+    }
+    // the last block that starts at or before the hash
+    const block_index_entry* index_end = _block_index + _header.num_blocks;
+    const block_index_entry* block = std::upper_bound(_block_index, index_end, canonical_hash,
+            [](std::uint64_t hash, const block_index_entry& entry) {
+                return hash < entry.first_hash;
+            });
+    if (block == _block_index) {
+        return false;
+    }
+    --block;
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(_file.get_data()) + block->offset;
+    const unsigned char* end = data + block->size;
+    std::uint64_t hash = block->first_hash;
+    for (std::uint32_t i = 0; i < block->num_records; ++i) {
+        if (i > 0) {
+            std::uint64_t difference;
+            if (!read_varint(data, end, difference)) {
+                return false;
+            }
+            hash += difference;
+        }
+        if (hash > canonical_hash || !read_record(data, end, record)) {
+            return false;
+        }
+        if (hash == canonical_hash) {
+            record.hash = hash;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool position_database::find(const search_position& position, position_record& record) const {
+    const canonical_hash key = position_hash::get_canonical_hash(position);
+    if (!find(key.hash, record)) {
+        return false;
+    }
+    record.best_move = position_hash::inverse_transform(key.symmetry, position.get_board_size(), record.best_move);
+    return true;
+}
+
+std::uint64_t position_database::get_num_records() const {
+    return _header.num_records;
+}
+
+
+void position_database::encode_block(const position_record* records, unsigned int num_records, std::string& out) {
+    for (unsigned int i = 0; i < num_records; ++i) {
+        const position_record& record = records[i];
+        if (i > 0) {
+            append_varint(out, record.hash - records[i - 1].hash);
+        }
+        unsigned char flags = (record.side_to_move == field_type::white_stone ? 1 : 0) | (record.result << 1);
+        if (record.best_move.type == search_move_type::swap_move) {
+            flags |= 8 | (record.best_move.swap_decision << 4);
+            out.push_back(static_cast<char>(flags));
+        } else {
+            out.push_back(static_cast<char>(flags));
+            out.push_back(static_cast<char>(record.best_move.x));
+            out.push_back(static_cast<char>(record.best_move.y));
+        }
+        append_varint(out, record.plies_to_end);
+        append_varint(out, record.num_games);
+    }
+}
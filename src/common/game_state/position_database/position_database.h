@@ -0,0 +1,97 @@
+// The position_database stores positions from game records for training, bot tuning and puzzles: the canonical hash
+// of the position (see position_hash), the colour to move, the best result known for that side, the move that led to
+// it and how many plies later the game ended. The results come from the games the positions were imported from.
+//
+// The database is a single file, sorted by hash (all values little endian):
+//   header: char[4] "GPDB", uint32 version, uint64 number of records, uint32 number of blocks,
+//           uint32 number of bloom filter hashes, uint64 number of bloom filter bits
+//   bloom filter: uint64 words [number of bloom filter bits / 64]
+//   block index [number of blocks]: uint64 first hash, uint64 offset in the file, uint32 size, uint32 number of records
+//   blocks of up to records_per_block records, each record encoded as:
+//     varint hash difference to the previous record (omitted for the first record of a block),
+//     uint8 flags (bit 0: white to move, bits 1-2: result, bit 3: swap move, bits 4-6: swap decision),
+//     uint8 x, uint8 y (stone moves only), varint plies to the end, varint number of games
+// The file is memory-mapped. A query checks the bloom filter, binary searches the block index and decodes the block
+// until it reaches the hash, without any allocation.
+
+#ifndef GOMOKU_POSITION_DATABASE_H
+#define GOMOKU_POSITION_DATABASE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "../search_position/search_position.h"
+#include "../../storage/mapped_file.h"
+
+// result for the side to move
+enum position_result {
+    position_won,
+    position_drawn,
+    position_lost,
+};
+
+struct position_record {
+    std::uint64_t hash;             // canonical hash
+    field_type side_to_move;
+    position_result result;
+    search_move best_move;          // in the canonical orientation, unless returned by position_database::find()
+    std::uint32_t plies_to_end;     // from this position to the end of the game, including 'best_move'
+    std::uint32_t num_games;        // number of imported games with this position
+};
+
+class position_database {
+
+public:
+    static constexpr std::array<char, 4> file_magic = {'G', 'P', 'D', 'B'};
+    static constexpr std::uint32_t file_version = 1;
+    static constexpr unsigned int records_per_block = 128;
+    static constexpr unsigned int bloom_bits_per_record = 10;
+    static constexpr unsigned int bloom_num_hashes = 7;
+
+    struct file_header {
+        std::array<char, 4> magic;
+        std::uint32_t version;
+        std::uint64_t num_records;
+        std::uint32_t num_blocks;
+        std::uint32_t bloom_num_hashes;
+        std::uint64_t bloom_num_bits;
+    };
+
+    struct block_index_entry {
+        std::uint64_t first_hash;
+        std::uint64_t offset;
+        std::uint32_t size;
+        std::uint32_t num_records;
+    };
+
+    // Maps the database at 'path'. Throws a gomoku_exception if the file cannot be opened or is not a database.
+    explicit position_database(const std::string& path);
+
+    // Looks up 'position' and returns its record with the best move in the orientation of 'position'.
+    // Returns false if the position is not in the database.
+    bool find(const search_position& position, position_record& record) const;
+    // looks up a canonical hash, the best move stays in the canonical orientation
+    bool find(std::uint64_t canonical_hash, position_record& record) const;
+    // false if the hash is certainly not in the database, true if it might be
+    bool may_contain(std::uint64_t canonical_hash) const;
+
+    std::uint64_t get_num_records() const;
+
+    // Appends the encoding of 'num_records' sorted records to 'out'. Used by the position_database_builder.
+    static void encode_block(const position_record* records, unsigned int num_records, std::string& out);
+    // the bits of the bloom filter that 'hash' sets, with double hashing
+    static std::uint64_t get_bloom_bit(std::uint64_t hash, unsigned int i, std::uint64_t num_bits);
+
+private:
+    mapped_file _file;
+    file_header _header;
+    const std::uint64_t* _bloom_words;
+    const block_index_entry* _block_index;
+};
+
+static_assert(sizeof(position_database::file_header) == 32 && sizeof(position_database::block_index_entry) == 24,
+              "The layout of the database file must not depend on the compiler.");
+
+
+#endif //GOMOKU_POSITION_DATABASE_H
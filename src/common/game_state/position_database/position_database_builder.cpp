@@ -0,0 +1,134 @@
+#include "position_database_builder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "../position_hash/position_hash.h"
+#include "../../exceptions/gomoku_exception.h"
+
+
+position_database_builder::position_database_builder(unsigned int max_plies_to_end) :
+        _max_plies_to_end(max_plies_to_end)
+{ }
+
+
+bool position_database_builder::is_better(const position_record& a, const position_record& b) {
+    if (a.result != b.result) {
+        return a.result < b.result;
+    }
+    // win fast, lose slowly
+    return a.result == position_result::position_lost ? a.plies_to_end > b.plies_to_end : a.plies_to_end < b.plies_to_end;
+}
+
+void position_database_builder::add_position(const position_record& record) {
+    auto [it, is_new] = _positions.try_emplace(record.hash, record);
+    if (is_new) {
+        return;
+    }
+    const std::uint32_t num_games = it->second.num_games + record.num_games;
+    if (is_better(record, it->second)) {
+        it->second = record;
+    }
+    it->second.num_games = num_games;
+}
+
+bool position_database_builder::add_game(const game_record& record) {
+    search_position position = record.replay();
+    if (!position.is_finished()) {
+        return false;
+    }
+    const int winner_idx = position.is_tied() ? -1 : int(position.get_current_player_idx());
+    const std::size_t num_moves = record.moves.size();
+
+    // walk back from the end, so that the positions close to the end are added first
+    for (std::size_t i = num_moves; i-- > 0;) {
+        const std::uint32_t plies_to_end = num_moves - i;
+        if (_max_plies_to_end != 0 && plies_to_end > _max_plies_to_end) {
+            break;
+        }
+        position.undo_move();
+        const canonical_hash key = position_hash::get_canonical_hash(position);
+        position_record position_entry = {};
+        position_entry.hash = key.hash;
+        position_entry.side_to_move = position.get_current_colour();
+        position_entry.best_move = position_hash::transform(key.symmetry, record.board_size, record.moves[i]);
+        position_entry.plies_to_end = plies_to_end;
+        position_entry.num_games = 1;
+        if (winner_idx < 0) {
+            position_entry.result = position_result::position_drawn;
+        } else {
+            position_entry.result = winner_idx == int(position.get_current_player_idx())
+                    ? position_result::position_won : position_result::position_lost;
+        }
+        add_position(position_entry);
+    }
+    return true;
+}
+
+unsigned int position_database_builder::import_records(std::istream& in) {
+    unsigned int num_games = 0;
+    game_record record;
+    while (game_record::read(in, record)) {
+        if (add_game(record)) {
+            num_games++;
+        }
+    }
+    return num_games;
+}
+
+std::size_t position_database_builder::get_num_positions() const {
+    return _positions.size();
+}
+
+
+void position_database_builder::write(const std::string& path) const {
+    std::vector<position_record> records;
+    records.reserve(_positions.size());
+    for (const auto& [hash, record] : _positions) {
+        records.push_back(record);
+    }
+    std::sort(records.begin(), records.end(), [](const position_record& a, const position_record& b) {
+        return a.hash < b.hash;
+    });
+
+    position_database::file_header header = {};
+    header.magic = position_database::file_magic;
+    header.version = position_database::file_version;
+    header.num_records = records.size();
+    header.num_blocks = (records.size() + position_database::records_per_block - 1) / position_database::records_per_block;
+    header.bloom_num_hashes = position_database::bloom_num_hashes;
+    // at least one word, rounded up to whole words
+    header.bloom_num_bits = (std::max<std::uint64_t>(records.size(), 1) * position_database::bloom_bits_per_record + 63) / 64 * 64;
+
+    std::vector<std::uint64_t> bloom_words(header.bloom_num_bits / 64, 0);
+    for (const position_record& record : records) {
+        for (unsigned int i = 0; i < header.bloom_num_hashes; ++i) {
+            const std::uint64_t bit = position_database::get_bloom_bit(record.hash, i, header.bloom_num_bits);
+            bloom_words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        }
+    }
+
+    std::vector<position_database::block_index_entry> block_index(header.num_blocks);
+    std::string blocks;
+    const std::uint64_t blocks_offset = sizeof(header) + bloom_words.size() * sizeof(std::uint64_t)
+                                        + block_index.size() * sizeof(position_database::block_index_entry);
+    for (std::uint32_t block = 0; block < header.num_blocks; ++block) {
+        const std::size_t first = std::size_t(block) * position_database::records_per_block;
+        const unsigned int num_records = std::min<std::size_t>(position_database::records_per_block, records.size() - first);
+        const std::size_t block_start = blocks.size();
+        position_database::encode_block(&records[first], num_records, blocks);
+        block_index[block] = {records[first].hash, blocks_offset + block_start,
+                              static_cast<std::uint32_t>(blocks.size() - block_start), num_records};
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(bloom_words.data()), std::streamsize(bloom_words.size() * sizeof(std::uint64_t)));
+    file.write(reinterpret_cast<const char*>(block_index.data()),
+               std::streamsize(block_index.size() * sizeof(position_database::block_index_entry)));
+    file.write(blocks.data(), std::streamsize(blocks.size()));
+    if (!file) {
+        throw gomoku_exception("Could not write the position database " + path);
+    }
+}
@@ -0,0 +1,45 @@
+// The position_database_builder collects the positions of game records in memory and writes them as a
+// position_database file. A position that occurs in several games keeps the best result that the side to move
+// reached from it, and the move that led to it.
+
+#ifndef GOMOKU_POSITION_DATABASE_BUILDER_H
+#define GOMOKU_POSITION_DATABASE_BUILDER_H
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+
+#include "position_database.h"
+#include "../game_record/game_record.h"
+
+class position_database_builder {
+
+public:
+    // only positions at most 'max_plies_to_end' plies before the end of the game are added, 0 adds all positions
+    explicit position_database_builder(unsigned int max_plies_to_end);
+
+    // Adds the positions of a finished game. Returns false for games that are not finished, as they have no result.
+    // Throws a gomoku_exception if the record contains an illegal move.
+    bool add_game(const game_record& record);
+    // adds a single position, or merges it into the record of the same position
+    void add_position(const position_record& record);
+    // Adds all game records in 'in' and returns the number of finished games among them.
+    // Throws a gomoku_exception for invalid records.
+    unsigned int import_records(std::istream& in);
+
+    std::size_t get_num_positions() const;
+
+    // Writes the database. Throws a gomoku_exception if the file cannot be written.
+    void write(const std::string& path) const;
+
+private:
+    unsigned int _max_plies_to_end;
+    std::unordered_map<std::uint64_t, position_record> _positions;
+
+    // true if 'a' is a better result for the side to move than 'b'
+    static bool is_better(const position_record& a, const position_record& b);
+};
+
+
+#endif //GOMOKU_POSITION_DATABASE_BUILDER_H
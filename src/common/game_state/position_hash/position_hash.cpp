@@ -0,0 +1,167 @@
+#include "position_hash.h"
+
+#include "../search_position/search_position.h"
+#include "../../exceptions/gomoku_exception.h"
+
+namespace {
+    constexpr unsigned int num_stone_keys = 2 * position_hash::max_board_size * position_hash::max_board_size;
+    constexpr unsigned int num_ruleset_keys = ruleset_type::uninitialized + 1;
+    constexpr unsigned int num_board_size_keys = position_hash::max_board_size + 1;
+    // turn numbers beyond the opening share a key
+    constexpr unsigned int num_turn_number_keys = 16;
+    constexpr unsigned int num_swap_decision_keys = swap_decision_type::no_decision_yet + 1;
+
+    constexpr unsigned int ruleset_keys_offset = num_stone_keys;
+    constexpr unsigned int board_size_keys_offset = ruleset_keys_offset + num_ruleset_keys;
+    constexpr unsigned int turn_number_keys_offset = board_size_keys_offset + num_board_size_keys;
+    constexpr unsigned int swap_decision_keys_offset = turn_number_keys_offset + num_turn_number_keys;
+    constexpr unsigned int white_to_move_key = swap_decision_keys_offset + num_swap_decision_keys;
+    constexpr unsigned int swap_next_turn_key = white_to_move_key + 1;
+    constexpr unsigned int num_keys = swap_next_turn_key + 1;
+
+    // splitmix64, which fills the table with well distributed keys from a single seed
+    constexpr std::array<std::uint64_t, num_keys> generate_keys() {
+        std::array<std::uint64_t, num_keys> keys = {};
+        std::uint64_t state = 0x676f6d6f6b75ULL;
+        for (std::uint64_t& key : keys) {
+            state += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = state;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            key = z ^ (z >> 31);
+        }
+        return keys;
+    }
+
+    constexpr std::array<std::uint64_t, num_keys> keys = generate_keys();
+
+    void transform_coordinates(unsigned int symmetry, unsigned int board_size, unsigned int& x, unsigned int& y) {
+        const unsigned int last = board_size - 1;
+        if (symmetry >= 4) {
+            x = last - x;
+        }
+        for (unsigned int i = 0; i < symmetry % 4; ++i) {
+            unsigned int rotated_x = last - y;
+            y = x;
+            x = rotated_x;
+        }
+    }
+
+    std::vector<position_hash::symmetry_table> create_symmetry_tables() {
+        std::vector<position_hash::symmetry_table> tables;
+        for (unsigned int board_size : playing_board::_supported_board_sizes) {
+            tables.emplace_back(board_size);
+        }
+        return tables;
+    }
+}
+
+
+position_hash::symmetry_table::symmetry_table(unsigned int board_size) : _board_size(board_size) {
+    const unsigned int num_fields = board_size * board_size;
+    for (std::vector<std::uint16_t>& permutation : _permutations) {
+        permutation.resize(num_fields);
+    }
+    _stone_keys.resize(2 * num_fields);
+    for (unsigned int field = 0; field < num_fields; ++field) {
+        for (unsigned int symmetry = 0; symmetry < num_symmetries; ++symmetry) {
+            unsigned int x = field % board_size;
+            unsigned int y = field / board_size;
+            transform_coordinates(symmetry, board_size, x, y);
+            _permutations[symmetry][field] = static_cast<std::uint16_t>(y * board_size + x);
+            _stone_keys[2 * field][symmetry] = get_stone_key(x, y, field_type::black_stone);
+            _stone_keys[2 * field + 1][symmetry] = get_stone_key(x, y, field_type::white_stone);
+        }
+    }
+}
+
+const position_hash::symmetry_table& position_hash::get_symmetry_table(unsigned int board_size) {
+    static const std::vector<symmetry_table> tables = create_symmetry_tables();
+    for (const symmetry_table& table : tables) {
+        if (table.get_board_size() == board_size) {
+            return table;
+        }
+    }
+    throw gomoku_exception("Unsupported board size " + std::to_string(board_size) + ".");
+}
+
+unsigned int position_hash::inverse_symmetry(unsigned int symmetry) {
+    // reflections are their own inverse
+    return symmetry >= 4 ? symmetry : (4 - symmetry) % 4;
+}
+
+
+std::uint64_t position_hash::get_stone_key(unsigned int x, unsigned int y, field_type colour) {
+    unsigned int colour_offset = colour == field_type::black_stone ? 0 : max_board_size * max_board_size;
+    return keys[colour_offset + y * max_board_size + x];
+}
+
+std::uint64_t position_hash::get_turn_key(const search_position& position) {
+    unsigned int turn_number = position.get_turn_number();
+    std::uint64_t key = keys[ruleset_keys_offset + position.get_ruleset()]
+            ^ keys[board_size_keys_offset + position.get_board_size()]
+            ^ keys[turn_number_keys_offset + (turn_number < num_turn_number_keys ? turn_number : num_turn_number_keys - 1)]
+            ^ keys[swap_decision_keys_offset + position.get_swap_decision()];
+    if (position.get_current_colour() == field_type::white_stone) {
+        key ^= keys[white_to_move_key];
+    }
+    if (position.get_swap_next_turn()) {
+        key ^= keys[swap_next_turn_key];
+    }
+    return key;
+}
+
+position_hash::symmetric_hashes position_hash::compute_stone_hashes(const field_type* fields, unsigned int board_size) {
+    const symmetry_table& table = get_symmetry_table(board_size);
+    symmetric_hashes hashes = {};
+    for (unsigned int field = 0; field < board_size * board_size; ++field) {
+        if (fields[field] != field_type::empty) {
+            table.toggle_stone(hashes, field, fields[field]);
+        }
+    }
+    return hashes;
+}
+
+
+std::uint64_t position_hash::get_hash(const search_position& position) {
+    return position.get_stone_hashes()[0] ^ get_turn_key(position);
+}
+
+canonical_hash position_hash::get_canonical_hash(const search_position& position) {
+    return get_canonical_hash(position.get_stone_hashes(), get_turn_key(position));
+}
+
+canonical_hash position_hash::get_canonical_hash(const symmetric_hashes& stone_hashes, std::uint64_t turn_key) {
+    canonical_hash result = {stone_hashes[0] ^ turn_key, 0};
+    for (unsigned int symmetry = 1; symmetry < num_symmetries; ++symmetry) {
+        if ((stone_hashes[symmetry] ^ turn_key) < result.hash) {
+            result = {stone_hashes[symmetry] ^ turn_key, symmetry};
+        }
+    }
+    return result;
+}
+
+
+void position_hash::transform(unsigned int symmetry, unsigned int board_size, unsigned int& x, unsigned int& y) {
+    unsigned int field = get_symmetry_table(board_size).transform(symmetry, y * board_size + x);
+    x = field % board_size;
+    y = field / board_size;
+}
+
+void position_hash::inverse_transform(unsigned int symmetry, unsigned int board_size, unsigned int& x, unsigned int& y) {
+    transform(inverse_symmetry(symmetry), board_size, x, y);
+}
+
+search_move position_hash::transform(unsigned int symmetry, unsigned int board_size, const search_move& move) {
+    if (move.type != search_move_type::stone_move) {
+        return move;
+    }
+    unsigned int x = move.x;
+    unsigned int y = move.y;
+    transform(symmetry, board_size, x, y);
+    return search_move::stone(x, y);
+}
+
+search_move position_hash::inverse_transform(unsigned int symmetry, unsigned int board_size, const search_move& move) {
+    return transform(inverse_symmetry(symmetry), board_size, move);
+}
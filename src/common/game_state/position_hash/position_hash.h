@@ -0,0 +1,92 @@
+// The position_hash computes Zobrist hashes of search_positions: the XOR of a fixed random key for every stone on the
+// board and for the state of the turn (ruleset, board size, turn number, colour to move and swap state). The keys are
+// generated from a fixed seed at compile time, so hashes stay the same across runs and can be stored on disk.
+// The canonical hash is the smallest hash of the 8 rotations and reflections of a position, so that symmetric
+// positions share one entry in opening books and caches.
+// The symmetries are precomputed per board size as permutations of the fields, together with the keys of a stone on
+// each field in all 8 orientations. A search_position keeps the hashes of its stones in all orientations up to date
+// with 8 XORs per move, so its canonical hash is found without looking at the board.
+
+#ifndef GOMOKU_POSITION_HASH_H
+#define GOMOKU_POSITION_HASH_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../playing_board/playing_board.h"
+
+class search_position;
+struct search_move;
+
+struct canonical_hash {
+    std::uint64_t hash;
+    // the symmetry that maps the position to its canonical orientation
+    unsigned int symmetry;
+};
+
+class position_hash {
+
+public:
+    static constexpr unsigned int num_symmetries = 8;
+    // the largest supported board size, stone keys are indexed by y * max_board_size + x for all board sizes
+    static constexpr unsigned int max_board_size = 31;
+
+    // hashes of the stones of a position in all 8 orientations
+    using symmetric_hashes = std::array<std::uint64_t, num_symmetries>;
+
+    // The symmetries of one board size. Symmetry s (0 - 7) first mirrors the board along the vertical axis if s >= 4
+    // and then rotates it clockwise by (s % 4) * 90 degrees. Fields are indexed by y * board_size + x.
+    class symmetry_table {
+
+    public:
+        explicit symmetry_table(unsigned int board_size);
+
+        unsigned int get_board_size() const {
+            return _board_size;
+        }
+
+        // the field that 'field' is moved to by 'symmetry'
+        unsigned int transform(unsigned int symmetry, unsigned int field) const {
+            return _permutations[symmetry][field];
+        }
+
+        // adds a stone to the hashes of all orientations, or removes it again
+        void toggle_stone(symmetric_hashes& hashes, unsigned int field, field_type colour) const {
+            const symmetric_hashes& keys = _stone_keys[2 * field + (colour == field_type::white_stone ? 1 : 0)];
+            for (unsigned int symmetry = 0; symmetry < num_symmetries; ++symmetry) {
+                hashes[symmetry] ^= keys[symmetry];
+            }
+        }
+
+    private:
+        unsigned int _board_size;
+        std::array<std::vector<std::uint16_t>, num_symmetries> _permutations;
+        // by 2 * field + colour (black, white)
+        std::vector<symmetric_hashes> _stone_keys;
+    };
+
+    // The table of a supported board size, which is built on first use. Throws a gomoku_exception for other sizes.
+    static const symmetry_table& get_symmetry_table(unsigned int board_size);
+    // the symmetry that undoes 'symmetry'
+    static unsigned int inverse_symmetry(unsigned int symmetry);
+
+    static std::uint64_t get_stone_key(unsigned int x, unsigned int y, field_type colour);
+    // key of everything but the stones, which is the same in all orientations
+    static std::uint64_t get_turn_key(const search_position& position);
+    // the hashes of the stones on 'fields' in all orientations, computed from scratch
+    static symmetric_hashes compute_stone_hashes(const field_type* fields, unsigned int board_size);
+
+    static std::uint64_t get_hash(const search_position& position);
+    static canonical_hash get_canonical_hash(const search_position& position);
+    static canonical_hash get_canonical_hash(const symmetric_hashes& stone_hashes, std::uint64_t turn_key);
+
+    static void transform(unsigned int symmetry, unsigned int board_size, unsigned int& x, unsigned int& y);
+    static void inverse_transform(unsigned int symmetry, unsigned int board_size, unsigned int& x, unsigned int& y);
+    // swap decisions are not changed by symmetries
+    static search_move transform(unsigned int symmetry, unsigned int board_size, const search_move& move);
+    static search_move inverse_transform(unsigned int symmetry, unsigned int board_size, const search_move& move);
+};
+
+
+#endif //GOMOKU_POSITION_HASH_H
@@ -0,0 +1,244 @@
+#include "renju_rules.h"
+
+#include <array>
+#include <cstdint>
+
+const std::unordered_map<forbidden_move_type, std::string> renju_rules::_forbidden_move_type_to_string = {
+        {forbidden_move_type::allowed_move, "allowed move"},
+        {forbidden_move_type::forbidden_overline, "overline"},
+        {forbidden_move_type::forbidden_double_four, "double-four"},
+        {forbidden_move_type::forbidden_double_three, "double-three"},
+};
+
+namespace {
+
+    // A line window contains the move at its centre and 5 fields on either side
+    constexpr int window_radius = 5;
+    constexpr int window_size = 2 * window_radius + 1;
+    constexpr int centre = window_radius;
+
+    // field states inside a line window. Fields outside the board and white stones both block black.
+    constexpr std::uint8_t cell_empty = 0;
+    constexpr std::uint8_t cell_black = 1;
+    constexpr std::uint8_t cell_blocked = 2;
+
+    // the centre of a window always holds the black move, so only the other 10 fields are part of the table index
+    constexpr unsigned int num_windows = 59049; // 3^10
+
+    struct line_entry {
+        bool five;                  // the centre stone is part of exactly five black stones
+        bool overline;              // the centre stone is part of six or more black stones
+        std::uint8_t num_fours;     // number of fours through the centre stone (a straight four counts once)
+        std::uint16_t three_points; // bit i is set if black on window field i makes a straight four with the centre
+    };
+
+    // number of consecutive black stones through the centre of 'window'
+    unsigned int run_through_centre(const std::array<std::uint8_t, window_size>& window) {
+        unsigned int length = 1;
+        for (int i = centre - 1; i >= 0 && window[i] == cell_black; --i) {
+            ++length;
+        }
+        for (int i = centre + 1; i < window_size && window[i] == cell_black; ++i) {
+            ++length;
+        }
+        return length;
+    }
+
+    // Collects the empty window fields on which black completes exactly five stones together with the centre.
+    // Such a five lies within 4 fields of the centre, the outermost window fields are only needed to tell a five
+    // from an overline.
+    unsigned int five_completions(std::array<std::uint8_t, window_size>& window, std::array<int, 2>& completions) {
+        unsigned int num_completions = 0;
+        for (int i = centre - 4; i <= centre + 4; ++i) {
+            if (window[i] != cell_empty) {
+                continue;
+            }
+            window[i] = cell_black;
+            if (run_through_centre(window) == 5) {
+                if (num_completions < completions.size()) {
+                    completions[num_completions] = i;
+                }
+                ++num_completions;
+            }
+            window[i] = cell_empty;
+        }
+        return num_completions;
+    }
+
+    bool is_straight_four(unsigned int num_completions, const std::array<int, 2>& completions) {
+        return num_completions == 2 && completions[1] - completions[0] == 5;
+    }
+
+    line_entry classify_window(std::array<std::uint8_t, window_size>& window) {
+        line_entry entry = {false, false, 0, 0};
+        unsigned int run = run_through_centre(window);
+        if (run == 5) {
+            entry.five = true;
+            return entry;
+        }
+        if (run > 5) {
+            entry.overline = true;
+            return entry;
+        }
+
+        std::array<int, 2> completions = {0, 0};
+        unsigned int num_completions = five_completions(window, completions);
+        if (is_straight_four(num_completions, completions)) {
+            entry.num_fours = 1;
+        } else {
+            entry.num_fours = static_cast<std::uint8_t>(num_completions < 2 ? num_completions : 2);
+        }
+
+        // a straight four through the centre consists of the centre and 3 more stones within 3 fields of it
+        for (int i = centre - 3; i <= centre + 3; ++i) {
+            if (window[i] != cell_empty) {
+                continue;
+            }
+            window[i] = cell_black;
+            if (run_through_centre(window) < 5) {
+                std::array<int, 2> four_completions = {0, 0};
+                if (is_straight_four(five_completions(window, four_completions), four_completions)) {
+                    entry.three_points |= static_cast<std::uint16_t>(1u << i);
+                }
+            }
+            window[i] = cell_empty;
+        }
+        return entry;
+    }
+
+    // builds the classification of every possible line window, indexed by the base-3 digits of the non-centre fields
+    std::vector<line_entry> build_line_table() {
+        std::vector<line_entry> table(num_windows);
+        std::array<std::uint8_t, window_size> window{};
+        for (unsigned int idx = 0; idx < num_windows; ++idx) {
+            unsigned int remainder = idx;
+            for (int i = 0; i < window_size; ++i) {
+                if (i == centre) {
+                    window[i] = cell_black;
+                } else {
+                    window[i] = static_cast<std::uint8_t>(remainder % 3);
+                    remainder /= 3;
+                }
+            }
+            table[idx] = classify_window(window);
+        }
+        return table;
+    }
+
+    const std::vector<line_entry>& line_table() {
+        static const std::vector<line_entry> table = build_line_table();
+        return table;
+    }
+
+    // the four line directions: horizontal, vertical and both diagonals
+    constexpr std::array<int, 4> line_direction_x = {1, 0, 1, 1};
+    constexpr std::array<int, 4> line_direction_y = {0, 1, 1, -1};
+
+    unsigned int window_index(const field_type* fields, int board_size, int x, int y, unsigned int direction) {
+        unsigned int idx = 0;
+        unsigned int digit = 1;
+        for (int offset = -window_radius; offset <= window_radius; ++offset) {
+            if (offset == 0) {
+                continue;
+            }
+            int cell_x = x + offset * line_direction_x[direction];
+            int cell_y = y + offset * line_direction_y[direction];
+            std::uint8_t cell = cell_blocked;
+            if (cell_x >= 0 && cell_x < board_size && cell_y >= 0 && cell_y < board_size) {
+                field_type field = fields[cell_y * board_size + cell_x];
+                cell = field == field_type::empty ? cell_empty : (field == field_type::black_stone ? cell_black : cell_blocked);
+            }
+            idx += cell * digit;
+            digit *= 3;
+        }
+        return idx;
+    }
+
+    forbidden_move_type check_black_move_recursive(field_type* fields, int board_size, int x, int y, unsigned int depth) {
+        const int field_idx = y * board_size + x;
+        if (fields[field_idx] != field_type::empty) {
+            return forbidden_move_type::allowed_move;
+        }
+
+        const std::vector<line_entry>& table = line_table();
+        std::array<line_entry, 4> lines;
+        fields[field_idx] = field_type::black_stone;
+        for (unsigned int direction = 0; direction < 4; ++direction) {
+            lines[direction] = table[window_index(fields, board_size, x, y, direction)];
+        }
+
+        forbidden_move_type result = forbidden_move_type::allowed_move;
+        bool five = false;
+        bool overline = false;
+        unsigned int num_fours = 0;
+        for (const line_entry& line : lines) {
+            five = five || line.five;
+            overline = overline || line.overline;
+            num_fours += line.num_fours;
+        }
+
+        // completing exactly five wins, even if the move would otherwise be forbidden
+        if (!five) {
+            if (overline) {
+                result = forbidden_move_type::forbidden_overline;
+            } else if (num_fours >= 2) {
+                result = forbidden_move_type::forbidden_double_four;
+            } else {
+                unsigned int num_threes = 0;
+                for (unsigned int direction = 0; direction < 4 && num_threes < 2; ++direction) {
+                    const line_entry& line = lines[direction];
+                    if (line.num_fours > 0 || line.three_points == 0) {
+                        continue;
+                    }
+                    // the three is real if at least one of its straight four completions is allowed itself
+                    for (int i = 0; i < window_size; ++i) {
+                        if ((line.three_points & (1u << i)) == 0) {
+                            continue;
+                        }
+                        int three_x = x + (i - centre) * line_direction_x[direction];
+                        int three_y = y + (i - centre) * line_direction_y[direction];
+                        if (depth >= renju_rules::MAX_THREE_CHECK_DEPTH ||
+                            check_black_move_recursive(fields, board_size, three_x, three_y, depth + 1) == forbidden_move_type::allowed_move) {
+                            ++num_threes;
+                            break;
+                        }
+                    }
+                }
+                if (num_threes >= 2) {
+                    result = forbidden_move_type::forbidden_double_three;
+                }
+            }
+        }
+
+        fields[field_idx] = field_type::empty;
+        return result;
+    }
+}
+
+
+forbidden_move_type renju_rules::check_black_move(field_type* fields, unsigned int board_size, unsigned int x, unsigned int y) {
+    if (x >= board_size || y >= board_size) {
+        return forbidden_move_type::allowed_move;
+    }
+    return check_black_move_recursive(fields, int(board_size), int(x), int(y), 0);
+}
+
+forbidden_move_type renju_rules::check_black_move(const playing_board& board, unsigned int x, unsigned int y) {
+    unsigned int board_size = board.get_board_size();
+    std::vector<field_type> fields(board.get_fields(), board.get_fields() + board_size * board_size);
+    return check_black_move(fields.data(), board_size, x, y);
+}
+
+std::vector<std::pair<unsigned int, unsigned int>> renju_rules::get_forbidden_fields(const playing_board& board) {
+    std::vector<std::pair<unsigned int, unsigned int>> forbidden_fields;
+    unsigned int board_size = board.get_board_size();
+    std::vector<field_type> fields(board.get_fields(), board.get_fields() + board_size * board_size);
+    for (unsigned int y = 0; y < board_size; ++y) {
+        for (unsigned int x = 0; x < board_size; ++x) {
+            if (check_black_move(fields.data(), board_size, x, y) != forbidden_move_type::allowed_move) {
+                forbidden_fields.emplace_back(x, y);
+            }
+        }
+    }
+    return forbidden_fields;
+}
@@ -0,0 +1,45 @@
+// The renju_rules class detects forbidden moves for black under the Renju ruleset: overlines (six or more stones),
+// double-fours and double-threes. Each of the four lines through a move is classified with a precomputed table
+// indexed by the contents of the 11 fields around the move. Whether a three is "real" (i.e. can be turned into a
+// straight four by a move that is not forbidden itself) is resolved by checking the completing moves recursively.
+
+#ifndef GOMOKU_RENJU_RULES_H
+#define GOMOKU_RENJU_RULES_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+
+#include "../playing_board/playing_board.h"
+
+enum forbidden_move_type {
+    allowed_move,
+    forbidden_overline,
+    forbidden_double_four,
+    forbidden_double_three,
+};
+
+class renju_rules {
+
+public:
+    // maximal depth of the recursive checks whether a three can become a straight four
+    static constexpr unsigned int MAX_THREE_CHECK_DEPTH = 4;
+
+    // Classifies a black stone at (x, y). Occupied fields and fields outside the board are reported as allowed_move,
+    // as they are rejected by the playing board itself.
+    static forbidden_move_type check_black_move(const playing_board& board, unsigned int x, unsigned int y);
+
+    // Same as above, but works directly on the row-major 'fields' of a board of size 'board_size'.
+    // 'fields' is temporarily modified during the check and restored before returning.
+    static forbidden_move_type check_black_move(field_type* fields, unsigned int board_size, unsigned int x, unsigned int y);
+
+    // returns the (x, y) coordinates of all empty fields on which black is not allowed to play
+    static std::vector<std::pair<unsigned int, unsigned int>> get_forbidden_fields(const playing_board& board);
+
+    // for error messages
+    static const std::unordered_map<forbidden_move_type, std::string> _forbidden_move_type_to_string;
+};
+
+
+#endif //GOMOKU_RENJU_RULES_H
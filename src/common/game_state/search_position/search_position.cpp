@@ -0,0 +1,410 @@
+#include "search_position.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../../exceptions/gomoku_exception.h"
+#include "../playing_board/board_geometry.h"
+#include "../renju_rules/renju_rules.h"
+
+namespace {
+
+// the last turn with a special rule of the opening (a deferred swap under swap2)
+constexpr int last_opening_turn = 6;
+
+}
+
+search_move search_move::stone(unsigned int x, unsigned int y) {
+    return {search_move_type::stone_move, static_cast<std::uint8_t>(x), static_cast<std::uint8_t>(y),
+            swap_decision_type::no_decision_yet};
+}
+
+search_move search_move::swap(swap_decision_type swap_decision) {
+    return {search_move_type::swap_move, 0, 0, swap_decision};
+}
+
+bool search_move::operator==(const search_move& other) const {
+    return type == other.type && x == other.x && y == other.y && swap_decision == other.swap_decision;
+}
+
+
+search_position::search_position(const game_state& state) {
+    const std::vector<player*>& players = state.get_players();
+    if (players.size() != 2) {
+        throw gomoku_exception("A search position can only be created for a game with two players.");
+    }
+    _board_size = state.get_board_size();
+    _ruleset = state.get_opening_rules();
+    _fields.reserve(_board_size * _board_size);
+    for (const std::vector<field_type>& row : state.get_playing_board()) {
+        _fields.insert(_fields.end(), row.begin(), row.end());
+    }
+    _num_empty_fields = std::count(_fields.begin(), _fields.end(), field_type::empty);
+    _turn_number = state.get_turn_number();
+    _turn.current_player_idx = static_cast<std::uint8_t>(state.get_current_player_idx());
+    _turn.player_colours = {players[0]->get_colour(), players[1]->get_colour()};
+    _turn.swap_next_turn = state.get_swap_next_turn();
+    _turn.swap_decision = state.get_swap_decision();
+    _is_finished = state.is_finished();
+    _is_tied = state.is_tied();
+    _symmetry_table = &position_hash::get_symmetry_table(_board_size);
+    _stone_hashes = position_hash::compute_stone_hashes(_fields.data(), _board_size);
+    // every stone and at most two swap decisions can be taken back
+    _history.reserve(_num_empty_fields + 2);
+}
+
+search_position::search_position(ruleset_type ruleset, unsigned int board_size) {
+    if (!playing_board::is_supported_board_size(board_size)) {
+        throw gomoku_exception("Unsupported board size " + std::to_string(board_size) + ".");
+    }
+    _board_size = board_size;
+    _ruleset = ruleset;
+    _fields.assign(_board_size * _board_size, field_type::empty);
+    _num_empty_fields = _fields.size();
+    // same as game_state::setup_round with player 0 as the starting player
+    _turn_number = 0;
+    _turn.current_player_idx = 0;
+    _turn.player_colours = {player_colour_type::black, player_colour_type::white};
+    _turn.swap_next_turn = false;
+    _turn.swap_decision = swap_decision_type::no_decision_yet;
+    _is_finished = false;
+    _is_tied = false;
+    _symmetry_table = &position_hash::get_symmetry_table(_board_size);
+    _stone_hashes = {};
+    _history.reserve(_num_empty_fields + 2);
+}
+
+search_position::search_position(ruleset_type ruleset, unsigned int board_size, const std::vector<field_type>& fields,
+                                 player_colour_type colour_to_move) :
+        search_position(ruleset, board_size)
+{
+    if (fields.size() != _fields.size()) {
+        throw gomoku_exception("A board of size " + std::to_string(board_size) + " needs "
+                               + std::to_string(_fields.size()) + " fields.");
+    }
+    _fields = fields;
+    _num_empty_fields = std::count(_fields.begin(), _fields.end(), field_type::empty);
+    _turn_number = std::max<int>(get_num_stones(), last_opening_turn + 1);
+    _turn.current_player_idx = colour_to_move == player_colour_type::black ? 0 : 1;
+    _turn.swap_decision = swap_decision_type::do_not_swap;
+    _is_tied = _num_empty_fields == 0;
+    _is_finished = _is_tied;
+    _stone_hashes = position_hash::compute_stone_hashes(_fields.data(), _board_size);
+
+    // a board with a five is finished like after the winning move, with the winner as the current player
+    for (unsigned int y = 0; y < _board_size; ++y) {
+        for (unsigned int x = 0; x < _board_size; ++x) {
+            const field_type colour = _fields[y * _board_size + x];
+            if (colour != field_type::empty && is_winning_stone(x, y, colour)) {
+                _turn.current_player_idx = colour == field_type::black_stone ? 0 : 1;
+                _is_finished = true;
+                _is_tied = false;
+                return;
+            }
+        }
+    }
+}
+
+search_position::search_position(const search_position& other) {
+    *this = other;
+}
+
+search_position& search_position::operator=(const search_position& other) {
+    _board_size = other._board_size;
+    _ruleset = other._ruleset;
+    _fields = other._fields;
+    _num_empty_fields = other._num_empty_fields;
+    _turn_number = other._turn_number;
+    _turn = other._turn;
+    _is_finished = other._is_finished;
+    _is_tied = other._is_tied;
+    _symmetry_table = other._symmetry_table;
+    _stone_hashes = other._stone_hashes;
+    _history = other._history;
+    // every remaining stone and at most two swap decisions
+    _history.reserve(_history.size() + _num_empty_fields + 2);
+    return *this;
+}
+
+// same as game_state::check_win_condition
+bool search_position::is_winning_stone(unsigned int x, unsigned int y, field_type colour) const {
+    const field_type* fields = _fields.data();
+    const bool exact_five_only = _ruleset == ruleset_type::renju && colour == field_type::black_stone;
+    return with_board_geometry(_board_size, [&](auto geometry) {
+        if (exact_five_only) {
+            return decltype(geometry)::has_exact_five(fields, x, y, colour);
+        }
+        return decltype(geometry)::longest_line(fields, x, y, colour) >= 5;
+    });
+}
+
+bool search_position::determine_swap_decision(swap_decision_type swap_decision, turn_state& turn) {
+    if (swap_decision != do_swap && swap_decision != do_not_swap && swap_decision != defer_swap) {
+        return false;
+    }
+    if (turn.swap_decision == defer_swap && swap_decision == do_swap) {
+        turn.swap_decision = deferred_do_swap;
+    } else if (turn.swap_decision == defer_swap && swap_decision == do_not_swap) {
+        turn.swap_decision = deferred_do_not_swap;
+    } else {
+        turn.swap_decision = swap_decision;
+    }
+    return true;
+}
+
+bool search_position::update_current_player(ruleset_type ruleset, int turn_number, turn_state& turn) {
+    auto alternate = [&turn]() {
+        turn.current_player_idx = turn.current_player_idx == 0 ? 1 : 0;
+    };
+    auto change_colour = [&turn]() {
+        player_colour_type& colour = turn.player_colours[turn.current_player_idx];
+        colour = colour == player_colour_type::black ? player_colour_type::white : player_colour_type::black;
+    };
+    auto execute_swap = [&]() {
+        std::swap(turn.player_colours[0], turn.player_colours[1]);
+        turn.swap_next_turn = false;
+        alternate();
+    };
+
+    switch (ruleset) {
+        case freestyle:
+        case renju:
+            alternate();
+            return true;
+        case swap_after_first_move:
+            if (turn_number == 0) {
+                turn.swap_next_turn = true;
+                alternate();
+                return true;
+            }
+            if (turn_number == 1) {
+                if (turn.swap_decision == do_swap) {
+                    execute_swap();
+                    return true;
+                }
+                if (turn.swap_decision == do_not_swap) {
+                    turn.swap_next_turn = false;
+                    return true;
+                }
+                return false;
+            }
+            alternate();
+            return true;
+        case swap2:
+            switch (turn_number) {
+                case 0:
+                    return true;
+                case 1:
+                    change_colour();
+                    return true;
+                case 2:
+                    change_colour();
+                    turn.swap_next_turn = true;
+                    alternate();
+                    return true;
+                case 3:
+                    if (turn.swap_decision == do_swap) {
+                        execute_swap();
+                        return true;
+                    }
+                    if (turn.swap_decision == do_not_swap || turn.swap_decision == defer_swap) {
+                        turn.swap_next_turn = false;
+                        return true;
+                    }
+                    return false;
+                default:
+                    break;
+            }
+            if (turn.swap_decision == do_swap || turn.swap_decision == do_not_swap) {
+                alternate();
+                return true;
+            }
+            if (turn.swap_decision != defer_swap && turn.swap_decision != deferred_do_swap
+                && turn.swap_decision != deferred_do_not_swap) {
+                return false;
+            }
+            // the swap was deferred: the second player places two more stones before the first player decides
+            switch (turn_number) {
+                case 4:
+                    change_colour();
+                    return true;
+                case 5:
+                    change_colour();
+                    turn.swap_next_turn = true;
+                    alternate();
+                    return true;
+                case 6:
+                    if (turn.swap_decision == deferred_do_swap) {
+                        execute_swap();
+                    } else if (turn.swap_decision == deferred_do_not_swap) {
+                        turn.swap_next_turn = false;
+                    } else {
+                        return false;
+                    }
+                    // the player with the white stones continues, as in game_state
+                    alternate();
+                    return true;
+                default:
+                    alternate();
+                    return true;
+            }
+        default:
+            return false;
+    }
+}
+
+bool search_position::is_legal(const search_move& move) const {
+    if (_is_finished) {
+        return false;
+    }
+    if (move.type == search_move_type::swap_move) {
+        if (!_turn.swap_next_turn) {
+            return false;
+        }
+        turn_state turn = _turn;
+        return determine_swap_decision(move.swap_decision, turn) && update_current_player(_ruleset, _turn_number, turn);
+    }
+    if (_turn.swap_next_turn || move.x >= _board_size || move.y >= _board_size
+        || _fields[move.y * _board_size + move.x] != field_type::empty) {
+        return false;
+    }
+    if (_ruleset == ruleset_type::renju && get_current_colour() == field_type::black_stone) {
+        // the check restores the fields before returning
+        field_type* fields = const_cast<field_type*>(_fields.data());
+        return renju_rules::check_black_move(fields, _board_size, move.x, move.y) == forbidden_move_type::allowed_move;
+    }
+    return true;
+}
+
+bool search_position::apply_move(const search_move& move) {
+    if (!is_legal(move)) {
+        return false;
+    }
+    _history.push_back({move, _turn});
+
+    if (move.type == search_move_type::swap_move) {
+        determine_swap_decision(move.swap_decision, _turn);
+        update_current_player(_ruleset, _turn_number, _turn);
+        ++_turn_number;
+        return true;
+    }
+
+    const field_type colour = get_current_colour();
+    const unsigned int field = move.y * _board_size + move.x;
+    _fields[field] = colour;
+    _symmetry_table->toggle_stone(_stone_hashes, field, colour);
+    --_num_empty_fields;
+    if (is_winning_stone(move.x, move.y, colour)) {
+        _is_finished = true;
+    } else if (_num_empty_fields == 0) {
+        _is_finished = true;
+        _is_tied = true;
+    } else {
+        update_current_player(_ruleset, _turn_number, _turn);
+        ++_turn_number;
+    }
+    return true;
+}
+
+bool search_position::undo_move() {
+    if (_history.empty()) {
+        return false;
+    }
+    const undo_record& record = _history.back();
+    // the turn counter is not advanced by a move that ends the game
+    if (_is_finished) {
+        _is_finished = false;
+        _is_tied = false;
+    } else {
+        --_turn_number;
+    }
+    if (record.move.type == search_move_type::stone_move) {
+        const unsigned int field = record.move.y * _board_size + record.move.x;
+        _symmetry_table->toggle_stone(_stone_hashes, field, _fields[field]);
+        _fields[field] = field_type::empty;
+        ++_num_empty_fields;
+    }
+    _turn = record.turn;
+    _history.pop_back();
+    return true;
+}
+
+field_type search_position::get_field(unsigned int x, unsigned int y) const {
+    if (x >= _board_size || y >= _board_size) {
+        throw gomoku_exception("Field coordinates are outside of board dimensions.");
+    }
+    return _fields[y * _board_size + x];
+}
+
+const field_type* search_position::get_fields() const {
+    return _fields.data();
+}
+
+unsigned int search_position::get_board_size() const {
+    return _board_size;
+}
+
+unsigned int search_position::get_num_stones() const {
+    return _board_size * _board_size - _num_empty_fields;
+}
+
+ruleset_type search_position::get_ruleset() const {
+    return _ruleset;
+}
+
+int search_position::get_turn_number() const {
+    return _turn_number;
+}
+
+unsigned int search_position::get_current_player_idx() const {
+    return _turn.current_player_idx;
+}
+
+player_colour_type search_position::get_player_colour(unsigned int player_idx) const {
+    return _turn.player_colours.at(player_idx);
+}
+
+field_type search_position::get_current_colour() const {
+    return _turn.player_colours[_turn.current_player_idx] == player_colour_type::black ? field_type::black_stone
+                                                                                        : field_type::white_stone;
+}
+
+bool search_position::get_swap_next_turn() const {
+    return _turn.swap_next_turn;
+}
+
+swap_decision_type search_position::get_swap_decision() const {
+    return _turn.swap_decision;
+}
+
+bool search_position::is_finished() const {
+    return _is_finished;
+}
+
+bool search_position::is_tied() const {
+    return _is_tied;
+}
+
+unsigned int search_position::get_num_moves() const {
+    return _history.size();
+}
+
+const search_move& search_position::get_last_move() const {
+    if (_history.empty()) {
+        throw gomoku_exception("No move has been applied to the search position.");
+    }
+    return _history.back().move;
+}
+
+const position_hash::symmetric_hashes& search_position::get_stone_hashes() const {
+    return _stone_hashes;
+}
+
+std::vector<search_move> search_position::get_moves() const {
+    std::vector<search_move> moves;
+    moves.reserve(_history.size());
+    for (const undo_record& record : _history) {
+        moves.push_back(record.move);
+    }
+    return moves;
+}
@@ -0,0 +1,125 @@
+// The search_position is a lightweight copy of a game_state for search engines and replay tools. Moves are applied
+// with apply_move() and taken back with undo_move(). It covers the stones on the board, the turn counter, the current
+// player, the player colours and the swap state of the opening rules, and follows the same rules as the server-side
+// game_state functions. The Zobrist hashes of the stones in all orientations are updated with every move (see
+// position_hash). All memory is allocated on construction, so applying and undoing moves never allocates.
+// Illegal moves are rejected with a return value of false instead of an error message.
+
+#ifndef GOMOKU_SEARCH_POSITION_H
+#define GOMOKU_SEARCH_POSITION_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../game_state.h"
+#include "../position_hash/position_hash.h"
+
+enum search_move_type {
+    stone_move,
+    swap_move,
+};
+
+struct search_move {
+    search_move_type type;
+    std::uint8_t x;
+    std::uint8_t y;
+    swap_decision_type swap_decision;
+
+    static search_move stone(unsigned int x, unsigned int y);
+    static search_move swap(swap_decision_type swap_decision);
+
+    bool operator==(const search_move& other) const;
+};
+
+class search_position {
+
+private:
+    // the part of the state that is changed by the opening rules
+    struct turn_state {
+        std::uint8_t current_player_idx;
+        std::array<player_colour_type, 2> player_colours;
+        bool swap_next_turn;
+        swap_decision_type swap_decision;
+    };
+
+    // state before a move, to restore it in undo_move()
+    struct undo_record {
+        search_move move;
+        turn_state turn;
+    };
+
+    unsigned int _board_size;
+    ruleset_type _ruleset;
+    // fields in row-major order, like in playing_board
+    std::vector<field_type> _fields;
+    unsigned int _num_empty_fields;
+    int _turn_number;
+    turn_state _turn;
+    bool _is_finished;
+    bool _is_tied;
+    const position_hash::symmetry_table* _symmetry_table;
+    // updated with every stone, see position_hash
+    position_hash::symmetric_hashes _stone_hashes;
+    // reserved for the longest possible game on construction
+    std::vector<undo_record> _history;
+
+    bool is_winning_stone(unsigned int x, unsigned int y, field_type colour) const;
+    // same as game_state::update_current_player, applied to 'turn'
+    static bool update_current_player(ruleset_type ruleset, int turn_number, turn_state& turn);
+    // same as game_state::determine_swap_decision, applied to 'turn'
+    static bool determine_swap_decision(swap_decision_type swap_decision, turn_state& turn);
+
+public:
+    // Copies the position of a game with two players. Throws a gomoku_exception for games without two players.
+    explicit search_position(const game_state& state);
+    // The start of a new game on an empty board, where player 0 begins with black.
+    // Throws a gomoku_exception for unsupported board sizes.
+    search_position(ruleset_type ruleset, unsigned int board_size);
+    // A board without its history, e.g. for analysis: player 0 plays black, and the opening of the ruleset is over,
+    // so that the players alternate. 'fields' are in row-major order. A board that is full or contains a five is
+    // finished. Throws a gomoku_exception for unsupported board sizes or a wrong number of fields.
+    search_position(ruleset_type ruleset, unsigned int board_size, const std::vector<field_type>& fields,
+                    player_colour_type colour_to_move);
+    // Copies reserve the history for the rest of the game again, as a copied vector only gets the capacity of its
+    // size. The search engines copy positions for every thread and time slice.
+    search_position(const search_position& other);
+    search_position& operator=(const search_position& other);
+    search_position(search_position&& other) = default;
+    search_position& operator=(search_position&& other) = default;
+
+    // returns true if 'move' is allowed in the current position. Placing a stone requires no pending swap decision,
+    // swap decisions are only accepted when one is pending. Under the renju ruleset, forbidden moves are rejected.
+    bool is_legal(const search_move& move) const;
+
+    // applies 'move' for the current player and returns true, or returns false for illegal moves
+    bool apply_move(const search_move& move);
+    // takes back the last applied move, returns false if there is none
+    bool undo_move();
+
+// accessors
+    field_type get_field(unsigned int x, unsigned int y) const;
+    const field_type* get_fields() const;
+    unsigned int get_board_size() const;
+    unsigned int get_num_stones() const;
+    ruleset_type get_ruleset() const;
+    int get_turn_number() const;
+    unsigned int get_current_player_idx() const;
+    player_colour_type get_player_colour(unsigned int player_idx) const;
+    // colour of the stones the current player places
+    field_type get_current_colour() const;
+    bool get_swap_next_turn() const;
+    swap_decision_type get_swap_decision() const;
+    // a finished game that is not tied was won by the current player
+    bool is_finished() const;
+    bool is_tied() const;
+    unsigned int get_num_moves() const;
+    const search_move& get_last_move() const;
+    // the hashes of the stones in all 8 orientations of the board
+    const position_hash::symmetric_hashes& get_stone_hashes() const;
+    // all applied moves, oldest first
+    std::vector<search_move> get_moves() const;
+};
+
+
+#endif //GOMOKU_SEARCH_POSITION_H
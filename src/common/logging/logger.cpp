@@ -0,0 +1,224 @@
+// The logger writes structured log records (an event name and key=value fields) without blocking the calling thread.
+// Records are pushed into a lock-free ring buffer, and a background thread writes them out in batches.
+
+#include "logger.h"
+
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+const std::array<const char*, log_level::off_level> level_names = {"trace", "debug", "info", "warning", "error"};
+
+// values with spaces, quotes or '=' are quoted, so that every record stays on one parsable line
+void append_value(std::string& out, const std::string& value) {
+    bool needs_quotes = value.empty();
+    for (char c : value) {
+        if (c == ' ' || c == '"' || c == '=' || c == '\n' || c == '\r' || c == '\t' || c == '\\') {
+            needs_quotes = true;
+            break;
+        }
+    }
+    if (!needs_quotes) {
+        out += value;
+        return;
+    }
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:   out += c;
+        }
+    }
+    out += '"';
+}
+
+}
+
+
+void logger::set_level(log_level level) {
+    _level.store(level, std::memory_order_relaxed);
+}
+
+log_level logger::get_level() {
+    return _level.load(std::memory_order_relaxed);
+}
+
+void logger::set_sample_rate(log_level level, unsigned int rate) {
+    if (level < log_level::off_level) {
+        _sample_rates[level].store(rate == 0 ? 1 : rate, std::memory_order_relaxed);
+    }
+}
+
+void logger::set_output(std::FILE* output) {
+    _output.store(output, std::memory_order_relaxed);
+}
+
+bool logger::parse_level(const std::string& name, log_level& level) {
+    static const std::unordered_map<std::string, log_level> string_to_level = {
+            {"trace",   log_level::trace_level},
+            {"debug",   log_level::debug_level},
+            {"info",    log_level::info_level},
+            {"warning", log_level::warning_level},
+            {"error",   log_level::error_level},
+            {"off",     log_level::off_level}
+    };
+    auto it = string_to_level.find(name);
+    if (it == string_to_level.end()) {
+        return false;
+    }
+    level = it->second;
+    return true;
+}
+
+void logger::configure_from_environment() {
+    const char* level_name = std::getenv("GOMOKU_LOG_LEVEL");
+    log_level level;
+    if (level_name != nullptr) {
+        if (parse_level(level_name, level)) {
+            set_level(level);
+        } else {
+            GOMOKU_LOG(log_level::warning_level, "invalid_log_level", {"value", level_name});
+        }
+    }
+    const char* sample_rate = std::getenv("GOMOKU_LOG_SAMPLE_RATE");
+    if (sample_rate != nullptr) {
+        unsigned int rate = std::strtoul(sample_rate, nullptr, 10);
+        set_sample_rate(log_level::trace_level, rate);
+        set_sample_rate(log_level::debug_level, rate);
+    }
+}
+
+
+bool logger::sample(log_level level, unsigned int rate) {
+    return _sample_counters[level].fetch_add(1, std::memory_order_relaxed) % rate == 0;
+}
+
+
+void logger::write(log_level level, const char* event, std::initializer_list<field> fields) {
+    // the ring buffer and the writer thread are created by the first record
+    static bool writer_is_started = (start_writer_thread(), true);
+    (void) writer_is_started;
+
+    if (!try_push(record{level, std::chrono::system_clock::now(), event, std::vector<field>(fields)})) {
+        _nof_dropped_records.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+void logger::flush() {
+    uint64_t target = _enqueue_position.load(std::memory_order_acquire);
+    while (_nof_written_records.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint64_t logger::get_nof_dropped_records() {
+    return _nof_dropped_records.load(std::memory_order_relaxed);
+}
+
+
+// Bounded multi-producer queue: a producer claims a position by moving _enqueue_position forward, fills the slot
+// and then publishes it by advancing the slot's sequence number. The single consumer only reads published slots.
+bool logger::try_push(record&& content) {
+    uint64_t position = _enqueue_position.load(std::memory_order_relaxed);
+    slot* target;
+    while (true) {
+        target = &_slots[position & (ring_buffer_capacity - 1)];
+        uint64_t sequence = target->sequence.load(std::memory_order_acquire);
+        int64_t difference = int64_t(sequence) - int64_t(position);
+        if (difference == 0) {
+            if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;   // the writer thread has not caught up yet
+        } else {
+            position = _enqueue_position.load(std::memory_order_relaxed);
+        }
+    }
+    target->content = std::move(content);
+    target->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool logger::try_pop(record& content) {
+    uint64_t position = _dequeue_position.load(std::memory_order_relaxed);
+    slot& source = _slots[position & (ring_buffer_capacity - 1)];
+    if (source.sequence.load(std::memory_order_acquire) != position + 1) {
+        return false;
+    }
+    content = std::move(source.content);
+    source.sequence.store(position + ring_buffer_capacity, std::memory_order_release);
+    _dequeue_position.store(position + 1, std::memory_order_relaxed);
+    return true;
+}
+
+
+void logger::start_writer_thread() {
+    _slots = new slot[ring_buffer_capacity];
+    for (unsigned int i = 0; i < ring_buffer_capacity; ++i) {
+        _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    std::thread writer(writer_loop);
+    writer.detach();
+}
+
+void logger::writer_loop() {
+    std::string batch;
+    record content;
+    uint64_t nof_reported_drops = 0;
+    while (true) {
+        batch.clear();
+        unsigned int nof_records = 0;
+        while (nof_records < batch_size && try_pop(content)) {
+            append_record(batch, content);
+            nof_records++;
+        }
+
+        uint64_t nof_drops = _nof_dropped_records.load(std::memory_order_relaxed);
+        if (nof_drops != nof_reported_drops) {
+            append_record(batch, record{log_level::warning_level, std::chrono::system_clock::now(), "log_records_dropped",
+                                        {{"count", std::to_string(nof_drops - nof_reported_drops)}}});
+            nof_reported_drops = nof_drops;
+        }
+
+        if (!batch.empty()) {
+            std::FILE* output = _output.load(std::memory_order_relaxed);
+            if (output == nullptr) {
+                output = stdout;
+            }
+            std::fwrite(batch.data(), 1, batch.size(), output);
+            std::fflush(output);
+        }
+        _nof_written_records.fetch_add(nof_records, std::memory_order_release);
+
+        if (nof_records < batch_size) {
+            // the buffer is drained, wait a moment for new records instead of spinning
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
+
+// writes 'content' as a single line: time=<unix time> level=<level> event=<event> <key>=<value> ...
+void logger::append_record(std::string& out, const record& content) {
+    int64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(content.time.time_since_epoch()).count();
+    std::string milliseconds_part = std::to_string(milliseconds % 1000);
+    out += "time=" + std::to_string(milliseconds / 1000) + "." + std::string(3 - milliseconds_part.size(), '0') + milliseconds_part;
+    out += " level=";
+    out += level_names[content.level];
+    out += " event=";
+    out += content.event;
+    for (const field& f : content.fields) {
+        out += ' ';
+        out += f.first;
+        out += '=';
+        append_value(out, f.second);
+    }
+    out += '\n';
+}
@@ -0,0 +1,110 @@
+// The logger writes structured log records (an event name and key=value fields) without blocking the calling thread.
+// Records are pushed into a lock-free ring buffer, and a background thread writes them out in batches.
+// Which records are written is configured at runtime by a minimum level and a sample rate per level.
+
+#ifndef GOMOKU_LOGGER_H
+#define GOMOKU_LOGGER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+enum log_level {
+    trace_level,    // full message payloads
+    debug_level,
+    info_level,
+    warning_level,
+    error_level,
+    off_level
+};
+
+// writes a record only if 'level' is enabled and sampled, the fields are not even evaluated otherwise.
+// Example: GOMOKU_LOG(log_level::info_level, "connection_accepted", {"peer", peer.to_string()});
+#define GOMOKU_LOG(level, event, ...) \
+    do { \
+        if (logger::should_write(level)) { \
+            logger::write(level, event, {__VA_ARGS__}); \
+        } \
+    } while (false)
+
+class logger {
+
+public:
+    // key and value of a field of a log record
+    using field = std::pair<const char*, std::string>;
+
+    static constexpr unsigned int ring_buffer_capacity = 4096;    // must be a power of two
+    static constexpr unsigned int batch_size = 256;
+
+    // records below 'level' are not written
+    static void set_level(log_level level);
+    static log_level get_level();
+    // only every 'rate'-th record of 'level' is written, a rate of 1 writes all of them
+    static void set_sample_rate(log_level level, unsigned int rate);
+    // the stream the background thread writes to, stdout by default
+    static void set_output(std::FILE* output);
+    // reads GOMOKU_LOG_LEVEL (trace, debug, info, warning, error or off) and GOMOKU_LOG_SAMPLE_RATE (applied to the
+    // trace and debug levels) from the environment
+    static void configure_from_environment();
+    // returns false if 'name' is not the name of a log_level
+    static bool parse_level(const std::string& name, log_level& level);
+
+    static bool should_write(log_level level) {
+        if (level < _level.load(std::memory_order_relaxed) || level >= log_level::off_level) {
+            return false;
+        }
+        unsigned int rate = _sample_rates[level].load(std::memory_order_relaxed);
+        return rate <= 1 || sample(level, rate);
+    }
+
+    // queues a record, use GOMOKU_LOG instead to skip suppressed records cheaply.
+    // If the ring buffer is full, the record is dropped and counted instead of waiting.
+    static void write(log_level level, const char* event, std::initializer_list<field> fields);
+
+    // blocks until all records that were queued before are written
+    static void flush();
+
+    static uint64_t get_nof_dropped_records();
+
+private:
+    struct record {
+        log_level level;
+        std::chrono::system_clock::time_point time;
+        const char* event;
+        std::vector<field> fields;
+    };
+
+    // slot of the ring buffer. 'sequence' tells producers and the consumer whose turn it is to use the slot.
+    struct slot {
+        std::atomic<uint64_t> sequence;
+        record content;
+    };
+
+    static bool sample(log_level level, unsigned int rate);
+    static bool try_push(record&& content);
+    static bool try_pop(record& content);
+    static void start_writer_thread();
+    static void writer_loop();
+    static void append_record(std::string& out, const record& content);
+
+    inline static std::atomic<log_level> _level = log_level::info_level;
+    inline static std::array<std::atomic<unsigned int>, log_level::off_level> _sample_rates = {1, 1, 1, 1, 1};
+    inline static std::array<std::atomic<uint64_t>, log_level::off_level> _sample_counters = {};
+    inline static std::atomic<std::FILE*> _output = nullptr;
+
+    // never deleted on purpose: the detached writer thread may still read it while static objects are destroyed
+    inline static slot* _slots = nullptr;
+    inline static std::atomic<uint64_t> _enqueue_position = 0;
+    inline static std::atomic<uint64_t> _dequeue_position = 0;    // only moved by the writer thread
+    inline static std::atomic<uint64_t> _nof_written_records = 0;
+    inline static std::atomic<uint64_t> _nof_dropped_records = 0;
+};
+
+
+#endif //GOMOKU_LOGGER_H
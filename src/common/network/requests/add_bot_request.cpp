@@ -0,0 +1,27 @@
+#include "add_bot_request.h"
+
+// Public constructor
+add_bot_request::add_bot_request(std::string player_id, std::string game_id, std::string difficulty)
+        : client_request( client_request::create_base_class_properties(request_type::add_bot, uuid_generator::generate_uuid_v4(), player_id, game_id) ),
+        _difficulty(difficulty)
+{ }
+
+// private constructor for deserialization
+add_bot_request::add_bot_request(client_request::base_class_properties props, std::string difficulty) :
+        client_request(props),
+        _difficulty(difficulty)
+{ }
+
+add_bot_request* add_bot_request::from_json(const rapidjson::Value &json) {
+    if (json.HasMember("difficulty") && json["difficulty"].IsString()) {
+        return new add_bot_request(client_request::extract_base_class_properties((json)), json["difficulty"].GetString());
+    }
+    throw gomoku_exception("Could not parse add_bot_request from json. difficulty is missing.");
+}
+
+void add_bot_request::write_into_json(rapidjson::Value &json,
+                                   rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
+    client_request::write_into_json(json, allocator);
+    rapidjson::Value difficulty_val(_difficulty, allocator);
+    json.AddMember("difficulty", difficulty_val, allocator);
+}
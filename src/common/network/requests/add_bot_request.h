@@ -0,0 +1,29 @@
+#ifndef GOMOKU_ADD_BOT_REQUEST_H
+#define GOMOKU_ADD_BOT_REQUEST_H
+
+#include <string>
+#include "client_request.h"
+#include "../../../../rapidjson/include/rapidjson/document.h"
+
+class add_bot_request : public client_request{
+
+private:
+
+    std::string _difficulty;
+
+    /*
+     * Private constructor for deserialization
+     */
+    explicit add_bot_request(base_class_properties, std::string difficulty);
+
+public:
+    add_bot_request(std::string player_id, std::string game_id, std::string difficulty);
+    // "easy", "medium" or "hard"
+    [[nodiscard]] std::string get_difficulty() const { return this->_difficulty; }
+
+    virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
+    static add_bot_request* from_json(const rapidjson::Value& json);
+};
+
+
+#endif //GOMOKU_ADD_BOT_REQUEST_H
@@ -0,0 +1,85 @@
+#include "analyze_position_request.h"
+
+// Public constructor
+analyze_position_request::analyze_position_request(std::string player_id, std::string game_id, std::string ruleset_string,
+                                                   unsigned int board_size, std::vector<field_type> fields,
+                                                   player_colour_type colour_to_move, unsigned int nof_lines)
+        : client_request( client_request::create_base_class_properties(request_type::analyze_position, uuid_generator::generate_uuid_v4(), player_id, game_id) ),
+        _ruleset_string(std::move(ruleset_string)),
+        _board_size(board_size),
+        _fields(std::move(fields)),
+        _colour_to_move(colour_to_move),
+        _nof_lines(nof_lines)
+{ }
+
+// private constructor for deserialization
+analyze_position_request::analyze_position_request(client_request::base_class_properties props, std::string ruleset_string,
+                                                   unsigned int board_size, std::vector<field_type> fields,
+                                                   player_colour_type colour_to_move, unsigned int nof_lines) :
+        client_request(props),
+        _ruleset_string(std::move(ruleset_string)),
+        _board_size(board_size),
+        _fields(std::move(fields)),
+        _colour_to_move(colour_to_move),
+        _nof_lines(nof_lines)
+{ }
+
+
+std::string analyze_position_request::encode_board(const std::vector<field_type>& fields) {
+    std::string board;
+    board.reserve(fields.size());
+    for (field_type field : fields) {
+        board.push_back(field == field_type::black_stone ? 'b' : (field == field_type::white_stone ? 'w' : '.'));
+    }
+    return board;
+}
+
+std::vector<field_type> analyze_position_request::decode_board(const std::string& board) {
+    std::vector<field_type> fields;
+    fields.reserve(board.size());
+    for (char field : board) {
+        if (field == '.') {
+            fields.push_back(field_type::empty);
+        } else if (field == 'b') {
+            fields.push_back(field_type::black_stone);
+        } else if (field == 'w') {
+            fields.push_back(field_type::white_stone);
+        } else {
+            throw gomoku_exception("Invalid field '" + std::string(1, field) + "' in the board of an analyze_position_request.");
+        }
+    }
+    return fields;
+}
+
+
+analyze_position_request* analyze_position_request::from_json(const rapidjson::Value &json) {
+    if (json.HasMember("ruleset_string") && json.HasMember("board_size") && json.HasMember("board")
+        && json.HasMember("colour_to_move") && json.HasMember("nof_lines")) {
+        auto colour_to_move = player::_string_to_player_colour_type.find(json["colour_to_move"].GetString());
+        if (colour_to_move == player::_string_to_player_colour_type.end()) {
+            throw gomoku_exception("Invalid colour_to_move in analyze_position_request.");
+        }
+        return new analyze_position_request(client_request::extract_base_class_properties((json)),
+                                            json["ruleset_string"].GetString(),
+                                            std::stoul(json["board_size"].GetString()),
+                                            decode_board(json["board"].GetString()),
+                                            colour_to_move->second,
+                                            std::stoul(json["nof_lines"].GetString()));
+    }
+    throw gomoku_exception("Could not find 'ruleset_string', 'board_size', 'board', 'colour_to_move' or 'nof_lines' in analyze_position_request");
+}
+
+void analyze_position_request::write_into_json(rapidjson::Value &json,
+                                   rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
+    client_request::write_into_json(json, allocator);
+    rapidjson::Value ruleset_string_val(_ruleset_string, allocator);
+    json.AddMember("ruleset_string", ruleset_string_val, allocator);
+    rapidjson::Value board_size_val(std::to_string(_board_size), allocator);
+    json.AddMember("board_size", board_size_val, allocator);
+    rapidjson::Value board_val(encode_board(_fields), allocator);
+    json.AddMember("board", board_val, allocator);
+    rapidjson::Value colour_to_move_val(player::_player_colour_type_to_string.at(_colour_to_move), allocator);
+    json.AddMember("colour_to_move", colour_to_move_val, allocator);
+    rapidjson::Value nof_lines_val(std::to_string(_nof_lines), allocator);
+    json.AddMember("nof_lines", nof_lines_val, allocator);
+}
@@ -0,0 +1,51 @@
+// Asks the server to analyze a board. The request is answered right away, the results follow as analysis_responses.
+
+#ifndef GOMOKU_ANALYZE_POSITION_REQUEST_H
+#define GOMOKU_ANALYZE_POSITION_REQUEST_H
+
+#include <string>
+#include <vector>
+#include "client_request.h"
+#include "../../../../rapidjson/include/rapidjson/document.h"
+#include "../../game_state/playing_board/playing_board.h"
+#include "../../game_state/player/player.h"
+
+class analyze_position_request : public client_request{
+
+private:
+
+    std::string _ruleset_string;
+    unsigned int _board_size;
+    std::vector<field_type> _fields;
+    player_colour_type _colour_to_move;
+    unsigned int _nof_lines;
+
+    /*
+     * Private constructor for deserialization
+     */
+    analyze_position_request(base_class_properties, std::string ruleset_string, unsigned int board_size,
+                             std::vector<field_type> fields, player_colour_type colour_to_move, unsigned int nof_lines);
+
+public:
+    analyze_position_request(std::string player_id, std::string game_id, std::string ruleset_string,
+                             unsigned int board_size, std::vector<field_type> fields, player_colour_type colour_to_move,
+                             unsigned int nof_lines);
+    [[nodiscard]] std::string get_ruleset_string() const { return this->_ruleset_string; }
+    [[nodiscard]] unsigned int get_board_size() const { return this->_board_size; }
+    // in row-major order
+    [[nodiscard]] const std::vector<field_type>& get_fields() const { return this->_fields; }
+    [[nodiscard]] player_colour_type get_colour_to_move() const { return this->_colour_to_move; }
+    // number of best moves to return
+    [[nodiscard]] unsigned int get_nof_lines() const { return this->_nof_lines; }
+
+    // The board is sent as one character per field, row after row: '.' for empty fields, 'b' and 'w' for stones.
+    // decode_board throws a gomoku_exception for other characters.
+    static std::string encode_board(const std::vector<field_type>& fields);
+    static std::vector<field_type> decode_board(const std::string& board);
+
+    virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
+    static analyze_position_request* from_json(const rapidjson::Value& json);
+};
+
+
+#endif //GOMOKU_ANALYZE_POSITION_REQUEST_H
@@ -10,6 +10,8 @@
 #include "start_game_request.h"
 #include "restart_game_request.h"
 #include "forfeit_request.h"
+#include "add_bot_request.h"
+#include "analyze_position_request.h"
 
 #include <iostream>
 
@@ -21,7 +23,9 @@ const std::unordered_map<std::string, request_type> client_request::_string_to_r
         {"swap_colour",      request_type::swap_colour},
         {"select_game_mode", request_type::select_game_mode},
         {"restart_game",     request_type::restart_game},
-        {"forfeit", request_type::forfeit}
+        {"forfeit", request_type::forfeit},
+        {"add_bot",          request_type::add_bot},
+        {"analyze_position", request_type::analyze_position}
 };
 // for serialization
 const std::unordered_map<request_type, std::string> client_request::_request_type_to_string = {
@@ -31,9 +35,15 @@ const std::unordered_map<request_type, std::string> client_request::_request_typ
         {request_type::swap_colour,      "swap_colour"},
         {request_type::select_game_mode, "select_game_mode"},
         {request_type::restart_game,     "restart_game"},
-        {request_type::forfeit, "forfeit"}
+        {request_type::forfeit, "forfeit"},
+        {request_type::add_bot,          "add_bot"},
+        {request_type::analyze_position, "analyze_position"}
 };
 
+const std::string& client_request::get_type_name(request_type type) {
+    return _request_type_to_string.at(type);
+}
+
 // protected constructor. only used by subclasses
 client_request::client_request(client_request::base_class_properties props) :
         _type(props._type),
@@ -118,6 +128,12 @@ client_request* client_request::from_json(const rapidjson::Value &json) {
         }
         else if (request_type == request_type::forfeit) {
             return forfeit_request::from_json(json);
+        }
+        else if (request_type == request_type::add_bot) {
+            return add_bot_request::from_json(json);
+        }
+        else if (request_type == request_type::analyze_position) {
+            return analyze_position_request::from_json(json);
         }else {
             throw gomoku_exception("Encountered unknown ClientRequest type " + type);
         }
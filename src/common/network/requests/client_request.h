@@ -23,6 +23,8 @@ enum request_type {
     select_game_mode,
     restart_game,
     forfeit,
+    add_bot,
+    analyze_position,
 };
 
 class client_request : public serializable {
@@ -59,6 +61,9 @@ public:
     [[nodiscard]] std::string get_game_id() const { return this->_game_id; }
     [[nodiscard]] std::string get_player_id() const { return this->_player_id; }
 
+    // name of 'type' as it is sent over the network
+    static const std::string& get_type_name(request_type type);
+
     // Tries to create the specific client_request from the provided json.
     // Throws exception if parsing fails -> Use only in "try{ }catch()" block
     static client_request* from_json(const rapidjson::Value& json);
@@ -5,19 +5,26 @@
 #include "select_game_mode_request.h"
 
 // Public constructor
-select_game_mode_request::select_game_mode_request(std::string player_id, std::string game_id, std::string ruleset_string)
+select_game_mode_request::select_game_mode_request(std::string player_id, std::string game_id, std::string ruleset_string, unsigned int board_size)
         : client_request( client_request::create_base_class_properties(request_type::select_game_mode, uuid_generator::generate_uuid_v4(), player_id, game_id) ),
-        _ruleset_string(ruleset_string)
+        _ruleset_string(ruleset_string),
+        _board_size(board_size)
 { }
 
 // private constructor for deserialization
-select_game_mode_request::select_game_mode_request(client_request::base_class_properties props, std::string ruleset_string) :
+select_game_mode_request::select_game_mode_request(client_request::base_class_properties props, std::string ruleset_string, unsigned int board_size) :
         client_request(props),
-        _ruleset_string(ruleset_string)
+        _ruleset_string(ruleset_string),
+        _board_size(board_size)
 { }
 
 select_game_mode_request* select_game_mode_request::from_json(const rapidjson::Value &json) {
-    return new select_game_mode_request(client_request::extract_base_class_properties((json)), json["ruleset_string"].GetString());
+    // requests without a board size select the standard board
+    unsigned int board_size = playing_board::_playing_board_size;
+    if (json.HasMember("board_size")) {
+        board_size = std::stoul(json["board_size"].GetString());
+    }
+    return new select_game_mode_request(client_request::extract_base_class_properties((json)), json["ruleset_string"].GetString(), board_size);
 }
 
 void select_game_mode_request::write_into_json(rapidjson::Value &json,
@@ -25,4 +32,6 @@ void select_game_mode_request::write_into_json(rapidjson::Value &json,
     client_request::write_into_json(json, allocator);
     rapidjson::Value ruleset_string_val(_ruleset_string, allocator);
     json.AddMember("ruleset_string", ruleset_string_val,allocator);
-}
\ No newline at end of file
+    rapidjson::Value board_size_val(std::to_string(_board_size), allocator);
+    json.AddMember("board_size", board_size_val,allocator);
+}
@@ -4,21 +4,25 @@
 #include <string>
 #include "client_request.h"
 #include "../../../../rapidjson/include/rapidjson/document.h"
+#include "../../game_state/playing_board/playing_board.h"
 
 class select_game_mode_request : public client_request{
 
 private:
 
     std::string _ruleset_string;
+    unsigned int _board_size;
 
     /*
      * Private constructor for deserialization
      */
-    explicit select_game_mode_request(base_class_properties, std::string ruleset_string);
+    explicit select_game_mode_request(base_class_properties, std::string ruleset_string, unsigned int board_size);
 
 public:
-    select_game_mode_request(std::string game_id, std::string player_id, std::string ruleset_string);
+    select_game_mode_request(std::string game_id, std::string player_id, std::string ruleset_string,
+                             unsigned int board_size = playing_board::_playing_board_size);
     [[nodiscard]] std::string get_ruleset_string() const { return this->_ruleset_string; }
+    [[nodiscard]] unsigned int get_board_size() const { return this->_board_size; }
 
     virtual void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
     static select_game_mode_request* from_json(const rapidjson::Value& json);
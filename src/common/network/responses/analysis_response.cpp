@@ -0,0 +1,151 @@
+#include "analysis_response.h"
+
+#include "../../exceptions/gomoku_exception.h"
+#include "../../game_state/game_state.h"
+
+#ifdef GOMOKU_CLIENT
+#include <iomanip>
+#include <sstream>
+#include "../../../client/game_controller.h"
+#endif
+
+namespace {
+
+void write_move(const search_move& move, rapidjson::Value& moves, rapidjson::Document::AllocatorType& allocator) {
+    if (move.type == search_move_type::stone_move) {
+        rapidjson::Value stone(rapidjson::kArrayType);
+        stone.PushBack(unsigned(move.x), allocator);
+        stone.PushBack(unsigned(move.y), allocator);
+        moves.PushBack(stone, allocator);
+    } else {
+        rapidjson::Value decision(game_state::_swap_decision_type_to_string.at(move.swap_decision), allocator);
+        moves.PushBack(decision, allocator);
+    }
+}
+
+search_move read_move(const rapidjson::Value& move) {
+    if (move.IsArray() && move.Size() == 2 && move[0].IsUint() && move[1].IsUint()) {
+        return search_move::stone(move[0].GetUint(), move[1].GetUint());
+    }
+    if (move.IsString()) {
+        auto decision = game_state::_string_to_swap_decision_type.find(move.GetString());
+        if (decision != game_state::_string_to_swap_decision_type.end()) {
+            return search_move::swap(decision->second);
+        }
+    }
+    throw gomoku_exception("Could not parse a move of an analysis_response.");
+}
+
+}
+
+
+analysis_response::analysis_response(server_response::base_class_properties props, std::string analysis_id,
+                                     bool is_final, unsigned int nof_playouts, std::vector<mcts_line> lines) :
+        server_response(props),
+        _analysis_id(std::move(analysis_id)),
+        _is_final(is_final),
+        _nof_playouts(nof_playouts),
+        _lines(std::move(lines))
+{ }
+
+// the analysis is not tied to a game, so the game_id is left empty
+analysis_response::analysis_response(std::string analysis_id, bool is_final, unsigned int nof_playouts,
+                                     std::vector<mcts_line> lines) :
+        server_response(server_response::create_base_class_properties(ResponseType::analysis_msg, "")),
+        _analysis_id(std::move(analysis_id)),
+        _is_final(is_final),
+        _nof_playouts(nof_playouts),
+        _lines(std::move(lines))
+{ }
+
+
+std::string analysis_response::get_analysis_id() const {
+    return _analysis_id;
+}
+
+bool analysis_response::is_final() const {
+    return _is_final;
+}
+
+unsigned int analysis_response::get_nof_playouts() const {
+    return _nof_playouts;
+}
+
+const std::vector<mcts_line>& analysis_response::get_lines() const {
+    return _lines;
+}
+
+
+void analysis_response::write_into_json(rapidjson::Value &json,
+                                        rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
+    server_response::write_into_json(json, allocator);
+
+    rapidjson::Value analysis_id_val(_analysis_id.c_str(), allocator);
+    json.AddMember("analysis_id", analysis_id_val, allocator);
+    json.AddMember("is_final", _is_final, allocator);
+    json.AddMember("nof_playouts", _nof_playouts, allocator);
+
+    rapidjson::Value lines_val(rapidjson::kArrayType);
+    for (const mcts_line& line : _lines) {
+        rapidjson::Value line_val(rapidjson::kObjectType);
+        rapidjson::Value moves_val(rapidjson::kArrayType);
+        for (const search_move& move : line.principal_variation) {
+            write_move(move, moves_val, allocator);
+        }
+        line_val.AddMember("moves", moves_val, allocator);
+        line_val.AddMember("win_rate", line.win_rate, allocator);
+        line_val.AddMember("visits", line.visits, allocator);
+        lines_val.PushBack(line_val, allocator);
+    }
+    json.AddMember("lines", lines_val, allocator);
+}
+
+analysis_response* analysis_response::from_json(const rapidjson::Value& json) {
+    if (json.HasMember("analysis_id") && json["analysis_id"].IsString() && json.HasMember("is_final") && json["is_final"].IsBool()
+        && json.HasMember("nof_playouts") && json["nof_playouts"].IsUint() && json.HasMember("lines") && json["lines"].IsArray()) {
+        std::vector<mcts_line> lines;
+        for (const rapidjson::Value& line_val : json["lines"].GetArray()) {
+            if (!line_val.HasMember("moves") || !line_val["moves"].IsArray() || line_val["moves"].Empty()
+                || !line_val.HasMember("win_rate") || !line_val["win_rate"].IsNumber()
+                || !line_val.HasMember("visits") || !line_val["visits"].IsUint()) {
+                throw gomoku_exception("Could not parse a line of an analysis_response.");
+            }
+            mcts_line line;
+            for (const rapidjson::Value& move : line_val["moves"].GetArray()) {
+                line.principal_variation.push_back(read_move(move));
+            }
+            line.move = line.principal_variation.front();
+            line.win_rate = line_val["win_rate"].GetFloat();
+            line.visits = line_val["visits"].GetUint();
+            lines.push_back(std::move(line));
+        }
+        return new analysis_response(server_response::extract_base_class_properties(json),
+                                     json["analysis_id"].GetString(),
+                                     json["is_final"].GetBool(),
+                                     json["nof_playouts"].GetUint(),
+                                     std::move(lines));
+    } else {
+        throw gomoku_exception("Could not parse analysis_response from json. analysis_id, is_final, nof_playouts or lines is missing.");
+    }
+}
+
+#ifdef GOMOKU_CLIENT
+
+void analysis_response::Process() const {
+    if (_lines.empty()) {
+        return;
+    }
+    const mcts_line& best_line = _lines.front();
+    std::stringstream status;
+    status << (_is_final ? "Analysis: " : "Analysing: ") << "best move ";
+    if (best_line.move.type == search_move_type::stone_move) {
+        status << "(" << unsigned(best_line.move.x) << ", " << unsigned(best_line.move.y) << ")";
+    } else {
+        status << game_state::_swap_decision_type_to_string.at(best_line.move.swap_decision);
+    }
+    status << " wins " << std::fixed << std::setprecision(0) << best_line.win_rate * 100 << "% of "
+           << _nof_playouts << " playouts";
+    game_controller::show_status(status.str());
+}
+
+#endif
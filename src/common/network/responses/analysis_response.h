@@ -0,0 +1,45 @@
+// Sent to a player who asked for the analysis of a board with an analyze_position_request. While the search runs, the
+// server sends the best lines found so far, the last response is marked as final. Moves are written like in game
+// records: [x, y] for stones and the name of the decision for swap decisions.
+
+#ifndef GOMOKU_ANALYSIS_RESPONSE_H
+#define GOMOKU_ANALYSIS_RESPONSE_H
+
+#include <string>
+#include <vector>
+#include "server_response.h"
+#include "../../game_state/mcts_engine/mcts_engine.h"
+
+
+class analysis_response : public server_response {
+private:
+    std::string _analysis_id;
+    bool _is_final;
+    unsigned int _nof_playouts;
+    std::vector<mcts_line> _lines;
+
+    /*
+     * Private constructor for deserialization
+     */
+    analysis_response(base_class_properties props, std::string analysis_id, bool is_final, unsigned int nof_playouts,
+                      std::vector<mcts_line> lines);
+
+public:
+    // 'analysis_id' is the req_id of the analyze_position_request
+    analysis_response(std::string analysis_id, bool is_final, unsigned int nof_playouts, std::vector<mcts_line> lines);
+
+    std::string get_analysis_id() const;
+    bool is_final() const;
+    unsigned int get_nof_playouts() const;
+    const std::vector<mcts_line>& get_lines() const;
+
+    void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
+    static analysis_response* from_json(const rapidjson::Value& json);
+
+#ifdef GOMOKU_CLIENT
+    virtual void Process() const override;
+#endif
+};
+
+
+#endif //GOMOKU_ANALYSIS_RESPONSE_H
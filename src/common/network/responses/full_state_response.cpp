@@ -5,15 +5,16 @@
 #include "full_state_response.h"
 
 #include "../../exceptions/gomoku_exception.h"
-#include "../../serialization/json_utils.h"
+#include "../../logging/logger.h"
 
 #ifdef GOMOKU_CLIENT
 #include "../../../client/game_controller.h"
 #endif
 
-full_state_response::full_state_response(server_response::base_class_properties props, rapidjson::Value* state_json) :
+full_state_response::full_state_response(server_response::base_class_properties props,
+                                         const rapidjson::Value* received_state_json) :
         server_response(props),
-        _state_json(state_json)
+        _received_state_json(received_state_json)
 { }
 
 full_state_response::full_state_response(std::string game_id, const game_state& state) :
@@ -26,13 +27,16 @@ full_state_response::full_state_response(std::string game_id, const game_state&
 void full_state_response::write_into_json(rapidjson::Value &json,
                                        rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
     server_response::write_into_json(json, allocator);
-    json.AddMember("state_json", *_state_json, allocator);
+    if (_state_json != nullptr) {
+        json.AddMember("state_json", *_state_json, allocator);
+    } else {
+        json.AddMember("state_json", rapidjson::Value(*_received_state_json, allocator), allocator);
+    }
 }
 
 full_state_response *full_state_response::from_json(const rapidjson::Value& json) {
-    if (json.HasMember("state_json")) {
-        return new full_state_response(server_response::extract_base_class_properties(json),
-                                       json_utils::clone_value(json["state_json"].GetObject()));
+    if (json.HasMember("state_json") && json["state_json"].IsObject()) {
+        return new full_state_response(server_response::extract_base_class_properties(json), &json["state_json"]);
     } else {
         throw gomoku_exception("Could not parse full_state_response from json. state is missing.");
     }
@@ -45,20 +49,18 @@ full_state_response::~full_state_response() {
     }
 }
 
-rapidjson::Value* full_state_response::get_state_json() const {
-    return _state_json;
+const rapidjson::Value* full_state_response::get_state_json() const {
+    return _state_json != nullptr ? _state_json : _received_state_json;
 }
 
 #ifdef GOMOKU_CLIENT
 
 void full_state_response::Process() const {
     try {
-        game_state* state = game_state::from_json(*_state_json);
-        game_controller::update_game_state(state);
+        game_controller::update_game_state(*get_state_json());
 
     } catch(std::exception& e) {
-        std::cerr << "Failed to extract game_state from full_state_response" << std::endl
-                  << e.what() << std::endl;
+        GOMOKU_LOG(log_level::error_level, "full_state_response_failed", {"error", e.what()});
     }
 }
 
@@ -6,19 +6,22 @@
 
 class full_state_response : public server_response {
 private:
-    rapidjson::Value* _state_json;
+    // built from a game_state on the server, moved into the message when it is written
+    rapidjson::Value* _state_json = nullptr;
+    // received by the client, points into the parsed message instead of copying the state
+    const rapidjson::Value* _received_state_json = nullptr;
 
     /*
      * Private constructor for deserialization
      */
-    full_state_response(base_class_properties props, rapidjson::Value* state_json);
+    full_state_response(base_class_properties props, const rapidjson::Value* received_state_json);
 
 public:
 
     full_state_response(std::string game_id, const game_state& state);
     ~full_state_response();
 
-    rapidjson::Value* get_state_json() const;
+    const rapidjson::Value* get_state_json() const;
 
     void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
     static full_state_response* from_json(const rapidjson::Value& json);
@@ -3,7 +3,6 @@
 //
 
 #include "request_response.h"
-#include "../../serialization/json_utils.h"
 #include "../../exceptions/gomoku_exception.h"
 #include "../../game_state/game_state.h"
 
@@ -12,10 +11,10 @@
 #endif
 
 
-request_response::request_response(const server_response::base_class_properties& props, std::string req_id, const bool success, rapidjson::Value* state_json, std::string err) :
+request_response::request_response(const server_response::base_class_properties& props, std::string req_id, const bool success, const rapidjson::Value* received_state_json, std::string err) :
     server_response(props),
     _req_id(std::move(req_id)),
-    _state_json(state_json),
+    _received_state_json(received_state_json),
     _success(success),
     _err(std::move(err))
 { }
@@ -36,6 +35,18 @@ request_response::~request_response() {
     }
 }
 
+std::string request_response::get_req_id() const {
+    return _req_id;
+}
+
+bool request_response::is_success() const {
+    return _success;
+}
+
+const rapidjson::Value* request_response::get_state_json() const {
+    return _state_json != nullptr ? _state_json : _received_state_json;
+}
+
 void request_response::write_into_json(rapidjson::Value &json,
                                        rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
     server_response::write_into_json(json, allocator);
@@ -50,6 +61,8 @@ void request_response::write_into_json(rapidjson::Value &json,
 
     if (_state_json != nullptr) {
         json.AddMember("state_json", *_state_json, allocator);
+    } else if (_received_state_json != nullptr) {
+        json.AddMember("state_json", rapidjson::Value(*_received_state_json, allocator), allocator);
     }
 }
 
@@ -58,9 +71,9 @@ request_response *request_response::from_json(const rapidjson::Value& json) {
     if (json.HasMember("err") && json.HasMember("success")) {
         std::string err = json["err"].GetString();
 
-        rapidjson::Value* state_json = nullptr;
-        if (json.HasMember("state_json")) {
-            state_json = json_utils::clone_value(json["state_json"].GetObject());
+        const rapidjson::Value* state_json = nullptr;
+        if (json.HasMember("state_json") && json["state_json"].IsObject()) {
+            state_json = &json["state_json"];
         }
         return new request_response(
                 server_response::extract_base_class_properties(json),
@@ -77,15 +90,13 @@ request_response *request_response::from_json(const rapidjson::Value& json) {
 
 void request_response::Process() const {
     if (_success) {
-        if (this->_state_json != nullptr) {
-            game_state* state = game_state::from_json(*_state_json);
-            game_controller::update_game_state(state);
-
-        } else {
-            game_controller::show_error("Network error",
-                                        "Expected a state as JSON inside the request_response. But there was none.");
+        // requests that are not about the game (e.g. analyze_position) are answered without a state
+        if (this->get_state_json() != nullptr) {
+            game_controller::update_game_state(*get_state_json(), _req_id);
         }
     } else {
+        // a move that was shown before the server answered is taken back
+        game_controller::reject_move(_req_id);
         game_controller::show_error("Warning!", _err);
     }
 
@@ -10,15 +10,24 @@ private:
     bool _success;
     std::string _err;
     std::string _req_id;
+    // built from a game_state on the server, moved into the message when it is written
     rapidjson::Value* _state_json = nullptr;
+    // received by the client, points into the parsed message instead of copying the state
+    const rapidjson::Value* _received_state_json = nullptr;
 
-    request_response(const base_class_properties& props, std::string req_id, bool success, rapidjson::Value* state_json, std::string err);
+    request_response(const base_class_properties& props, std::string req_id, bool success,
+                     const rapidjson::Value* received_state_json, std::string err);
 
 public:
 
     request_response(const std::string& game_id, std::string req_id, bool success, rapidjson::Value* state_json, std::string err);
     ~request_response();
 
+    std::string get_req_id() const;
+    bool is_success() const;
+    // the state of the game after the request, nullptr if the response has none
+    const rapidjson::Value* get_state_json() const;
+
     void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
     static request_response* from_json(const rapidjson::Value& json);
 
@@ -5,6 +5,8 @@
 #include "server_response.h"
 #include "request_response.h"
 #include "full_state_response.h"
+#include "server_shutdown_response.h"
+#include "analysis_response.h"
 
 #include "../../exceptions/gomoku_exception.h"
 
@@ -12,13 +14,17 @@
 const std::unordered_map<std::string, ResponseType> server_response::_string_to_response_type = {
         {"req_response", ResponseType::req_response },
         {"state_diff_msg", ResponseType::state_diff_msg},
-        {"full_state_msg", ResponseType::full_state_msg}
+        {"full_state_msg", ResponseType::full_state_msg},
+        {"server_shutdown_msg", ResponseType::server_shutdown_msg},
+        {"analysis_msg", ResponseType::analysis_msg}
 };
 // for serialization
 const std::unordered_map<ResponseType, std::string> server_response::_response_type_to_string = {
         { ResponseType::req_response,   "req_response" },
         { ResponseType::state_diff_msg, "state_diff_msg"},
-        { ResponseType::full_state_msg, "full_state_msg"}
+        { ResponseType::full_state_msg, "full_state_msg"},
+        { ResponseType::server_shutdown_msg, "server_shutdown_msg"},
+        { ResponseType::analysis_msg, "analysis_msg"}
 };
 
 server_response::server_response(server_response::base_class_properties params):
@@ -69,6 +75,12 @@ server_response *server_response::from_json(const rapidjson::Value& json) {
         }
         else if (response_type == ResponseType::full_state_msg) {
             return full_state_response::from_json(json);
+        }
+        else if (response_type == ResponseType::server_shutdown_msg) {
+            return server_shutdown_response::from_json(json);
+        }
+        else if (response_type == ResponseType::analysis_msg) {
+            return analysis_response::from_json(json);
         } else {
             throw gomoku_exception("Encountered unknown ServerResponse type " + response_type);
         }
@@ -15,7 +15,9 @@
 enum ResponseType {
     req_response,
     state_diff_msg,
-    full_state_msg
+    full_state_msg,
+    server_shutdown_msg,
+    analysis_msg
 };
 
 class server_response : public serializable {
@@ -43,8 +45,8 @@ public:
     ResponseType get_type() const;
     std::string get_game_id() const;
 
-    // Tries to create the specific server_response from the provided json.
-    // Throws exception if parsing fails -> Use only inside "try{ }catch()" block
+    // Tries to create the specific server_response from the provided json. The response may point into 'json', which
+    // must therefore outlive it. Throws exception if parsing fails -> Use only inside "try{ }catch()" block
     static server_response* from_json(const rapidjson::Value& json);
 
     // Serializes the server_response into a json object that can be sent over the network
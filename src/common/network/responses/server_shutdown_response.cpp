@@ -0,0 +1,61 @@
+#include "server_shutdown_response.h"
+
+#include "../../exceptions/gomoku_exception.h"
+
+#ifdef GOMOKU_CLIENT
+#include "../../../client/game_controller.h"
+#endif
+
+
+server_shutdown_response::server_shutdown_response(server_response::base_class_properties props, std::string message,
+                                                   unsigned int reconnect_delay_ms) :
+        server_response(props),
+        _message(std::move(message)),
+        _reconnect_delay_ms(reconnect_delay_ms)
+{ }
+
+// the message is not tied to a game, so the game_id is left empty
+server_shutdown_response::server_shutdown_response(std::string message, unsigned int reconnect_delay_ms) :
+        server_response(server_response::create_base_class_properties(ResponseType::server_shutdown_msg, "")),
+        _message(std::move(message)),
+        _reconnect_delay_ms(reconnect_delay_ms)
+{ }
+
+
+std::string server_shutdown_response::get_message() const {
+    return _message;
+}
+
+unsigned int server_shutdown_response::get_reconnect_delay_ms() const {
+    return _reconnect_delay_ms;
+}
+
+
+void server_shutdown_response::write_into_json(rapidjson::Value &json,
+                                               rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> &allocator) const {
+    server_response::write_into_json(json, allocator);
+
+    rapidjson::Value message_val(_message.c_str(), allocator);
+    json.AddMember("message", message_val, allocator);
+
+    json.AddMember("reconnect_delay_ms", _reconnect_delay_ms, allocator);
+}
+
+server_shutdown_response* server_shutdown_response::from_json(const rapidjson::Value& json) {
+    if (json.HasMember("message") && json["message"].IsString()
+        && json.HasMember("reconnect_delay_ms") && json["reconnect_delay_ms"].IsUint()) {
+        return new server_shutdown_response(server_response::extract_base_class_properties(json),
+                                            json["message"].GetString(),
+                                            json["reconnect_delay_ms"].GetUint());
+    } else {
+        throw gomoku_exception("Could not parse server_shutdown_response from json. message or reconnect_delay_ms is missing.");
+    }
+}
+
+#ifdef GOMOKU_CLIENT
+
+void server_shutdown_response::Process() const {
+    game_controller::on_server_shutdown(_message, std::chrono::milliseconds(_reconnect_delay_ms));
+}
+
+#endif
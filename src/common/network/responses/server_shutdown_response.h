@@ -0,0 +1,37 @@
+// Sent to all connected clients when the server shuts down, e.g. for a restart. Games that are still running
+// are restored when the server starts again, so clients can reconnect after 'reconnect_delay_ms'.
+
+#ifndef GOMOKU_SERVER_SHUTDOWN_RESPONSE_H
+#define GOMOKU_SERVER_SHUTDOWN_RESPONSE_H
+
+#include <string>
+#include "server_response.h"
+
+
+class server_shutdown_response : public server_response {
+private:
+    std::string _message;
+    unsigned int _reconnect_delay_ms;
+
+    /*
+     * Private constructor for deserialization
+     */
+    server_shutdown_response(base_class_properties props, std::string message, unsigned int reconnect_delay_ms);
+
+public:
+
+    server_shutdown_response(std::string message, unsigned int reconnect_delay_ms);
+
+    std::string get_message() const;
+    unsigned int get_reconnect_delay_ms() const;
+
+    void write_into_json(rapidjson::Value& json, rapidjson::Document::AllocatorType& allocator) const override;
+    static server_shutdown_response* from_json(const rapidjson::Value& json);
+
+#ifdef GOMOKU_CLIENT
+    virtual void Process() const override;
+#endif
+};
+
+
+#endif //GOMOKU_SERVER_SHUTDOWN_RESPONSE_H
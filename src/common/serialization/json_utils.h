@@ -7,10 +7,12 @@
 #define GOMOKU_JSON_UTILS_H
 
 #include <string>
+#include <unordered_map>
 
 #include "../../rapidjson/include/rapidjson/writer.h"
 #include "../../rapidjson/include/rapidjson/document.h"
 #include "../../rapidjson/include/rapidjson/stringbuffer.h"
+#include "../exceptions/gomoku_exception.h"
 
 
 class json_utils {
@@ -30,6 +32,33 @@ public:
         return state_json;
     }
 
+    // Looks up the string of a serialized_value<std::string> in 'map', without constructing a std::string.
+    template<class T>
+    static T parse_enum_value(const rapidjson::Value& serialized_value, const std::unordered_map<std::string, T>& map) {
+        if (!serialized_value.IsObject() || !serialized_value.HasMember("value") || !serialized_value["value"].IsString()) {
+            throw gomoku_exception("Expected a serialized string value.");
+        }
+        const char* name = serialized_value["value"].GetString();
+        for (const auto& entry : map) {
+            if (entry.first == name) {
+                return entry.second;
+            }
+        }
+        throw gomoku_exception("Unknown value '" + std::string(name) + "'.");
+    }
+
+    // Returns true if 'json' has a serialized_value 'name' whose value has the type checked by 'is_type',
+    // e.g. has_serialized_value(json, "score", &rapidjson::Value::IsInt).
+    static bool has_serialized_value(const rapidjson::Value& json, const char* name,
+                                     bool (rapidjson::Value::*is_type)() const) {
+        if (!json.IsObject() || !json.HasMember(name)) {
+            return false;
+        }
+        const rapidjson::Value& serialized_value = json[name];
+        return serialized_value.IsObject() && serialized_value.HasMember("value")
+               && (serialized_value["value"].*is_type)();
+    }
+
 };
 
 #endif //GOMOKU_JSON_UTILS_H
@@ -10,6 +10,8 @@
 
 class serializable {
 public:
+    // requests and responses are deleted through pointers to their base class
+    virtual ~serializable() = default;
 
     virtual rapidjson::Document* to_json() const {
         rapidjson::Document* json = new rapidjson::Document();
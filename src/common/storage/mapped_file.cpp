@@ -0,0 +1,91 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../exceptions/gomoku_exception.h"
+
+
+mapped_file::mapped_file(const std::string& path) : _data(nullptr), _size(0) {
+#ifdef _WIN32
+    _file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    _mapping_handle = nullptr;
+    LARGE_INTEGER file_size;
+    if (_file_handle == INVALID_HANDLE_VALUE || !GetFileSizeEx(_file_handle, &file_size)) {
+        unmap();
+        throw gomoku_exception("Could not open " + path);
+    }
+    _size = static_cast<std::size_t>(file_size.QuadPart);
+    if (_size > 0) {
+        _mapping_handle = CreateFileMappingA(_file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        _data = _mapping_handle != nullptr
+                ? static_cast<const char*>(MapViewOfFile(_mapping_handle, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (_data == nullptr) {
+            unmap();
+            throw gomoku_exception("Could not map " + path);
+        }
+    }
+#else
+    int file = open(path.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file < 0 || fstat(file, &file_status) != 0) {
+        if (file >= 0) {
+            close(file);
+        }
+        throw gomoku_exception("Could not open " + path);
+    }
+    _size = static_cast<std::size_t>(file_status.st_size);
+    if (_size > 0) {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, file, 0);
+        if (data == MAP_FAILED) {
+            close(file);
+            throw gomoku_exception("Could not map " + path);
+        }
+        _data = static_cast<const char*>(data);
+    }
+    // the mapping stays valid after closing the file
+    close(file);
+#endif
+}
+
+mapped_file::~mapped_file() {
+    unmap();
+}
+
+void mapped_file::unmap() {
+#ifdef _WIN32
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping_handle != nullptr) {
+        CloseHandle(_mapping_handle);
+    }
+    if (_file_handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(_file_handle);
+    }
+    _mapping_handle = nullptr;
+    _file_handle = INVALID_HANDLE_VALUE;
+#else
+    if (_data != nullptr) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+    _data = nullptr;
+    _size = 0;
+}
+
+
+const char* mapped_file::get_data() const {
+    return _data;
+}
+
+std::size_t mapped_file::get_size() const {
+    return _size;
+}
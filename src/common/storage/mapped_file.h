@@ -0,0 +1,36 @@
+// A mapped_file maps a whole file read-only into memory (mmap, or MapViewOfFile on Windows), so that large tables can
+// be searched in place without reading them into the heap. The operating system loads the pages on first access.
+
+#ifndef GOMOKU_MAPPED_FILE_H
+#define GOMOKU_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+class mapped_file {
+
+public:
+    // Throws a gomoku_exception if the file cannot be opened or mapped. An empty file has no data.
+    explicit mapped_file(const std::string& path);
+    ~mapped_file();
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    // starts at a page boundary
+    const char* get_data() const;
+    std::size_t get_size() const;
+
+private:
+    const char* _data;
+    std::size_t _size;
+#ifdef _WIN32
+    void* _file_handle;
+    void* _mapping_handle;
+#endif
+
+    void unmap();
+};
+
+
+#endif //GOMOKU_MAPPED_FILE_H
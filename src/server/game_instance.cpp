@@ -7,6 +7,8 @@
 #include "game_instance.h"
 
 #include "server_network_manager.h"
+#include "server_metrics.h"
+#include "request_tracer.h"
 #include "../common/network/responses/full_state_response.h"
 
 
@@ -14,6 +16,10 @@ game_instance::game_instance() {
     _game_state = new game_state();
 }
 
+game_instance::game_instance(game_state* state) {
+    _game_state = state;
+}
+
 game_state *game_instance::get_game_state() {
     return _game_state;
 }
@@ -26,6 +32,12 @@ bool game_instance::is_player_allowed_to_play(player *player) {
     return _game_state->is_allowed_to_play_now(player);
 }
 
+void game_instance::notify_bot() {
+    if (_bot != nullptr) {
+        _bot->notify();
+    }
+}
+
 bool game_instance::is_full() {
     return _game_state->is_full();
 }
@@ -41,12 +53,14 @@ bool game_instance::is_finished() {
 
 
 bool game_instance::start_game(player* player, std::string &err) {
-    modification_lock.lock();
+    trace_span span("game_instance::start_game");
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
     if (_game_state->get_opening_rules() != ruleset_type::uninitialized) {
         if (_game_state->start_game(err)) {
             // send state update to all other players
             full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
             server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+            notify_bot();
             modification_lock.unlock();
             return true;
         }
@@ -60,12 +74,14 @@ bool game_instance::start_game(player* player, std::string &err) {
 }
 
 bool game_instance::try_remove_player(player *player, std::string &err) {
-    modification_lock.lock();
+    trace_span span("game_instance::try_remove_player");
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
     if (_game_state->remove_player(player, err)) {
         player->set_game_id("");
         // send state update to all other players
         full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
         server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+        notify_bot();
         modification_lock.unlock();
         return true;
     }
@@ -74,12 +90,14 @@ bool game_instance::try_remove_player(player *player, std::string &err) {
 }
 
 bool game_instance::try_add_player(player *new_player, std::string &err) {
-    modification_lock.lock();
+    trace_span span("game_instance::try_add_player");
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
     if (_game_state->add_player(new_player, err)) {
         new_player->set_game_id(get_id());
         // send state update to all other players
         full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
         server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), new_player);
+        notify_bot();
         modification_lock.unlock();
         return true;
     }
@@ -88,40 +106,53 @@ bool game_instance::try_add_player(player *new_player, std::string &err) {
 }
 
 bool game_instance::place_stone(player *player, unsigned int x, unsigned int y, field_type colour, std::string &err) {
-    modification_lock.lock();
-    if (_game_state->place_stone(x, y, colour, err)){
-        if (_game_state->check_win_condition(x, y, colour) ||
-           (_game_state->get_turn_number() >= playing_board::MAX_NUM_STONES-1 && _game_state->check_for_tie())) { // -1 because turn number starts at 0 -> first turn that a tie can occur on is 224 in freestyle
+    trace_span span("game_instance::place_stone");
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
+    bool is_placed;
+    bool is_round_over = false;
+    {
+        trace_span rules_span("rule_evaluation");
+        is_placed = _game_state->place_stone(x, y, colour, err);
+        if (is_placed) {
+            is_round_over = _game_state->check_win_condition(x, y, colour) || _game_state->check_for_tie();
+        }
+    }
+    if (is_placed){
+        if (is_round_over) {
             _game_state->wrap_up_round(err);
             full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
             server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+            notify_bot();
             modification_lock.unlock();
             return true;
         } else if (_game_state->update_current_player(err)){
             _game_state->iterate_turn();
             full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
             server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+            notify_bot();
             modification_lock.unlock();
             return true;
         } else {
             err = "game_instance: Unable to update current player.";
         }
     } else {
-        err = "game_instance: Unable to place stone.";
+        err = "game_instance: Unable to place stone. " + err;
     }
     modification_lock.unlock();
     return false;
 }
 
 bool game_instance::do_swap_decision(player *player, swap_decision_type swap_decision, std::string &err) {
+    trace_span span("game_instance::do_swap_decision");
     // NOTE: This method expects swap_decision to be "do_swap", "do_not_swap", or "defer_swap".
     // Anything else will result in an error, or return false, to occur.
-    modification_lock.lock();
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
     if (_game_state->determine_swap_decision(swap_decision, err)) {
         if (_game_state->update_current_player(err)){
             _game_state->iterate_turn();
             full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
             server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+            notify_bot();
             modification_lock.unlock();
             return true;
         } else {
@@ -135,11 +166,13 @@ bool game_instance::do_swap_decision(player *player, swap_decision_type swap_dec
 }
 
 bool game_instance::do_forfeit(player* player, std::string &err){
-    modification_lock.lock();
+    trace_span span("game_instance::do_forfeit");
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
     if(_game_state->alternate_current_player(err)){
         _game_state->wrap_up_round(err);
         full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
         server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+        notify_bot();
         modification_lock.unlock();
         return true;
     } else {
@@ -149,15 +182,104 @@ bool game_instance::do_forfeit(player* player, std::string &err){
     return false;
 }
 
-bool game_instance::set_game_mode(player* player, const std::string& ruleset_string, std::string& err) {
-    modification_lock.lock();
-    if (_game_state->set_game_mode(ruleset_string, err)) {
+bool game_instance::set_game_mode(player* player, const std::string& ruleset_string, unsigned int board_size, std::string& err) {
+    trace_span span("game_instance::set_game_mode");
+    // checked before anything changes, so that an unknown ruleset does not leave the board resized
+    if (game_state::_string_to_ruleset_type.count(ruleset_string) == 0) {
+        err = "game_instance: Unable to set game rule. Unknown ruleset " + ruleset_string + ".";
+        return false;
+    }
+    std::unique_lock<std::mutex> modification_guard(modification_lock, std::defer_lock);
+    server_metrics::lock(modification_guard, lock_type::game_modification_lock);
+    if (!_game_state->set_board_size(board_size, err) || !_game_state->set_game_mode(ruleset_string, err)) {
+        err = "game_instance: Unable to set game rule. " + err;
+        return false;
+    }
+    full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
+    server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
+    notify_bot();
+    return true;
+}
+
+bool game_instance::add_bot(player* player, const std::string& difficulty_string, std::string& err) {
+    trace_span span("game_instance::add_bot");
+    auto difficulty = server_bot::_string_to_bot_difficulty.find(difficulty_string);
+    if (difficulty == server_bot::_string_to_bot_difficulty.end()) {
+        err = "Unknown bot difficulty " + difficulty_string + ".";
+        return false;
+    }
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
+    if (_bot != nullptr) {
+        err = "This game already has a bot.";
+        modification_lock.unlock();
+        return false;
+    }
+    const std::vector<::player*>& players = _game_state->get_players();
+    const player_colour_type colour = !players.empty() && players.front()->get_colour() == player_colour_type::black
+            ? player_colour_type::white : player_colour_type::black;
+    std::unique_ptr<server_bot> bot = std::make_unique<server_bot>(this, difficulty->second, colour);
+    if (_game_state->add_player(bot->get_player(), err)) {
+        bot->get_player()->set_game_id(get_id());
+        _bot = std::move(bot);
         full_state_response state_update_msg = full_state_response(this->get_id(), *_game_state);
         server_network_manager::broadcast_message(state_update_msg, _game_state->get_players(), player);
         modification_lock.unlock();
         return true;
     }
-    err = "game_instance: Unable to set game rule.";
     modification_lock.unlock();
     return false;
 }
+
+bool game_instance::get_bot(player*& bot_player, std::string& difficulty_string) {
+    if (_bot == nullptr) {
+        return false;
+    }
+    bot_player = _bot->get_player();
+    difficulty_string = server_bot::_bot_difficulty_to_string.at(_bot->get_difficulty());
+    return true;
+}
+
+bool game_instance::restore_bot(const std::string& bot_player_id, const std::string& difficulty_string, std::string& err) {
+    auto difficulty = server_bot::_string_to_bot_difficulty.find(difficulty_string);
+    if (difficulty == server_bot::_string_to_bot_difficulty.end()) {
+        err = "Unknown bot difficulty " + difficulty_string + ".";
+        return false;
+    }
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
+    if (_bot != nullptr) {
+        err = "This game already has a bot.";
+        modification_lock.unlock();
+        return false;
+    }
+    for (::player* restored_player : _game_state->get_players()) {
+        if (restored_player->get_id() == bot_player_id) {
+            _bot = std::make_unique<server_bot>(this, difficulty->second, std::unique_ptr<::player>(restored_player));
+            // the bot may be to move
+            notify_bot();
+            modification_lock.unlock();
+            return true;
+        }
+    }
+    err = "The game has no player " + bot_player_id + ".";
+    modification_lock.unlock();
+    return false;
+}
+
+void game_instance::stop_bot() {
+    // not under the modification_lock, as the bot may be waiting for it to play its move
+    if (_bot != nullptr) {
+        _bot->stop();
+    }
+}
+
+bool game_instance::get_search_position(player* player, std::optional<search_position>& position, bool& is_players_turn) {
+    server_metrics::lock(modification_lock, lock_type::game_modification_lock);
+    const bool is_playing = _game_state->is_started() && !_game_state->is_finished()
+                            && _game_state->get_players().size() == 2;
+    if (is_playing) {
+        position.emplace(*_game_state);
+        is_players_turn = _game_state->get_current_player() == player;
+    }
+    modification_lock.unlock();
+    return is_playing;
+}
@@ -6,21 +6,34 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <mutex>
+#include <optional>
 
 #include "../common/game_state/player/player.h"
 #include "../common/game_state/game_state.h"
+#include "../common/game_state/search_position/search_position.h"
+#include "server_bot.h"
 
 class game_instance {
 
 private:
     game_state* _game_state;
+    std::unique_ptr<server_bot> _bot;
     bool is_player_allowed_to_play(player* player);
+    // wakes up the bot after a change of the game
+    void notify_bot();
     inline static std::mutex modification_lock;
 
 public:
     game_instance();
+    // wraps a game_state that was restored from a snapshot, the game_instance takes ownership of it
+    explicit game_instance(game_state* state);
     ~game_instance() {
+        // the bot plays through this game_instance, so it has to stop first
+        if (_bot != nullptr) {
+            _bot->stop();
+        }
         if (_game_state != nullptr) {
             delete _game_state;
         }
@@ -39,9 +52,20 @@ public:
     bool try_add_player(player* new_player, std::string& err);
     bool try_remove_player(player* player, std::string& err);
     bool place_stone(player* player, unsigned int x, unsigned int y, field_type colour, std::string& err);
-    bool set_game_mode(player* player, const std::string& ruleset_string, std::string& err);
+    bool set_game_mode(player* player, const std::string& ruleset_string, unsigned int board_size, std::string& err);
     bool do_swap_decision(player* player, swap_decision_type swap_decision, std::string &err);
     bool do_forfeit(player* player, std::string &err);
+    // adds a bot of the given difficulty ("easy", "medium" or "hard") as the second player
+    bool add_bot(player* player, const std::string& difficulty_string, std::string& err);
+    // The player of the bot and its difficulty. Returns false if the game has no bot.
+    bool get_bot(player*& bot_player, std::string& difficulty_string);
+    // Lets the restored player 'bot_player_id' be played by a bot again, the bot takes ownership of the player.
+    bool restore_bot(const std::string& bot_player_id, const std::string& difficulty_string, std::string& err);
+    // stops the bot for good, so that it does not change the game anymore, e.g. before the game is saved
+    void stop_bot();
+
+    // Copies the board for a bot. Returns false if no round is being played.
+    bool get_search_position(player* player, std::optional<search_position>& position, bool& is_players_turn);
 };
 
 
@@ -10,6 +10,8 @@
 
 #include "player_manager.h"
 #include "server_network_manager.h"
+#include "server_metrics.h"
+#include "request_tracer.h"
 
 // Initialize static map
 std::unordered_map<std::string, game_instance*> game_instance_manager::games_lut = {};
@@ -17,7 +19,7 @@ std::unordered_map<std::string, game_instance*> game_instance_manager::games_lut
 game_instance *game_instance_manager::find_joinable_game_instance() {
     std::vector<std::string> to_remove;
     game_instance* res = nullptr;
-    games_lut_lock.lock_shared();
+    server_metrics::lock_shared(games_lut_lock, lock_type::game_lookup_lock);
     for (auto it = games_lut.begin(); it != games_lut.end(); it++) {
         if (it->second->is_finished()) {    // also check if there are any finished games that can be removed
             to_remove.push_back(it->first);
@@ -35,18 +37,19 @@ game_instance *game_instance_manager::find_joinable_game_instance() {
 
     // remove all finished games
     if (to_remove.size() > 0) {
-        games_lut_lock.lock();
+        server_metrics::lock(games_lut_lock, lock_type::game_lookup_lock);
         for (auto& game_id : to_remove) {
             games_lut.erase(game_id);
         }
         games_lut_lock.unlock();
     }
+    server_metrics::count_reaper_run(to_remove.size());
     return res;
 }
 
 game_instance* game_instance_manager::create_new_game() {
     game_instance* new_game = new game_instance();
-    games_lut_lock.lock();  // exclusive
+    server_metrics::lock(games_lut_lock, lock_type::game_lookup_lock);  // exclusive
     game_instance_manager::games_lut.insert({new_game->get_id(), new_game});
     games_lut_lock.unlock();
     return new_game;
@@ -54,8 +57,9 @@ game_instance* game_instance_manager::create_new_game() {
 
 
 bool game_instance_manager::try_get_game_instance(const std::string& game_id, game_instance *&game_instance_ptr) {
+    trace_span span("game_instance_manager::try_get_game_instance");
     game_instance_ptr = nullptr;
-    games_lut_lock.lock_shared();
+    server_metrics::lock_shared(games_lut_lock, lock_type::game_lookup_lock);
     auto it = game_instance_manager::games_lut.find(game_id);
     if (it != games_lut.end()) {
         game_instance_ptr = it->second;
@@ -64,8 +68,44 @@ bool game_instance_manager::try_get_game_instance(const std::string& game_id, ga
     return game_instance_ptr != nullptr;
 }
 
+std::vector<game_instance*> game_instance_manager::get_game_instances() {
+    std::vector<game_instance*> game_instances;
+    server_metrics::lock_shared(games_lut_lock, lock_type::game_lookup_lock);
+    for (auto& game : games_lut) {
+        if (!game.second->is_finished()) {
+            game_instances.push_back(game.second);
+        }
+    }
+    games_lut_lock.unlock_shared();
+    return game_instances;
+}
+
+bool game_instance_manager::try_add_game_instance(game_instance* game_instance_ptr) {
+    server_metrics::lock(games_lut_lock, lock_type::game_lookup_lock);
+    bool is_added = games_lut.insert({game_instance_ptr->get_id(), game_instance_ptr}).second;
+    games_lut_lock.unlock();
+    return is_added;
+}
+
+void game_instance_manager::get_statistics(unsigned int& nof_live_games, unsigned int& nof_queued_players) {
+    nof_live_games = 0;
+    nof_queued_players = 0;
+    server_metrics::lock_shared(games_lut_lock, lock_type::game_lookup_lock);
+    for (auto& game : games_lut) {
+        if (game.second->is_finished()) {
+            continue;
+        }
+        nof_live_games++;
+        if (!game.second->is_started()) {
+            nof_queued_players += game.second->get_game_state()->get_players().size();
+        }
+    }
+    games_lut_lock.unlock_shared();
+}
+
 bool
 game_instance_manager::try_get_player_and_game_instance(const std::string& player_id, player *&player, game_instance *&game_instance_ptr, std::string& err) {
+    trace_span span("game_instance_manager::try_get_player_and_game_instance");
     if (player_manager::try_get_player(player_id, player)) {
         if (game_instance_manager::try_get_game_instance(player->get_game_id(), game_instance_ptr)) {
             return true;
@@ -113,10 +153,10 @@ bool game_instance_manager::try_add_player(player *player, game_instance *&game_
     if (player->get_game_id() != "") {
         if (player->get_game_id() != game_instance_ptr->get_id()) {
             err = "Player is already active in a different src with id " + player->get_game_id();
-        } else {
-            err = "Player is already active in this src";
+            return false;
         }
-        return false;
+        // the player reconnected to its game, e.g. after the server was restarted
+        return true;
     }
 
     if (game_instance_ptr->try_add_player(player, err)) {
@@ -9,6 +9,7 @@
 #include <string>
 #include <shared_mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "game_instance.h"
 
@@ -41,6 +42,14 @@ public:
     static bool try_remove_player(player* player, const std::string& game_id, std::string& err);
     static bool try_remove_player(player* player, game_instance*& game_instance_ptr, std::string& err);
 
+    // returns all games that are not finished yet
+    static std::vector<game_instance*> get_game_instances();
+    // adds a game_instance that was restored from a snapshot. Returns false if a game with the same id exists already.
+    static bool try_add_game_instance(game_instance* game_instance_ptr);
+
+    // counts the games that are not finished yet and the players waiting in games that have not started yet
+    static void get_statistics(unsigned int& nof_live_games, unsigned int& nof_queued_players);
+
 };
 
 
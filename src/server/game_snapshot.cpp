@@ -0,0 +1,157 @@
+// The game_snapshot only exists on the server side. When the server shuts down, the games that are still running are
+// written to a file, so that they can be restored when the server starts again and the players can reconnect to them.
+
+#include "game_snapshot.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+#include "game_instance_manager.h"
+#include "player_manager.h"
+#include "../common/logging/logger.h"
+#include "../common/serialization/json_utils.h"
+
+
+std::string game_snapshot::get_path() {
+    const char* path = std::getenv("GOMOKU_SNAPSHOT_PATH");
+    return path != nullptr ? path : default_path;
+}
+
+
+bool game_snapshot::save(const std::string& path, unsigned int& nof_saved_games, std::string& err) {
+    nof_saved_games = 0;
+    rapidjson::Document snapshot(rapidjson::kObjectType);
+    rapidjson::Document::AllocatorType& allocator = snapshot.GetAllocator();
+    snapshot.AddMember("version", version, allocator);
+
+    rapidjson::Value games(rapidjson::kArrayType);
+    rapidjson::Value bots(rapidjson::kArrayType);
+    for (game_instance* game : game_instance_manager::get_game_instances()) {
+        game->stop_bot();
+        player* bot_player;
+        std::string difficulty;
+        if (game->get_bot(bot_player, difficulty)) {
+            rapidjson::Value bot(rapidjson::kObjectType);
+            bot.AddMember("game_id", rapidjson::Value(game->get_id().c_str(), allocator), allocator);
+            bot.AddMember("player_id", rapidjson::Value(bot_player->get_id().c_str(), allocator), allocator);
+            bot.AddMember("difficulty", rapidjson::Value(difficulty.c_str(), allocator), allocator);
+            bots.PushBack(bot, allocator);
+        }
+        rapidjson::Document* state_json = game->get_game_state()->to_json();
+        rapidjson::Value state_copy(*state_json, allocator);
+        games.PushBack(state_copy, allocator);
+        delete state_json;
+        nof_saved_games++;
+    }
+    snapshot.AddMember("games", games, allocator);
+    snapshot.AddMember("bots", bots, allocator);
+
+    std::string temporary_path = path + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::trunc);
+        file << json_utils::to_string(&snapshot);
+        if (!file) {
+            err = "Could not write snapshot to " + temporary_path;
+            return false;
+        }
+    }
+    std::error_code error_code;
+    std::filesystem::rename(temporary_path, path, error_code);
+    if (error_code) {
+        err = "Could not move snapshot to " + path + ": " + error_code.message();
+        return false;
+    }
+    return true;
+}
+
+
+bool game_snapshot::load(const std::string& path, std::chrono::milliseconds time_budget, unsigned int& nof_restored_games, std::string& err) {
+    nof_restored_games = 0;
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + time_budget;
+
+    std::ifstream file(path);
+    if (!file) {
+        return true;    // nothing to restore
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+
+    rapidjson::Document snapshot;
+    snapshot.Parse(content.str().c_str());
+    if (snapshot.HasParseError() || !snapshot.IsObject() || !snapshot.HasMember("version") || !snapshot["version"].IsUint()
+        || !snapshot.HasMember("games") || !snapshot["games"].IsArray()) {
+        err = "Could not parse snapshot " + path;
+        return false;
+    }
+    if (snapshot["version"].GetUint() != version) {
+        err = "Snapshot " + path + " has the unsupported version " + std::to_string(snapshot["version"].GetUint());
+        return false;
+    }
+
+    // the bot player of each game, snapshots without bots have no "bots" member
+    std::unordered_map<std::string, std::pair<std::string, std::string>> bots;
+    if (snapshot.HasMember("bots") && snapshot["bots"].IsArray()) {
+        for (const rapidjson::Value& bot : snapshot["bots"].GetArray()) {
+            if (bot.IsObject() && bot.HasMember("game_id") && bot["game_id"].IsString() && bot.HasMember("player_id")
+                && bot["player_id"].IsString() && bot.HasMember("difficulty") && bot["difficulty"].IsString()) {
+                bots[bot["game_id"].GetString()] = {bot["player_id"].GetString(), bot["difficulty"].GetString()};
+            }
+        }
+    }
+
+    const rapidjson::Value& games = snapshot["games"];
+    for (rapidjson::SizeType i = 0; i < games.Size(); ++i) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            GOMOKU_LOG(log_level::warning_level, "snapshot_load_timed_out",
+                       {"skipped_games", std::to_string(games.Size() - i)});
+            break;
+        }
+        game_state* state;
+        try {
+            state = game_state::from_json(games[i]);
+        } catch (const std::exception& e) {
+            GOMOKU_LOG(log_level::warning_level, "snapshot_game_invalid", {"error", e.what()});
+            continue;
+        }
+
+        game_instance* game = new game_instance(state);
+        if (!game_instance_manager::try_add_game_instance(game)) {
+            GOMOKU_LOG(log_level::warning_level, "snapshot_game_exists", {"game_id", state->get_id()});
+            delete game;
+            continue;
+        }
+        auto bot = bots.find(state->get_id());
+        std::string bot_player_id;
+        if (bot != bots.end()) {
+            std::string bot_err;
+            if (game->restore_bot(bot->second.first, bot->second.second, bot_err)) {
+                bot_player_id = bot->second.first;
+            } else {
+                GOMOKU_LOG(log_level::warning_level, "snapshot_bot_invalid", {"game_id", state->get_id()}, {"error", bot_err});
+            }
+        }
+        // the players are found by their id again when they reconnect, bots do not reconnect
+        for (player* restored_player : state->get_players()) {
+            if (restored_player->get_id() == bot_player_id) {
+                continue;
+            }
+            restored_player->set_game_id(state->get_id());
+            if (!player_manager::try_add_player(restored_player)) {
+                GOMOKU_LOG(log_level::warning_level, "snapshot_player_exists", {"player_id", restored_player->get_id()});
+            }
+        }
+        nof_restored_games++;
+    }
+
+    std::error_code error_code;
+    std::filesystem::rename(path, path + ".restored", error_code);
+    if (error_code) {
+        err = "Could not rename restored snapshot " + path + ": " + error_code.message();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,31 @@
+// The game_snapshot only exists on the server side. When the server shuts down, the games that are still running are
+// written to a file, so that they can be restored when the server starts again and the players can reconnect to them.
+
+#ifndef GOMOKU_GAME_SNAPSHOT_H
+#define GOMOKU_GAME_SNAPSHOT_H
+
+#include <chrono>
+#include <string>
+
+class game_snapshot {
+
+public:
+    static constexpr unsigned int version = 1;
+    static constexpr const char* default_path = "gomoku-snapshot.json";
+
+    // the path set with GOMOKU_SNAPSHOT_PATH, or default_path
+    static std::string get_path();
+
+    // Writes all games that are not finished to 'path'. Must only be called when no requests are handled anymore.
+    // The bots are stopped first, so that they do not change the games while they are written, and are saved with
+    // their difficulty. The file is replaced atomically, so a crash while saving keeps the previous snapshot.
+    static bool save(const std::string& path, unsigned int& nof_saved_games, std::string& err);
+
+    // Restores the games saved in 'path', but stops after 'time_budget' so that the server starts in bounded time.
+    // The bots of the games are created again. The file is renamed afterwards, so that the same games are not restored
+    // twice. Returns true if there is no file.
+    static bool load(const std::string& path, std::chrono::milliseconds time_budget, unsigned int& nof_restored_games, std::string& err);
+};
+
+
+#endif //GOMOKU_GAME_SNAPSHOT_H
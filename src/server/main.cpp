@@ -2,10 +2,53 @@
 // Created by manuel on 17.03.21.
 //
 
+#include <csignal>
+#include <cstdlib>
+
 #include "server_network_manager.h"
+#include "game_snapshot.h"
+#include "../common/logging/logger.h"
+#include "request_tracer.h"
+
+namespace {
+
+void on_shutdown_signal(int) {
+    server_network_manager::request_shutdown();
+}
+
+}
 
 int main() {
-    // create server_network_manager, which listens endlessly for new connections
+    // log level and sampling are set with GOMOKU_LOG_LEVEL and GOMOKU_LOG_SAMPLE_RATE
+    logger::configure_from_environment();
+    // every n-th request is traced if GOMOKU_TRACE_SAMPLE_RATE is set, see http://127.0.0.1:50506/trace
+    request_tracer::configure_from_environment();
+
+    // restore the games that were running when the server was stopped last time
+    std::string snapshot_path = game_snapshot::get_path();
+    std::string err;
+    unsigned int nof_games = 0;
+    if (!game_snapshot::load(snapshot_path, std::chrono::seconds(2), nof_games, err)) {
+        GOMOKU_LOG(log_level::error_level, "snapshot_load_failed", {"path", snapshot_path}, {"error", err});
+    } else if (nof_games > 0) {
+        GOMOKU_LOG(log_level::info_level, "snapshot_loaded", {"path", snapshot_path}, {"games", std::to_string(nof_games)});
+    }
+
+    std::signal(SIGINT, on_shutdown_signal);
+    std::signal(SIGTERM, on_shutdown_signal);
+
+    // create server_network_manager, which listens for new connections until the server is asked to shut down
     server_network_manager server;
-    return 0;
-}
\ No newline at end of file
+
+    if (server_network_manager::is_shutting_down()) {
+        if (!game_snapshot::save(snapshot_path, nof_games, err)) {
+            GOMOKU_LOG(log_level::error_level, "snapshot_save_failed", {"path", snapshot_path}, {"error", err});
+        } else {
+            GOMOKU_LOG(log_level::info_level, "snapshot_saved", {"path", snapshot_path}, {"games", std::to_string(nof_games)});
+        }
+    }
+    logger::flush();
+
+    // the threads of the connections are detached, so the static objects they use are not destroyed
+    std::quick_exit(0);
+}
@@ -7,12 +7,14 @@
 
 #include "player_manager.h"
 
+#include "server_metrics.h"
+
 // Initialize static map
 std::unordered_map<std::string, player*> player_manager::_players_lut = {};
 
 bool player_manager::try_get_player(const std::string& player_id, player *&player_ptr) {
     player_ptr = nullptr;
-    _rw_lock.lock_shared();
+    server_metrics::lock_shared(_rw_lock, lock_type::player_lookup_lock);
     auto it = player_manager::_players_lut.find(player_id);
     if (it != _players_lut.end()) {
         player_ptr = it->second;
@@ -30,15 +32,22 @@ bool player_manager::add_or_get_player(std::string name, const std::string& play
     } else {
         player_ptr = new player(player_id, std::move(name), player_colour_type::white);
     }
-    _rw_lock.lock();    // exclusive
+    server_metrics::lock(_rw_lock, lock_type::player_lookup_lock);    // exclusive
     player_manager::_players_lut.insert({player_id, player_ptr});
     _rw_lock.unlock();
     return true;
 }
 
+bool player_manager::try_add_player(player* player_ptr) {
+    server_metrics::lock(_rw_lock, lock_type::player_lookup_lock);    // exclusive
+    bool is_added = player_manager::_players_lut.insert({player_ptr->get_id(), player_ptr}).second;
+    _rw_lock.unlock();
+    return is_added;
+}
+
 bool player_manager::remove_player(const std::string& player_id, player *&player) {
     if (try_get_player(player_id, player)) {
-        _rw_lock.lock();    // exclusive
+        server_metrics::lock(_rw_lock, lock_type::player_lookup_lock);    // exclusive
         int nof_removals = player_manager::_players_lut.erase(player_id);
         _rw_lock.unlock();
         return true;
@@ -21,6 +21,8 @@ private:
 public:
     static bool try_get_player(const std::string& player_id, player*& player_ptr);
     static bool add_or_get_player(std::string name, const std::string& player_id, player*& player_ptr);
+    // adds a player that was restored from a snapshot. Returns false if a player with the same id exists already.
+    static bool try_add_player(player* player_ptr);
     static bool remove_player(const std::string& player_id, player*& player);  // not implemented
 };
 
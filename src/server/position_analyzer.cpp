@@ -0,0 +1,178 @@
+// The position_analyzer only exists on the server side. It searches the boards of analyze_position requests in the
+// background and sends the best lines to the player.
+
+#include "position_analyzer.h"
+
+#include <algorithm>
+
+#include "server_network_manager.h"
+#include "../common/game_state/game_state.h"
+#include "../common/game_state/position_hash/position_hash.h"
+#include "../common/exceptions/gomoku_exception.h"
+
+// initialize static members
+std::mutex position_analyzer::_lock;
+mcts_settings position_analyzer::_settings = {std::chrono::milliseconds(2000), 0, 1, 1.2f, 3, 1u << 18, 1};
+std::unordered_map<std::uint64_t, position_analyzer::cached_analysis> position_analyzer::_cache;
+std::deque<std::uint64_t> position_analyzer::_cache_order;
+std::unordered_map<std::string, position_analyzer::running_analysis> position_analyzer::_running;
+
+namespace {
+
+struct analysis_job {
+    player* requester;
+    std::string analysis_id;
+    search_position position;
+    unsigned int nof_lines;
+    mcts_engine engine;
+    std::chrono::steady_clock::time_point next_progress;
+};
+
+}
+
+
+bool position_analyzer::start_analysis(player* requester, const analyze_position_request& request, std::string& err) {
+    auto ruleset = game_state::_string_to_ruleset_type.find(request.get_ruleset_string());
+    if (ruleset == game_state::_string_to_ruleset_type.end() || ruleset->second == ruleset_type::uninitialized) {
+        err = "Unknown ruleset " + request.get_ruleset_string() + ".";
+        return false;
+    }
+    try {
+        search_position position(ruleset->second, request.get_board_size(), request.get_fields(),
+                                 request.get_colour_to_move());
+        start_analysis(requester, request.get_req_id(), position, std::clamp(request.get_nof_lines(), 1u, max_lines));
+        return true;
+    } catch (const gomoku_exception& e) {
+        err = e.what();
+        return false;
+    }
+}
+
+std::shared_ptr<task_scheduler::task> position_analyzer::start_analysis(player* requester, const std::string& analysis_id,
+                                                                        const search_position& position,
+                                                                        unsigned int nof_lines) {
+    if (position.is_finished()) {
+        throw gomoku_exception("The game on this board is already finished.");
+    }
+    std::vector<mcts_line> lines;
+    unsigned int nof_playouts = 0;
+    if (find_cached(position, lines, nof_playouts)) {
+        lines.resize(std::min<std::size_t>(lines.size(), nof_lines));
+        analysis_response response(analysis_id, true, nof_playouts, std::move(lines));
+        send(requester, response);
+        return nullptr;
+    }
+
+    mcts_settings settings;
+    {
+        std::lock_guard<std::mutex> analyzer_guard(_lock);
+        settings = _settings;
+    }
+    std::shared_ptr<analysis_job> job(new analysis_job{requester, analysis_id, position, nof_lines,
+                                                       mcts_engine(settings), std::chrono::steady_clock::now()});
+    job->engine.begin_search(job->position, false);
+    {
+        // registered before the task is submitted, so that a task that finishes right away can remove its entry
+        std::lock_guard<std::mutex> analyzer_guard(_lock);
+        running_analysis& running = _running[requester->get_id()];
+        if (running.task != nullptr) {
+            running.task->cancel();
+        }
+        running = {analysis_id, nullptr};
+    }
+
+    std::shared_ptr<task_scheduler::task> analysis_task = task_scheduler::get_server_scheduler().submit(
+            task_priority::background_priority, [job](std::chrono::steady_clock::time_point slice_end) {
+                const bool is_done = job->engine.run_search_slice(job->position, 0, slice_end);
+                const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                if (!is_done && now < job->next_progress) {
+                    return false;
+                }
+                job->next_progress = now + progress_interval;
+
+                std::vector<mcts_line> lines = job->engine.get_lines(max_lines, max_line_length);
+                const unsigned int nof_playouts = job->engine.end_search().num_playouts;
+                if (is_done) {
+                    add_to_cache(job->position, nof_playouts, lines);
+                    job->engine.clear_tree();
+                    finish_analysis(job->requester->get_id(), job->analysis_id);
+                }
+                lines.resize(std::min<std::size_t>(lines.size(), job->nof_lines));
+                analysis_response response(job->analysis_id, is_done, nof_playouts, std::move(lines));
+                send(job->requester, response);
+                return is_done;
+            });
+
+    std::lock_guard<std::mutex> analyzer_guard(_lock);
+    auto running = _running.find(requester->get_id());
+    if (running != _running.end() && running->second.analysis_id == analysis_id) {
+        running->second.task = analysis_task;
+    }
+    return analysis_task;
+}
+
+
+bool position_analyzer::find_cached(const search_position& position, std::vector<mcts_line>& lines,
+                                    unsigned int& nof_playouts) {
+    const canonical_hash key = position_hash::get_canonical_hash(position);
+    {
+        std::lock_guard<std::mutex> analyzer_guard(_lock);
+        auto cached = _cache.find(key.hash);
+        if (cached == _cache.end()) {
+            return false;
+        }
+        lines = cached->second.lines;
+        nof_playouts = cached->second.nof_playouts;
+    }
+    transform_lines(key.symmetry, position.get_board_size(), true, lines);
+    return true;
+}
+
+void position_analyzer::add_to_cache(const search_position& position, unsigned int nof_playouts,
+                                     std::vector<mcts_line> lines) {
+    const canonical_hash key = position_hash::get_canonical_hash(position);
+    transform_lines(key.symmetry, position.get_board_size(), false, lines);
+    std::lock_guard<std::mutex> analyzer_guard(_lock);
+    if (_cache.find(key.hash) == _cache.end()) {
+        _cache_order.push_back(key.hash);
+    }
+    _cache[key.hash] = {nof_playouts, std::move(lines)};
+    if (_cache_order.size() > max_cached_positions) {
+        _cache.erase(_cache_order.front());
+        _cache_order.pop_front();
+    }
+}
+
+void position_analyzer::finish_analysis(const std::string& player_id, const std::string& analysis_id) {
+    std::lock_guard<std::mutex> analyzer_guard(_lock);
+    auto running = _running.find(player_id);
+    // a newer analysis of the player may have replaced this one already
+    if (running != _running.end() && running->second.analysis_id == analysis_id) {
+        _running.erase(running);
+    }
+}
+
+void position_analyzer::set_settings(const mcts_settings& settings) {
+    std::lock_guard<std::mutex> analyzer_guard(_lock);
+    _settings = settings;
+}
+
+
+void position_analyzer::transform_lines(unsigned int symmetry, unsigned int board_size, bool is_inverse,
+                                        std::vector<mcts_line>& lines) {
+    auto transform = [symmetry, board_size, is_inverse](const search_move& move) {
+        return is_inverse ? position_hash::inverse_transform(symmetry, board_size, move)
+                          : position_hash::transform(symmetry, board_size, move);
+    };
+    for (mcts_line& line : lines) {
+        line.move = transform(line.move);
+        for (search_move& move : line.principal_variation) {
+            move = transform(move);
+        }
+    }
+}
+
+void position_analyzer::send(player* requester, analysis_response& response) {
+    const std::vector<player*> players = {requester};
+    server_network_manager::broadcast_message(response, players, nullptr);
+}
@@ -0,0 +1,75 @@
+// The position_analyzer only exists on the server side. It answers analyze_position requests: the board is searched by
+// a background task of the server's task_scheduler, so that analyses never hold up games. While the search runs, the
+// best lines found so far are sent to the player as analysis_responses, the last one is marked as final.
+// Final results are cached by the canonical hash of the position, so that repeated queries, also of mirrored or
+// rotated boards, are answered right away.
+
+#ifndef GOMOKU_POSITION_ANALYZER_H
+#define GOMOKU_POSITION_ANALYZER_H
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../common/game_state/player/player.h"
+#include "../common/game_state/mcts_engine/mcts_engine.h"
+#include "../common/network/requests/analyze_position_request.h"
+#include "../common/network/responses/analysis_response.h"
+#include "task_scheduler.h"
+
+class position_analyzer {
+
+public:
+    static constexpr unsigned int max_lines = 10;
+    static constexpr unsigned int max_line_length = 10;
+    static constexpr std::chrono::milliseconds progress_interval = std::chrono::milliseconds(250);
+    static constexpr std::size_t max_cached_positions = 4096;
+
+    // Builds the board of 'request' and starts its analysis. Returns false with 'err' for invalid boards.
+    static bool start_analysis(player* requester, const analyze_position_request& request, std::string& err);
+    // Starts the analysis of 'position' for 'requester' and returns its task. If the position is in the cache, the
+    // result is sent right away and nullptr is returned. An analysis that is still running for the same player is
+    // cancelled. Throws a gomoku_exception if the game in 'position' is finished.
+    static std::shared_ptr<task_scheduler::task> start_analysis(player* requester, const std::string& analysis_id,
+                                                                const search_position& position, unsigned int nof_lines);
+
+    // the cached result of 'position' in its orientation
+    static bool find_cached(const search_position& position, std::vector<mcts_line>& lines, unsigned int& nof_playouts);
+
+    // limits of the searches, e.g. fewer playouts for tests
+    static void set_settings(const mcts_settings& settings);
+
+private:
+    // lines in the canonical orientation of the position
+    struct cached_analysis {
+        unsigned int nof_playouts;
+        std::vector<mcts_line> lines;
+    };
+
+    static std::mutex _lock;
+    static mcts_settings _settings;
+    static std::unordered_map<std::uint64_t, cached_analysis> _cache;
+    static std::deque<std::uint64_t> _cache_order;  // oldest first
+    struct running_analysis {
+        std::string analysis_id;
+        std::shared_ptr<task_scheduler::task> task;
+    };
+
+    // the analysis that is running for a player, by player id
+    static std::unordered_map<std::string, running_analysis> _running;
+
+    static void add_to_cache(const search_position& position, unsigned int nof_playouts, std::vector<mcts_line> lines);
+    // applies 'symmetry' to all moves of 'lines', or its inverse
+    static void transform_lines(unsigned int symmetry, unsigned int board_size, bool is_inverse,
+                                std::vector<mcts_line>& lines);
+    static void finish_analysis(const std::string& player_id, const std::string& analysis_id);
+    static void send(player* requester, analysis_response& response);
+};
+
+
+#endif //GOMOKU_POSITION_ANALYZER_H
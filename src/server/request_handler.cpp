@@ -10,6 +10,8 @@
 #include "player_manager.h"
 #include "game_instance_manager.h"
 #include "game_instance.h"
+#include "position_analyzer.h"
+#include "request_tracer.h"
 
 #include "../common/network/requests/join_game_request.h"
 #include "../common/network/requests/place_stone_request.h"
@@ -17,9 +19,12 @@
 #include "../common/network/requests/select_game_mode_request.h"
 #include "../common/network/requests/restart_game_request.h"
 #include "../common/network/requests/forfeit_request.h"
+#include "../common/network/requests/add_bot_request.h"
+#include "../common/network/requests/analyze_position_request.h"
 
 
 request_response* request_handler::handle_request(const client_request* const req) {
+    trace_span span("request_handler::handle_request");
 
     // Prepare variables that are used by every request type
     player* player;
@@ -115,7 +120,8 @@ request_response* request_handler::handle_request(const client_request* const re
         case request_type::select_game_mode: {
             if (game_instance_manager::try_get_player_and_game_instance(player_id, player, game_instance_ptr, err)) {
                 const std::string& ruleset_string = (dynamic_cast<const select_game_mode_request *>(req))->get_ruleset_string();
-                if (game_instance_ptr->set_game_mode(player, ruleset_string, err)) {
+                unsigned int board_size = (dynamic_cast<const select_game_mode_request *>(req))->get_board_size();
+                if (game_instance_ptr->set_game_mode(player, ruleset_string, board_size, err)) {
                     return new request_response(game_instance_ptr->get_id(), req_id, true,
                                                 game_instance_ptr->get_game_state()->to_json(), err);
                 }
@@ -131,7 +137,7 @@ request_response* request_handler::handle_request(const client_request* const re
                     if(game_instance_ptr->get_game_state()->prepare_game(player, err)){
                         if (game_instance_ptr->get_game_state()->get_players().at(0)->reset_score(err) &&
                             game_instance_ptr->get_game_state()->get_players().at(1)->reset_score(err)){
-                            if (game_instance_ptr->set_game_mode(player, "uninitialized", err)){
+                            if (game_instance_ptr->set_game_mode(player, "uninitialized", game_instance_ptr->get_game_state()->get_board_size(), err)){
                                 return new request_response(game_instance_ptr->get_id(), req_id, true,
                                                         game_instance_ptr->get_game_state()->to_json(), err);
                             }
@@ -155,6 +161,34 @@ request_response* request_handler::handle_request(const client_request* const re
                                                 game_instance_ptr->get_game_state()->to_json(), err);
                 }
             }
+            return new request_response("", req_id, false, nullptr, err);
+        }
+
+        // ##################### ADD BOT ##################### //
+        case request_type::add_bot: {
+            if (game_instance_manager::try_get_player_and_game_instance(player_id, player, game_instance_ptr, err)) {
+                const std::string difficulty = (dynamic_cast<const add_bot_request *>(req))->get_difficulty();
+                if (game_instance_ptr->add_bot(player, difficulty, err)) {
+                    return new request_response(game_instance_ptr->get_id(), req_id, true,
+                                                game_instance_ptr->get_game_state()->to_json(), err);
+                }
+            }
+            return new request_response("", req_id, false, nullptr, err);
+        }
+
+        // ##################### ANALYZE POSITION ##################### //
+        case request_type::analyze_position: {
+            // the board is sent with the request, so the player does not need to be in a game
+            if (player_manager::try_get_player(player_id, player)) {
+                const analyze_position_request* analyze_req = dynamic_cast<const analyze_position_request *>(req);
+                if (position_analyzer::start_analysis(player, *analyze_req, err)) {
+                    // the results follow as analysis_responses
+                    return new request_response(game_id, req_id, true, nullptr, err);
+                }
+            } else {
+                err = "Unknown player, join a game first.";
+            }
+            return new request_response("", req_id, false, nullptr, err);
         }
 
         // ##################### UNKNOWN REQUEST ##################### //
@@ -0,0 +1,165 @@
+// The request_tracer only exists on the server side. It records how long the steps of handling a request take and
+// exports them in the Chrome trace format.
+
+#include "request_tracer.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+
+// initialize static members
+std::mutex request_tracer::_registry_lock;
+std::vector<std::shared_ptr<request_tracer::thread_buffer>> request_tracer::_live_buffers;
+request_tracer::thread_buffer request_tracer::_retired_buffer;
+
+namespace {
+
+thread_local uint32_t local_thread_id = 0;
+
+void append_json_string(std::ostream& out, const char* value) {
+    out << '"';
+    for (const char* c = value; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+}
+
+
+void request_tracer::set_sample_rate(unsigned int rate) {
+    _sample_rate.store(rate, std::memory_order_relaxed);
+}
+
+void request_tracer::configure_from_environment() {
+    const char* sample_rate = std::getenv("GOMOKU_TRACE_SAMPLE_RATE");
+    if (sample_rate != nullptr) {
+        set_sample_rate(std::strtoul(sample_rate, nullptr, 10));
+    }
+}
+
+
+void request_tracer::begin_request() {
+    unsigned int rate = _sample_rate.load(std::memory_order_relaxed);
+    _is_tracing = rate != 0 && _nof_requests.fetch_add(1, std::memory_order_relaxed) % rate == 0;
+}
+
+void request_tracer::end_request() {
+    _is_tracing = false;
+}
+
+
+void request_tracer::thread_buffer::append_to(std::vector<span_record>& out) {
+    std::lock_guard<std::mutex> buffer_guard(lock);
+    if (nof_recorded <= spans.size()) {
+        out.insert(out.end(), spans.begin(), spans.begin() + nof_recorded);
+    } else {
+        // oldest first
+        size_t oldest = nof_recorded % spans.size();
+        out.insert(out.end(), spans.begin() + oldest, spans.end());
+        out.insert(out.end(), spans.begin(), spans.begin() + oldest);
+    }
+}
+
+request_tracer::thread_registration::thread_registration() {
+    buffer = std::make_shared<thread_buffer>();
+    buffer->spans.resize(thread_buffer_capacity);
+    local_thread_id = ++_nof_threads;
+    std::lock_guard<std::mutex> registry_guard(_registry_lock);
+    _live_buffers.push_back(buffer);
+}
+
+request_tracer::thread_registration::~thread_registration() {
+    // keep the spans of threads that ended (e.g. closed connections)
+    std::vector<span_record> spans;
+    buffer->append_to(spans);
+    std::lock_guard<std::mutex> registry_guard(_registry_lock);
+    if (_retired_buffer.spans.empty()) {
+        _retired_buffer.spans.resize(retired_buffer_capacity);
+    }
+    for (const span_record& span : spans) {
+        _retired_buffer.spans[_retired_buffer.nof_recorded++ % retired_buffer_capacity] = span;
+    }
+    std::erase(_live_buffers, buffer);
+}
+
+// the buffer is only created once the thread records its first span, so threads of untraced requests cost nothing
+request_tracer::thread_buffer& request_tracer::local_buffer() {
+    thread_local thread_registration registration;
+    return *registration.buffer;
+}
+
+
+void request_tracer::record_span(const span_record& span) {
+    thread_buffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> buffer_guard(buffer.lock);
+    span_record& target = buffer.spans[buffer.nof_recorded++ % thread_buffer_capacity];
+    target = span;
+    target.thread_id = local_thread_id;
+}
+
+
+double request_tracer::get_ticks_per_microsecond() {
+    // measure the tick rate over at least 10ms since the start
+    std::chrono::steady_clock::time_point earliest_end = _start_time + std::chrono::milliseconds(10);
+    std::this_thread::sleep_until(earliest_end);
+    uint64_t end_ticks = now_ticks();
+    double elapsed_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start_time).count();
+    return double(end_ticks - _start_ticks) / elapsed_us;
+}
+
+std::string request_tracer::to_chrome_trace_json() {
+    std::vector<span_record> spans;
+    {
+        std::lock_guard<std::mutex> registry_guard(_registry_lock);
+        if (_retired_buffer.spans.empty()) {
+            _retired_buffer.spans.resize(retired_buffer_capacity);
+        }
+        _retired_buffer.append_to(spans);
+        for (const std::shared_ptr<thread_buffer>& buffer : _live_buffers) {
+            buffer->append_to(spans);
+        }
+    }
+    std::sort(spans.begin(), spans.end(), [](const span_record& a, const span_record& b) {
+        return a.start_ticks < b.start_ticks;
+    });
+
+    double ticks_per_microsecond = get_ticks_per_microsecond();
+
+    std::stringstream out;
+    out.precision(3);
+    out << std::fixed;
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    for (size_t i = 0; i < spans.size(); ++i) {
+        const span_record& span = spans[i];
+        if (i > 0) {
+            out << ',';
+        }
+        out << "{\"name\":";
+        append_json_string(out, span.name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << span.thread_id
+            << ",\"ts\":" << double(int64_t(span.start_ticks - _start_ticks)) / ticks_per_microsecond
+            << ",\"dur\":" << double(span.end_ticks - span.start_ticks) / ticks_per_microsecond;
+        if (span.detail != nullptr) {
+            out << ",\"args\":{\"detail\":";
+            append_json_string(out, span.detail);
+            out << '}';
+        }
+        out << '}';
+    }
+    out << "]}";
+    return out.str();
+}
+
+void request_tracer::clear() {
+    std::lock_guard<std::mutex> registry_guard(_registry_lock);
+    _retired_buffer.nof_recorded = 0;
+    for (const std::shared_ptr<thread_buffer>& buffer : _live_buffers) {
+        std::lock_guard<std::mutex> buffer_guard(buffer->lock);
+        buffer->nof_recorded = 0;
+    }
+}
@@ -0,0 +1,134 @@
+// The request_tracer only exists on the server side. It records how long the steps of handling a request take
+// (framing, parsing, lookups, waiting for locks, rule evaluation, serialization, socket writes, ...).
+// Only every n-th request is traced. The spans of a traced request are kept in a buffer of the thread that handles
+// it and can be exported in the Chrome trace format (chrome://tracing, Perfetto) for offline viewing.
+
+#ifndef GOMOKU_REQUEST_TRACER_H
+#define GOMOKU_REQUEST_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+class request_tracer {
+
+public:
+    static constexpr unsigned int thread_buffer_capacity = 4096;    // spans kept per thread
+    static constexpr unsigned int retired_buffer_capacity = 16384;  // spans kept of threads that ended
+
+    // a completed span
+    struct span_record {
+        const char* name;
+        const char* detail;     // optional, e.g. the request type
+        uint64_t start_ticks;
+        uint64_t end_ticks;
+        uint32_t thread_id;
+    };
+
+    // traces every 'rate'-th request, 0 disables tracing
+    static void set_sample_rate(unsigned int rate);
+    // reads GOMOKU_TRACE_SAMPLE_RATE from the environment
+    static void configure_from_environment();
+
+    // Decide whether the request that the calling thread is about to handle is traced.
+    // Spans opened by the thread until end_request() belong to this request.
+    static void begin_request();
+    static void end_request();
+
+    static bool is_tracing() {
+        return _is_tracing;
+    }
+
+    // timestamp in ticks of the time stamp counter where it is available, in steady_clock ticks otherwise
+    static uint64_t now_ticks() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    static void record_span(const span_record& span);
+
+    // all spans recorded so far, as a Chrome trace JSON document
+    static std::string to_chrome_trace_json();
+    static void clear();
+
+private:
+    struct thread_buffer {
+        std::mutex lock;    // only contended while exporting
+        std::vector<span_record> spans;
+        uint64_t nof_recorded = 0;  // the oldest spans are overwritten once the buffer is full
+
+        void append_to(std::vector<span_record>& out);
+    };
+
+    // registers the buffer of the calling thread on first use and moves its spans to the retired spans when it ends
+    struct thread_registration {
+        std::shared_ptr<thread_buffer> buffer;
+        thread_registration();
+        ~thread_registration();
+    };
+
+    static thread_buffer& local_buffer();
+    static double get_ticks_per_microsecond();
+
+    inline static std::atomic<unsigned int> _sample_rate = 0;
+    inline static std::atomic<uint64_t> _nof_requests = 0;
+    inline static std::atomic<uint32_t> _nof_threads = 0;
+    inline static thread_local bool _is_tracing = false;
+
+    static std::mutex _registry_lock;
+    static std::vector<std::shared_ptr<thread_buffer>> _live_buffers;
+    static thread_buffer _retired_buffer;
+
+    // reference points to convert ticks into time
+    inline static const uint64_t _start_ticks = now_ticks();
+    inline static const std::chrono::steady_clock::time_point _start_time = std::chrono::steady_clock::now();
+};
+
+
+// Records the time between its construction and destruction as a span named 'name', if the current request is traced.
+// 'name' and 'detail' must outlive the trace, string literals are used for them.
+class trace_span {
+
+public:
+    explicit trace_span(const char* name, const char* detail = nullptr) {
+        if (request_tracer::is_tracing()) {
+            _name = name;
+            _detail = detail;
+            _start_ticks = request_tracer::now_ticks();
+        }
+    }
+
+    ~trace_span() {
+        if (_name != nullptr) {
+            request_tracer::record_span({_name, _detail, _start_ticks, request_tracer::now_ticks(), 0});
+        }
+    }
+
+    void set_detail(const char* detail) {
+        _detail = detail;
+    }
+
+    trace_span(const trace_span&) = delete;
+    trace_span& operator=(const trace_span&) = delete;
+
+private:
+    const char* _name = nullptr;
+    const char* _detail = nullptr;
+    uint64_t _start_ticks = 0;
+};
+
+
+#endif //GOMOKU_REQUEST_TRACER_H
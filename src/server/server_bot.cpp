@@ -0,0 +1,167 @@
+// The server_bot only exists on the server side. It plays for one player of a game with an mcts_engine on its own
+// thread.
+
+#include "server_bot.h"
+
+#include <algorithm>
+
+#include "game_instance.h"
+#include "../common/logging/logger.h"
+#include "../common/exceptions/gomoku_exception.h"
+
+// for deserialization
+const std::unordered_map<std::string, bot_difficulty> server_bot::_string_to_bot_difficulty = {
+        {"easy",   bot_difficulty::easy_bot},
+        {"medium", bot_difficulty::medium_bot},
+        {"hard",   bot_difficulty::hard_bot}
+};
+// for serialization
+const std::unordered_map<bot_difficulty, std::string> server_bot::_bot_difficulty_to_string = {
+        {bot_difficulty::easy_bot,   "easy"},
+        {bot_difficulty::medium_bot, "medium"},
+        {bot_difficulty::hard_bot,   "hard"}
+};
+
+
+server_bot::server_bot(game_instance* game, bot_difficulty difficulty, player_colour_type colour,
+                       task_scheduler& scheduler) :
+        server_bot(game, difficulty, std::make_unique<player>(uuid_generator::generate_uuid_v4(),
+                                                              "Bot (" + _bot_difficulty_to_string.at(difficulty) + ")",
+                                                              colour), scheduler)
+{ }
+
+server_bot::server_bot(game_instance* game, bot_difficulty difficulty, std::unique_ptr<player> bot_player,
+                       task_scheduler& scheduler) :
+        _game(game),
+        _difficulty(difficulty),
+        _player(std::move(bot_player)),
+        _scheduler(scheduler),
+        _max_threads(mcts_engine::get_settings(difficulty).num_threads),
+        _engine(mcts_engine::get_settings(difficulty)),
+        _is_changed(false),
+        _is_stopped(false)
+{
+    _thread = std::thread(&server_bot::run, this);
+}
+
+server_bot::~server_bot() {
+    stop();
+}
+
+player* server_bot::get_player() {
+    return _player.get();
+}
+
+bot_difficulty server_bot::get_difficulty() const {
+    return _difficulty;
+}
+
+
+void server_bot::notify() {
+    std::lock_guard<std::mutex> bot_guard(_lock);
+    _is_changed = true;
+    _changed.notify_one();
+}
+
+void server_bot::stop() {
+    {
+        std::lock_guard<std::mutex> bot_guard(_lock);
+        _is_stopped = true;
+        _changed.notify_one();
+    }
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+
+void server_bot::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> bot_guard(_lock);
+            _changed.wait(bot_guard, [this] { return _is_changed || _is_stopped; });
+            if (_is_stopped) {
+                break;
+            }
+            _is_changed = false;
+        }
+        // the engine is needed for the new position
+        stop_pondering();
+
+        std::optional<search_position> position;
+        bool is_bots_turn = false;
+        if (!_game->get_search_position(_player.get(), position, is_bots_turn) || position->is_finished()) {
+            continue;
+        }
+        if (is_bots_turn) {
+            play_move(*position);
+        } else {
+            start_pondering(*position);
+        }
+    }
+    stop_pondering();
+}
+
+void server_bot::play_move(const search_position& position) {
+    mcts_result result;
+    if (!_engine.find_known_move(position, result)) {
+        try {
+            _engine.begin_search(position, false);
+        } catch (const gomoku_exception& e) {
+            GOMOKU_LOG(log_level::warning_level, "bot_search_failed", {"error", e.what()});
+            return;
+        }
+        // every task searches the same tree, like the threads of mcts_engine::search()
+        const unsigned int nof_workers = _scheduler.get_nof_workers();
+        const unsigned int nof_tasks = _max_threads != 0 ? std::min(_max_threads, nof_workers) : nof_workers;
+        std::vector<std::shared_ptr<task_scheduler::task>> tasks;
+        for (unsigned int thread_idx = 0; thread_idx < nof_tasks; ++thread_idx) {
+            tasks.push_back(_scheduler.submit(task_priority::bot_move_priority,
+                    [this, &position, thread_idx](std::chrono::steady_clock::time_point slice_end) {
+                        return _engine.run_search_slice(position, thread_idx, slice_end);
+                    }));
+        }
+        for (const std::shared_ptr<task_scheduler::task>& search_task : tasks) {
+            search_task->wait();
+        }
+        result = _engine.end_search();
+        GOMOKU_LOG(log_level::debug_level, "bot_move_searched",
+                   {"playouts", std::to_string(result.num_playouts)},
+                   {"reused_playouts", std::to_string(result.num_reused_playouts)});
+    }
+
+    // the game_instance wakes the bot up again once the move is played
+    std::string err;
+    bool is_played;
+    if (result.best_move.type == search_move_type::stone_move) {
+        is_played = _game->place_stone(_player.get(), result.best_move.x, result.best_move.y,
+                                       position.get_current_colour(), err);
+    } else {
+        is_played = _game->do_swap_decision(_player.get(), result.best_move.swap_decision, err);
+    }
+    if (!is_played) {
+        GOMOKU_LOG(log_level::warning_level, "bot_move_rejected", {"error", err});
+    }
+}
+
+void server_bot::start_pondering(const search_position& position) {
+    try {
+        _engine.begin_search(position, true);
+    } catch (const gomoku_exception& e) {
+        return;
+    }
+    _ponder_position = position;
+    // pondering has no time limit, it ends when the task is cancelled
+    _ponder_task = _scheduler.submit(task_priority::background_priority,
+            [this](std::chrono::steady_clock::time_point slice_end) {
+                return _engine.run_search_slice(*_ponder_position, 0, slice_end);
+            });
+}
+
+void server_bot::stop_pondering() {
+    if (_ponder_task != nullptr) {
+        _ponder_task->cancel();
+        _ponder_task->wait();
+        _ponder_task.reset();
+    }
+}
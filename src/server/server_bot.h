@@ -0,0 +1,74 @@
+// The server_bot only exists on the server side. It plays for one player of a game with an mcts_engine on its own
+// thread. The game_instance wakes it up whenever the game changes: on its turn the bot searches and plays its move
+// through the game_instance like a client would, on the opponent's turn it ponders until the opponent has moved.
+// The search for the next move then continues with the subtree of the opponent's move.
+// The searches run as tasks of a task_scheduler, moves in the bot_move class and pondering in the background class.
+
+#ifndef GOMOKU_SERVER_BOT_H
+#define GOMOKU_SERVER_BOT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "../common/game_state/player/player.h"
+#include "../common/game_state/mcts_engine/mcts_engine.h"
+#include "task_scheduler.h"
+
+class game_instance;
+
+class server_bot {
+
+public:
+    // for deserialization
+    static const std::unordered_map<std::string, bot_difficulty> _string_to_bot_difficulty;
+    // for serialization
+    static const std::unordered_map<bot_difficulty, std::string> _bot_difficulty_to_string;
+
+    // creates the player of the bot, the bot does not join 'game' by itself
+    server_bot(game_instance* game, bot_difficulty difficulty, player_colour_type colour,
+               task_scheduler& scheduler = task_scheduler::get_server_scheduler());
+    // plays for 'bot_player', e.g. the player of a bot that was restored from a snapshot
+    server_bot(game_instance* game, bot_difficulty difficulty, std::unique_ptr<player> bot_player,
+               task_scheduler& scheduler = task_scheduler::get_server_scheduler());
+    ~server_bot();
+
+    player* get_player();
+    bot_difficulty get_difficulty() const;
+
+    // wakes the bot up after the game changed, which ends pondering
+    void notify();
+    // stops the thread of the bot after the move it is searching
+    void stop();
+
+private:
+    game_instance* _game;
+    bot_difficulty _difficulty;
+    std::unique_ptr<player> _player;
+    task_scheduler& _scheduler;
+    unsigned int _max_threads;      // of the difficulty, 0 for all workers of the scheduler
+    mcts_engine _engine;
+
+    std::mutex _lock;
+    std::condition_variable _changed;
+    bool _is_changed;
+    bool _is_stopped;
+    std::thread _thread;
+    // only used by the thread of the bot
+    std::optional<search_position> _ponder_position;
+    std::shared_ptr<task_scheduler::task> _ponder_task;
+
+    void run();
+    void play_move(const search_position& position);
+    // ponders in the background until stop_pondering() is called
+    void start_pondering(const search_position& position);
+    void stop_pondering();
+};
+
+
+#endif //GOMOKU_SERVER_BOT_H
@@ -0,0 +1,295 @@
+// The server_metrics only exist on the server side. They count what is going on inside the server (requests, traffic,
+// lock contention, ...) and expose the totals in the Prometheus text format on a separate local port.
+
+#include "server_metrics.h"
+
+#include <sstream>
+#include <thread>
+
+#include "sockpp/tcp_acceptor.h"
+
+#include "game_instance_manager.h"
+#include "task_scheduler.h"
+#include "../common/logging/logger.h"
+
+// initialize static members
+std::mutex server_metrics::_registry_lock;
+std::vector<server_metrics::thread_counters*> server_metrics::_live_counters;
+server_metrics::thread_counters server_metrics::_retired_counters;
+
+namespace {
+
+sockpp::tcp_acceptor metrics_acceptor;
+
+const std::array<std::string, server_metrics::nof_lock_types> lock_type_names = {
+        "connection_lookup", "game_lookup", "player_lookup", "game_modification"
+};
+
+void add(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+void add_counter_to(const std::atomic<uint64_t>& counter, std::atomic<uint64_t>& total) {
+    total.fetch_add(counter.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+uint64_t get(const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+}
+
+void write_header(std::ostream& out, const std::string& name, const std::string& type, const std::string& help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+}
+
+
+void server_metrics::thread_counters::add_to(thread_counters& total) const {
+    add_counter_to(connections_opened, total.connections_opened);
+    add_counter_to(connections_closed, total.connections_closed);
+    add_counter_to(invalid_requests, total.invalid_requests);
+    add_counter_to(bytes_in, total.bytes_in);
+    add_counter_to(bytes_out, total.bytes_out);
+    add_counter_to(reaper_runs, total.reaper_runs);
+    add_counter_to(reaped_games, total.reaped_games);
+    for (unsigned int type = 0; type < nof_request_types; ++type) {
+        add_counter_to(requests[type], total.requests[type]);
+        add_counter_to(request_latency_ns[type], total.request_latency_ns[type]);
+        for (unsigned int bucket = 0; bucket <= latency_buckets.size(); ++bucket) {
+            add_counter_to(request_latency_buckets[type][bucket], total.request_latency_buckets[type][bucket]);
+        }
+    }
+    for (unsigned int lock = 0; lock < nof_lock_types; ++lock) {
+        add_counter_to(lock_acquisitions[lock], total.lock_acquisitions[lock]);
+        add_counter_to(contended_lock_acquisitions[lock], total.contended_lock_acquisitions[lock]);
+        add_counter_to(lock_wait_ns[lock], total.lock_wait_ns[lock]);
+    }
+}
+
+
+server_metrics::thread_registration::thread_registration() {
+    std::lock_guard<std::mutex> registry_guard(_registry_lock);
+    _live_counters.push_back(&counters);
+}
+
+server_metrics::thread_registration::~thread_registration() {
+    // keep the counts of threads that ended (e.g. closed connections)
+    std::lock_guard<std::mutex> registry_guard(_registry_lock);
+    counters.add_to(_retired_counters);
+    std::erase(_live_counters, &counters);
+}
+
+server_metrics::thread_counters& server_metrics::local_counters() {
+    thread_local thread_registration registration;
+    return registration.counters;
+}
+
+
+void server_metrics::count_connection_opened() {
+    add(local_counters().connections_opened, 1);
+}
+
+void server_metrics::count_connection_closed() {
+    add(local_counters().connections_closed, 1);
+}
+
+void server_metrics::count_request(request_type type, std::chrono::steady_clock::duration latency) {
+    thread_counters& counters = local_counters();
+    uint64_t latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+    double latency_s = std::chrono::duration<double>(latency).count();
+
+    unsigned int bucket = 0;
+    while (bucket < latency_buckets.size() && latency_s > latency_buckets[bucket]) {
+        bucket++;
+    }
+    add(counters.requests[type], 1);
+    add(counters.request_latency_ns[type], latency_ns);
+    add(counters.request_latency_buckets[type][bucket], 1);
+}
+
+void server_metrics::count_invalid_request() {
+    add(local_counters().invalid_requests, 1);
+}
+
+void server_metrics::count_bytes_in(uint64_t bytes) {
+    add(local_counters().bytes_in, bytes);
+}
+
+void server_metrics::count_bytes_out(uint64_t bytes) {
+    add(local_counters().bytes_out, bytes);
+}
+
+void server_metrics::count_reaper_run(uint64_t nof_reaped_games) {
+    thread_counters& counters = local_counters();
+    add(counters.reaper_runs, 1);
+    add(counters.reaped_games, nof_reaped_games);
+}
+
+void server_metrics::count_lock_wait(lock_type lock, std::chrono::steady_clock::duration wait) {
+    thread_counters& counters = local_counters();
+    add(counters.lock_acquisitions[lock], 1);
+    if (wait > std::chrono::steady_clock::duration::zero()) {
+        add(counters.contended_lock_acquisitions[lock], 1);
+        add(counters.lock_wait_ns[lock], std::chrono::duration_cast<std::chrono::nanoseconds>(wait).count());
+    }
+}
+
+
+std::string server_metrics::to_prometheus_text() {
+    thread_counters total;
+    {
+        std::lock_guard<std::mutex> registry_guard(_registry_lock);
+        _retired_counters.add_to(total);
+        for (const thread_counters* counters : _live_counters) {
+            counters->add_to(total);
+        }
+    }
+
+    unsigned int nof_live_games = 0;
+    unsigned int nof_queued_players = 0;
+    game_instance_manager::get_statistics(nof_live_games, nof_queued_players);
+
+    std::stringstream out;
+
+    write_header(out, "gomoku_connected_sockets", "gauge", "Number of currently open client connections.");
+    out << "gomoku_connected_sockets " << get(total.connections_opened) - get(total.connections_closed) << "\n";
+    write_header(out, "gomoku_connections_total", "counter", "Number of accepted client connections.");
+    out << "gomoku_connections_total " << get(total.connections_opened) << "\n";
+
+    write_header(out, "gomoku_live_games", "gauge", "Number of games that are not finished.");
+    out << "gomoku_live_games " << nof_live_games << "\n";
+    write_header(out, "gomoku_queued_players", "gauge", "Number of players waiting in games that have not started yet.");
+    out << "gomoku_queued_players " << nof_queued_players << "\n";
+
+    write_header(out, "gomoku_requests_total", "counter", "Number of handled requests.");
+    for (unsigned int type = 0; type < nof_request_types; ++type) {
+        out << "gomoku_requests_total{type=\"" << client_request::get_type_name(request_type(type)) << "\"} " << get(total.requests[type]) << "\n";
+    }
+    write_header(out, "gomoku_invalid_requests_total", "counter", "Number of messages that could not be handled.");
+    out << "gomoku_invalid_requests_total " << get(total.invalid_requests) << "\n";
+
+    write_header(out, "gomoku_request_duration_seconds", "histogram", "Time from receiving a request until its response is sent.");
+    for (unsigned int type = 0; type < nof_request_types; ++type) {
+        const std::string& name = client_request::get_type_name(request_type(type));
+        uint64_t cumulative_count = 0;
+        for (unsigned int bucket = 0; bucket <= latency_buckets.size(); ++bucket) {
+            cumulative_count += get(total.request_latency_buckets[type][bucket]);
+            out << "gomoku_request_duration_seconds_bucket{type=\"" << name << "\",le=\"";
+            if (bucket < latency_buckets.size()) {
+                out << latency_buckets[bucket];
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative_count << "\n";
+        }
+        out << "gomoku_request_duration_seconds_sum{type=\"" << name << "\"} " << get(total.request_latency_ns[type]) / 1e9 << "\n";
+        out << "gomoku_request_duration_seconds_count{type=\"" << name << "\"} " << cumulative_count << "\n";
+    }
+
+    write_header(out, "gomoku_received_bytes_total", "counter", "Number of bytes read from client connections.");
+    out << "gomoku_received_bytes_total " << get(total.bytes_in) << "\n";
+    write_header(out, "gomoku_sent_bytes_total", "counter", "Number of bytes written to client connections.");
+    out << "gomoku_sent_bytes_total " << get(total.bytes_out) << "\n";
+
+    write_header(out, "gomoku_lock_acquisitions_total", "counter", "Number of times a lock was acquired.");
+    for (unsigned int lock = 0; lock < nof_lock_types; ++lock) {
+        out << "gomoku_lock_acquisitions_total{lock=\"" << lock_type_names[lock] << "\"} " << get(total.lock_acquisitions[lock]) << "\n";
+    }
+    write_header(out, "gomoku_lock_contended_acquisitions_total", "counter", "Number of times a lock was already held by another thread.");
+    for (unsigned int lock = 0; lock < nof_lock_types; ++lock) {
+        out << "gomoku_lock_contended_acquisitions_total{lock=\"" << lock_type_names[lock] << "\"} " << get(total.contended_lock_acquisitions[lock]) << "\n";
+    }
+    write_header(out, "gomoku_lock_wait_seconds_total", "counter", "Time spent waiting for a lock.");
+    for (unsigned int lock = 0; lock < nof_lock_types; ++lock) {
+        out << "gomoku_lock_wait_seconds_total{lock=\"" << lock_type_names[lock] << "\"} " << get(total.lock_wait_ns[lock]) / 1e9 << "\n";
+    }
+
+    write_header(out, "gomoku_reaper_runs_total", "counter", "Number of times finished games were looked for.");
+    out << "gomoku_reaper_runs_total " << get(total.reaper_runs) << "\n";
+    write_header(out, "gomoku_reaped_games_total", "counter", "Number of finished games that were removed.");
+    out << "gomoku_reaped_games_total " << get(total.reaped_games) << "\n";
+
+    const task_scheduler& scheduler = task_scheduler::get_server_scheduler();
+    write_header(out, "gomoku_engine_busy_seconds_total", "counter", "Time the engine workers spent on tasks of each class.");
+    for (unsigned int priority = 0; priority < task_scheduler::nof_priorities; ++priority) {
+        out << "gomoku_engine_busy_seconds_total{class=\"" << task_scheduler::priority_names[priority] << "\"} "
+            << scheduler.get_statistics(task_priority(priority)).busy_ns / 1e9 << "\n";
+    }
+    write_header(out, "gomoku_engine_utilization", "gauge", "Share of the time of all engine workers spent on each class since the start.");
+    for (unsigned int priority = 0; priority < task_scheduler::nof_priorities; ++priority) {
+        out << "gomoku_engine_utilization{class=\"" << task_scheduler::priority_names[priority] << "\"} "
+            << scheduler.get_utilization(task_priority(priority)) << "\n";
+    }
+    write_header(out, "gomoku_engine_tasks_total", "counter", "Number of engine tasks that completed or were cancelled.");
+    for (unsigned int priority = 0; priority < task_scheduler::nof_priorities; ++priority) {
+        const task_scheduler::class_statistics statistics = scheduler.get_statistics(task_priority(priority));
+        out << "gomoku_engine_tasks_total{class=\"" << task_scheduler::priority_names[priority] << "\",state=\"completed\"} "
+            << statistics.nof_completed << "\n";
+        out << "gomoku_engine_tasks_total{class=\"" << task_scheduler::priority_names[priority] << "\",state=\"cancelled\"} "
+            << statistics.nof_cancelled << "\n";
+    }
+    write_header(out, "gomoku_engine_queued_tasks", "gauge", "Number of engine tasks waiting for a worker.");
+    for (unsigned int priority = 0; priority < task_scheduler::nof_priorities; ++priority) {
+        out << "gomoku_engine_queued_tasks{class=\"" << task_scheduler::priority_names[priority] << "\"} "
+            << scheduler.get_statistics(task_priority(priority)).nof_queued << "\n";
+    }
+
+    return out.str();
+}
+
+
+bool server_metrics::start_listener(const std::string& host, uint16_t port, std::string& err) {
+    metrics_acceptor = sockpp::tcp_acceptor(sockpp::inet_address(host, port));
+    if (!metrics_acceptor) {
+        err = "Error creating the metrics acceptor: " + metrics_acceptor.last_error_str();
+        return false;
+    }
+    std::thread listener(listener_loop);
+    listener.detach();
+    return true;
+}
+
+// Answers one scrape after another. Scrapes are rare, so they don't need a thread each.
+void server_metrics::listener_loop() {
+    while (true) {
+        sockpp::tcp_socket sock = metrics_acceptor.accept();
+        if (!sock) {
+            GOMOKU_LOG(log_level::error_level, "metrics_accept_failed", {"error", metrics_acceptor.last_error_str()});
+            continue;
+        }
+        sock.read_timeout(std::chrono::seconds(1));
+
+        // read the request header, the body of a GET request is empty
+        std::string request;
+        char buffer[512];
+        ssize_t count = 0;
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192
+               && (count = sock.read(buffer, sizeof(buffer))) > 0) {
+            request.append(buffer, count);
+        }
+
+        std::string response;
+        if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+            std::string body = to_prometheus_text();
+            response = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+        } else if (request.rfind("GET /trace ", 0) == 0) {
+            // the traced requests so far, to be opened in chrome://tracing or Perfetto
+            std::string body = request_tracer::to_chrome_trace_json();
+            response = "HTTP/1.1 200 OK\r\n"
+                       "Content-Type: application/json\r\n"
+                       "Content-Disposition: attachment; filename=\"gomoku-trace.json\"\r\n"
+                       "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                       "Connection: close\r\n\r\n" + body;
+        } else {
+            response = "HTTP/1.1 404 Not Found\r\n"
+                       "Content-Length: 0\r\n"
+                       "Connection: close\r\n\r\n";
+        }
+        sock.write(response);
+        sock.shutdown();
+    }
+}
@@ -0,0 +1,119 @@
+// The server_metrics only exist on the server side. They count what is going on inside the server (requests, traffic,
+// lock contention, ...) and expose the totals in the Prometheus text format on a separate local port.
+// Every thread counts into its own block of counters without taking any lock. The blocks are only summed up when the
+// metrics are scraped.
+
+#ifndef GOMOKU_SERVER_METRICS_H
+#define GOMOKU_SERVER_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../common/network/requests/client_request.h"
+#include "request_tracer.h"
+
+// Identifier for the locks whose wait times are measured
+enum lock_type {
+    connection_lookup_lock,  // server_network_manager::_rw_lock
+    game_lookup_lock,        // game_instance_manager::games_lut_lock
+    player_lookup_lock,      // player_manager::_rw_lock
+    game_modification_lock,  // game_instance::modification_lock
+};
+
+class server_metrics {
+
+public:
+    static constexpr unsigned int nof_request_types = request_type::analyze_position + 1;
+    static constexpr unsigned int nof_lock_types = lock_type::game_modification_lock + 1;
+    // names of the trace spans of contended lock acquisitions
+    static constexpr std::array<const char*, nof_lock_types> lock_wait_span_names = {
+            "wait_connection_lookup_lock", "wait_game_lookup_lock", "wait_player_lookup_lock", "wait_game_modification_lock"
+    };
+    // upper bounds (in seconds) of the buckets of the request latency histograms, the last bucket is +Inf
+    static constexpr std::array<double, 12> latency_buckets = {0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005,
+                                                               0.01, 0.025, 0.05, 0.1, 0.25, 1.0};
+
+    // starts a thread that answers "GET /metrics" and "GET /trace" (see request_tracer) on 'host':'port'.
+    // Returns false if the port could not be opened.
+    static bool start_listener(const std::string& host, uint16_t port, std::string& err);
+
+    static void count_connection_opened();
+    static void count_connection_closed();
+    static void count_request(request_type type, std::chrono::steady_clock::duration latency);
+    static void count_invalid_request();
+    static void count_bytes_in(uint64_t bytes);
+    static void count_bytes_out(uint64_t bytes);
+    static void count_reaper_run(uint64_t nof_reaped_games);
+
+    // acquire 'mutex' and record how long it took
+    template<class mutex_type>
+    static void lock(mutex_type& mutex, lock_type lock) {
+        if (mutex.try_lock()) {
+            count_lock_wait(lock, std::chrono::steady_clock::duration::zero());
+            return;
+        }
+        trace_span wait_span(lock_wait_span_names[lock]);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        mutex.lock();
+        count_lock_wait(lock, std::chrono::steady_clock::now() - start);
+    }
+
+    template<class mutex_type>
+    static void lock_shared(mutex_type& mutex, lock_type lock) {
+        if (mutex.try_lock_shared()) {
+            count_lock_wait(lock, std::chrono::steady_clock::duration::zero());
+            return;
+        }
+        trace_span wait_span(lock_wait_span_names[lock]);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        mutex.lock_shared();
+        count_lock_wait(lock, std::chrono::steady_clock::now() - start);
+    }
+
+    // sums up the counters of all threads and writes them in the Prometheus text exposition format
+    static std::string to_prometheus_text();
+
+private:
+    // Counters of a single thread. Only the owning thread writes to them, so relaxed atomics are enough to
+    // read them consistently while scraping.
+    struct thread_counters {
+        std::atomic<uint64_t> connections_opened{0};
+        std::atomic<uint64_t> connections_closed{0};
+        std::atomic<uint64_t> invalid_requests{0};
+        std::atomic<uint64_t> bytes_in{0};
+        std::atomic<uint64_t> bytes_out{0};
+        std::atomic<uint64_t> reaper_runs{0};
+        std::atomic<uint64_t> reaped_games{0};
+        std::array<std::atomic<uint64_t>, nof_request_types> requests{};
+        std::array<std::atomic<uint64_t>, nof_request_types> request_latency_ns{};
+        std::array<std::array<std::atomic<uint64_t>, latency_buckets.size() + 1>, nof_request_types> request_latency_buckets{};
+        std::array<std::atomic<uint64_t>, nof_lock_types> lock_acquisitions{};
+        std::array<std::atomic<uint64_t>, nof_lock_types> contended_lock_acquisitions{};
+        std::array<std::atomic<uint64_t>, nof_lock_types> lock_wait_ns{};
+
+        void add_to(thread_counters& total) const;
+    };
+
+    // registers the counters of the calling thread on first use and folds them into _retired_counters when it ends
+    struct thread_registration {
+        thread_counters counters;
+        thread_registration();
+        ~thread_registration();
+    };
+
+    static thread_counters& local_counters();
+    static void count_lock_wait(lock_type lock, std::chrono::steady_clock::duration wait);
+    static void listener_loop();
+
+    static std::mutex _registry_lock;
+    static std::vector<thread_counters*> _live_counters;
+    static thread_counters _retired_counters;
+};
+
+
+#endif //GOMOKU_SERVER_METRICS_H
@@ -5,11 +5,18 @@
 // to all connected players of a game.
 
 #include "server_network_manager.h"
+
+#include <optional>
+
 #include "request_handler.h"
+#include "server_metrics.h"
+#include "request_tracer.h"
+#include "../common/logging/logger.h"
 
 // include server address configurations
 #include "../common/network/default.conf"
 #include "../common/network/responses/request_response.h"
+#include "../common/network/responses/server_shutdown_response.h"
 
 
 server_network_manager::server_network_manager() {
@@ -17,6 +24,14 @@ server_network_manager::server_network_manager() {
         _instance = this;
     }
     sockpp::socket_initializer socket_initializer; // Required to initialise sockpp
+
+    std::string err;
+    if (!server_metrics::start_listener(default_metrics_host, default_metrics_port, err)) {
+        GOMOKU_LOG(log_level::error_level, "metrics_listener_failed", {"error", err});    // the server also works without metrics
+    } else {
+        GOMOKU_LOG(log_level::info_level, "metrics_listener_started",
+                   {"address", default_metrics_host + ":" + std::to_string(default_metrics_port)});
+    }
     this->connect(default_server_host, default_port);   // variables from "default.conf"
 }
 
@@ -26,28 +41,50 @@ void server_network_manager::connect(const std::string &url, const uint16_t port
     this->_acc = sockpp::tcp_acceptor(port);
 
     if (!_acc) {
-        std::cerr << "Error creating the acceptor: " << _acc.last_error_str() << std::endl;
+        GOMOKU_LOG(log_level::error_level, "acceptor_failed", {"error", _acc.last_error_str()});
+        logger::flush();
         return;
     }
 
-    std::cout << "Awaiting connections on port " << port << "..." << std::endl;
-    listener_loop();    // start endless loop
+    GOMOKU_LOG(log_level::info_level, "awaiting_connections", {"port", std::to_string(port)});
+    std::thread shutdown_watcher(shutdown_watcher_loop);
+    listener_loop();    // runs until a shutdown is requested
+    shutdown_watcher.join();
+    drain_connections();
+}
+
+void server_network_manager::request_shutdown() {
+    _is_shutting_down.store(true);
+}
+
+bool server_network_manager::is_shutting_down() {
+    return _is_shutting_down.load();
+}
+
+// accept() cannot be interrupted by the signal handler itself, so this thread shuts the acceptor down instead
+void server_network_manager::shutdown_watcher_loop() {
+    while (!_is_shutting_down.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    GOMOKU_LOG(log_level::info_level, "shutdown_requested");
+    _acc.shutdown();
 }
 
 void server_network_manager::listener_loop() {
-    // intentional endless loop
-    while (true) {
+    while (!_is_shutting_down.load()) {
         sockpp::inet_address peer;
 
         // Accept a new client connection
         sockpp::tcp_socket sock = _acc.accept(&peer);
-        std::cout << "Received a connection request from " << peer << std::endl;
-
+        if (_is_shutting_down.load()) {
+            break;
+        }
         if (!sock) {
-            std::cerr << "Error accepting incoming connection: "
-                      << _acc.last_error_str() << std::endl;
+            GOMOKU_LOG(log_level::error_level, "accept_failed", {"error", _acc.last_error_str()});
         } else {
-            _rw_lock.lock();
+            GOMOKU_LOG(log_level::info_level, "connection_accepted", {"peer", peer.to_string()});
+            server_metrics::count_connection_opened();
+            server_metrics::lock(_rw_lock, lock_type::connection_lookup_lock);
             _address_to_socket.emplace(sock.peer_address().to_string(), std::move(sock.clone()));
             _rw_lock.unlock();
             // Create a listener thread and transfer the new stream to it.
@@ -74,7 +111,10 @@ void server_network_manager::read_message(sockpp::tcp_socket socket, const std::
     ssize_t msg_length = 0;
 
     while ((count = socket.read(buffer, sizeof(buffer))) > 0) {
+        server_metrics::count_bytes_in(count);
+        request_tracer::begin_request();
         try {
+            std::optional<trace_span> framing_span(std::in_place, "read_message");
             int i = 0;
             std::stringstream ss_msg_length;
             while (buffer[i] != ':' && i < count) {
@@ -82,7 +122,8 @@ void server_network_manager::read_message(sockpp::tcp_socket socket, const std::
                 i++;
             }
             msg_length = std::stoi(ss_msg_length.str());
-            std::cout << "Expecting message of length " << msg_length << std::endl;
+            GOMOKU_LOG(log_level::debug_level, "message_started", {"peer", socket.peer_address().to_string()},
+                       {"length", std::to_string(msg_length)});
 
             // put everything after the message length declaration into a stringstream
             std::stringstream ss_msg;
@@ -92,83 +133,156 @@ void server_network_manager::read_message(sockpp::tcp_socket socket, const std::
             // read the remaining packages
             while (msg_bytes_read < msg_length && count > 0) {
                 count = socket.read(buffer, sizeof(buffer));
+                if (count > 0) {
+                    server_metrics::count_bytes_in(count);
+                }
                 msg_bytes_read += count;
                 ss_msg.write(buffer, count);
             }
 
+            framing_span.reset();
+
             if (msg_bytes_read == msg_length) {
                 // sanity check that really all bytes got read (possibility that count was <= 0, indicating a read error)
                 std::string msg = ss_msg.str();
                 message_handler(msg, socket.peer_address());    // attempt to parse client_request from 'msg'
             } else {
-                std::cerr << "Could not read entire message. TCP stream ended before. Difference is " << msg_length - msg_bytes_read << std::endl;
+                GOMOKU_LOG(log_level::warning_level, "message_truncated", {"peer", socket.peer_address().to_string()},
+                           {"missing_bytes", std::to_string(msg_length - msg_bytes_read)});
             }
         } catch (std::exception& e) { // Make sure the connection isn't torn down only because of a read error
-            std::cerr << "Error while reading message from " << socket.peer_address() << std::endl << e.what() << std::endl;
+            GOMOKU_LOG(log_level::warning_level, "message_read_failed", {"peer", socket.peer_address().to_string()},
+                       {"error", e.what()});
         }
+        request_tracer::end_request();
     }
     if (count <= 0) {
-        std::cout << "Read error [" << socket.last_error() << "]: "
-                  << socket.last_error_str() << std::endl;
+        GOMOKU_LOG(log_level::info_level, "connection_read_ended", {"peer", socket.peer_address().to_string()},
+                   {"error_code", std::to_string(socket.last_error())}, {"error", socket.last_error_str()});
     }
 
-    std::cout << "Closing connection to " << socket.peer_address() << std::endl;
+    GOMOKU_LOG(log_level::info_level, "connection_closed", {"peer", socket.peer_address().to_string()});
     socket.shutdown();
+    server_metrics::count_connection_closed();
 }
 
 
 void server_network_manager::handle_incoming_message(const std::string& msg, const sockpp::tcp_socket::addr_t& peer_address) {
+    std::chrono::steady_clock::time_point received_at = std::chrono::steady_clock::now();
+    trace_span request_span("handle_incoming_message");
+    // counted before checking the flag, so that drain_connections() waits for every request that got past the check
+    _nof_active_requests.fetch_add(1);
     try {
         // try to parse a json from the 'msg'
         rapidjson::Document req_json;
-        req_json.Parse(msg.c_str());
+        {
+            trace_span parse_span("parse_json");
+            req_json.Parse(msg.c_str());
+        }
         // try to parse a client_request from the json
-        client_request* req = client_request::from_json(req_json);
+        client_request* req;
+        {
+            trace_span from_json_span("client_request::from_json");
+            req = client_request::from_json(req_json);
+        }
+        request_type type = req->get_type();
+        request_span.set_detail(client_request::get_type_name(type).c_str());
+
+        if (_is_shutting_down.load()) {
+            // the game states must not change anymore once they are being saved
+            request_response rejection("", req->get_req_id(), false, nullptr,
+                                       "The server is restarting. Please wait a moment.");
+            delete req;
+            rapidjson::Document* rejection_json = rejection.to_json();
+            send_message(json_utils::to_string(rejection_json), peer_address.to_string());
+            delete rejection_json;
+            _nof_active_requests.fetch_sub(1);
+            return;
+        }
 
         // check if this is a connection to a new player
         std::string player_id = req->get_player_id();
-        _rw_lock.lock_shared();
-        if (_player_id_to_address.find(player_id) == _player_id_to_address.end()) {
-            // save connection to this client
+        server_metrics::lock_shared(_rw_lock, lock_type::connection_lookup_lock);
+        auto known_address = _player_id_to_address.find(player_id);
+        if (known_address == _player_id_to_address.end() || known_address->second != peer_address.to_string()) {
+            // save connection to this client, or replace it if the client reconnected
             _rw_lock.unlock_shared();
-            std::cout << "New client with id " << player_id << std::endl;
-            _rw_lock.lock();
-            _player_id_to_address.emplace(player_id, peer_address.to_string());
+            GOMOKU_LOG(log_level::info_level, "client_registered", {"player_id", player_id},
+                       {"peer", peer_address.to_string()});
+            server_metrics::lock(_rw_lock, lock_type::connection_lookup_lock);
+            _player_id_to_address[player_id] = peer_address.to_string();
             _rw_lock.unlock();
         } else {
             _rw_lock.unlock_shared();
         }
-#ifdef PRINT_NETWORK_MESSAGES
-        std::cout << "\nReceived valid request : " << msg << std::endl;
-#endif
         // execute client request
+        GOMOKU_LOG(log_level::trace_level, "request_received", {"peer", peer_address.to_string()}, {"message", msg});
         server_response* res = request_handler::handle_request(req);
         delete req;
 
-        // transform response into a json
-        rapidjson::Document* res_json = res->to_json();
-        delete res;
+        std::string res_msg;
+        {
+            trace_span serialize_span("serialize_response");
+            // transform response into a json
+            rapidjson::Document* res_json = res->to_json();
+            delete res;
 
-        // transform json to string
-        std::string res_msg = json_utils::to_string(res_json);
+            // transform json to string
+            res_msg = json_utils::to_string(res_json);
+            delete res_json;
+        }
 
-#ifdef PRINT_NETWORK_MESSAGES
-        std::cout << "\nSending response : " << res_msg << std::endl;
-#endif
+        GOMOKU_LOG(log_level::trace_level, "response_sent", {"peer", peer_address.to_string()}, {"message", res_msg});
 
         // send response back to client
         send_message(res_msg, peer_address.to_string());
-        delete res_json;
+        server_metrics::count_request(type, std::chrono::steady_clock::now() - received_at);
     } catch (const std::exception& e) {
-        std::cerr << "Failed to execute client request. Content was :\n"
-                  << msg << std::endl
-                  << "Error was " << e.what() << std::endl;
+        server_metrics::count_invalid_request();
+        GOMOKU_LOG(log_level::warning_level, "request_failed", {"peer", peer_address.to_string()}, {"error", e.what()},
+                   {"message", msg});
+    }
+    _nof_active_requests.fetch_sub(1);
+}
+
+
+void server_network_manager::drain_connections() {
+    // the clients are told first, so that they stop sending requests while the ones in flight finish
+    server_shutdown_response notice("The server is restarting.", reconnect_delay.count());
+    rapidjson::Document* notice_json = notice.to_json();
+    std::string notice_msg = json_utils::to_string(notice_json);
+    delete notice_json;
+
+    server_metrics::lock_shared(_rw_lock, lock_type::connection_lookup_lock);
+    unsigned int nof_notified_clients = 0;
+    for (auto& connection : _address_to_socket) {
+        if (send_message(notice_msg, connection.first) > 0) {
+            nof_notified_clients++;
+        }
+    }
+    _rw_lock.unlock_shared();
+
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + drain_timeout;
+    while (_nof_active_requests.load() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    if (_nof_active_requests.load() > 0) {
+        GOMOKU_LOG(log_level::warning_level, "drain_timed_out",
+                   {"active_requests", std::to_string(_nof_active_requests.load())});
+    }
+
+    // the clients see the end of the stream after the last response and close their side
+    server_metrics::lock_shared(_rw_lock, lock_type::connection_lookup_lock);
+    for (auto& connection : _address_to_socket) {
+        connection.second.shutdown(SHUT_WR);
     }
+    _rw_lock.unlock_shared();
+    GOMOKU_LOG(log_level::info_level, "connections_drained", {"notified_clients", std::to_string(nof_notified_clients)});
 }
 
 
 void server_network_manager::on_player_left(std::string player_id) {
-    _rw_lock.lock();
+    server_metrics::lock(_rw_lock, lock_type::connection_lookup_lock);
     std::string address = _player_id_to_address[player_id];
     _player_id_to_address.erase(player_id);
     _address_to_socket.erase(address);
@@ -176,34 +290,44 @@ void server_network_manager::on_player_left(std::string player_id) {
 }
 
 ssize_t server_network_manager::send_message(const std::string &msg, const std::string& address) {
+    trace_span span("send_message");
 
     std::stringstream ss_msg;
     ss_msg << std::to_string(msg.size()) << ':' << msg; // prepend message length
-    return _address_to_socket.at(address).write(ss_msg.str());
+    ssize_t nof_bytes_written = _address_to_socket.at(address).write(ss_msg.str());
+    if (nof_bytes_written > 0) {
+        server_metrics::count_bytes_out(nof_bytes_written);
+    }
+    return nof_bytes_written;
 }
 
 void server_network_manager::broadcast_message(server_response &msg, const std::vector<player *> &players,
                                                const player *exclude) {
-    rapidjson::Document* msg_json = msg.to_json();  // write to JSON format
-    std::string msg_string = json_utils::to_string(msg_json);   // convert to string
+    trace_span span("broadcast_message");
+    std::string msg_string;
+    {
+        trace_span serialize_span("serialize_broadcast");
+        rapidjson::Document* msg_json = msg.to_json();  // write to JSON format
+        msg_string = json_utils::to_string(msg_json);   // convert to string
+        delete msg_json;
+    }
 
-#ifdef PRINT_NETWORK_MESSAGES
-    std::cout << "\nBroadcasting message : " << msg_string << std::endl;
-#endif
+    GOMOKU_LOG(log_level::trace_level, "broadcast_sent", {"message", msg_string});
 
-    _rw_lock.lock_shared();
+    server_metrics::lock_shared(_rw_lock, lock_type::connection_lookup_lock);
     // send object_diff to all requested players
     try {
         for (auto& player : players) {
-            if (player != exclude) {
-                int nof_bytes_written = send_message(msg_string, _player_id_to_address.at(player->get_id()));
+            // bots have no connection
+            auto address = _player_id_to_address.find(player->get_id());
+            if (player != exclude && address != _player_id_to_address.end()) {
+                int nof_bytes_written = send_message(msg_string, address->second);
             }
         }
     } catch (std::exception& e) {
-        std::cerr << "Encountered error when sending state update: " << e.what() << std::endl;
+        GOMOKU_LOG(log_level::error_level, "broadcast_failed", {"error", e.what()});
     }
     _rw_lock.unlock_shared();
-    delete msg_json;
 }
 
 
@@ -4,6 +4,8 @@
 #ifndef GOMOKU_SERVER_NETWORK_MANAGER_H
 #define GOMOKU_SERVER_NETWORK_MANAGER_H
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 #include <functional>
 #include <unordered_map>
@@ -28,6 +30,10 @@ private:
     inline static std::unordered_map<std::string, std::string> _player_id_to_address;
     inline static std::unordered_map<std::string, sockpp::tcp_socket> _address_to_socket;
 
+    // lock-free, so that it can be set from a signal handler
+    inline static std::atomic<bool> _is_shutting_down = false;
+    inline static std::atomic<unsigned int> _nof_active_requests = 0;
+
     void connect(const std::string& url, const uint16_t  port);
 
     static void listener_loop();
@@ -35,10 +41,25 @@ private:
                              const std::function<void(const std::string&, const sockpp::tcp_socket::addr_t&)>& message_handler);
     static void handle_incoming_message(const std::string& msg, const sockpp::tcp_socket::addr_t& peer_address);
     static ssize_t send_message(const std::string& msg, const std::string& address);
+    // stops accepting connections once a shutdown was requested
+    static void shutdown_watcher_loop();
+    // tells all clients to reconnect later, lets the requests in flight finish and closes the connections
+    static void drain_connections();
 public:
+    // how long the requests in flight may take to finish after a shutdown was requested
+    static constexpr std::chrono::milliseconds drain_timeout = std::chrono::milliseconds(5000);
+    // how long clients wait before they reconnect after a shutdown
+    static constexpr std::chrono::milliseconds reconnect_delay = std::chrono::milliseconds(2000);
+
+
+    // listens for new connections until request_shutdown() is called
     server_network_manager();
     ~server_network_manager();
 
+    // Makes the constructor return after the connections were drained. Safe to call from a signal handler.
+    static void request_shutdown();
+    static bool is_shutting_down();
+
     // Used to broadcast a server_response (e.g. a full_state_response) to all 'players' except 'exclude'
     static void broadcast_message(server_response& msg, const std::vector<player*>& players, const player* exclude);
 
@@ -0,0 +1,236 @@
+// The task_scheduler only exists on the server side. It runs the CPU heavy work of the server on a fixed number of
+// worker threads, in time slices and by priority class.
+
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+#include "../common/logging/logger.h"
+
+
+void task_scheduler::task::cancel() {
+    _is_cancelled.store(true);
+}
+
+bool task_scheduler::task::is_cancelled() const {
+    return _is_cancelled.load();
+}
+
+bool task_scheduler::task::is_done() const {
+    std::lock_guard<std::mutex> task_guard(_lock);
+    return _is_done;
+}
+
+void task_scheduler::task::wait() {
+    std::unique_lock<std::mutex> task_guard(_lock);
+    _done.wait(task_guard, [this] { return _is_done; });
+}
+
+void task_scheduler::task::finish() {
+    std::lock_guard<std::mutex> task_guard(_lock);
+    _is_done = true;
+    _done.notify_all();
+}
+
+
+task_scheduler::task_scheduler(unsigned int nof_workers) :
+        _time_slice(std::chrono::duration_cast<std::chrono::steady_clock::duration>(default_time_slice).count()),
+        _start_time(std::chrono::steady_clock::now())
+{
+    if (nof_workers == 0) {
+        nof_workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::atomic<unsigned int>& max_workers : _max_workers) {
+        max_workers.store(nof_workers);
+    }
+    for (unsigned int worker_idx = 0; worker_idx < nof_workers; ++worker_idx) {
+        _queues.push_back(std::make_unique<worker_queues>());
+    }
+    for (unsigned int worker_idx = 0; worker_idx < nof_workers; ++worker_idx) {
+        _workers.emplace_back(&task_scheduler::run_worker, this, worker_idx);
+    }
+}
+
+task_scheduler::~task_scheduler() {
+    {
+        std::lock_guard<std::mutex> sleep_guard(_sleep_lock);
+        _is_stopped.store(true);
+    }
+    _work_available.notify_all();
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+    // nobody must wait forever for a task that did not get to run
+    for (const std::unique_ptr<worker_queues>& queues : _queues) {
+        for (std::deque<std::shared_ptr<task>>& tasks : queues->tasks) {
+            for (const std::shared_ptr<task>& queued_task : tasks) {
+                queued_task->cancel();
+                queued_task->finish();
+            }
+        }
+    }
+}
+
+task_scheduler& task_scheduler::get_server_scheduler() {
+    // never destroyed, like the games whose bots use it
+    static task_scheduler* server_scheduler = [] {
+        const char* nof_workers = std::getenv("GOMOKU_ENGINE_THREADS");
+        task_scheduler* scheduler = new task_scheduler(nof_workers != nullptr ? std::strtoul(nof_workers, nullptr, 10) : 0);
+        scheduler->set_max_workers(task_priority::background_priority, scheduler->get_nof_workers() / 2);
+        return scheduler;
+    }();
+    return *server_scheduler;
+}
+
+
+std::shared_ptr<task_scheduler::task> task_scheduler::submit(task_priority priority, task_function function) {
+    std::shared_ptr<task> new_task(new task());
+    new_task->_priority = priority;
+    new_task->_function = std::move(function);
+    const unsigned int worker_idx = _current_scheduler == this
+            ? _current_worker : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+    enqueue(worker_idx, new_task);
+    return new_task;
+}
+
+void task_scheduler::set_max_workers(task_priority priority, unsigned int nof_workers) {
+    _max_workers[priority].store(std::max(1u, nof_workers));
+    wake_workers();
+}
+
+void task_scheduler::set_time_slice(std::chrono::steady_clock::duration time_slice) {
+    _time_slice.store(time_slice.count());
+}
+
+unsigned int task_scheduler::get_nof_workers() const {
+    return _workers.size();
+}
+
+task_scheduler::class_statistics task_scheduler::get_statistics(task_priority priority) const {
+    return {_busy_ns[priority].load(), _nof_slices[priority].load(), _nof_completed[priority].load(),
+            _nof_cancelled[priority].load(), _nof_queued[priority].load(), _nof_running[priority].load()};
+}
+
+double task_scheduler::get_utilization(task_priority priority) const {
+    const double elapsed_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - _start_time).count();
+    return double(_busy_ns[priority].load()) / (elapsed_ns * double(_workers.size()));
+}
+
+
+void task_scheduler::enqueue(unsigned int worker_idx, std::shared_ptr<task> queued_task) {
+    const task_priority priority = queued_task->_priority;
+    // counted first, so that the count never drops below zero when the task is taken right away
+    _nof_queued[priority].fetch_add(1);
+    {
+        std::lock_guard<std::mutex> queue_guard(_queues[worker_idx]->lock);
+        _queues[worker_idx]->tasks[priority].push_back(std::move(queued_task));
+    }
+    wake_workers();
+}
+
+void task_scheduler::wake_workers() {
+    // taking the lock makes sure that a worker that is about to sleep sees the change
+    {
+        std::lock_guard<std::mutex> sleep_guard(_sleep_lock);
+    }
+    _work_available.notify_all();
+}
+
+bool task_scheduler::has_runnable_task() const {
+    for (unsigned int priority = 0; priority < nof_priorities; ++priority) {
+        if (_nof_queued[priority].load() > 0 && _nof_running[priority].load() < _max_workers[priority].load()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::shared_ptr<task_scheduler::task> task_scheduler::take_task(unsigned int worker_idx) {
+    for (unsigned int priority = 0; priority < nof_priorities; ++priority) {
+        if (_nof_queued[priority].load() == 0) {
+            continue;
+        }
+        // reserve a place of the class before looking for a task
+        unsigned int nof_running = _nof_running[priority].load();
+        do {
+            if (nof_running >= _max_workers[priority].load()) {
+                break;
+            }
+        } while (!_nof_running[priority].compare_exchange_weak(nof_running, nof_running + 1));
+        if (nof_running >= _max_workers[priority].load()) {
+            continue;
+        }
+
+        // the own queue is taken from the front, so that its tasks get their slices in turn. Other queues are taken
+        // from the back.
+        for (unsigned int offset = 0; offset < _queues.size(); ++offset) {
+            worker_queues& queues = *_queues[(worker_idx + offset) % _queues.size()];
+            std::lock_guard<std::mutex> queue_guard(queues.lock);
+            std::deque<std::shared_ptr<task>>& tasks = queues.tasks[priority];
+            if (!tasks.empty()) {
+                std::shared_ptr<task> taken;
+                if (offset == 0) {
+                    taken = std::move(tasks.front());
+                    tasks.pop_front();
+                } else {
+                    taken = std::move(tasks.back());
+                    tasks.pop_back();
+                }
+                _nof_queued[priority].fetch_sub(1);
+                return taken;
+            }
+        }
+        _nof_running[priority].fetch_sub(1);
+    }
+    return nullptr;
+}
+
+void task_scheduler::run_worker(unsigned int worker_idx) {
+    _current_scheduler = this;
+    _current_worker = worker_idx;
+    while (true) {
+        std::shared_ptr<task> current = take_task(worker_idx);
+        if (current == nullptr) {
+            std::unique_lock<std::mutex> sleep_guard(_sleep_lock);
+            _work_available.wait(sleep_guard, [this] { return _is_stopped.load() || has_runnable_task(); });
+            if (_is_stopped.load()) {
+                return;
+            }
+            continue;
+        }
+
+        const task_priority priority = current->_priority;
+        bool is_done = true;
+        if (current->is_cancelled()) {
+            _nof_cancelled[priority].fetch_add(1);
+        } else {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            try {
+                is_done = current->_function(start + std::chrono::steady_clock::duration(_time_slice.load()));
+            } catch (const std::exception& e) {
+                GOMOKU_LOG(log_level::error_level, "task_failed",
+                           {"class", priority_names[priority]}, {"error", e.what()});
+            }
+            _busy_ns[priority].fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count());
+            _nof_slices[priority].fetch_add(1);
+            if (is_done) {
+                _nof_completed[priority].fetch_add(1);
+            }
+        }
+        _nof_running[priority].fetch_sub(1);
+
+        if (is_done) {
+            current->finish();
+            // a worker may wait for a place of this class
+            wake_workers();
+        } else {
+            enqueue(worker_idx, std::move(current));
+        }
+        if (_is_stopped.load()) {
+            return;
+        }
+    }
+}
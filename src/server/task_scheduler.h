@@ -0,0 +1,135 @@
+// The task_scheduler only exists on the server side. It runs the CPU heavy work of the server (bot searches, pondering,
+// analysis) on a fixed number of worker threads, so that this work cannot slow down the threads that handle requests.
+// Tasks belong to a priority class and run in time slices: a task is called again and again with the end of its slice
+// until it returns true. Before every slice a worker takes the waiting task of the highest class, so a long task of a
+// lower class delays a higher class by at most one slice. Every worker has its own queues and takes tasks from the
+// queues of the other workers once its own are empty (work stealing).
+// The number of workers per class can be capped, and the time spent on each class is exported by the server_metrics.
+
+#ifndef GOMOKU_TASK_SCHEDULER_H
+#define GOMOKU_TASK_SCHEDULER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Identifier for the priority classes, the first one is the most urgent
+enum task_priority {
+    interactive_priority,   // short work that a player is waiting for
+    bot_move_priority,      // searches for the moves of bots, which have a time budget
+    background_priority,    // pondering and analysis
+};
+
+class task_scheduler {
+
+public:
+    static constexpr unsigned int nof_priorities = task_priority::background_priority + 1;
+    static constexpr std::array<const char*, nof_priorities> priority_names = {"interactive", "bot_move", "background"};
+    static constexpr std::chrono::milliseconds default_time_slice = std::chrono::milliseconds(10);
+
+    // called with the end of the slice, returns true once the task is done
+    using task_function = std::function<bool(std::chrono::steady_clock::time_point slice_end)>;
+
+    class task {
+
+    public:
+        // The task is not run again. A slice that is running is finished first, long tasks can check is_cancelled()
+        // themselves.
+        void cancel();
+        bool is_cancelled() const;
+        bool is_done() const;
+        // waits until the task is done or was cancelled
+        void wait();
+
+    private:
+        friend class task_scheduler;
+
+        task_priority _priority;
+        task_function _function;
+        std::atomic<bool> _is_cancelled{false};
+        mutable std::mutex _lock;
+        std::condition_variable _done;
+        bool _is_done = false;
+
+        void finish();
+    };
+
+    struct class_statistics {
+        uint64_t busy_ns;           // time spent running slices
+        uint64_t nof_slices;
+        uint64_t nof_completed;
+        uint64_t nof_cancelled;
+        unsigned int nof_queued;    // tasks waiting for their next slice
+        unsigned int nof_running;
+    };
+
+    // starts 'nof_workers' workers, 0 starts one per core
+    explicit task_scheduler(unsigned int nof_workers = 0);
+    // stops the workers after their current slice, tasks that did not finish are cancelled
+    ~task_scheduler();
+
+    task_scheduler(const task_scheduler&) = delete;
+    task_scheduler& operator=(const task_scheduler&) = delete;
+
+    // The scheduler of the bots and analyses of the server. GOMOKU_ENGINE_THREADS sets its number of workers.
+    // Background work may use half of them.
+    static task_scheduler& get_server_scheduler();
+
+    std::shared_ptr<task> submit(task_priority priority, task_function function);
+
+    // caps the number of workers that run tasks of 'priority' at the same time
+    void set_max_workers(task_priority priority, unsigned int nof_workers);
+    void set_time_slice(std::chrono::steady_clock::duration time_slice);
+
+    unsigned int get_nof_workers() const;
+    class_statistics get_statistics(task_priority priority) const;
+    // share of the time of all workers that was spent on 'priority' since the scheduler was started
+    double get_utilization(task_priority priority) const;
+
+private:
+    struct worker_queues {
+        std::mutex lock;
+        std::array<std::deque<std::shared_ptr<task>>, nof_priorities> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queues>> _queues;
+    std::vector<std::thread> _workers;
+    std::atomic<std::chrono::steady_clock::rep> _time_slice;
+    std::atomic<unsigned int> _next_queue{0};
+    const std::chrono::steady_clock::time_point _start_time;
+
+    std::array<std::atomic<unsigned int>, nof_priorities> _max_workers{};
+    std::array<std::atomic<unsigned int>, nof_priorities> _nof_queued{};
+    std::array<std::atomic<unsigned int>, nof_priorities> _nof_running{};
+    std::array<std::atomic<uint64_t>, nof_priorities> _busy_ns{};
+    std::array<std::atomic<uint64_t>, nof_priorities> _nof_slices{};
+    std::array<std::atomic<uint64_t>, nof_priorities> _nof_completed{};
+    std::array<std::atomic<uint64_t>, nof_priorities> _nof_cancelled{};
+
+    // idle workers wait for _work_available
+    std::mutex _sleep_lock;
+    std::condition_variable _work_available;
+    std::atomic<bool> _is_stopped{false};
+
+    // the worker that runs on the calling thread, so that tasks submitted by tasks stay on their worker
+    inline static thread_local const task_scheduler* _current_scheduler = nullptr;
+    inline static thread_local unsigned int _current_worker = 0;
+
+    void run_worker(unsigned int worker_idx);
+    void enqueue(unsigned int worker_idx, std::shared_ptr<task> queued_task);
+    // takes the most urgent task whose class is below its cap, own tasks first. Returns nullptr if there is none.
+    std::shared_ptr<task> take_task(unsigned int worker_idx);
+    bool has_runnable_task() const;
+    void wake_workers();
+};
+
+
+#endif //GOMOKU_TASK_SCHEDULER_H
@@ -0,0 +1,102 @@
+// Builds an opening book from game records and games that bots play against each other.
+//
+//   Gomoku-book <book file> [--records <file>]... [--self-play <games>] [--ruleset <name>] [--board-size <size>]
+//               [--difficulty easy|medium|hard] [--depth <moves>] [--min-games <games>]
+//
+// Records are read in the game_record format (one JSON object per line). Self-play games are appended to
+// '<book file>.games.jsonl', so that they can be added to later books again.
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/common/game_state/opening_book/opening_book_builder.h"
+#include "../src/common/game_state/game_state.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+namespace {
+
+int print_usage() {
+    std::cerr << "Usage: Gomoku-book <book file> [--records <file>]... [--self-play <games>] [--ruleset <name>]"
+                 " [--board-size <size>] [--difficulty easy|medium|hard] [--depth <moves>] [--min-games <games>]"
+              << std::endl;
+    return 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        return print_usage();
+    }
+    const std::string book_path = argv[1];
+    std::vector<std::string> record_paths;
+    unsigned int num_self_play_games = 0;
+    ruleset_type ruleset = ruleset_type::swap2;
+    unsigned int board_size = playing_board::_playing_board_size;
+    bot_difficulty difficulty = bot_difficulty::easy_bot;
+    unsigned int depth = 8;
+    unsigned int min_games = 2;
+
+    try {
+        for (int i = 2; i < argc; i += 2) {
+            const std::string option = argv[i];
+            if (i + 1 >= argc) {
+                return print_usage();
+            }
+            const std::string value = argv[i + 1];
+            if (option == "--records") {
+                record_paths.push_back(value);
+            } else if (option == "--self-play") {
+                num_self_play_games = std::stoul(value);
+            } else if (option == "--ruleset" && game_state::_string_to_ruleset_type.contains(value)) {
+                ruleset = game_state::_string_to_ruleset_type.at(value);
+            } else if (option == "--board-size") {
+                board_size = std::stoul(value);
+            } else if (option == "--difficulty" && (value == "easy" || value == "medium" || value == "hard")) {
+                difficulty = value == "easy" ? easy_bot : value == "medium" ? medium_bot : hard_bot;
+            } else if (option == "--depth") {
+                depth = std::stoul(value);
+            } else if (option == "--min-games") {
+                min_games = std::stoul(value);
+            } else {
+                return print_usage();
+            }
+        }
+
+        opening_book_builder builder(depth);
+        for (const std::string& record_path : record_paths) {
+            std::ifstream records(record_path);
+            if (!records) {
+                std::cerr << "Could not open " << record_path << std::endl;
+                return 1;
+            }
+            game_record record;
+            while (game_record::read(records, record)) {
+                builder.add_game(record);
+            }
+        }
+
+        if (num_self_play_games > 0) {
+            std::ofstream games(book_path + ".games.jsonl", std::ios::app);
+            mcts_settings settings = mcts_engine::get_settings(difficulty);
+            for (unsigned int game = 0; game < num_self_play_games; ++game) {
+                settings.seed += 1000;
+                game_record record = opening_book_builder::play_self_play_game(ruleset, board_size, settings);
+                record.write(games);
+                builder.add_game(record);
+                std::cout << "self-play game " << game + 1 << "/" << num_self_play_games << ": "
+                          << record.moves.size() << " moves" << std::endl;
+            }
+        }
+
+        builder.write(book_path, min_games);
+        std::cout << builder.get_num_games() << " games, " << builder.get_num_positions() << " positions, written to "
+                  << book_path << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+// Annotates game records with evaluations of the mcts_engine and marks blunders and missed wins.
+//
+//   Gomoku-annotate <records file> <output file> [--playouts <playouts>] [--threads <threads>] [--batch <games>]
+//
+// Records are read in the game_record format (one JSON object per line) and written with an "annotations" member in
+// the same order, batch by batch, so that the output can be read while the tool runs. Every distinct position is only
+// searched once, also when it appears in several games or in another orientation.
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "../src/common/game_state/game_annotator/game_annotator.h"
+
+namespace {
+
+int print_usage() {
+    std::cerr << "Usage: Gomoku-annotate <records file> <output file> [--playouts <playouts>] [--threads <threads>]"
+                 " [--batch <games>]" << std::endl;
+    return 1;
+}
+
+void print_statistics(const game_annotator::statistics& statistics) {
+    std::cout << statistics.nof_games << " games, " << statistics.nof_positions << " positions ("
+              << statistics.nof_searched << " searched, " << statistics.nof_reused << " known), "
+              << statistics.nof_blunders << " blunders, " << statistics.nof_missed_wins << " missed wins, "
+              << static_cast<unsigned long>(statistics.nof_positions / std::max(statistics.seconds, 1e-9))
+              << " positions/s" << std::endl;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return print_usage();
+    }
+    const std::string records_path = argv[1];
+    const std::string output_path = argv[2];
+    unsigned int num_playouts = 2000;
+    unsigned int num_threads = 0;
+    unsigned int batch_size = 256;
+
+    try {
+        for (int i = 3; i < argc; ++i) {
+            const std::string argument = argv[i];
+            if (i + 1 >= argc) {
+                return print_usage();
+            }
+            if (argument == "--playouts") {
+                num_playouts = std::stoul(argv[++i]);
+            } else if (argument == "--threads") {
+                num_threads = std::stoul(argv[++i]);
+            } else if (argument == "--batch") {
+                batch_size = std::stoul(argv[++i]);
+            } else {
+                return print_usage();
+            }
+        }
+
+        std::ifstream records(records_path);
+        if (!records) {
+            std::cerr << "Could not open " << records_path << std::endl;
+            return 1;
+        }
+        std::ofstream output(output_path, std::ios::trunc);
+        if (!output) {
+            std::cerr << "Could not write " << output_path << std::endl;
+            return 1;
+        }
+
+        // the search is limited by playouts only, so that the evaluations do not depend on the load of the machine
+        mcts_settings search = mcts_engine::get_settings(bot_difficulty::hard_bot);
+        search.time_budget = std::chrono::milliseconds(0);
+        search.max_playouts = num_playouts;
+        search.max_nodes = 1u << 18;
+        game_annotator annotator({search, num_threads, 0.25f, 0.9f, 1u << 24});
+        std::cout << "Annotating " << records_path << " with " << annotator.get_num_workers() << " threads" << std::endl;
+        annotator.annotate_records(records, output, batch_size, print_statistics);
+        std::cout << "written to " << output_path << " in " << annotator.get_statistics().seconds << " s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
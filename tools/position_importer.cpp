@@ -0,0 +1,69 @@
+// Imports the positions of game records into a position database.
+//
+//   Gomoku-positions <database file> <records file>... [--max-plies <plies>]
+//
+// Records are read in the game_record format (one JSON object per line). With --max-plies, only the positions that
+// many plies before the end of each game are imported, which gives a database of endgame puzzles.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../src/common/game_state/position_database/position_database_builder.h"
+
+namespace {
+
+int print_usage() {
+    std::cerr << "Usage: Gomoku-positions <database file> <records file>... [--max-plies <plies>]" << std::endl;
+    return 1;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        return print_usage();
+    }
+    const std::string database_path = argv[1];
+    std::vector<std::string> record_paths;
+    unsigned int max_plies = 0;
+
+    try {
+        for (int i = 2; i < argc; ++i) {
+            const std::string argument = argv[i];
+            if (argument == "--max-plies") {
+                if (i + 1 >= argc) {
+                    return print_usage();
+                }
+                max_plies = std::stoul(argv[++i]);
+            } else {
+                record_paths.push_back(argument);
+            }
+        }
+        if (record_paths.empty()) {
+            return print_usage();
+        }
+
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        position_database_builder builder(max_plies);
+        unsigned int num_games = 0;
+        for (const std::string& record_path : record_paths) {
+            std::ifstream records(record_path);
+            if (!records) {
+                std::cerr << "Could not open " << record_path << std::endl;
+                return 1;
+            }
+            num_games += builder.import_records(records);
+        }
+        builder.write(database_path);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << num_games << " games, " << builder.get_num_positions() << " positions, written to "
+                  << database_path << " in " << seconds << " s" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/game_annotator/game_annotator.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class game_annotator_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    static constexpr unsigned int missed_win_move = 8;
+    static constexpr unsigned int blunder_move = 7;
+
+    // a playout limit instead of the time budget keeps the evaluations reproducible
+    annotator_settings settings = {{std::chrono::milliseconds(0), 500, 1, 1.2f, 3, 1u << 16, 1}, 2, 0.25f, 0.9f, 1u << 16};
+
+    // A freestyle game in which black builds a four in row 7 that white blocks on one end. White does not block the
+    // other end (a blunder) and black does not complete the five (a missed win), before white blocks it after all.
+    static game_record missed_win_game() {
+        game_record record;
+        record.ruleset = ruleset_type::freestyle;
+        record.moves = {search_move::stone(3, 7), search_move::stone(2, 7),
+                        search_move::stone(4, 7), search_move::stone(0, 0),
+                        search_move::stone(5, 7), search_move::stone(0, 2),
+                        search_move::stone(6, 7), search_move::stone(14, 14),
+                        search_move::stone(10, 10), search_move::stone(7, 7)};
+        return record;
+    }
+
+    // 'record' mirrored at the vertical axis
+    static game_record mirror(game_record record) {
+        for (search_move& move : record.moves) {
+            move.x = record.board_size - 1 - move.x;
+        }
+        return record;
+    }
+};
+
+
+// Moves that lose the game or give away a won position are marked
+TEST_F(game_annotator_test, annotate_mistakes) {
+    game_annotator annotator(settings);
+    const std::vector<annotated_game> games = annotator.annotate({missed_win_game()});
+    ASSERT_EQ(games.size(), 1);
+    const std::vector<move_annotation>& annotations = games[0].annotations;
+    ASSERT_EQ(annotations.size(), missed_win_game().moves.size());
+
+    EXPECT_EQ(annotations[blunder_move].type, annotation_type::blunder);
+    EXPECT_EQ(annotations[blunder_move].best_move, search_move::stone(7, 7));
+    EXPECT_EQ(annotations[missed_win_move].type, annotation_type::missed_win);
+    EXPECT_EQ(annotations[missed_win_move].best_move, search_move::stone(7, 7));
+    EXPECT_GE(annotations[missed_win_move].win_rate, 0.9f);
+    // the forced block at the end is the best move
+    EXPECT_EQ(annotations.back().type, annotation_type::normal_move);
+    EXPECT_EQ(annotations.back().loss, 0.0f);
+    EXPECT_EQ(annotator.get_statistics().nof_blunders,
+              std::count_if(annotations.begin(), annotations.end(), [](const move_annotation& annotation) {
+                  return annotation.type == annotation_type::blunder;
+              }));
+    EXPECT_EQ(annotator.get_statistics().nof_missed_wins, 1);
+}
+
+// Positions are searched once, also when they appear in other games, batches or orientations
+TEST_F(game_annotator_test, deduplicate_positions) {
+    game_annotator annotator(settings);
+    const game_record record = missed_win_game();
+    const unsigned int num_positions = record.moves.size() + 1;
+    const std::vector<annotated_game> games = annotator.annotate({record, record, mirror(record)});
+    EXPECT_EQ(annotator.get_statistics().nof_positions, 3 * num_positions);
+    EXPECT_EQ(annotator.get_statistics().nof_searched, num_positions);
+    EXPECT_EQ(annotator.get_statistics().nof_reused, 2 * num_positions);
+
+    // the best moves of the mirrored game lead to the mirrored positions. Positions that are symmetric themselves may
+    // get another move of the same orbit.
+    search_position position(record.ruleset, record.board_size);
+    search_position mirrored(record.ruleset, record.board_size);
+    for (unsigned int i = 0; i < record.moves.size(); ++i) {
+        ASSERT_TRUE(position.apply_move(games[0].annotations[i].best_move));
+        ASSERT_TRUE(mirrored.apply_move(games[2].annotations[i].best_move));
+        EXPECT_EQ(position_hash::get_canonical_hash(position).hash, position_hash::get_canonical_hash(mirrored).hash);
+        EXPECT_EQ(games[2].annotations[i].type, games[0].annotations[i].type);
+        position.undo_move();
+        mirrored.undo_move();
+        position.apply_move(games[0].record.moves[i]);
+        mirrored.apply_move(games[2].record.moves[i]);
+    }
+
+    annotator.annotate({record});
+    EXPECT_EQ(annotator.get_statistics().nof_searched, num_positions);
+}
+
+// Positions that do not fit into the evaluation table anymore are still annotated
+TEST_F(game_annotator_test, full_table) {
+    settings.max_table_entries = 2;
+    game_annotator annotator(settings);
+    const game_record record = missed_win_game();
+    const std::vector<annotated_game> games = annotator.annotate({record, mirror(record)});
+    ASSERT_EQ(games.size(), 2);
+    for (const annotated_game& game : games) {
+        ASSERT_EQ(game.annotations.size(), record.moves.size());
+        EXPECT_EQ(game.annotations[missed_win_move].type, annotation_type::missed_win);
+    }
+    EXPECT_EQ(annotator.get_statistics().nof_searched + annotator.get_statistics().nof_reused,
+              2 * (record.moves.size() + 1));
+}
+
+// Annotated records are written in the order of the input and can still be read as game records
+TEST_F(game_annotator_test, annotate_records) {
+    const game_record record = missed_win_game();
+    std::stringstream records;
+    record.write(records);
+    mirror(record).write(records);
+    records << '\n';
+    record.write(records);
+
+    game_annotator annotator(settings);
+    std::stringstream output;
+    unsigned int num_batches = 0;
+    annotator.annotate_records(records, output, 2, [&num_batches](const game_annotator::statistics&) {
+        num_batches++;
+    });
+    EXPECT_EQ(num_batches, 2);
+    EXPECT_EQ(annotator.get_statistics().nof_games, 3);
+
+    game_record annotated;
+    for (const game_record& expected : {record, mirror(record), record}) {
+        ASSERT_TRUE(game_record::read(output, annotated));
+        EXPECT_EQ(annotated.moves, expected.moves);
+    }
+    EXPECT_FALSE(game_record::read(output, annotated));
+}
+
+// Records with illegal moves are rejected
+TEST_F(game_annotator_test, illegal_move) {
+    game_record record = missed_win_game();
+    record.moves.push_back(search_move::stone(7, 7));
+    game_annotator annotator(settings);
+    EXPECT_THROW(annotator.annotate({record}), gomoku_exception);
+}
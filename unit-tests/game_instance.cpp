@@ -0,0 +1,38 @@
+#include "gtest/gtest.h"
+#include "../src/server/game_instance.h"
+
+
+class game_instance_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    // without an address, so no state updates are sent
+    player host = player(uuid_generator::generate_uuid_v4(), "host", black);
+    game_instance game;
+    std::string err;
+
+    void SetUp() override {
+        ASSERT_TRUE(game.try_add_player(&host, err));
+    }
+};
+
+
+// An unknown ruleset is rejected before the board is resized
+TEST_F(game_instance_test, unknown_ruleset) {
+    EXPECT_FALSE(game.set_game_mode(&host, "gomoku", 19, err));
+    EXPECT_EQ(game.get_game_state()->get_board_size(), playing_board::_playing_board_size);
+    EXPECT_EQ(game.get_game_state()->get_opening_rules(), ruleset_type::uninitialized);
+}
+
+// The ruleset and the board size are changed together
+TEST_F(game_instance_test, set_game_mode) {
+    EXPECT_TRUE(game.set_game_mode(&host, "renju", 19, err)) << err;
+    EXPECT_EQ(game.get_game_state()->get_board_size(), 19);
+    EXPECT_EQ(game.get_game_state()->get_opening_rules(), ruleset_type::renju);
+
+    // an unsupported board size leaves the ruleset as it was
+    EXPECT_FALSE(game.set_game_mode(&host, "freestyle", 16, err));
+    EXPECT_EQ(game.get_game_state()->get_board_size(), 19);
+    EXPECT_EQ(game.get_game_state()->get_opening_rules(), ruleset_type::renju);
+}
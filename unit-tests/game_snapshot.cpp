@@ -0,0 +1,152 @@
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/server/game_snapshot.h"
+#include "../src/server/game_instance_manager.h"
+#include "../src/server/player_manager.h"
+#include "../src/common/serialization/json_utils.h"
+
+
+class game_snapshot_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::string path = (std::filesystem::temp_directory_path() / "gomoku-snapshot-test.json").string();
+    std::string err;
+    unsigned int nof_games = 0;
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + ".restored");
+    }
+
+    // writes a snapshot file that contains 'state' and the given bots
+    void write_snapshot(const game_state& state, rapidjson::Value bots = rapidjson::Value(rapidjson::kArrayType)) {
+        rapidjson::Document snapshot(rapidjson::kObjectType);
+        snapshot.AddMember("version", game_snapshot::version, snapshot.GetAllocator());
+        rapidjson::Value games(rapidjson::kArrayType);
+        rapidjson::Document* state_json = state.to_json();
+        games.PushBack(rapidjson::Value(*state_json, snapshot.GetAllocator()), snapshot.GetAllocator());
+        delete state_json;
+        snapshot.AddMember("games", games, snapshot.GetAllocator());
+        snapshot.AddMember("bots", rapidjson::Value(bots, snapshot.GetAllocator()), snapshot.GetAllocator());
+        std::ofstream(path) << json_utils::to_string(&snapshot);
+    }
+};
+
+
+// Without a snapshot file there is nothing to restore, which is not an error
+TEST_F(game_snapshot_test, load_missing_file) {
+    EXPECT_TRUE(game_snapshot::load(path, std::chrono::seconds(2), nof_games, err));
+    EXPECT_EQ(nof_games, 0);
+}
+
+// A restored game can be found again, together with its board and its players
+TEST_F(game_snapshot_test, restore_game) {
+    game_state state;
+    player* player1 = new player("player1", black);
+    player* player2 = new player("player2", white);
+    ASSERT_TRUE(state.add_player(player1, err));
+    ASSERT_TRUE(state.add_player(player2, err));
+    ASSERT_TRUE(state.place_stone(3, 4, field_type::black_stone, err));
+    write_snapshot(state);
+
+    ASSERT_TRUE(game_snapshot::load(path, std::chrono::seconds(2), nof_games, err)) << err;
+    EXPECT_EQ(nof_games, 1);
+    EXPECT_FALSE(std::filesystem::exists(path));
+    EXPECT_TRUE(std::filesystem::exists(path + ".restored"));
+
+    game_instance* restored_game;
+    ASSERT_TRUE(game_instance_manager::try_get_game_instance(state.get_id(), restored_game));
+    EXPECT_EQ(restored_game->get_game_state()->get_playing_board().at(4).at(3), field_type::black_stone);
+
+    player* restored_player;
+    ASSERT_TRUE(player_manager::try_get_player(player2->get_id(), restored_player));
+    EXPECT_EQ(restored_player->get_player_name(), "player2");
+    EXPECT_EQ(restored_player->get_game_id(), state.get_id());
+
+    // the same game is not restored twice
+    write_snapshot(state);
+    ASSERT_TRUE(game_snapshot::load(path, std::chrono::seconds(2), nof_games, err)) << err;
+    EXPECT_EQ(nof_games, 0);
+}
+
+// A restored bot plays its move again and is not found as a player that reconnects
+TEST_F(game_snapshot_test, restore_bot) {
+    game_state state;
+    player* human = new player("human", black);
+    player* bot = new player("Bot (easy)", white);
+    ASSERT_TRUE(state.add_player(human, err));
+    ASSERT_TRUE(state.add_player(bot, err));
+    ASSERT_TRUE(state.set_game_mode("freestyle", err)) << err;
+    ASSERT_TRUE(state.start_game(err)) << err;
+    ASSERT_TRUE(state.place_stone(7, 7, field_type::black_stone, err)) << err;
+    // it is the turn of the bot
+    ASSERT_TRUE(state.update_current_player(err)) << err;
+    state.iterate_turn();
+    ASSERT_EQ(state.get_current_player(), bot);
+
+    rapidjson::Document bots(rapidjson::kArrayType);
+    rapidjson::Value saved_bot(rapidjson::kObjectType);
+    saved_bot.AddMember("game_id", rapidjson::Value(state.get_id().c_str(), bots.GetAllocator()), bots.GetAllocator());
+    saved_bot.AddMember("player_id", rapidjson::Value(bot->get_id().c_str(), bots.GetAllocator()), bots.GetAllocator());
+    saved_bot.AddMember("difficulty", "easy", bots.GetAllocator());
+    bots.PushBack(saved_bot, bots.GetAllocator());
+    write_snapshot(state, rapidjson::Value(bots, bots.GetAllocator()));
+
+    ASSERT_TRUE(game_snapshot::load(path, std::chrono::seconds(2), nof_games, err)) << err;
+    EXPECT_EQ(nof_games, 1);
+    game_instance* restored_game;
+    ASSERT_TRUE(game_instance_manager::try_get_game_instance(state.get_id(), restored_game));
+    player* restored_player;
+    EXPECT_TRUE(player_manager::try_get_player(human->get_id(), restored_player));
+    EXPECT_FALSE(player_manager::try_get_player(bot->get_id(), restored_player));
+
+    for (int i = 0; i < 1000 && restored_game->get_game_state()->get_turn_number() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(restored_game->get_game_state()->get_turn_number(), 2);
+    EXPECT_EQ(restored_game->get_game_state()->get_current_player()->get_id(), human->get_id());
+
+    // the bot is saved again, after it was stopped
+    ASSERT_TRUE(game_snapshot::save(path, nof_games, err)) << err;
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    rapidjson::Document snapshot;
+    snapshot.Parse(content.c_str());
+    ASSERT_FALSE(snapshot.HasParseError());
+    bool is_saved = false;
+    for (const rapidjson::Value& saved : snapshot["bots"].GetArray()) {
+        is_saved |= saved["game_id"].GetString() == state.get_id() && saved["difficulty"].GetString() == std::string("easy");
+    }
+    EXPECT_TRUE(is_saved);
+}
+
+// Saving writes the games that are still running, so that they can be restored
+TEST_F(game_snapshot_test, save_running_games) {
+    player* new_player;
+    game_instance* joined_game = nullptr;
+    player_manager::add_or_get_player("snapshot_player", "snapshot_player_id", new_player);
+    ASSERT_TRUE(game_instance_manager::try_add_player_to_any_game(new_player, joined_game, err)) << err;
+
+    ASSERT_TRUE(game_snapshot::save(path, nof_games, err)) << err;
+    EXPECT_GE(nof_games, 1);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+
+    std::ifstream file(path);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    rapidjson::Document snapshot;
+    snapshot.Parse(content.c_str());
+    ASSERT_FALSE(snapshot.HasParseError());
+    EXPECT_EQ(snapshot["version"].GetUint(), game_snapshot::version);
+    EXPECT_EQ(snapshot["games"].Size(), nof_games);
+
+    bool is_saved = false;
+    for (const rapidjson::Value& saved_game : snapshot["games"].GetArray()) {
+        is_saved |= saved_game["id"].GetString() == joined_game->get_id();
+    }
+    EXPECT_TRUE(is_saved);
+}
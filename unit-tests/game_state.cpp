@@ -147,6 +147,9 @@ TEST_F(game_state_test, set_opening_rules){
     EXPECT_EQ(test_game_state.get_opening_rules(), swap_after_first_move);
     test_game_state.set_game_mode("swap2", err);
     EXPECT_EQ(test_game_state.get_opening_rules(), swap2);
+    // unknown rulesets are rejected without changing the rules
+    EXPECT_FALSE(test_game_state.set_game_mode("gomoku", err));
+    EXPECT_EQ(test_game_state.get_opening_rules(), swap2);
 }
 
 //// CHAPTER 3: swap decision functionality
@@ -713,6 +716,44 @@ TEST_F(game_state_test, check_win_condition_straight){
     EXPECT_TRUE(test_game_state.check_win_condition(11, 6, black_stone));
 }
 
+// lines ending at the edge of a larger board must be detected
+TEST_F(game_state_test, check_win_condition_larger_board){
+    EXPECT_TRUE(test_game_state.set_board_size(19, err));
+    EXPECT_EQ(test_game_state.get_board_size(), 19);
+    for (unsigned int x = 14; x < 19; ++x) {
+        EXPECT_TRUE(test_game_state.place_stone(x, 18, white_stone, err));
+    }
+    EXPECT_EQ(test_game_state.count_stones_one_direction(14, 18, 1, 0, white_stone), 4);
+    EXPECT_TRUE(test_game_state.check_win_condition(18, 18, white_stone));
+    EXPECT_FALSE(test_game_state.check_win_condition(18, 18, black_stone));
+}
+
+// under the renju ruleset, black must not be able to place forbidden stones and only wins with exactly five
+TEST_F(game_state_test, renju_restrictions){
+    test_game_state.add_player(player1, err);
+    test_game_state.add_player(player2, err);
+    test_game_state.set_game_mode("renju", err);
+    EXPECT_EQ(test_game_state.get_opening_rules(), renju);
+
+    EXPECT_TRUE(test_game_state.place_stone(7, 5, black_stone, err));
+    EXPECT_TRUE(test_game_state.place_stone(7, 6, black_stone, err));
+    EXPECT_TRUE(test_game_state.place_stone(5, 7, black_stone, err));
+    EXPECT_TRUE(test_game_state.place_stone(6, 7, black_stone, err));
+    // black is the current player, so the forbidden fields are reported
+    EXPECT_EQ(test_game_state.get_forbidden_fields().size(), 1);
+    EXPECT_FALSE(test_game_state.place_stone(7, 7, black_stone, err));   // double-three
+    EXPECT_TRUE(test_game_state.place_stone(7, 7, white_stone, err));    // white has no restrictions
+
+    for (unsigned int x = 0; x < 6; ++x) {
+        EXPECT_TRUE(test_game_state.place_stone(x, 0, white_stone, err));
+    }
+    EXPECT_TRUE(test_game_state.check_win_condition(5, 0, white_stone));  // overline wins for white
+    for (unsigned int x = 0; x < 5; ++x) {
+        EXPECT_TRUE(test_game_state.place_stone(x, 14, black_stone, err));
+    }
+    EXPECT_TRUE(test_game_state.check_win_condition(4, 14, black_stone));
+}
+
 // check for a tie
 TEST_F(game_state_test, check_tie){
     for(int i = 0; i<playing_board::_playing_board_size; ++i){
@@ -751,6 +792,129 @@ TEST_F(game_state_test, serialization_equality) {
     EXPECT_EQ(test_game_state.get_turn_number(), game_state_recv->get_turn_number());
 }
 
+// updating a deserialized game state in place must result in the same state as deserializing it again,
+// while keeping the player objects
+TEST_F(game_state_test, update_from_json) {
+    test_game_state.add_player(player1, err);
+    rapidjson::Document* json_before = test_game_state.to_json();
+    class game_state* game_state_recv = game_state::from_json(*json_before);
+    delete json_before;
+    player* first_player_recv = game_state_recv->get_players().at(0);
+
+    test_game_state.add_player(player2, err);
+    test_game_state.set_game_mode("swap2", err);
+    test_game_state.set_board_size(19, err);
+    test_game_state.start_game(err);
+    EXPECT_TRUE(test_game_state.place_stone(18, 18, field_type::black_stone, err));
+    EXPECT_TRUE(test_game_state.update_current_player(err));
+    test_game_state.iterate_turn();
+
+    rapidjson::Document* json_after = test_game_state.to_json();
+    game_state_recv->update_from_json(*json_after);
+    delete json_after;
+
+    EXPECT_EQ(test_game_state.get_playing_board(), game_state_recv->get_playing_board());
+    EXPECT_EQ(19, game_state_recv->get_board_size());
+    EXPECT_EQ(swap2, game_state_recv->get_opening_rules());
+    EXPECT_TRUE(game_state_recv->is_started());
+    EXPECT_EQ(test_game_state.get_turn_number(), game_state_recv->get_turn_number());
+    EXPECT_EQ(test_game_state.get_current_player_idx(), game_state_recv->get_current_player_idx());
+    ASSERT_EQ(2, game_state_recv->get_players().size());
+    EXPECT_EQ(first_player_recv, game_state_recv->get_players().at(0));
+    EXPECT_EQ(player2->get_id(), game_state_recv->get_players().at(1)->get_id());
+    EXPECT_EQ(player2->get_colour(), game_state_recv->get_players().at(1)->get_colour());
+
+    // a player who left is deleted
+    test_game_state.remove_player(player2, err);
+    json_after = test_game_state.to_json();
+    game_state_recv->update_from_json(*json_after);
+    delete json_after;
+    EXPECT_EQ(1, game_state_recv->get_players().size());
+
+    delete game_state_recv->get_players().at(0);
+    delete game_state_recv;
+}
+
+// an invalid message must leave the state unchanged instead of updating it halfway
+TEST_F(game_state_test, update_from_invalid_json) {
+    test_game_state.add_player(player1, err);
+    rapidjson::Document* json_before = test_game_state.to_json();
+    class game_state* game_state_recv = game_state::from_json(*json_before);
+    delete json_before;
+
+    test_game_state.add_player(player2, err);
+    test_game_state.set_game_mode("freestyle", err);
+    test_game_state.set_board_size(19, err);
+    test_game_state.start_game(err);
+    EXPECT_TRUE(test_game_state.place_stone(3, 3, field_type::black_stone, err));
+
+    // the last field of the board is broken
+    rapidjson::Document* json_after = test_game_state.to_json();
+    rapidjson::Value& fields = (*json_after)["playing_board"]["playing_board"];
+    fields[fields.Size() - 1]["value"].SetString("purple_stone");
+    EXPECT_THROW(game_state_recv->update_from_json(*json_after), gomoku_exception);
+    fields[fields.Size() - 1]["value"].SetString("empty");
+
+    // the stone counter does not match
+    (*json_after)["playing_board"]["num_stones"].SetUint(2);
+    EXPECT_THROW(game_state_recv->update_from_json(*json_after), gomoku_exception);
+    (*json_after)["playing_board"]["num_stones"].SetUint(1);
+
+    // the second player has an unknown colour
+    (*json_after)["players"][1]["colour"]["value"].SetString("green");
+    EXPECT_THROW(game_state_recv->update_from_json(*json_after), gomoku_exception);
+    delete json_after;
+
+    EXPECT_EQ(playing_board::_playing_board_size, game_state_recv->get_board_size());
+    EXPECT_EQ(field_type::empty, game_state_recv->get_playing_board().at(3).at(3));
+    EXPECT_FALSE(game_state_recv->is_started());
+    EXPECT_EQ(1, game_state_recv->get_players().size());
+
+    delete game_state_recv->get_players().at(0);
+    delete game_state_recv;
+}
+
+// copying a game state in place must result in an equal state, while keeping the board and player objects
+TEST_F(game_state_test, copy_from) {
+    test_game_state.add_player(player1, err);
+    rapidjson::Document* json_before = test_game_state.to_json();
+    class game_state* copy = game_state::from_json(*json_before);
+    delete json_before;
+    player* first_player_copy = copy->get_players().at(0);
+
+    test_game_state.add_player(player2, err);
+    test_game_state.set_game_mode("renju", err);
+    test_game_state.start_game(err);
+    EXPECT_TRUE(test_game_state.place_stone(7, 7, field_type::black_stone, err));
+    EXPECT_TRUE(test_game_state.update_current_player(err));
+    test_game_state.iterate_turn();
+
+    copy->copy_from(test_game_state);
+    EXPECT_EQ(test_game_state.get_id(), copy->get_id());
+    EXPECT_EQ(test_game_state.get_playing_board(), copy->get_playing_board());
+    EXPECT_EQ(renju, copy->get_opening_rules());
+    EXPECT_TRUE(copy->is_started());
+    EXPECT_EQ(test_game_state.get_turn_number(), copy->get_turn_number());
+    EXPECT_EQ(test_game_state.get_current_player_idx(), copy->get_current_player_idx());
+    ASSERT_EQ(2, copy->get_players().size());
+    EXPECT_EQ(first_player_copy, copy->get_players().at(0));
+    EXPECT_NE(player2, copy->get_players().at(1));
+    EXPECT_EQ(player2->get_id(), copy->get_players().at(1)->get_id());
+    EXPECT_EQ(player2->get_player_name(), copy->get_players().at(1)->get_player_name());
+
+    // the copy does not change with the original
+    EXPECT_TRUE(test_game_state.place_stone(8, 8, field_type::white_stone, err));
+    EXPECT_EQ(field_type::empty, copy->get_playing_board().at(8).at(8));
+
+    // a player who left is deleted
+    test_game_state.remove_player(player2, err);
+    copy->copy_from(test_game_state);
+    EXPECT_EQ(1, copy->get_players().size());
+
+    delete copy->get_players().at(0);
+    delete copy;
+}
+
 // Deserializing an invalid string must throw a gomoku_exception
 TEST_F(game_state_test, serialization_exception) {
     rapidjson::Document json = rapidjson::Document(rapidjson::kObjectType);
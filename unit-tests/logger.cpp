@@ -0,0 +1,121 @@
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/common/logging/logger.h"
+
+
+class logger_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::FILE* output = nullptr;
+
+    void SetUp() override {
+        output = std::tmpfile();
+        ASSERT_NE(output, nullptr);
+        logger::flush();
+        logger::set_output(output);
+    }
+
+    void TearDown() override {
+        logger::flush();
+        logger::set_output(nullptr);
+        logger::set_level(log_level::info_level);
+        logger::set_sample_rate(log_level::debug_level, 1);
+        std::fclose(output);
+    }
+
+    // returns all lines written so far, without the time stamp at the start of each line
+    std::vector<std::string> read_lines() {
+        logger::flush();
+        std::vector<std::string> lines;
+        std::rewind(output);
+        std::string line;
+        int c;
+        while ((c = std::fgetc(output)) != EOF) {
+            if (c == '\n') {
+                lines.push_back(line.substr(line.find(' ') + 1));
+                line.clear();
+            } else {
+                line += char(c);
+            }
+        }
+        return lines;
+    }
+};
+
+
+// Records below the level are suppressed without evaluating their fields
+TEST_F(logger_test, level) {
+    logger::set_level(log_level::info_level);
+    bool field_was_evaluated = false;
+    auto evaluate = [&field_was_evaluated]() {
+        field_was_evaluated = true;
+        return std::string("value");
+    };
+    GOMOKU_LOG(log_level::debug_level, "suppressed", {"key", evaluate()});
+    GOMOKU_LOG(log_level::warning_level, "written", {"key", "value"});
+
+    std::vector<std::string> lines = read_lines();
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_EQ(lines[0], "level=warning event=written key=value");
+    EXPECT_FALSE(field_was_evaluated);
+
+    logger::set_level(log_level::off_level);
+    GOMOKU_LOG(log_level::error_level, "suppressed");
+    EXPECT_EQ(read_lines().size(), 1);
+}
+
+// Values that would break the key=value format are quoted and escaped
+TEST_F(logger_test, quote_values) {
+    GOMOKU_LOG(log_level::info_level, "message", {"json", "{\"x\": 1}"}, {"text", "a\nb"}, {"empty", ""});
+
+    std::vector<std::string> lines = read_lines();
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_EQ(lines[0], "level=info event=message json=\"{\\\"x\\\": 1}\" text=\"a\\nb\" empty=\"\"");
+}
+
+// Only every n-th record of a sampled level is written
+TEST_F(logger_test, sample_rate) {
+    logger::set_level(log_level::debug_level);
+    logger::set_sample_rate(log_level::debug_level, 10);
+    for (int i = 0; i < 100; ++i) {
+        GOMOKU_LOG(log_level::debug_level, "sampled");
+    }
+    GOMOKU_LOG(log_level::info_level, "not_sampled");
+
+    std::vector<std::string> lines = read_lines();
+    ASSERT_EQ(lines.size(), 11);
+    EXPECT_EQ(lines.back(), "level=info event=not_sampled");
+}
+
+// Records of concurrent threads are all written, each on its own line
+TEST_F(logger_test, concurrent_writers) {
+    const int nof_threads = 4;
+    const int nof_records = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nof_threads; ++t) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < nof_records; ++i) {
+                GOMOKU_LOG(log_level::info_level, "record", {"thread", std::to_string(t)}, {"i", std::to_string(i)});
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<std::string> lines = read_lines();
+    ASSERT_EQ(lines.size() + logger::get_nof_dropped_records(), nof_threads * nof_records);
+    std::vector<int> next_record(nof_threads, 0);
+    for (const std::string& line : lines) {
+        int t = 0;
+        int i = 0;
+        ASSERT_EQ(std::sscanf(line.c_str(), "level=info event=record thread=%d i=%d", &t, &i), 2) << line;
+        // records of the same thread keep their order
+        EXPECT_GE(i, next_record[t]);
+        next_record[t] = i + 1;
+    }
+}
@@ -0,0 +1,190 @@
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/mcts_engine/mcts_engine.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class mcts_engine_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::unique_ptr<game_state> test_game_state = std::make_unique<game_state>();
+    std::unique_ptr<player> player1 = std::make_unique<player>("player1", black);
+    std::unique_ptr<player> player2 = std::make_unique<player>("player2", white);
+
+    std::string err;
+
+    // a fixed number of playouts keeps the tests independent of the speed of the machine
+    mcts_settings settings = {std::chrono::milliseconds(0), 3000, 2, 1.5f, 3, 1u << 18, 42};
+
+    search_position start_game(const std::string& ruleset, const std::vector<search_move>& moves) {
+        EXPECT_TRUE(test_game_state->add_player(player1.get(), err));
+        EXPECT_TRUE(test_game_state->add_player(player2.get(), err));
+        EXPECT_TRUE(test_game_state->set_game_mode(ruleset, err));
+        EXPECT_TRUE(test_game_state->start_game(err));
+        search_position position(*test_game_state);
+        for (const search_move& move : moves) {
+            EXPECT_TRUE(position.apply_move(move));
+        }
+        return position;
+    }
+};
+
+
+// A five is completed as soon as it is possible
+TEST_F(mcts_engine_test, complete_five) {
+    search_position position = start_game("freestyle", {
+            search_move::stone(3, 7), search_move::stone(0, 0),
+            search_move::stone(4, 7), search_move::stone(14, 14),
+            search_move::stone(5, 7), search_move::stone(0, 14),
+            search_move::stone(6, 7), search_move::stone(14, 0)});
+
+    mcts_result result = mcts_engine(settings).search(position);
+    EXPECT_TRUE(result.best_move == search_move::stone(2, 7) || result.best_move == search_move::stone(7, 7));
+    EXPECT_GT(result.win_rate, 0.99f);
+}
+
+// A four of the opponent must be blocked, even if the game is lost anyway
+TEST_F(mcts_engine_test, block_four) {
+    search_position position = start_game("freestyle", {
+            search_move::stone(0, 0), search_move::stone(3, 7),
+            search_move::stone(14, 14), search_move::stone(4, 7),
+            search_move::stone(0, 14), search_move::stone(5, 7),
+            search_move::stone(14, 0), search_move::stone(6, 7)});
+
+    mcts_result result = mcts_engine(settings).search(position);
+    EXPECT_TRUE(result.best_move == search_move::stone(2, 7) || result.best_move == search_move::stone(7, 7));
+    EXPECT_LT(result.win_rate, 0.01f);
+}
+
+// An open three is blocked before it becomes an open four
+TEST_F(mcts_engine_test, block_open_three) {
+    search_position position = start_game("freestyle", {
+            search_move::stone(0, 0), search_move::stone(6, 7),
+            search_move::stone(14, 14), search_move::stone(7, 7),
+            search_move::stone(0, 14), search_move::stone(8, 7)});
+
+    settings.max_playouts = 8000;
+    mcts_result result = mcts_engine(settings).search(position);
+    ASSERT_EQ(result.best_move.type, search_move_type::stone_move);
+    EXPECT_EQ(result.best_move.y, 7);
+    EXPECT_TRUE(result.best_move.x == 4 || result.best_move.x == 5 || result.best_move.x == 9 || result.best_move.x == 10);
+}
+
+// The players decide on the swap in the opening rules that have one
+TEST_F(mcts_engine_test, swap_decision) {
+    search_position position = start_game("swap_after_first_move", {search_move::stone(7, 7)});
+    ASSERT_TRUE(position.get_swap_next_turn());
+
+    mcts_result result = mcts_engine(settings).search(position);
+    EXPECT_EQ(result.best_move.type, search_move_type::swap_move);
+    EXPECT_TRUE(position.is_legal(result.best_move));
+}
+
+// All threads count their playouts, and the search stops at the limit
+TEST_F(mcts_engine_test, playout_limit_with_threads) {
+    search_position position = start_game("renju", {search_move::stone(7, 7), search_move::stone(8, 8)});
+
+    settings.num_threads = 4;
+    settings.max_playouts = 2000;
+    mcts_result result = mcts_engine(settings).search(position);
+    EXPECT_GE(result.num_playouts, 2000);
+    EXPECT_LT(result.num_playouts, 2000 + settings.num_threads);
+    EXPECT_GT(result.num_nodes, 1);
+    EXPECT_TRUE(position.is_legal(result.best_move));
+}
+
+// Once the node pool is used up, the search continues with playouts from the leaves
+TEST_F(mcts_engine_test, small_node_pool) {
+    search_position position = start_game("freestyle", {search_move::stone(7, 7)});
+
+    settings.max_nodes = 100;
+    mcts_result result = mcts_engine(settings).search(position);
+    EXPECT_LE(result.num_nodes, 100);
+    EXPECT_GE(result.num_playouts, settings.max_playouts);
+    EXPECT_TRUE(position.is_legal(result.best_move));
+}
+
+// A playout takes all of its moves back
+TEST_F(mcts_engine_test, playout_restores_position) {
+    search_position position = start_game("swap2", {search_move::stone(7, 7), search_move::stone(8, 7)});
+    pattern_board board(position.get_board_size());
+    board.place_stone(7, 7, field_type::black_stone);
+    board.place_stone(8, 7, field_type::white_stone);
+    const int evaluation = board.evaluate(field_type::black_stone);
+
+    std::mt19937 rng(7);
+    for (int i = 0; i < 20; ++i) {
+        int winner = mcts_engine::playout(position, board, rng);
+        EXPECT_TRUE(winner == mcts_engine::no_winner || winner == 0 || winner == 1);
+        EXPECT_EQ(position.get_num_moves(), 2);
+        EXPECT_EQ(position.get_num_stones(), 2);
+        EXPECT_EQ(board.get_num_stones(), 2);
+        EXPECT_EQ(board.evaluate(field_type::black_stone), evaluation);
+    }
+}
+
+// There is nothing to search in a finished game
+TEST_F(mcts_engine_test, finished_game) {
+    search_position position = start_game("freestyle", {
+            search_move::stone(3, 7), search_move::stone(0, 0),
+            search_move::stone(4, 7), search_move::stone(14, 14),
+            search_move::stone(5, 7), search_move::stone(0, 14),
+            search_move::stone(6, 7), search_move::stone(14, 0),
+            search_move::stone(7, 7)});
+    ASSERT_TRUE(position.is_finished());
+    EXPECT_THROW(mcts_engine(settings).search(position), gomoku_exception);
+}
+
+// The next search continues with the subtree of the move that was played
+TEST_F(mcts_engine_test, reuse_subtree) {
+    search_position position = start_game("freestyle", {search_move::stone(7, 7), search_move::stone(8, 8)});
+
+    mcts_engine engine(settings);
+    mcts_result first = engine.search(position);
+    EXPECT_EQ(first.num_reused_playouts, 0);
+    ASSERT_TRUE(position.apply_move(first.best_move));
+    mcts_result second = engine.search(position);
+    EXPECT_GT(second.num_reused_playouts, 0);
+    EXPECT_TRUE(position.is_legal(second.best_move));
+
+    // a position that is not in the tree starts a new one
+    search_position other(ruleset_type::freestyle, 15);
+    ASSERT_TRUE(other.apply_move(search_move::stone(0, 0)));
+    EXPECT_EQ(engine.search(other).num_reused_playouts, 0);
+}
+
+// Pondering grows the tree of the opponent's moves, so the search after the opponent's reply starts with playouts
+TEST_F(mcts_engine_test, ponder) {
+    // no symmetric moves are removed at the root, so the reply is in the tree
+    search_position position = start_game("freestyle", {search_move::stone(7, 7), search_move::stone(9, 8)});
+    const search_move reply = mcts_engine(settings).search(position).best_move;
+
+    mcts_engine engine(settings);
+    std::atomic<bool> is_cancelled(false);
+    engine.ponder(position, is_cancelled);
+    ASSERT_TRUE(position.apply_move(reply));
+    mcts_result result = engine.search(position);
+    EXPECT_GT(result.num_reused_playouts, 0);
+    EXPECT_TRUE(position.is_legal(result.best_move));
+}
+
+// Pondering stops once it is cancelled
+TEST_F(mcts_engine_test, cancel_ponder) {
+    search_position position = start_game("renju", {search_move::stone(7, 7)});
+
+    settings.max_playouts = 0;
+    mcts_engine engine(settings);
+    std::atomic<bool> is_cancelled(false);
+    std::thread canceller([&is_cancelled] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        is_cancelled.store(true);
+    });
+    engine.ponder(position, is_cancelled);
+    canceller.join();
+    EXPECT_TRUE(is_cancelled.load());
+}
@@ -0,0 +1,144 @@
+#include <random>
+#include <set>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/move_generator/move_generator.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class move_generator_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    move_generator generator = move_generator(15);
+    move_generator::move_list moves;
+
+    std::set<unsigned int> generated_fields(unsigned int distance) {
+        generator.generate(distance, moves);
+        std::set<unsigned int> fields;
+        for (unsigned int i = 0; i < moves.size; ++i) {
+            fields.insert(moves.moves[i].field);
+        }
+        EXPECT_EQ(fields.size(), moves.size);
+        return fields;
+    }
+
+    // the empty fields within 'distance' of a stone, found by looking at every field
+    static std::set<unsigned int> scan_fields(const std::vector<bool>& stones, unsigned int board_size,
+                                              unsigned int distance) {
+        std::set<unsigned int> fields;
+        for (unsigned int field = 0; field < board_size * board_size; ++field) {
+            if (stones[field]) {
+                continue;
+            }
+            const int x = int(field % board_size);
+            const int y = int(field / board_size);
+            for (unsigned int stone = 0; stone < board_size * board_size; ++stone) {
+                if (stones[stone] && std::abs(int(stone % board_size) - x) <= int(distance)
+                    && std::abs(int(stone / board_size) - y) <= int(distance)) {
+                    fields.insert(field);
+                    break;
+                }
+            }
+        }
+        return fields;
+    }
+};
+
+
+// Only the centre is generated on an empty board
+TEST_F(move_generator_test, empty_board) {
+    EXPECT_EQ(generated_fields(2), std::set<unsigned int>({7 * 15 + 7}));
+}
+
+// The fields around a single stone, clipped at the edges
+TEST_F(move_generator_test, single_stone) {
+    generator.place_stone(7, 7);
+    EXPECT_EQ(generated_fields(1).size(), 8);
+    EXPECT_EQ(generated_fields(2).size(), 24);
+    EXPECT_TRUE(generator.is_near_stone(9, 5, 2));
+    EXPECT_FALSE(generator.is_near_stone(9, 5, 1));
+
+    generator.undo_stone(7, 7);
+    generator.place_stone(14, 0);
+    EXPECT_EQ(generated_fields(1), std::set<unsigned int>({13, 15 + 13, 15 + 14}));
+    EXPECT_EQ(generated_fields(2).size(), 8);
+}
+
+// Placing and undoing stones in any order gives the same fields as scanning the board
+TEST_F(move_generator_test, incremental_updates) {
+    std::mt19937 rng(7);
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        generator = move_generator(board_size);
+        std::vector<bool> stones(board_size * board_size, false);
+        std::vector<unsigned int> placed;
+        for (unsigned int step = 0; step < 400; ++step) {
+            // mostly places stones, so that the board fills up
+            if (!placed.empty() && rng() % 3 == 0) {
+                const unsigned int index = rng() % placed.size();
+                const unsigned int field = placed[index];
+                placed.erase(placed.begin() + index);
+                stones[field] = false;
+                generator.undo_stone(field % board_size, field / board_size);
+            } else {
+                const unsigned int field = rng() % (board_size * board_size);
+                if (stones[field]) {
+                    continue;
+                }
+                placed.push_back(field);
+                stones[field] = true;
+                generator.place_stone(field % board_size, field / board_size);
+            }
+            ASSERT_EQ(generator.get_num_stones(), placed.size());
+            if (!placed.empty()) {
+                ASSERT_EQ(generated_fields(1), scan_fields(stones, board_size, 1));
+                ASSERT_EQ(generated_fields(2), scan_fields(stones, board_size, 2));
+            }
+        }
+    }
+}
+
+// The stones of a position are taken over
+TEST_F(move_generator_test, from_position) {
+    search_position position(ruleset_type::freestyle, 19);
+    ASSERT_TRUE(position.apply_move(search_move::stone(0, 18)));
+    ASSERT_TRUE(position.apply_move(search_move::stone(18, 18)));
+    generator = move_generator(position);
+    EXPECT_EQ(generator.get_num_stones(), 2);
+    EXPECT_TRUE(generator.is_occupied(18, 18));
+    EXPECT_EQ(generated_fields(1).size(), 6);
+}
+
+// Winning fields come first, then blocks of the opponent's five, then the other threats
+TEST_F(move_generator_test, ordered_by_threats) {
+    pattern_board board(15);
+    for (unsigned int x = 3; x < 7; ++x) {
+        board.place_stone(x, 7, field_type::black_stone);
+        generator.place_stone(x, 7);
+    }
+    board.place_stone(2, 7, field_type::white_stone);
+    generator.place_stone(2, 7);
+    for (unsigned int y = 9; y < 13; ++y) {
+        board.place_stone(10, y, field_type::white_stone);
+        generator.place_stone(10, y);
+    }
+
+    generator.generate(2, board, field_type::black_stone, moves);
+    ASSERT_GE(moves.size, 3);
+    EXPECT_EQ(moves.moves[0].field, 7 * 15 + 7);
+    // both ends of the open four of white
+    EXPECT_EQ(std::set<unsigned int>({moves.moves[1].field, moves.moves[2].field}),
+              std::set<unsigned int>({8 * 15 + 10, 13 * 15 + 10}));
+    for (unsigned int i = 1; i < moves.size; ++i) {
+        EXPECT_GE(moves.moves[i - 1].score, moves.moves[i].score);
+    }
+
+    generator.generate(2, board, field_type::white_stone, moves);
+    EXPECT_TRUE(moves.moves[0].field == 8 * 15 + 10 || moves.moves[0].field == 13 * 15 + 10);
+}
+
+// Boards with rows wider than the bitmasks are rejected
+TEST_F(move_generator_test, unsupported_board_size) {
+    EXPECT_THROW(move_generator(move_generator::max_board_size + 1), gomoku_exception);
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/evaluation/nnue_evaluator.h"
+#include "../src/common/game_state/line_patterns/pattern_board.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class nnue_evaluator_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::shared_ptr<nnue_network> network = nnue_network::create_random(15, 42);
+    std::string path = (std::filesystem::temp_directory_path() / "gomoku-nnue-test.bin").string();
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    // the forward pass written out without incremental updates and without SIMD
+    int evaluate_reference(const std::vector<field_type>& fields, field_type colour) const {
+        std::vector<int> input(2 * nnue_network::accumulator_size);
+        for (unsigned int perspective = 0; perspective < 2; ++perspective) {
+            field_type perspective_colour = perspective == 0 ? colour
+                    : (colour == field_type::black_stone ? field_type::white_stone : field_type::black_stone);
+            for (unsigned int i = 0; i < nnue_network::accumulator_size; ++i) {
+                int value = network->feature_biases[i];
+                for (unsigned int field = 0; field < fields.size(); ++field) {
+                    if (fields[field] != field_type::empty) {
+                        unsigned int feature = network->get_feature(field, fields[field] == perspective_colour);
+                        value += network->feature_weights[feature * nnue_network::accumulator_size + i];
+                    }
+                }
+                input[perspective * nnue_network::accumulator_size + i] = std::clamp(value, 0, 127);
+            }
+        }
+        int output = network->output_bias;
+        for (unsigned int neuron = 0; neuron < nnue_network::hidden_size; ++neuron) {
+            int sum = network->hidden_biases[neuron];
+            for (unsigned int i = 0; i < input.size(); ++i) {
+                sum += input[i] * network->hidden_weights[neuron * input.size() + i];
+            }
+            output += std::clamp(sum >> nnue_network::hidden_weight_shift, 0, 127) * network->output_weights[neuron];
+        }
+        return output / nnue_network::output_divisor;
+    }
+};
+
+
+// The incremental updates and the SIMD layers give the same evaluation as the plain forward pass
+TEST_F(nnue_evaluator_test, same_as_reference) {
+    nnue_evaluator evaluator(network);
+    std::vector<field_type> fields(15 * 15, field_type::empty);
+    std::mt19937 rng(7);
+    for (unsigned int move = 0; move < 60; ++move) {
+        unsigned int field = rng() % fields.size();
+        field_type colour = move % 2 == 0 ? field_type::black_stone : field_type::white_stone;
+        if (evaluator.place_stone(field % 15, field / 15, colour)) {
+            fields[field] = colour;
+        }
+        if (move % 10 == 0) {
+            EXPECT_EQ(evaluator.evaluate(field_type::black_stone), evaluate_reference(fields, field_type::black_stone));
+            EXPECT_EQ(evaluator.evaluate(field_type::white_stone), evaluate_reference(fields, field_type::white_stone));
+        }
+    }
+}
+
+// Undoing the stones in reverse order restores the accumulators exactly
+TEST_F(nnue_evaluator_test, undo_restores_accumulators) {
+    nnue_evaluator evaluator(network);
+    const nnue_evaluator::accumulator empty_black = evaluator.get_accumulator(field_type::black_stone);
+    const int empty_evaluation = evaluator.evaluate(field_type::white_stone);
+
+    std::vector<std::pair<unsigned int, unsigned int>> moves = {{7, 7}, {8, 8}, {0, 14}, {14, 0}, {3, 9}};
+    for (unsigned int i = 0; i < moves.size(); ++i) {
+        ASSERT_TRUE(evaluator.place_stone(moves[i].first, moves[i].second, i % 2 == 0 ? field_type::black_stone : field_type::white_stone));
+    }
+    EXPECT_FALSE(evaluator.place_stone(7, 7, field_type::white_stone));
+    EXPECT_EQ(evaluator.get_num_stones(), 5);
+
+    nnue_evaluator::accumulator incremental = evaluator.get_accumulator(field_type::white_stone);
+    evaluator.refresh();
+    EXPECT_EQ(evaluator.get_accumulator(field_type::white_stone), incremental);
+
+    for (auto move = moves.rbegin(); move != moves.rend(); ++move) {
+        ASSERT_TRUE(evaluator.undo_stone(move->first, move->second));
+    }
+    EXPECT_FALSE(evaluator.undo_stone(7, 7));
+    EXPECT_EQ(evaluator.get_accumulator(field_type::black_stone), empty_black);
+    EXPECT_EQ(evaluator.evaluate(field_type::white_stone), empty_evaluation);
+}
+
+// The pattern_board and the nnue_evaluator can be used through the same interface
+TEST_F(nnue_evaluator_test, position_evaluator_interface) {
+    std::vector<std::unique_ptr<position_evaluator>> evaluators;
+    evaluators.push_back(std::make_unique<pattern_board>(15));
+    evaluators.push_back(std::make_unique<nnue_evaluator>(network));
+    for (std::unique_ptr<position_evaluator>& evaluator : evaluators) {
+        EXPECT_EQ(evaluator->get_board_size(), 15);
+        EXPECT_TRUE(evaluator->place_stone(7, 7, field_type::black_stone));
+        int evaluation = evaluator->evaluate(field_type::black_stone);
+        EXPECT_TRUE(evaluator->undo_stone(7, 7));
+        EXPECT_TRUE(evaluator->place_stone(7, 7, field_type::black_stone));
+        EXPECT_EQ(evaluator->evaluate(field_type::black_stone), evaluation);
+    }
+}
+
+// A saved network is loaded with the same weights
+TEST_F(nnue_evaluator_test, save_and_load) {
+    network->save(path);
+    std::shared_ptr<const nnue_network> loaded = nnue_network::load(path);
+    EXPECT_EQ(loaded->board_size, 15);
+    EXPECT_EQ(loaded->feature_weights, network->feature_weights);
+    EXPECT_EQ(loaded->hidden_weights, network->hidden_weights);
+    EXPECT_EQ(loaded->output_bias, network->output_bias);
+
+    nnue_evaluator evaluator(network);
+    nnue_evaluator loaded_evaluator(loaded);
+    evaluator.place_stone(4, 5, field_type::white_stone);
+    loaded_evaluator.place_stone(4, 5, field_type::white_stone);
+    EXPECT_EQ(loaded_evaluator.evaluate(field_type::black_stone), evaluator.evaluate(field_type::black_stone));
+}
+
+// Files of another version or that are cut off are rejected
+TEST_F(nnue_evaluator_test, reject_invalid_files) {
+    EXPECT_THROW(nnue_network::load(path), gomoku_exception);
+
+    network->save(path);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_THROW(nnue_network::load(path), gomoku_exception);
+
+    network->save(path);
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(4);
+        std::uint32_t version = nnue_network::file_version + 1;
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    }
+    EXPECT_THROW(nnue_network::load(path), gomoku_exception);
+}
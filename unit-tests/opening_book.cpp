@@ -0,0 +1,148 @@
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/opening_book/opening_book_builder.h"
+#include "../src/common/game_state/position_hash/position_hash.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class opening_book_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::string path = (std::filesystem::temp_directory_path() / "gomoku-book-test.bin").string();
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    // Plays 'opening' and finishes the game: every player fills its own edge row, swaps are declined
+    static game_record play_game(ruleset_type ruleset, const std::vector<search_move>& opening) {
+        search_position position(ruleset, 15);
+        for (const search_move& move : opening) {
+            EXPECT_TRUE(position.apply_move(move));
+        }
+        while (!position.is_finished()) {
+            if (position.get_swap_next_turn()) {
+                EXPECT_TRUE(position.apply_move(search_move::swap(swap_decision_type::do_not_swap)));
+                continue;
+            }
+            unsigned int y = position.get_current_player_idx() == 0 ? 0 : 14;
+            unsigned int x = 0;
+            while (position.get_field(x, y) != field_type::empty) {
+                x++;
+            }
+            EXPECT_TRUE(position.apply_move(search_move::stone(x, y)));
+        }
+        return game_record::from_position(position);
+    }
+};
+
+
+// A game record is written as a single line and read back with the same moves
+TEST_F(opening_book_test, record_round_trip) {
+    game_record record = play_game(ruleset_type::swap2, {search_move::stone(7, 7), search_move::stone(8, 8),
+                                                         search_move::stone(6, 8), search_move::swap(swap_decision_type::do_swap)});
+    std::string line = record.to_json_line();
+    EXPECT_EQ(line.find('\n'), std::string::npos);
+
+    std::stringstream stream;
+    record.write(stream);
+    stream << "\n";
+    record.write(stream);
+    game_record read_record;
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_TRUE(game_record::read(stream, read_record));
+        EXPECT_EQ(read_record.ruleset, ruleset_type::swap2);
+        EXPECT_EQ(read_record.board_size, 15);
+        EXPECT_EQ(read_record.moves, record.moves);
+    }
+    EXPECT_FALSE(game_record::read(stream, read_record));
+    EXPECT_TRUE(read_record.replay().is_finished());
+}
+
+// Records with unknown rulesets, invalid moves or illegal moves are rejected
+TEST_F(opening_book_test, invalid_records) {
+    EXPECT_THROW(game_record::from_json_line("{\"ruleset\":\"chess\",\"board_size\":15,\"moves\":[]}"), gomoku_exception);
+    EXPECT_THROW(game_record::from_json_line("{\"ruleset\":\"swap2\",\"board_size\":16,\"moves\":[]}"), gomoku_exception);
+    EXPECT_THROW(game_record::from_json_line("{\"ruleset\":\"swap2\",\"board_size\":15,\"moves\":[[15,0]]}"), gomoku_exception);
+    EXPECT_THROW(game_record::from_json_line("{\"ruleset\":\"swap2\",\"board_size\":15,\"moves\":[\"fly\"]}"), gomoku_exception);
+    EXPECT_THROW(game_record::from_json_line("not json"), gomoku_exception);
+    game_record record = game_record::from_json_line("{\"ruleset\":\"freestyle\",\"board_size\":15,\"moves\":[[7,7],[7,7]]}");
+    EXPECT_THROW(record.replay(), gomoku_exception);
+}
+
+// A book built from records finds the book stone in a rotated position and rotates it accordingly
+TEST_F(opening_book_test, lookup_in_symmetric_position) {
+    opening_book_builder builder(2);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(builder.add_game(play_game(ruleset_type::swap2, {search_move::stone(3, 4), search_move::stone(5, 6)})));
+    }
+    // played only once, so it does not make it into the book
+    ASSERT_TRUE(builder.add_game(play_game(ruleset_type::swap2, {search_move::stone(3, 4), search_move::stone(9, 9)})));
+    EXPECT_FALSE(builder.add_game(game_record::from_json_line("{\"ruleset\":\"swap2\",\"board_size\":15,\"moves\":[[3,4]]}")));
+    EXPECT_EQ(builder.get_num_games(), 4);
+    builder.write(path, 2);
+
+    opening_book book(path);
+    EXPECT_EQ(book.get_num_entries(), 2);
+    for (unsigned int symmetry = 0; symmetry < position_hash::num_symmetries; ++symmetry) {
+        search_position position(ruleset_type::swap2, 15);
+        ASSERT_TRUE(position.apply_move(position_hash::transform(symmetry, 15, search_move::stone(3, 4))));
+        search_move move;
+        const opening_book::entry* book_entry = book.lookup(position, move);
+        ASSERT_NE(book_entry, nullptr);
+        EXPECT_EQ(book_entry->games, 3);
+        EXPECT_EQ(move, position_hash::transform(symmetry, 15, search_move::stone(5, 6)));
+    }
+
+    search_position unknown_position(ruleset_type::swap2, 15);
+    unknown_position.apply_move(search_move::stone(7, 7));
+    search_move move;
+    EXPECT_EQ(book.lookup(unknown_position, move), nullptr);
+}
+
+// Swap decisions are book moves like stones
+TEST_F(opening_book_test, lookup_swap_decision) {
+    opening_book_builder builder(2);
+    for (int i = 0; i < 2; ++i) {
+        builder.add_game(play_game(ruleset_type::swap_after_first_move,
+                                   {search_move::stone(7, 7), search_move::swap(swap_decision_type::do_swap)}));
+    }
+    builder.write(path, 1);
+
+    opening_book book(path);
+    search_position position(ruleset_type::swap_after_first_move, 15);
+    search_move move;
+    ASSERT_NE(book.lookup(position, move), nullptr);
+    EXPECT_EQ(move, search_move::stone(7, 7));
+    position.apply_move(move);
+    ASSERT_NE(book.lookup(position, move), nullptr);
+    EXPECT_EQ(move, search_move::swap(swap_decision_type::do_swap));
+}
+
+// An engine with a book plays book moves without searching
+TEST_F(opening_book_test, engine_plays_book_move) {
+    opening_book_builder builder(1);
+    builder.add_game(play_game(ruleset_type::swap2, {search_move::stone(7, 7)}));
+    builder.write(path, 1);
+
+    mcts_engine engine(mcts_engine::get_settings(easy_bot));
+    engine.set_opening_book(std::make_shared<const opening_book>(path));
+    mcts_result result = engine.search(search_position(ruleset_type::swap2, 15));
+    EXPECT_EQ(result.best_move, search_move::stone(7, 7));
+    EXPECT_EQ(result.num_playouts, 0);
+}
+
+// Files that are not books are rejected
+TEST_F(opening_book_test, invalid_book_file) {
+    EXPECT_THROW(opening_book("/nonexistent/gomoku-book.bin"), gomoku_exception);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "GBOK and some text that is not a book";
+    }
+    EXPECT_THROW(opening_book book(path), gomoku_exception);
+}
@@ -0,0 +1,113 @@
+#include <random>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/line_patterns/pattern_board.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class pattern_board_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    pattern_board board;
+
+    void place_stones(const std::vector<std::pair<unsigned int, unsigned int>>& stones, field_type colour) {
+        for (const std::pair<unsigned int, unsigned int>& stone : stones) {
+            ASSERT_TRUE(board.place_stone(stone.first, stone.second, colour));
+        }
+    }
+
+    static void expect_same_patterns(const pattern_board& expected, const pattern_board& actual) {
+        ASSERT_EQ(expected.get_board_size(), actual.get_board_size());
+        for (field_type colour : {field_type::black_stone, field_type::white_stone}) {
+            for (unsigned int pattern = 0; pattern < line_pattern_table::NUM_LINE_PATTERNS; ++pattern) {
+                EXPECT_EQ(expected.get_pattern_count(colour, line_pattern(pattern)), actual.get_pattern_count(colour, line_pattern(pattern)));
+            }
+            for (unsigned int y = 0; y < expected.get_board_size(); ++y) {
+                for (unsigned int x = 0; x < expected.get_board_size(); ++x) {
+                    for (unsigned int direction = 0; direction < pattern_board::NUM_DIRECTIONS; ++direction) {
+                        ASSERT_EQ(expected.get_pattern(x, y, direction, colour), actual.get_pattern(x, y, direction, colour));
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(expected.evaluate(field_type::black_stone), actual.evaluate(field_type::black_stone));
+    }
+};
+
+TEST_F(pattern_board_test, empty_board) {
+    EXPECT_EQ(0, board.get_num_stones());
+    EXPECT_EQ(0, board.evaluate(field_type::black_stone));
+    EXPECT_EQ(no_pattern, board.get_best_pattern(7, 7, field_type::black_stone));
+    EXPECT_EQ(15 * 15 * pattern_board::NUM_DIRECTIONS, board.get_pattern_count(field_type::white_stone, no_pattern));
+}
+
+TEST_F(pattern_board_test, patterns) {
+    place_stones({{5, 7}, {6, 7}}, field_type::black_stone);
+    EXPECT_EQ(pattern_open_three, board.get_pattern(7, 7, 0, field_type::black_stone));
+    EXPECT_EQ(pattern_open_three, board.get_pattern(4, 7, 0, field_type::black_stone));
+    EXPECT_EQ(pattern_open_two, board.get_pattern(6, 8, 1, field_type::black_stone));
+    EXPECT_EQ(no_pattern, board.get_pattern(7, 7, 2, field_type::black_stone));
+    EXPECT_EQ(no_pattern, board.get_pattern(5, 7, 0, field_type::black_stone));
+
+    place_stones({{4, 7}}, field_type::white_stone);
+    EXPECT_EQ(pattern_three, board.get_pattern(7, 7, 0, field_type::black_stone));
+
+    place_stones({{7, 7}}, field_type::black_stone);
+    EXPECT_EQ(pattern_four, board.get_pattern(8, 7, 0, field_type::black_stone));
+    EXPECT_EQ(pattern_four, board.get_best_pattern(9, 7, field_type::black_stone));
+
+    place_stones({{8, 7}}, field_type::black_stone);
+    EXPECT_EQ(pattern_five, board.get_pattern(9, 7, 0, field_type::black_stone));
+    EXPECT_EQ(1, board.get_pattern_count(field_type::black_stone, pattern_five));
+    EXPECT_GT(board.evaluate(field_type::black_stone), 0);
+    EXPECT_EQ(-board.evaluate(field_type::black_stone), board.evaluate(field_type::white_stone));
+}
+
+// Lines near the edge of the board have less room for five stones
+TEST_F(pattern_board_test, edge_of_board) {
+    place_stones({{0, 0}, {1, 0}}, field_type::white_stone);
+    EXPECT_EQ(pattern_three, board.get_pattern(2, 0, 0, field_type::white_stone));
+    EXPECT_EQ(no_pattern, board.get_pattern(2, 0, 0, field_type::black_stone));
+    EXPECT_EQ(pattern_two, board.get_pattern(1, 1, 1, field_type::white_stone));
+}
+
+TEST_F(pattern_board_test, invalid_moves) {
+    EXPECT_FALSE(board.place_stone(15, 0, field_type::black_stone));
+    EXPECT_FALSE(board.place_stone(0, 0, field_type::empty));
+    EXPECT_TRUE(board.place_stone(0, 0, field_type::black_stone));
+    EXPECT_FALSE(board.place_stone(0, 0, field_type::white_stone));
+    EXPECT_FALSE(board.undo_stone(1, 0));
+    EXPECT_EQ(1, board.get_num_stones());
+    EXPECT_THROW(board.get_pattern(0, 0, 4, field_type::black_stone), gomoku_exception);
+}
+
+// The incrementally updated patterns must match a board that is built from scratch, and undoing all moves must
+// restore the empty board
+TEST_F(pattern_board_test, incremental_updates) {
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        pattern_board incremental(board_size);
+        playing_board reference(board_size);
+        std::vector<std::pair<unsigned int, unsigned int>> moves;
+        std::mt19937 rng(board_size);
+        std::uniform_int_distribution<unsigned int> coordinate(0, board_size - 1);
+        std::string err;
+        while (moves.size() < 2 * board_size) {
+            unsigned int x = coordinate(rng);
+            unsigned int y = coordinate(rng);
+            field_type colour = moves.size() % 2 == 0 ? field_type::black_stone : field_type::white_stone;
+            if (incremental.place_stone(x, y, colour)) {
+                ASSERT_TRUE(reference.place_stone(x, y, colour, err));
+                moves.emplace_back(x, y);
+            }
+        }
+        expect_same_patterns(pattern_board(reference), incremental);
+
+        for (auto move = moves.rbegin(); move != moves.rend(); ++move) {
+            ASSERT_TRUE(incremental.undo_stone(move->first, move->second));
+        }
+        EXPECT_EQ(0, incremental.get_num_stones());
+        expect_same_patterns(pattern_board(board_size), incremental);
+    }
+}
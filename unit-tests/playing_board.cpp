@@ -96,6 +96,47 @@ TEST_F(playing_board_test, reset_board) {
     EXPECT_EQ(expected_board, board.get_playing_board());
 }
 
+// The stone counter must follow successful placements only and be restored by a reset
+TEST_F(playing_board_test, count_stones) {
+    EXPECT_EQ(0, board.get_num_stones());
+    EXPECT_EQ(playing_board::MAX_NUM_STONES, board.get_num_empty_fields());
+    EXPECT_TRUE(board.place_stone(0, 0, field_type::black_stone, err));
+    EXPECT_TRUE(board.place_stone(5, 5, field_type::white_stone, err));
+    EXPECT_FALSE(board.place_stone(5, 5, field_type::black_stone, err));
+    EXPECT_FALSE(board.place_stone(15, 0, field_type::black_stone, err));
+    EXPECT_EQ(2, board.get_num_stones());
+    EXPECT_FALSE(board.is_full());
+
+    board.setup_round(err);
+    EXPECT_EQ(0, board.get_num_stones());
+}
+
+// A board with a stone on every field must be full
+TEST_F(playing_board_test, full_board) {
+    for (int i = 0; i < playing_board::_playing_board_size; ++i) {
+        for (int j = 0; j < playing_board::_playing_board_size; ++j) {
+            EXPECT_FALSE(board.is_full());
+            EXPECT_TRUE(board.place_stone(i, j, field_type::white_stone, err));
+        }
+    }
+    EXPECT_TRUE(board.is_full());
+    EXPECT_EQ(0, board.get_num_empty_fields());
+}
+
+// Boards of other supported sizes must accept stones up to their own edge
+TEST_F(playing_board_test, larger_board) {
+    playing_board large_board(19);
+    EXPECT_EQ(19, large_board.get_board_size());
+    EXPECT_EQ(19 * 19, large_board.get_num_empty_fields());
+    EXPECT_TRUE(large_board.place_stone(18, 18, field_type::black_stone, err));
+    EXPECT_FALSE(large_board.place_stone(19, 0, field_type::black_stone, err));
+    EXPECT_EQ(field_type::black_stone, large_board.get_playing_board().at(18).at(18));
+
+    EXPECT_FALSE(board.set_board_size(16, err));
+    EXPECT_TRUE(board.set_board_size(31, err));
+    EXPECT_EQ(31 * 31, board.get_num_empty_fields());
+}
+
 // serialising and deserialising a playing board must result in the initial playing board
 TEST_F(playing_board_test, serialization_equality) {
     EXPECT_TRUE(board.place_stone(0, 0, field_type::black_stone, err));
@@ -111,6 +152,31 @@ TEST_F(playing_board_test, serialization_equality) {
 
     EXPECT_EQ(board.get_id(), playing_board_recv->get_id());
     EXPECT_EQ(board.get_playing_board(), playing_board_recv->get_playing_board());
+    EXPECT_EQ(board.get_num_stones(), playing_board_recv->get_num_stones());
+}
+
+// serialising and deserialising a larger playing board must keep its size
+TEST_F(playing_board_test, serialization_board_size) {
+    playing_board large_board(19);
+    EXPECT_TRUE(large_board.place_stone(18, 0, field_type::white_stone, err));
+
+    rapidjson::Document* json = large_board.to_json();
+    class playing_board* playing_board_recv = playing_board::from_json(*json);
+    delete json;
+
+    EXPECT_EQ(19, playing_board_recv->get_board_size());
+    EXPECT_EQ(large_board.get_playing_board(), playing_board_recv->get_playing_board());
+    delete playing_board_recv;
+}
+
+// Deserializing a board whose stones do not match the transmitted stone count must throw a gomoku_exception
+TEST_F(playing_board_test, serialization_wrong_stone_count) {
+    EXPECT_TRUE(board.place_stone(0, 0, field_type::black_stone, err));
+
+    rapidjson::Document* json = board.to_json();
+    (*json)["num_stones"].SetUint(2);
+    EXPECT_THROW(playing_board::from_json(*json), gomoku_exception);
+    delete json;
 }
 
 // Deserializing an invalid string must throw a gomoku_exception
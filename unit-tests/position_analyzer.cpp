@@ -0,0 +1,168 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/server/position_analyzer.h"
+#include "../src/common/game_state/position_hash/position_hash.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+#include "../src/common/serialization/json_utils.h"
+
+
+class position_analyzer_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    static constexpr unsigned int board_size = 15;
+
+    // without an address, so no responses are sent
+    player requester = player(uuid_generator::generate_uuid_v4(), "requester", black);
+
+    void SetUp() override {
+        // a small playout limit instead of the time budget keeps the tests short
+        position_analyzer::set_settings({std::chrono::milliseconds(0), 400, 1, 1.2f, 3, 1u << 16, 1});
+    }
+
+    // a board with 'black' and 'white' stones, on which 'colour_to_move' is to move
+    static std::vector<field_type> make_board(const std::vector<std::pair<unsigned int, unsigned int>>& black,
+                                              const std::vector<std::pair<unsigned int, unsigned int>>& white) {
+        std::vector<field_type> fields(board_size * board_size, field_type::empty);
+        for (const auto& [x, y] : black) {
+            fields[y * board_size + x] = field_type::black_stone;
+        }
+        for (const auto& [x, y] : white) {
+            fields[y * board_size + x] = field_type::white_stone;
+        }
+        return fields;
+    }
+};
+
+
+// Boards are sent as one character per field
+TEST_F(position_analyzer_test, encode_board) {
+    const std::vector<field_type> fields = make_board({{0, 0}, {7, 7}}, {{14, 14}});
+    const std::string board = analyze_position_request::encode_board(fields);
+    ASSERT_EQ(board.size(), board_size * board_size);
+    EXPECT_EQ(board.front(), 'b');
+    EXPECT_EQ(board.back(), 'w');
+    EXPECT_EQ(analyze_position_request::decode_board(board), fields);
+    EXPECT_THROW(analyze_position_request::decode_board("..x"), gomoku_exception);
+}
+
+// The request keeps its board and settings when it is sent
+TEST_F(position_analyzer_test, request_json) {
+    const analyze_position_request request(requester.get_id(), "", "freestyle", board_size,
+                                           make_board({{7, 7}}, {{8, 8}}), player_colour_type::black, 3);
+    rapidjson::Document* json_send = request.to_json();
+    const std::string message = json_utils::to_string(json_send);
+    delete json_send;
+
+    rapidjson::Document json_recv = rapidjson::Document(rapidjson::kObjectType);
+    json_recv.Parse(message.c_str());
+    client_request* received = client_request::from_json(json_recv);
+    const analyze_position_request* received_request = dynamic_cast<analyze_position_request*>(received);
+    ASSERT_NE(received_request, nullptr);
+    EXPECT_EQ(received_request->get_req_id(), request.get_req_id());
+    EXPECT_EQ(received_request->get_ruleset_string(), "freestyle");
+    EXPECT_EQ(received_request->get_board_size(), board_size);
+    EXPECT_EQ(received_request->get_fields(), request.get_fields());
+    EXPECT_EQ(received_request->get_colour_to_move(), player_colour_type::black);
+    EXPECT_EQ(received_request->get_nof_lines(), 3);
+    delete received;
+}
+
+// A board without history is past the opening, with the given colour to move
+TEST_F(position_analyzer_test, position_from_board) {
+    const search_position position(ruleset_type::freestyle, board_size, make_board({{7, 7}, {6, 9}}, {{8, 8}}),
+                                   player_colour_type::white);
+    EXPECT_EQ(position.get_num_stones(), 3);
+    EXPECT_EQ(position.get_current_colour(), field_type::white_stone);
+    EXPECT_FALSE(position.is_finished());
+    EXPECT_THROW(search_position(ruleset_type::freestyle, board_size, std::vector<field_type>(10, field_type::empty),
+                                 player_colour_type::black), gomoku_exception);
+}
+
+// Analyses finish with legal lines, the most visited first
+TEST_F(position_analyzer_test, analyze_position) {
+    search_position position(ruleset_type::freestyle, board_size, make_board({{7, 7}, {6, 9}, {3, 3}}, {{8, 8}}),
+                             player_colour_type::white);
+    std::shared_ptr<task_scheduler::task> analysis = position_analyzer::start_analysis(&requester, "analysis", position, 3);
+    ASSERT_NE(analysis, nullptr);
+    analysis->wait();
+    EXPECT_FALSE(analysis->is_cancelled());
+
+    std::vector<mcts_line> lines;
+    unsigned int nof_playouts = 0;
+    ASSERT_TRUE(position_analyzer::find_cached(position, lines, nof_playouts));
+    EXPECT_GE(nof_playouts, 400);
+    ASSERT_FALSE(lines.empty());
+    for (unsigned int i = 0; i < lines.size(); ++i) {
+        if (i > 0) {
+            EXPECT_GE(lines[i - 1].visits, lines[i].visits);
+        }
+        ASSERT_FALSE(lines[i].principal_variation.empty());
+        EXPECT_EQ(lines[i].principal_variation.front(), lines[i].move);
+        EXPECT_LE(lines[i].principal_variation.size(), position_analyzer::max_line_length);
+        // the whole variation can be played on the board
+        for (const search_move& move : lines[i].principal_variation) {
+            ASSERT_TRUE(position.is_legal(move));
+            position.apply_move(move);
+        }
+        for (unsigned int j = 0; j < lines[i].principal_variation.size(); ++j) {
+            position.undo_move();
+        }
+    }
+}
+
+// Analyses of the same board in another orientation are answered from the cache
+TEST_F(position_analyzer_test, cached_symmetric_position) {
+    const search_position position(ruleset_type::freestyle, board_size, make_board({{7, 7}, {5, 9}}, {{9, 8}}),
+                                   player_colour_type::white);
+    // mirrored at the vertical axis
+    const search_position mirrored(ruleset_type::freestyle, board_size, make_board({{7, 7}, {9, 9}}, {{5, 8}}),
+                                   player_colour_type::white);
+    ASSERT_EQ(position_hash::get_canonical_hash(position).hash, position_hash::get_canonical_hash(mirrored).hash);
+
+    std::shared_ptr<task_scheduler::task> analysis = position_analyzer::start_analysis(&requester, "first", position, 5);
+    ASSERT_NE(analysis, nullptr);
+    analysis->wait();
+    EXPECT_EQ(position_analyzer::start_analysis(&requester, "second", position, 5), nullptr);
+    EXPECT_EQ(position_analyzer::start_analysis(&requester, "mirrored", mirrored, 5), nullptr);
+
+    std::vector<mcts_line> lines;
+    std::vector<mcts_line> mirrored_lines;
+    unsigned int nof_playouts = 0;
+    ASSERT_TRUE(position_analyzer::find_cached(position, lines, nof_playouts));
+    ASSERT_TRUE(position_analyzer::find_cached(mirrored, mirrored_lines, nof_playouts));
+    ASSERT_EQ(lines.size(), mirrored_lines.size());
+    for (unsigned int i = 0; i < lines.size(); ++i) {
+        EXPECT_EQ(mirrored_lines[i].move, search_move::stone(board_size - 1 - lines[i].move.x, lines[i].move.y));
+        EXPECT_EQ(mirrored_lines[i].visits, lines[i].visits);
+    }
+}
+
+// Finished games cannot be analyzed
+TEST_F(position_analyzer_test, finished_game) {
+    const search_position full_board(ruleset_type::freestyle, board_size,
+                                     std::vector<field_type>(board_size * board_size, field_type::black_stone),
+                                     player_colour_type::white);
+    EXPECT_THROW(position_analyzer::start_analysis(&requester, "full", full_board, 1), gomoku_exception);
+}
+
+// A board with a five is finished, even if the board is not full
+TEST_F(position_analyzer_test, board_with_five) {
+    const search_position five(ruleset_type::freestyle, board_size,
+                               make_board({{3, 7}, {4, 7}, {5, 7}, {6, 7}, {7, 7}}, {{0, 0}, {1, 0}, {2, 0}, {3, 0}}),
+                               player_colour_type::white);
+    EXPECT_TRUE(five.is_finished());
+    EXPECT_FALSE(five.is_tied());
+    EXPECT_EQ(five.get_current_colour(), field_type::black_stone);
+    EXPECT_THROW(position_analyzer::start_analysis(&requester, "five", five, 1), gomoku_exception);
+
+    // an overline does not win for black under the renju ruleset
+    const search_position overline(ruleset_type::renju, board_size,
+                                   make_board({{2, 7}, {3, 7}, {4, 7}, {5, 7}, {6, 7}, {7, 7}},
+                                              {{0, 0}, {1, 0}, {2, 0}, {3, 0}, {0, 2}}),
+                                   player_colour_type::white);
+    EXPECT_FALSE(overline.is_finished());
+}
@@ -0,0 +1,165 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/position_database/position_database_builder.h"
+#include "../src/common/game_state/position_hash/position_hash.h"
+#include "../src/common/game_state/mcts_engine/mcts_engine.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class position_database_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::string path = (std::filesystem::temp_directory_path() / "gomoku-positions-test.bin").string();
+
+    void TearDown() override {
+        std::filesystem::remove(path);
+    }
+
+    // A freestyle game in which black builds a five in row 7 from x = 'start' on, while white plays in row 0
+    static game_record black_wins(unsigned int start) {
+        game_record record;
+        record.ruleset = ruleset_type::freestyle;
+        for (unsigned int i = 0; i < 5; ++i) {
+            record.moves.push_back(search_move::stone(start + i, 7));
+            if (i < 4) {
+                record.moves.push_back(search_move::stone(2 * i, 0));
+            }
+        }
+        return record;
+    }
+
+    static position_record random_record(std::mt19937_64& rng) {
+        position_record record = {};
+        record.hash = rng();
+        record.side_to_move = rng() % 2 == 0 ? field_type::black_stone : field_type::white_stone;
+        record.result = static_cast<position_result>(rng() % 3);
+        record.best_move = rng() % 10 == 0 ? search_move::swap(static_cast<swap_decision_type>(rng() % 3))
+                                           : search_move::stone(rng() % 15, rng() % 15);
+        record.plies_to_end = rng() % 300;
+        record.num_games = 1 + rng() % 1000;
+        return record;
+    }
+};
+
+
+// The positions of a game are stored with the result for the side to move and the move that was played
+TEST_F(position_database_test, positions_of_a_game) {
+    std::stringstream records;
+    black_wins(3).write(records);
+    position_database_builder builder(0);
+    EXPECT_EQ(builder.import_records(records), 1);
+    EXPECT_EQ(builder.get_num_positions(), 9);
+    builder.write(path);
+
+    position_database database(path);
+    EXPECT_EQ(database.get_num_records(), 9);
+    search_position position = black_wins(3).replay();
+    position_record record;
+
+    // black to move with four in a row
+    position.undo_move();
+    ASSERT_TRUE(database.find(position, record));
+    EXPECT_EQ(record.result, position_result::position_won);
+    EXPECT_EQ(record.side_to_move, field_type::black_stone);
+    EXPECT_EQ(record.plies_to_end, 1);
+    EXPECT_EQ(record.best_move, search_move::stone(7, 7));
+
+    position.undo_move();
+    ASSERT_TRUE(database.find(position, record));
+    EXPECT_EQ(record.result, position_result::position_lost);
+    EXPECT_EQ(record.side_to_move, field_type::white_stone);
+    EXPECT_EQ(record.plies_to_end, 2);
+    EXPECT_EQ(record.best_move, search_move::stone(6, 0));
+
+    // the empty board
+    while (position.undo_move()) { }
+    ASSERT_TRUE(database.find(position, record));
+    EXPECT_EQ(record.plies_to_end, 9);
+    EXPECT_EQ(record.best_move, search_move::stone(3, 7));
+}
+
+// Symmetric positions of several games share a record, which keeps the best result and counts all games
+TEST_F(position_database_test, merge_symmetric_positions) {
+    position_database_builder builder(1);
+    game_record mirrored = black_wins(3);
+    for (search_move& move : mirrored.moves) {
+        move = position_hash::transform(4, 15, move);
+    }
+    EXPECT_TRUE(builder.add_game(black_wins(3)));
+    EXPECT_TRUE(builder.add_game(mirrored));
+    EXPECT_FALSE(builder.add_game(game_record::from_json_line("{\"ruleset\":\"freestyle\",\"board_size\":15,\"moves\":[[7,7]]}")));
+    EXPECT_EQ(builder.get_num_positions(), 1);
+    builder.write(path);
+
+    position_database database(path);
+    search_position position = mirrored.replay();
+    position.undo_move();
+    position_record record;
+    ASSERT_TRUE(database.find(position, record));
+    EXPECT_EQ(record.num_games, 2);
+    EXPECT_EQ(record.best_move, position_hash::transform(4, 15, search_move::stone(7, 7)));
+}
+
+// Records spread over many blocks are found again, absent hashes are mostly rejected by the bloom filter
+TEST_F(position_database_test, many_records) {
+    std::mt19937_64 rng(5);
+    std::vector<position_record> records;
+    position_database_builder builder(0);
+    for (unsigned int i = 0; i < 20000; ++i) {
+        records.push_back(random_record(rng));
+        builder.add_position(records.back());
+    }
+    builder.write(path);
+
+    position_database database(path);
+    ASSERT_EQ(database.get_num_records(), records.size());
+    for (const position_record& expected : records) {
+        position_record record;
+        ASSERT_TRUE(database.find(expected.hash, record));
+        EXPECT_EQ(record.side_to_move, expected.side_to_move);
+        EXPECT_EQ(record.result, expected.result);
+        EXPECT_EQ(record.best_move, expected.best_move);
+        EXPECT_EQ(record.plies_to_end, expected.plies_to_end);
+        EXPECT_EQ(record.num_games, expected.num_games);
+    }
+
+    unsigned int num_false_positives = 0;
+    for (unsigned int i = 0; i < 10000; ++i) {
+        std::uint64_t hash = rng();
+        position_record record;
+        num_false_positives += database.may_contain(hash) ? 1 : 0;
+        EXPECT_FALSE(database.find(hash, record));
+    }
+    EXPECT_LT(num_false_positives, 300);
+}
+
+// An engine with a database plays a known quick win without searching
+TEST_F(position_database_test, engine_plays_known_win) {
+    position_database_builder builder(mcts_engine::max_database_plies);
+    builder.add_game(black_wins(3));
+    builder.write(path);
+
+    mcts_engine engine(mcts_engine::get_settings(easy_bot));
+    engine.set_position_database(std::make_shared<const position_database>(path));
+    search_position position = black_wins(3).replay();
+    position.undo_move();
+    mcts_result result = engine.search(position);
+    EXPECT_EQ(result.best_move, search_move::stone(7, 7));
+    EXPECT_EQ(result.num_playouts, 0);
+}
+
+// Files that are not databases are rejected
+TEST_F(position_database_test, invalid_database_file) {
+    EXPECT_THROW(position_database("/nonexistent/gomoku-positions.bin"), gomoku_exception);
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "GPDB and some text that is not a database";
+    }
+    EXPECT_THROW(position_database database(path), gomoku_exception);
+}
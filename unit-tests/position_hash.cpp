@@ -0,0 +1,96 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/position_hash/position_hash.h"
+#include "../src/common/game_state/search_position/search_position.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class position_hash_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    std::mt19937 rng = std::mt19937(3);
+};
+
+
+// The symmetry tables are permutations of the fields and each symmetry is undone by its inverse
+TEST_F(position_hash_test, symmetry_tables) {
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        const position_hash::symmetry_table& table = position_hash::get_symmetry_table(board_size);
+        const unsigned int num_fields = board_size * board_size;
+        for (unsigned int symmetry = 0; symmetry < position_hash::num_symmetries; ++symmetry) {
+            std::vector<bool> is_hit(num_fields, false);
+            for (unsigned int field = 0; field < num_fields; ++field) {
+                unsigned int symmetric_field = table.transform(symmetry, field);
+                ASSERT_LT(symmetric_field, num_fields);
+                EXPECT_FALSE(is_hit[symmetric_field]);
+                is_hit[symmetric_field] = true;
+                EXPECT_EQ(table.transform(position_hash::inverse_symmetry(symmetry), symmetric_field), field);
+            }
+        }
+        // the centre stays where it is
+        unsigned int centre = (board_size / 2) * board_size + board_size / 2;
+        EXPECT_EQ(table.transform(3, centre), centre);
+        // a clockwise rotation moves the top left corner to the top right corner
+        EXPECT_EQ(table.transform(1, 0), board_size - 1);
+    }
+    EXPECT_THROW(position_hash::get_symmetry_table(16), gomoku_exception);
+}
+
+// The hashes that the search_position updates with every move are the same as the ones computed from scratch
+TEST_F(position_hash_test, incremental_hashes) {
+    for (unsigned int board_size : playing_board::_supported_board_sizes) {
+        search_position position(ruleset_type::freestyle, board_size);
+        std::vector<position_hash::symmetric_hashes> history = {position.get_stone_hashes()};
+        while (position.get_num_moves() < 30 && !position.is_finished()) {
+            if (position.apply_move(search_move::stone(rng() % board_size, rng() % board_size))) {
+                EXPECT_EQ(position.get_stone_hashes(), position_hash::compute_stone_hashes(position.get_fields(), board_size));
+                history.push_back(position.get_stone_hashes());
+            }
+        }
+        while (position.undo_move()) {
+            history.pop_back();
+            EXPECT_EQ(position.get_stone_hashes(), history.back());
+        }
+        EXPECT_EQ(position.get_stone_hashes(), position_hash::symmetric_hashes{});
+    }
+}
+
+// All 8 symmetric versions of a position have the same canonical hash, and the transforms can be undone
+TEST_F(position_hash_test, canonical_hash_of_symmetric_positions) {
+    std::vector<search_move> moves;
+    search_position position(ruleset_type::freestyle, 15);
+    while (moves.size() < 12) {
+        search_move move = search_move::stone(rng() % 15, rng() % 15);
+        if (position.apply_move(move)) {
+            moves.push_back(move);
+        }
+    }
+    const canonical_hash expected = position_hash::get_canonical_hash(position);
+
+    for (unsigned int symmetry = 0; symmetry < position_hash::num_symmetries; ++symmetry) {
+        search_position symmetric_position(ruleset_type::freestyle, 15);
+        for (const search_move& move : moves) {
+            search_move symmetric_move = position_hash::transform(symmetry, 15, move);
+            ASSERT_TRUE(symmetric_position.apply_move(symmetric_move));
+            EXPECT_EQ(position_hash::inverse_transform(symmetry, 15, symmetric_move), move);
+        }
+        EXPECT_EQ(position_hash::get_canonical_hash(symmetric_position).hash, expected.hash);
+        if (symmetry != 0) {
+            EXPECT_NE(position_hash::get_hash(symmetric_position), position_hash::get_hash(position));
+        }
+    }
+}
+
+// The swap state is part of the hash
+TEST_F(position_hash_test, hash_depends_on_swap_state) {
+    search_position swap2_position(ruleset_type::swap2, 15);
+    search_position freestyle_position(ruleset_type::freestyle, 15);
+    EXPECT_NE(position_hash::get_hash(swap2_position), position_hash::get_hash(freestyle_position));
+    swap2_position.apply_move(search_move::stone(7, 7));
+    freestyle_position.apply_move(search_move::stone(7, 7));
+    EXPECT_NE(position_hash::get_hash(swap2_position), position_hash::get_hash(freestyle_position));
+}
@@ -0,0 +1,92 @@
+#include "gtest/gtest.h"
+#include "../src/common/game_state/renju_rules/renju_rules.h"
+#include "../src/common/game_state/playing_board/playing_board.h"
+
+
+class renju_rules_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    playing_board board;
+    std::string err;
+
+    void place_stones(const std::vector<std::pair<unsigned int, unsigned int>>& stones, field_type colour) {
+        for (const std::pair<unsigned int, unsigned int>& stone : stones) {
+            ASSERT_TRUE(board.place_stone(stone.first, stone.second, colour, err));
+        }
+    }
+};
+
+// Black completing two open threes with one stone must be forbidden
+TEST_F(renju_rules_test, double_three) {
+    place_stones({{7, 5}, {7, 6}, {5, 7}, {6, 7}}, black_stone);
+    EXPECT_EQ(forbidden_double_three, renju_rules::check_black_move(board, 7, 7));
+}
+
+// A three that is closed on one side can not become a straight four and does not count
+TEST_F(renju_rules_test, closed_three) {
+    place_stones({{7, 5}, {7, 6}, {5, 7}, {6, 7}}, black_stone);
+    place_stones({{7, 8}}, white_stone);
+    EXPECT_EQ(allowed_move, renju_rules::check_black_move(board, 7, 7));
+}
+
+// Black completing two fours with one stone must be forbidden
+TEST_F(renju_rules_test, double_four) {
+    place_stones({{7, 4}, {7, 5}, {7, 6}, {4, 7}, {5, 7}, {6, 7}}, black_stone);
+    EXPECT_EQ(forbidden_double_four, renju_rules::check_black_move(board, 7, 7));
+}
+
+// Two fours on the same line ("X.XXX.X") are a double-four as well
+TEST_F(renju_rules_test, double_four_one_line) {
+    place_stones({{3, 7}, {5, 7}, {6, 7}, {9, 7}}, black_stone);
+    EXPECT_EQ(forbidden_double_four, renju_rules::check_black_move(board, 7, 7));
+}
+
+// A four and a three at the same time are allowed
+TEST_F(renju_rules_test, four_three) {
+    place_stones({{7, 4}, {7, 5}, {7, 6}, {5, 7}, {6, 7}}, black_stone);
+    EXPECT_EQ(allowed_move, renju_rules::check_black_move(board, 7, 7));
+}
+
+// Six or more stones in a row must be forbidden for black
+TEST_F(renju_rules_test, overline) {
+    place_stones({{2, 7}, {3, 7}, {4, 7}, {6, 7}, {7, 7}}, black_stone);
+    EXPECT_EQ(forbidden_overline, renju_rules::check_black_move(board, 5, 7));
+}
+
+// Completing exactly five wins, even if the stone also forms a double-three
+TEST_F(renju_rules_test, five_takes_precedence) {
+    place_stones({{3, 7}, {4, 7}, {5, 7}, {6, 7}, {7, 5}, {7, 6}, {5, 5}, {6, 6}}, black_stone);
+    EXPECT_EQ(allowed_move, renju_rules::check_black_move(board, 7, 7));
+}
+
+// Stones that would only make an overline when extended do not form a three
+TEST_F(renju_rules_test, three_limited_by_overline) {
+    place_stones({{3, 7}, {6, 7}, {8, 7}, {11, 7}, {7, 5}, {7, 6}}, black_stone);
+    EXPECT_EQ(allowed_move, renju_rules::check_black_move(board, 7, 7));
+}
+
+// A three whose straight four completions are forbidden themselves is not a real three
+TEST_F(renju_rules_test, false_three_recursive) {
+    place_stones({{7, 6}, {7, 8}, {6, 7}, {8, 7}}, black_stone);
+    EXPECT_EQ(forbidden_double_three, renju_rules::check_black_move(board, 7, 7));
+
+    // turn both completions of the vertical three into overline points
+    place_stones({{4, 5}, {5, 5}, {6, 5}, {8, 5}, {9, 5}}, black_stone);
+    place_stones({{4, 9}, {5, 9}, {6, 9}, {8, 9}, {9, 9}}, black_stone);
+    EXPECT_EQ(forbidden_overline, renju_rules::check_black_move(board, 7, 5));
+    EXPECT_EQ(allowed_move, renju_rules::check_black_move(board, 7, 7));
+}
+
+// Only empty fields that are forbidden for black must be reported
+TEST_F(renju_rules_test, forbidden_fields) {
+    EXPECT_TRUE(renju_rules::get_forbidden_fields(board).empty());
+    place_stones({{7, 5}, {7, 6}, {5, 7}, {6, 7}}, black_stone);
+
+    std::vector<std::pair<unsigned int, unsigned int>> forbidden_fields = renju_rules::get_forbidden_fields(board);
+    EXPECT_NE(forbidden_fields.end(), std::find(forbidden_fields.begin(), forbidden_fields.end(), std::make_pair(7u, 7u)));
+    for (const std::pair<unsigned int, unsigned int>& field : forbidden_fields) {
+        EXPECT_EQ(field_type::empty, board.get_field(field.first, field.second));
+    }
+}
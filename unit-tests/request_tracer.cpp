@@ -0,0 +1,86 @@
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/server/request_tracer.h"
+#include "../rapidjson/include/rapidjson/document.h"
+
+
+class request_tracer_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    void SetUp() override {
+        request_tracer::clear();
+    }
+
+    void TearDown() override {
+        request_tracer::set_sample_rate(0);
+        request_tracer::end_request();
+    }
+
+    static void handle_traced_request() {
+        request_tracer::begin_request();
+        {
+            trace_span outer_span("outer", "detail");
+            trace_span inner_span("inner");
+        }
+        request_tracer::end_request();
+    }
+
+    // parses the exported trace and returns its events
+    static rapidjson::Document export_trace() {
+        rapidjson::Document trace;
+        trace.Parse(request_tracer::to_chrome_trace_json().c_str());
+        EXPECT_FALSE(trace.HasParseError());
+        EXPECT_TRUE(trace.HasMember("traceEvents"));
+        return trace;
+    }
+};
+
+
+// Nested spans are exported as complete events, the outer one first
+TEST_F(request_tracer_test, export_chrome_trace) {
+    request_tracer::set_sample_rate(1);
+    handle_traced_request();
+
+    rapidjson::Document trace = export_trace();
+    const rapidjson::Value& events = trace["traceEvents"];
+    ASSERT_EQ(events.Size(), 2);
+    EXPECT_STREQ(events[0]["name"].GetString(), "outer");
+    EXPECT_STREQ(events[0]["args"]["detail"].GetString(), "detail");
+    EXPECT_STREQ(events[0]["ph"].GetString(), "X");
+    EXPECT_STREQ(events[1]["name"].GetString(), "inner");
+    EXPECT_FALSE(events[1].HasMember("args"));
+    EXPECT_LE(events[0]["ts"].GetDouble(), events[1]["ts"].GetDouble());
+    EXPECT_GE(events[0]["dur"].GetDouble(), events[1]["dur"].GetDouble());
+}
+
+// Only every n-th request is traced and no spans are recorded outside of traced requests
+TEST_F(request_tracer_test, sample_rate) {
+    request_tracer::set_sample_rate(4);
+    for (int i = 0; i < 20; ++i) {
+        handle_traced_request();
+    }
+    {
+        trace_span span_outside_request("outside");
+    }
+    EXPECT_EQ(export_trace()["traceEvents"].Size(), 2 * 5);
+
+    request_tracer::clear();
+    request_tracer::set_sample_rate(0);
+    handle_traced_request();
+    EXPECT_EQ(export_trace()["traceEvents"].Size(), 0);
+}
+
+// The spans of threads that ended are kept
+TEST_F(request_tracer_test, finished_threads) {
+    request_tracer::set_sample_rate(1);
+    std::thread thread(handle_traced_request);
+    thread.join();
+    handle_traced_request();
+
+    const rapidjson::Value& events = export_trace()["traceEvents"];
+    ASSERT_EQ(events.Size(), 4);
+    EXPECT_NE(events[0]["tid"].GetUint(), events[2]["tid"].GetUint());
+}
@@ -0,0 +1,208 @@
+#include <memory>
+#include <random>
+
+#include "gtest/gtest.h"
+#include "../src/common/game_state/search_position/search_position.h"
+#include "../src/common/exceptions/gomoku_exception.h"
+
+
+class search_position_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    // recreated for every random game
+    std::unique_ptr<game_state> test_game_state = std::make_unique<game_state>();
+    std::unique_ptr<player> player1 = std::make_unique<player>("player1", black);
+    std::unique_ptr<player> player2 = std::make_unique<player>("player2", white);
+
+    std::string err;
+
+    void start_game(const std::string& ruleset) {
+        test_game_state = std::make_unique<game_state>();
+        player1 = std::make_unique<player>("player1", black);
+        player2 = std::make_unique<player>("player2", white);
+        ASSERT_TRUE(test_game_state->add_player(player1.get(), err));
+        ASSERT_TRUE(test_game_state->add_player(player2.get(), err));
+        ASSERT_TRUE(test_game_state->set_game_mode(ruleset, err));
+        ASSERT_TRUE(test_game_state->start_game(err));
+    }
+
+    // applies 'move' to the game state in the same way as the game_instance on the server
+    bool apply_to_game_state(const search_move& move) {
+        if (move.type == search_move_type::swap_move) {
+            if (!test_game_state->determine_swap_decision(move.swap_decision, err)
+                || !test_game_state->update_current_player(err)) {
+                return false;
+            }
+            test_game_state->iterate_turn();
+            return true;
+        }
+        field_type colour = test_game_state->get_current_player()->get_colour() == player_colour_type::black
+                            ? field_type::black_stone : field_type::white_stone;
+        if (!test_game_state->place_stone(move.x, move.y, colour, err)) {
+            return false;
+        }
+        if (test_game_state->check_win_condition(move.x, move.y, colour) || test_game_state->check_for_tie()) {
+            test_game_state->wrap_up_round(err);
+            return true;
+        }
+        if (!test_game_state->update_current_player(err)) {
+            return false;
+        }
+        test_game_state->iterate_turn();
+        return true;
+    }
+
+    void expect_same_state(const search_position& position) {
+        std::vector<std::vector<field_type>> board = test_game_state->get_playing_board();
+        for (unsigned int y = 0; y < position.get_board_size(); ++y) {
+            for (unsigned int x = 0; x < position.get_board_size(); ++x) {
+                ASSERT_EQ(board[y][x], position.get_field(x, y));
+            }
+        }
+        EXPECT_EQ(test_game_state->get_turn_number(), position.get_turn_number());
+        EXPECT_EQ(test_game_state->get_current_player_idx(), position.get_current_player_idx());
+        EXPECT_EQ(player1->get_colour(), position.get_player_colour(0));
+        EXPECT_EQ(player2->get_colour(), position.get_player_colour(1));
+        EXPECT_EQ(test_game_state->get_swap_next_turn(), position.get_swap_next_turn());
+        EXPECT_EQ(test_game_state->get_swap_decision(), position.get_swap_decision());
+        EXPECT_EQ(test_game_state->is_finished(), position.is_finished());
+        EXPECT_EQ(test_game_state->is_tied(), position.is_tied());
+    }
+
+    // everything that apply_move and undo_move change, to compare positions before and after undoing
+    static std::vector<int> snapshot(const search_position& position) {
+        std::vector<int> values(position.get_fields(), position.get_fields() + position.get_board_size() * position.get_board_size());
+        values.insert(values.end(), {position.get_turn_number(), int(position.get_current_player_idx()),
+                                     position.get_player_colour(0), position.get_player_colour(1),
+                                     position.get_swap_next_turn(), position.get_swap_decision(),
+                                     position.is_finished(), position.is_tied(), int(position.get_num_stones())});
+        return values;
+    }
+
+    // Plays a random game on both the game state and a search position, and checks that they agree after every move.
+    // Afterwards, all moves are undone and each earlier position must be restored.
+    void play_random_game(const std::string& ruleset, unsigned int seed) {
+        start_game(ruleset);
+        search_position position(*test_game_state);
+        expect_same_state(position);
+
+        std::mt19937 rng(seed);
+        std::uniform_int_distribution<unsigned int> coordinate(0, position.get_board_size() - 1);
+        const std::vector<swap_decision_type> swap_decisions = {do_swap, do_not_swap, defer_swap};
+        std::uniform_int_distribution<unsigned int> swap_decision(0, swap_decisions.size() - 1);
+
+        std::vector<std::vector<int>> snapshots = {snapshot(position)};
+        while (!position.is_finished()) {
+            search_move move = position.get_swap_next_turn()
+                               ? search_move::swap(swap_decisions[swap_decision(rng)])
+                               : search_move::stone(coordinate(rng), coordinate(rng));
+            if (!position.is_legal(move)) {
+                EXPECT_FALSE(position.apply_move(move));
+                // placing on taken or forbidden fields is rejected by the game state without changing it
+                if (move.type == search_move_type::stone_move) {
+                    EXPECT_FALSE(apply_to_game_state(move));
+                }
+                continue;
+            }
+            ASSERT_TRUE(position.apply_move(move));
+            ASSERT_TRUE(apply_to_game_state(move));
+            EXPECT_EQ(move, position.get_last_move());
+            expect_same_state(position);
+            snapshots.push_back(snapshot(position));
+        }
+
+        EXPECT_EQ(snapshots.size() - 1, position.get_num_moves());
+        for (auto expected = snapshots.rbegin(); expected != snapshots.rend(); ++expected) {
+            ASSERT_EQ(*expected, snapshot(position));
+            position.undo_move();
+        }
+        EXPECT_FALSE(position.undo_move());
+    }
+};
+
+TEST_F(search_position_test, requires_two_players) {
+    EXPECT_THROW(search_position position(*test_game_state), gomoku_exception);
+}
+
+TEST_F(search_position_test, illegal_moves) {
+    start_game("swap_after_first_move");
+    search_position position(*test_game_state);
+    EXPECT_FALSE(position.apply_move(search_move::swap(do_swap)));
+    EXPECT_FALSE(position.apply_move(search_move::stone(15, 0)));
+    EXPECT_TRUE(position.apply_move(search_move::stone(7, 7)));
+    EXPECT_FALSE(position.apply_move(search_move::stone(8, 8)));
+    EXPECT_FALSE(position.apply_move(search_move::swap(defer_swap)));
+    EXPECT_TRUE(position.apply_move(search_move::swap(do_swap)));
+    EXPECT_FALSE(position.apply_move(search_move::stone(7, 7)));
+    EXPECT_EQ(2, position.get_num_moves());
+}
+
+TEST_F(search_position_test, win_and_undo) {
+    start_game("freestyle");
+    search_position position(*test_game_state);
+    for (unsigned int x = 0; x < 4; ++x) {
+        ASSERT_TRUE(position.apply_move(search_move::stone(x, 0)));
+        ASSERT_TRUE(position.apply_move(search_move::stone(x, 1)));
+    }
+    ASSERT_TRUE(position.apply_move(search_move::stone(4, 0)));
+    EXPECT_TRUE(position.is_finished());
+    EXPECT_FALSE(position.is_tied());
+    EXPECT_EQ(0, position.get_current_player_idx());
+    EXPECT_EQ(8, position.get_turn_number());
+    EXPECT_FALSE(position.is_legal(search_move::stone(4, 1)));
+
+    ASSERT_TRUE(position.undo_move());
+    EXPECT_FALSE(position.is_finished());
+    EXPECT_EQ(8, position.get_turn_number());
+    EXPECT_EQ(field_type::empty, position.get_field(4, 0));
+}
+
+// a copy continues the game like the original, including its history and hashes, without changing the original
+TEST_F(search_position_test, copy_and_undo) {
+    start_game("freestyle");
+    search_position position(*test_game_state);
+    ASSERT_TRUE(position.apply_move(search_move::stone(7, 7)));
+    ASSERT_TRUE(position.apply_move(search_move::stone(8, 8)));
+
+    search_position copy(position);
+    ASSERT_TRUE(copy.apply_move(search_move::stone(6, 6)));
+    EXPECT_EQ(field_type::empty, position.get_field(6, 6));
+    ASSERT_TRUE(copy.undo_move());
+    ASSERT_TRUE(copy.undo_move());
+    EXPECT_EQ(field_type::empty, copy.get_field(8, 8));
+    EXPECT_EQ(field_type::white_stone, position.get_field(8, 8));
+
+    copy = position;
+    EXPECT_EQ(position.get_turn_number(), copy.get_turn_number());
+    EXPECT_EQ(position.get_current_player_idx(), copy.get_current_player_idx());
+    EXPECT_EQ(position_hash::get_canonical_hash(position).hash, position_hash::get_canonical_hash(copy).hash);
+    ASSERT_TRUE(copy.undo_move());
+    ASSERT_TRUE(copy.undo_move());
+    EXPECT_FALSE(copy.undo_move());
+}
+
+TEST_F(search_position_test, random_games_freestyle) {
+    for (unsigned int seed = 0; seed < 5; ++seed) {
+        play_random_game("freestyle", seed);
+    }
+}
+
+TEST_F(search_position_test, random_games_renju) {
+    for (unsigned int seed = 0; seed < 5; ++seed) {
+        play_random_game("renju", seed);
+    }
+}
+
+TEST_F(search_position_test, random_games_swap_after_first_move) {
+    for (unsigned int seed = 0; seed < 5; ++seed) {
+        play_random_game("swap_after_first_move", seed);
+    }
+}
+
+TEST_F(search_position_test, random_games_swap2) {
+    for (unsigned int seed = 0; seed < 20; ++seed) {
+        play_random_game("swap2", seed);
+    }
+}
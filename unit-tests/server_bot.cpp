@@ -0,0 +1,53 @@
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/server/game_instance.h"
+
+
+class server_bot_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    // the game and its bot are destroyed first
+    player human = player(uuid_generator::generate_uuid_v4(), "human", black);
+    game_instance game;
+    std::string err;
+
+    void SetUp() override {
+        ASSERT_TRUE(game.try_add_player(&human, err));
+    }
+
+    // waits until the game reached 'turn_number', returns false after a few seconds
+    bool wait_for_turn(int turn_number) {
+        for (int i = 0; i < 1000 && game.get_game_state()->get_turn_number() < turn_number; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return game.get_game_state()->get_turn_number() >= turn_number;
+    }
+};
+
+
+// The bot answers the moves of the other player
+TEST_F(server_bot_test, play_against_bot) {
+    ASSERT_TRUE(game.add_bot(&human, "easy", err));
+    EXPECT_FALSE(game.add_bot(&human, "easy", err));
+    ASSERT_TRUE(game.set_game_mode(&human, "freestyle", 15, err));
+    ASSERT_TRUE(game.start_game(&human, err));
+    ASSERT_EQ(game.get_game_state()->get_current_player(), &human);
+
+    ASSERT_TRUE(game.place_stone(&human, 7, 7, field_type::black_stone, err));
+    ASSERT_TRUE(wait_for_turn(2));
+    EXPECT_EQ(game.get_game_state()->get_current_player(), &human);
+    EXPECT_EQ(game.get_game_state()->get_playing_board().at(7).at(7), field_type::black_stone);
+
+    ASSERT_TRUE(game.place_stone(&human, 7, 3, field_type::black_stone, err));
+    EXPECT_TRUE(wait_for_turn(4));
+}
+
+// Only the known difficulties can be chosen
+TEST_F(server_bot_test, unknown_difficulty) {
+    EXPECT_FALSE(game.add_bot(&human, "impossible", err));
+    EXPECT_EQ(game.get_game_state()->get_players().size(), 1);
+}
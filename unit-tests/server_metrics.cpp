@@ -0,0 +1,97 @@
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "../src/server/server_metrics.h"
+
+
+class server_metrics_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    // the metrics are shared by all tests, so the tests only compare values before and after counting
+    static double get_value(const std::string& metric) {
+        std::stringstream text(server_metrics::to_prometheus_text());
+        std::string line;
+        while (std::getline(text, line)) {
+            if (line.rfind(metric + " ", 0) == 0) {
+                return std::stod(line.substr(metric.size() + 1));
+            }
+        }
+        ADD_FAILURE() << "Metric " << metric << " not found";
+        return -1;
+    }
+};
+
+
+// Counts of threads that already ended and of threads that are still running are both included
+TEST_F(server_metrics_test, aggregate_threads) {
+    double requests_before = get_value("gomoku_requests_total{type=\"place_stone\"}");
+    double bytes_before = get_value("gomoku_received_bytes_total");
+
+    std::thread finished_thread([] {
+        server_metrics::count_request(request_type::place_stone, std::chrono::microseconds(50));
+        server_metrics::count_bytes_in(100);
+    });
+    finished_thread.join();
+
+    std::mutex mutex;
+    mutex.lock();
+    std::thread running_thread([&mutex] {
+        server_metrics::count_request(request_type::place_stone, std::chrono::milliseconds(2));
+        server_metrics::count_bytes_in(20);
+        // keep the thread alive until the counts were checked
+        mutex.lock();
+        mutex.unlock();
+    });
+    while (get_value("gomoku_received_bytes_total") < bytes_before + 120) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(get_value("gomoku_requests_total{type=\"place_stone\"}"), requests_before + 2);
+    mutex.unlock();
+    running_thread.join();
+
+    EXPECT_EQ(get_value("gomoku_requests_total{type=\"place_stone\"}"), requests_before + 2);
+    EXPECT_EQ(get_value("gomoku_received_bytes_total"), bytes_before + 120);
+}
+
+// Histogram buckets are cumulative and end with +Inf
+TEST_F(server_metrics_test, latency_histogram) {
+    std::string bucket = "gomoku_request_duration_seconds_bucket{type=\"forfeit\",le=\"";
+    double fast_before = get_value(bucket + "0.0001\"}");
+    double slow_before = get_value(bucket + "0.01\"}");
+    double all_before = get_value(bucket + "+Inf\"}");
+    double count_before = get_value("gomoku_request_duration_seconds_count{type=\"forfeit\"}");
+
+    server_metrics::count_request(request_type::forfeit, std::chrono::microseconds(10));
+    server_metrics::count_request(request_type::forfeit, std::chrono::milliseconds(5));
+    server_metrics::count_request(request_type::forfeit, std::chrono::seconds(3));
+
+    EXPECT_EQ(get_value(bucket + "0.0001\"}"), fast_before + 1);
+    EXPECT_EQ(get_value(bucket + "0.01\"}"), slow_before + 2);
+    EXPECT_EQ(get_value(bucket + "+Inf\"}"), all_before + 3);
+    EXPECT_EQ(get_value("gomoku_request_duration_seconds_count{type=\"forfeit\"}"), count_before + 3);
+}
+
+// Waiting for a held lock is recorded as a contended acquisition
+TEST_F(server_metrics_test, lock_wait) {
+    std::string lock = "{lock=\"game_modification\"}";
+    double acquisitions_before = get_value("gomoku_lock_acquisitions_total" + lock);
+    double contended_before = get_value("gomoku_lock_contended_acquisitions_total" + lock);
+
+    std::mutex mutex;
+    server_metrics::lock(mutex, lock_type::game_modification_lock);
+    std::thread waiting_thread([&mutex] {
+        server_metrics::lock(mutex, lock_type::game_modification_lock);
+        mutex.unlock();
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    mutex.unlock();
+    waiting_thread.join();
+
+    EXPECT_EQ(get_value("gomoku_lock_acquisitions_total" + lock), acquisitions_before + 2);
+    EXPECT_EQ(get_value("gomoku_lock_contended_acquisitions_total" + lock), contended_before + 1);
+    EXPECT_GT(get_value("gomoku_lock_wait_seconds_total" + lock), 0.0);
+}
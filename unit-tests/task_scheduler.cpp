@@ -0,0 +1,120 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "../src/server/task_scheduler.h"
+
+
+class task_scheduler_test : public ::testing::Test {
+
+protected:
+    /* Any object and subroutine declared here can be accessed in the tests */
+
+    // a task that runs for 'nof_slices' slices and counts them
+    static task_scheduler::task_function count_slices(std::atomic<int>& counter, int nof_slices) {
+        return [&counter, nof_slices](std::chrono::steady_clock::time_point slice_end) {
+            std::this_thread::sleep_until(std::min(slice_end, std::chrono::steady_clock::now() + std::chrono::milliseconds(1)));
+            return counter.fetch_add(1) + 1 >= nof_slices;
+        };
+    }
+};
+
+
+// Every task runs until it is done, also tasks that need several slices
+TEST_F(task_scheduler_test, run_tasks) {
+    task_scheduler scheduler(2);
+    std::vector<std::atomic<int>> counters(20);
+    std::vector<std::shared_ptr<task_scheduler::task>> tasks;
+    for (unsigned int i = 0; i < counters.size(); ++i) {
+        tasks.push_back(scheduler.submit(task_priority(i % task_scheduler::nof_priorities), count_slices(counters[i], 3)));
+    }
+    for (unsigned int i = 0; i < tasks.size(); ++i) {
+        tasks[i]->wait();
+        EXPECT_TRUE(tasks[i]->is_done());
+        EXPECT_EQ(counters[i].load(), 3);
+    }
+    uint64_t nof_completed = 0;
+    for (unsigned int priority = 0; priority < task_scheduler::nof_priorities; ++priority) {
+        nof_completed += scheduler.get_statistics(task_priority(priority)).nof_completed;
+        EXPECT_GT(scheduler.get_statistics(task_priority(priority)).nof_slices, 0);
+        EXPECT_GT(scheduler.get_utilization(task_priority(priority)), 0.0);
+    }
+    EXPECT_EQ(nof_completed, 20);
+}
+
+// Between the slices of a background task, the worker runs the tasks of a more urgent class first
+TEST_F(task_scheduler_test, priorities) {
+    task_scheduler scheduler(1);
+    std::atomic<int> nof_background_slices(0);
+    std::shared_ptr<task_scheduler::task> background = scheduler.submit(task_priority::background_priority,
+            [&](std::chrono::steady_clock::time_point slice_end) {
+                nof_background_slices.fetch_add(1);
+                std::this_thread::sleep_until(slice_end);
+                return false;
+            });
+    while (nof_background_slices.load() == 0) {
+        std::this_thread::yield();
+    }
+    const int nof_slices_before = nof_background_slices.load();
+    int nof_slices_at_urgent = 0;
+    std::shared_ptr<task_scheduler::task> urgent = scheduler.submit(task_priority::interactive_priority,
+            [&](std::chrono::steady_clock::time_point) {
+                nof_slices_at_urgent = nof_background_slices.load();
+                return true;
+            });
+    urgent->wait();
+    background->cancel();
+    background->wait();
+    // at most the slice that was running when the urgent task came in was finished first
+    EXPECT_LE(nof_slices_at_urgent - nof_slices_before, 1);
+    EXPECT_EQ(scheduler.get_statistics(task_priority::background_priority).nof_cancelled, 1);
+}
+
+// A capped class never runs on more workers than allowed, even if other workers are idle
+TEST_F(task_scheduler_test, max_workers) {
+    task_scheduler scheduler(4);
+    scheduler.set_max_workers(task_priority::background_priority, 1);
+    std::atomic<int> nof_running(0);
+    std::atomic<int> max_running(0);
+    std::vector<std::shared_ptr<task_scheduler::task>> tasks;
+    for (int i = 0; i < 8; ++i) {
+        tasks.push_back(scheduler.submit(task_priority::background_priority,
+                [&](std::chrono::steady_clock::time_point) {
+                    int running = nof_running.fetch_add(1) + 1;
+                    int expected = max_running.load();
+                    while (running > expected && !max_running.compare_exchange_weak(expected, running)) { }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                    nof_running.fetch_sub(1);
+                    return true;
+                }));
+    }
+    for (const std::shared_ptr<task_scheduler::task>& task : tasks) {
+        task->wait();
+    }
+    EXPECT_EQ(max_running.load(), 1);
+}
+
+// Cancelled tasks are not run again, and tasks that did not run are cancelled when the scheduler stops
+TEST_F(task_scheduler_test, cancel) {
+    std::atomic<int> counter(0);
+    std::shared_ptr<task_scheduler::task> endless;
+    {
+        task_scheduler scheduler(1);
+        endless = scheduler.submit(task_priority::bot_move_priority, count_slices(counter, 1000000));
+        while (counter.load() < 3) {
+            std::this_thread::yield();
+        }
+        endless->cancel();
+        endless->wait();
+        const int nof_slices = counter.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_EQ(counter.load(), nof_slices);
+        EXPECT_TRUE(endless->is_cancelled());
+
+        endless = scheduler.submit(task_priority::bot_move_priority, count_slices(counter, 1000000));
+    }
+    // the scheduler was destroyed before the task was done
+    EXPECT_TRUE(endless->is_done());
+}